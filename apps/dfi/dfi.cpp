@@ -31,6 +31,10 @@
 #include <iostream>
 #include <fstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace std;
 using namespace seqan;
 
@@ -60,6 +64,7 @@ typedef double TFloat;
         double      entropy;
         bool        maximal;
         CharString  output;
+        unsigned    numThreads;
 
         DFIOptions()
         {
@@ -69,6 +74,7 @@ typedef double TFloat;
             growthRate = 0;
             entropy = 0;
             maximal = false;
+            numThreads = 1;
         }
     };
 
@@ -260,7 +266,7 @@ template <typename TSize>
 struct SubstringEntry
 {
 	Pair<unsigned>	lPos;
-	unsigned		len, freqSum;
+	unsigned		len, parentLen;
 	Pair<TSize>		range;
 };
 
@@ -459,6 +465,173 @@ inline void compactSameSuffLinkFreqMatches(TMatchString &matches, TIndex const &
 //
 //}
 
+//////////////////////////////////////////////////////////////////////////////
+// Parallel traversal
+//
+// The Dfi is constructed lazily: the suffixes below a node form a contiguous
+// SA range that is only refined when the node is expanded. Hence, subtrees
+// can be expanded independently. The upper part of the tree is traversed
+// serially and every subtree whose SA range is small enough becomes a job.
+// A job expands its subtree in an own index over a copy of the SA range.
+// Jobs are dynamically assigned to threads and keep their matches in own
+// buffers, which are concatenated in preorder afterwards.
+
+template <typename TSize>
+struct DfiSubtreeJob
+{
+	Pair<TSize>						range;		// SA range of the subtree
+	unsigned						upperEnd;	// number of upper matches preceding the subtree
+	String<SubstringEntry<TSize> >	matches;
+};
+
+template <typename TMatchString, typename TIter, typename TSize>
+inline void appendMatch(TMatchString &matches, TIter &it, TSize saOffset, bool maximal)
+{
+	typedef typename Container<TIter>::Type			TIndex;
+	typedef typename Value<TMatchString>::Type		TSubstringEntry;
+
+	TSubstringEntry entry;
+	posLocalize(entry.lPos, getOccurrence(it), stringSetLimits(container(it)));
+	entry.range = range(it);
+	entry.range.i1 += saOffset;
+	entry.range.i2 += saOffset;
+	entry.len = repLength(it);
+	entry.parentLen = parentRepLength(it);
+	appendValue(matches, entry, Generous());
+
+	if (maximal && (dirAt(value(it).node, container(it)) & TIndex::DFI_PARENT_FREQ))
+	{
+		entry.lPos.i1 = 0;
+		entry.lPos.i2 = 0;
+		entry.range = range(container(it), nodeUp(it));
+		entry.range.i1 += saOffset;
+		entry.range.i2 += saOffset;
+		entry.len = ~0u;
+		appendValue(matches, entry, Generous());
+	}
+}
+
+// preorder traversal of the upper tree, subtrees with at most maxJobSize
+// suffixes are not descended but returned as jobs
+template <typename TMatchString, typename TJobs, typename TIndex, typename TSize>
+inline void collectUpperMatches(TMatchString &matches, TJobs &jobs, TIndex &index, TSize maxJobSize, bool maximal)
+{
+	typedef Iter<TIndex, VSTree<TopDown<ParentLinks<> > > >	TIter;
+	typedef typename Value<TJobs>::Type						TJob;
+
+	TIter it(index);
+	bool descend = true;
+	while (true)
+	{
+		if (!(descend && goDown(it)) && !goRight(it))
+			while (goUp(it) && !goRight(it)) {}
+		if (isRoot(it))
+			break;
+
+		if (nodePredicate(it))
+			appendMatch(matches, it, (TSize)0, maximal);
+
+		descend = (countOccurrences(it) > maxJobSize);
+		if (!descend && !(dirAt(value(it).node, index) & TIndex::LEAF))
+		{
+			resize(jobs, length(jobs) + 1, Generous());
+			TJob &job = back(jobs);
+			job.range = range(it);
+			job.upperEnd = length(matches);
+		}
+	}
+}
+
+// expand the subtree of a job and collect the matches below its root
+template <typename TIndex, typename TSize>
+inline void collectSubtreeMatches(DfiSubtreeJob<TSize> &job, TIndex &index, bool maximal)
+{
+	typedef Iter<TIndex, VSTree<TopDown<ParentLinks<> > > >	TIter;
+
+	TIndex subIndex(indexText(index), index.predHull, index.pred);
+	subIndex.ds = index.ds;
+	indexSA(subIndex) = infix(indexSA(index), job.range.i1, job.range.i2);
+	indexCreate(subIndex, WotdDir());
+
+	// the only child of the root is the subtree root
+	TIter it(subIndex);
+	if (goDown(it))
+	{
+		typename VertexDescriptor<TIndex>::Type subtreeRoot = value(it);
+		bool inSubtree = goDown(it);
+		while (inSubtree)
+		{
+			if (nodePredicate(it))
+				appendMatch(job.matches, it, job.range.i1, maximal);
+			if (goDown(it) || goRight(it))
+				continue;
+			while (goUp(it) && value(it).node != subtreeRoot.node && !goRight(it)) {}
+			inSubtree = (value(it).node != subtreeRoot.node);
+		}
+	}
+
+	// write back the refined SA range (the matches refer to it)
+	arrayCopyForward(
+		begin(indexSA(subIndex), Standard()),
+		end(indexSA(subIndex), Standard()),
+		begin(indexSA(index), Standard()) + job.range.i1);
+}
+
+// output all substrings of a node that are longer than its parent's
+template <typename TMatch, typename TStringSet, typename TIndex>
+inline void writeSubstrings(
+	std::ostream &out,
+	TMatch const &match,
+	TStringSet const &mySet,
+	TIndex const &index,
+	String<unsigned> const &dbLookup,
+	String<bool> &seen,
+	DfiEntry_ &entry)
+{
+	for(unsigned l = match.parentLen + 1; l <= match.len; ++l)
+	{
+#ifdef DEBUG_ENTROPY
+		// count frequencies (debug)
+		typedef typename Fibre<TIndex const, FibreSA>::Type TSA;
+		typedef typename Iterator<TSA, Standard>::Type TSAIter;
+		TSAIter oc = begin(indexSA(index), Standard()) + match.range.i1;
+		TSAIter ocEnd = begin(indexSA(index), Standard()) + match.range.i2;
+		arrayFill(begin(seen, Standard()), end(seen, Standard()), false);
+		arrayFill(begin(entry.freq, Standard()), end(entry.freq, Standard()), 0);
+		for (; oc != ocEnd; ++oc)
+		{
+			unsigned seqNo = getSeqNo(*oc, stringSetLimits(index));
+			if (!seen[seqNo])
+			{
+				seen[seqNo] = true;
+				++entry.freq[dbLookup[seqNo]];
+			}
+		}
+
+		PredEntropy entrp(0, index.ds);
+		double H = entrp.getEntropy(entry);
+		if (H <= 0.0) H = 0.0;
+		out << left << setw(14) << H << "[";
+		for (unsigned i = 0; i < length(entry.freq); ++i)
+			out << right << setw(6) << entry.freq[i];
+		out << "]      \"";
+#else
+		ignoreUnusedVariableWarning(index);
+		ignoreUnusedVariableWarning(dbLookup);
+		ignoreUnusedVariableWarning(seen);
+		ignoreUnusedVariableWarning(entry);
+#endif
+		out << infix(
+			mySet[getSeqNo(match.lPos)],
+			getSeqOffset(match.lPos),
+			getSeqOffset(match.lPos) + l);
+#ifdef DEBUG_ENTROPY
+		out << "\"";
+#endif
+		out << endl;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Create Dfi and output substrings within constraints band
 //
@@ -490,7 +663,8 @@ int runDFI(
 	typedef Index<TStringSet, IndexWotd<
 		Dfi<TPredHull, TPred> > >									TIndex;
 	typedef Iter<TIndex, VSTree<TopDown<ParentLinks<> > > >			TIter;
-	typedef SubstringEntry<typename Size<TIndex>::Type>				TSubstringEntry;
+	typedef typename Size<TIndex>::Type								TSize;
+	typedef SubstringEntry<TSize>									TSubstringEntry;
 
 	String<unsigned>	ds;
 	TStringSet			mySet;
@@ -503,7 +677,6 @@ int runDFI(
 	TPred					pred(paramPred, ds);
 	TPredHull				predHull(paramPredHull, ds);
 	TIndex					index(mySet, predHull, pred);
-	Pair<unsigned>			lPos;
 	String<TSubstringEntry>	matches;
 
 	// set index partition of sequences into datasets
@@ -527,9 +700,6 @@ int runDFI(
 	unsigned			freqSumLast = ~0;
 #endif
 
-	TIter it(index);
-	goBegin(it);
-
     std::streambuf *buf;
     std::ofstream of;
     if (!empty(options.output))
@@ -540,128 +710,124 @@ int runDFI(
     else
         buf = cout.rdbuf();
     std::ostream out(buf);
-	
-	if (maximal)
+
+	if (!maximal && options.numThreads <= 1)
 	{
-		for (unsigned m = 0; !atEnd(it); goNext(it), ++m)
+		// stream the substrings while traversing the tree
+		TIter it(index);
+		TSubstringEntry match;
+		for (goBegin(it); !atEnd(it); goNext(it))
 		{
-			resize(matches, m + 1, Generous());
-			posLocalize(matches[m].lPos, getOccurrence(it), stringSetLimits(container(it)));
-			matches[m].range = range(it);
-			matches[m].len = repLength(it);
-			if (dirAt(value(it).node, index) & TIndex::DFI_PARENT_FREQ)
-			{
-				++m;
-				resize(matches, m + 1, Generous());
-				matches[m].lPos.i1 = 0;
-				matches[m].lPos.i2 = 0;
-				matches[m].range = range(index, nodeUp(it));
-				matches[m].len = ~0u;
-			}
+			posLocalize(match.lPos, getOccurrence(it), stringSetLimits(container(it)));
+			match.range = range(it);
+			match.len = repLength(it);
+			match.parentLen = parentRepLength(it);
+			writeSubstrings(out, match, mySet, index, dbLookup, seen, entry);
 		}
-		
-		sort(begin(matches, Standard()), end(matches, Standard()), LessSubstringEnd<TSubstringEntry>());
-		compactMatches(matches);
-		sort(begin(matches, Standard()), end(matches, Standard()), LessRange<TSubstringEntry>());
-		compactSameParentFreqMatches(matches);
-		sort(begin(matches, Standard()), end(matches, Standard()), LessSubstringEnd<TSubstringEntry>());
-		compactSameSuffLinkFreqMatches(matches, index, dbLookup, seen, entry);
-		sort(begin(matches, Standard()), end(matches, Standard()), LessLex<TSubstringEntry>());
-		
-		typedef typename Iterator<String<TSubstringEntry>, Standard>::Type TMatchIter;
-		TMatchIter mit = begin(matches, Standard());
-		TMatchIter mitEnd = end(matches, Standard());
-		
-		for (; mit != mitEnd; ++mit)
+		return 0;
+	}
+
+	// traverse the upper tree serially and expand the remaining subtrees in parallel
+	typedef DfiSubtreeJob<TSize>									TJob;
+	String<TJob>			jobs;
+	String<TSubstringEntry>	upperMatches;
+
+	indexRequire(index, WotdDir());
+	TSize maxJobSize = 0;
+	if (options.numThreads > 1)
+		maxJobSize = length(indexSA(index)) / (16 * options.numThreads);
+	collectUpperMatches(upperMatches, jobs, index, maxJobSize, maximal);
+
+	SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 1))
+	for (int j = 0; j < (int)length(jobs); ++j)
+		collectSubtreeMatches(jobs[j], index, maximal);
+
+	if (!maximal)
+	{
+		// output the upper matches and the matches of the jobs in preorder
+		unsigned upperBegin = 0;
+		for (unsigned j = 0; j < length(jobs); ++j)
 		{
+			for (; upperBegin < jobs[j].upperEnd; ++upperBegin)
+				writeSubstrings(out, upperMatches[upperBegin], mySet, index, dbLookup, seen, entry);
+			for (unsigned m = 0; m < length(jobs[j].matches); ++m)
+				writeSubstrings(out, jobs[j].matches[m], mySet, index, dbLookup, seen, entry);
+			shrinkToFit(jobs[j].matches);
+		}
+		for (; upperBegin < length(upperMatches); ++upperBegin)
+			writeSubstrings(out, upperMatches[upperBegin], mySet, index, dbLookup, seen, entry);
+		return 0;
+	}
+
+	// concatenate the matches in preorder
+	unsigned upperBegin = 0;
+	for (unsigned j = 0; j < length(jobs); ++j)
+	{
+		append(matches, infix(upperMatches, upperBegin, jobs[j].upperEnd));
+		append(matches, jobs[j].matches);
+		upperBegin = jobs[j].upperEnd;
+	}
+	append(matches, suffix(upperMatches, upperBegin));
+	clear(jobs);
+	clear(upperMatches);
+
+	sort(begin(matches, Standard()), end(matches, Standard()), LessSubstringEnd<TSubstringEntry>());
+	compactMatches(matches);
+	sort(begin(matches, Standard()), end(matches, Standard()), LessRange<TSubstringEntry>());
+	compactSameParentFreqMatches(matches);
+	sort(begin(matches, Standard()), end(matches, Standard()), LessSubstringEnd<TSubstringEntry>());
+	compactSameSuffLinkFreqMatches(matches, index, dbLookup, seen, entry);
+	sort(begin(matches, Standard()), end(matches, Standard()), LessLex<TSubstringEntry>());
+	
+	typedef typename Iterator<String<TSubstringEntry>, Standard>::Type TMatchIter;
+	TMatchIter mit = begin(matches, Standard());
+	TMatchIter mitEnd = end(matches, Standard());
+	
+	for (; mit != mitEnd; ++mit)
+	{
 #ifdef DEBUG_ENTROPY
-			// count frequencies (debug)
-	        typedef typename Fibre<TIndex, FibreSA>::Type TSA;
-	        typedef typename Iterator<TSA, Standard>::Type TSAIter;
-			TSAIter oc = begin(indexSA(index), Standard()) + (*mit).range.i1;
-			TSAIter ocEnd = begin(indexSA(index), Standard()) + (*mit).range.i2;
-			arrayFill(begin(seen, Standard()), end(seen, Standard()), false);
-			arrayFill(begin(entry.freq, Standard()), end(entry.freq, Standard()), 0);
-			unsigned freqSum = 0;
-			for (; oc != ocEnd; ++oc)
+		// count frequencies (debug)
+        typedef typename Fibre<TIndex, FibreSA>::Type TSA;
+        typedef typename Iterator<TSA, Standard>::Type TSAIter;
+		TSAIter oc = begin(indexSA(index), Standard()) + (*mit).range.i1;
+		TSAIter ocEnd = begin(indexSA(index), Standard()) + (*mit).range.i2;
+		arrayFill(begin(seen, Standard()), end(seen, Standard()), false);
+		arrayFill(begin(entry.freq, Standard()), end(entry.freq, Standard()), 0);
+		unsigned freqSum = 0;
+		for (; oc != ocEnd; ++oc)
+		{
+			unsigned seqNo = getSeqNo(*oc, stringSetLimits(index));
+			if (!seen[seqNo])
 			{
-				unsigned seqNo = getSeqNo(*oc, stringSetLimits(index));
-				if (!seen[seqNo])
-				{
-					seen[seqNo] = true;
-					++entry.freq[dbLookup[seqNo]];
-					++freqSum;
-				}
+				seen[seqNo] = true;
+				++entry.freq[dbLookup[seqNo]];
+				++freqSum;
 			}
-				
-			double H = entrp.getEntropy(entry);
-			if (H <= 0.0) H = 0.0;
+		}
+			
+		double H = entrp.getEntropy(entry);
+		if (H <= 0.0) H = 0.0;
 //			if (freqSum != freqSumLast)
 #endif
-			{
-#ifdef DEBUG_ENTROPY
-				out << left << setw(14) << H << "[";
-				for (unsigned i = 0; i < length(entry.freq); ++i)
-					out << right << setw(6) << entry.freq[i];
-				out << "]      \"";
-#endif
-				out << infix(
-					mySet[getSeqNo((*mit).lPos)], 
-					getSeqOffset((*mit).lPos),
-					getSeqOffset((*mit).lPos) + (*mit).len);
-#ifdef DEBUG_ENTROPY
-				out << "\"";
-				freqSumLast = freqSum;
-#endif
-				out << endl;
-			}
-		}
-	} 
-	else
-	{
-		for (; !atEnd(it); goNext(it))
 		{
-			posLocalize(lPos, getOccurrence(it), stringSetLimits(container(it)));
-			unsigned len = repLength(it);
-			for(unsigned l = parentRepLength(it) + 1; l <= len; ++l)
-			{
 #ifdef DEBUG_ENTROPY
-				// count frequencies (debug)
-				typedef typename Infix< typename Fibre<TIndex, FibreSA>::Type const >::Type TOccs;
-				typedef typename Iterator<TOccs, Standard>::Type TOccIter;
-	            TOccs occs = getOccurrences(it);
-	            TOccIter oc = begin(occs, Standard()), ocEnd = end(occs, Standard());
-				arrayFill(begin(seen, Standard()), end(seen, Standard()), false);
-				arrayFill(begin(entry.freq, Standard()), end(entry.freq, Standard()), 0);
-				for (; oc != ocEnd; ++oc)
-				{
-					unsigned seqNo = getSeqNo(*oc, stringSetLimits(index));
-					if (!seen[seqNo])
-					{
-						seen[seqNo] = true;
-						++entry.freq[dbLookup[seqNo]];
-					}
-				}
-					
-				double H = entrp.getEntropy(entry);
-				if (H <= 0.0) H = 0.0;
-				out << left << setw(14) << H << "[";
-				for (unsigned i = 0; i < length(entry.freq); ++i)
-					out << right << setw(6) << entry.freq[i];
-				out << "]      \"";
+			out << left << setw(14) << H << "[";
+			for (unsigned i = 0; i < length(entry.freq); ++i)
+				out << right << setw(6) << entry.freq[i];
+			out << "]      \"";
 #endif
-				out << infix(
-	                mySet[getSeqNo(lPos)],
-	                getSeqOffset(lPos),
-	                getSeqOffset(lPos) + l);
+			out << infix(
+				mySet[getSeqNo((*mit).lPos)], 
+				getSeqOffset((*mit).lPos),
+				getSeqOffset((*mit).lPos) + (*mit).len);
 #ifdef DEBUG_ENTROPY
 			out << "\"";
+			freqSumLast = freqSum;
 #endif
 			out << endl;
-			}
 		}
 	}
-	
+
 	return 0;
 }
 
@@ -718,6 +884,13 @@ void setUpArgumentParser(ArgumentParser & parser, DFIOptions const &)
     setDefaultValue(parser, "alphabet", "char");
 	addOption(parser, ArgParseOption("m", "maximal", "Output only left and right maximal substrings."));
 
+#ifdef _OPENMP
+    addSection(parser, "Performance Options");
+    addOption(parser, ArgParseOption("t", "num-threads", "Number of threads to use.", ArgParseOption::INTEGER));
+    setMinValue(parser, "num-threads", "1");
+    setDefaultValue(parser, "num-threads", "1");
+#endif
+
 
 /*
 	//////////////////////////////////////////////////////////////////////////////
@@ -758,6 +931,9 @@ extractOptions(
     if (alphabetString == "protein") options.alphabet = 1;
     if (alphabetString == "dna") options.alphabet = 2;
 	getOptionValue(options.maximal, parser, "maximal");
+#ifdef _OPENMP
+    getOptionValue(options.numThreads, parser, "num-threads");
+#endif
 
     unsigned numDatabases = getArgumentValueCount(parser, 0);
 
@@ -832,6 +1008,10 @@ int main(int argc, const char *argv[])
         cerr << "Exiting ..." << endl;
         return 1;
     }
+
+#ifdef _OPENMP
+    omp_set_num_threads(options.numThreads);
+#endif
 	
 	switch (options.predicate)
 	{
@@ -79,6 +79,16 @@ def main(source_base, binary_base):
                       ph.outFile(params[0]))])
         conf_list.append(conf)
 
+        # Run the parallel traversal, the output must not change.
+        conf = app_tests.TestConf(
+            program=path_to_program,
+            redir_stdout=ph.outFile(params[0] + '.tc2'),
+            args=[ph.outFile(params[1], 'datasets'),
+                  ph.outFile(params[2], 'datasets')] + params[3:] + ['--num-threads', '2'],
+            to_diff=[(ph.outFile(params[0], 'expected'),
+                      ph.outFile(params[0] + '.tc2'))])
+        conf_list.append(conf)
+
     # Execute the tests.
     failures = 0
     for conf in conf_list:
@@ -127,10 +127,9 @@ const char * PROGRAM_VERSION = "0.2";
 #include <../../include/seqan/index/index_sa_stree.h>
 #include <../../include/seqan/basic/basic_view.h>
 #include <../../include/seqan/sequence/iterator_range.h>
+#include <../../include/seqan/index/index_qgram_parallel.h>
 #endif
 
-#include "index_qgram_parallel.h"
-
 //Boost Math headers
 #include <boost/math/distributions.hpp>
 #include <boost/math/special_functions/binomial.hpp>
@@ -483,6 +482,20 @@ struct CorrectionIndelPos
                                         //  x..deletion
 };
 
+// a correction found during the suffix tree traversal that is not yet entered into the linked list,
+// each work package collects its own candidates which are committed after the traversal
+struct CorrectionCandidate
+{
+    unsigned int    erroneousReadId;
+    unsigned int    correctReadId;
+    unsigned int    correctPos;
+    unsigned int    errorPos;
+    unsigned int    overlap;
+    bool            strand;
+    signed char     indelLength;
+    Dna5            correctSeq[MAX_INDEL_LENGTH];
+};
+
 namespace seqan
 {
 
@@ -1151,77 +1164,6 @@ inline bool existsCorrectionAtPos(TValueShort previousErrorPos,
 }
 
 
-// this lock augments a string class by thread-safety as follows:
-//  - supports multiple concurrent readers (possibly waiting for writer to finish)
-//  - supports only a single writer at a time (possibly waiting for readers or other writers to finish)
-//  - the writer has higher priority than all readers
-struct StringLock
-{
-    volatile unsigned readers;
-    volatile unsigned writers;
-
-    StringLock():
-        readers(0),
-        writers(0)
-    {
-    }
-};
-
-static StringLock correctionListLock;
-
-
-inline void
-lockReading(StringLock &lock)
-{
-    do
-    {
-        // wait for the end of a write access
-        while (lock.writers != 0)
-        {}
-
-//        SEQAN_OMP_PRAGMA(atomic)
-//        ++lock.readers;
-        atomicInc(lock.readers);
-
-        if (lock.writers == 0)
-            break;
-
-        // writer hasn't noticed us -> retry
-//        SEQAN_OMP_PRAGMA(atomic)
-//        --lock.readers;
-        atomicDec(lock.readers);
-    } while (true);
-}
-
-inline void
-unlockReading(StringLock &lock)
-{
-//    SEQAN_OMP_PRAGMA(atomic)
-//    --lock.readers;
-    atomicDec(lock.readers);
-}
-
-inline void
-lockWriting(StringLock &lock)
-{
-    // wait until we are the only writer
-    while (atomicCas(lock.writers, 0u, 1u) != 0)
-    {}
-
-    // wait until all readers are done
-    while (lock.readers != 0)
-    {}
-}
-
-inline void
-unlockWriting(StringLock &lock)
-{
-    lock.writers = 0;
-}
-
-
-
-
 /*
 new function that returns the number of corrections already entered for a read position
 	
@@ -1230,7 +1172,7 @@ template <typename TCorrection,typename TValue, typename TId1, typename TPos,typ
 inline unsigned
 getFoundCorrections(
     String<TCorrection> const &correctionList,
-    String<TValue> &firstCorrectionForRead,
+    String<TValue> const &firstCorrectionForRead,
     TId1 erroneousReadId,
     TPos errorPos,
     TReadStore & store)
@@ -1348,13 +1290,7 @@ inline void addCorrectionEntry(String<TCorrection> &correctionList,
         length(store.readSeqStore[erroneousReadId]),
         correctReadId);
 
-    if (length(correctionList) == capacity(correctionList))
-    {
-        lockWriting(correctionListLock);
-        reserve(correctionList, capacity(correctionList) + 1, Generous());
-        unlockWriting(correctionListLock);
-    }
-    appendValue(correctionList, newCorrection);
+    appendValue(correctionList, newCorrection, Generous());
 
     if (insertLinkAt == maxValue<TValue>())
         firstCorrectionForRead[erroneousReadId] = length(correctionList) - 1;
@@ -1421,6 +1357,63 @@ inline void addCorrectionEntry(String<TCorrection> &correctionList,
     return;
 }
 
+/*
+record a correction in a package-local candidate list instead of the shared linked list,
+this allows the traversal of different packages to run without any synchronization
+*/
+template <typename TId1, typename TId2, typename TPos1, typename TPos2, typename TOverlap, typename TAlphabet>
+inline void queueCorrectionEntry(String<CorrectionCandidate> &candidates,
+                                 TId1 erroneousReadId,
+                                 TId2 correctReadId,
+                                 TPos1 correctPos,
+                                 TPos2 errorPos,
+                                 TOverlap overlap,
+                                 bool strand,
+                                 signed char indelLength,
+                                 TAlphabet & correctSeq)
+{
+    CorrectionCandidate candidate;
+    candidate.erroneousReadId = erroneousReadId;
+    candidate.correctReadId = correctReadId;
+    candidate.correctPos = correctPos;
+    candidate.errorPos = errorPos;
+    candidate.overlap = overlap;
+    candidate.strand = strand;
+    candidate.indelLength = indelLength;
+    for (unsigned i = 0; i < MAX_INDEL_LENGTH; ++i)
+        candidate.correctSeq[i] = correctSeq[i];
+    appendValue(candidates, candidate, Generous());
+}
+
+/*
+enter all candidates of a package into the linked list (in the order they were found),
+returns the number of committed candidates
+*/
+template <typename TCorrection, typename TValue, typename TReadStore>
+inline unsigned commitCorrectionEntries(String<TCorrection> &correctionList,
+                                        String<TValue> &firstCorrectionForRead,
+                                        String<CorrectionCandidate> const &candidates,
+                                        TReadStore & store)
+{
+    for (unsigned i = 0; i < length(candidates); ++i)
+    {
+        CorrectionCandidate const &candidate = candidates[i];
+        addCorrectionEntry(
+            correctionList,
+            firstCorrectionForRead,
+            candidate.erroneousReadId,
+            candidate.correctReadId,
+            candidate.correctPos,
+            candidate.errorPos,
+            candidate.overlap,
+            candidate.strand,
+            candidate.indelLength,
+            store,
+            candidate.correctSeq);
+    }
+    return length(candidates);
+}
+
    template <typename TCorrection,typename TValue,typename TReadStore>
         inline void  _testCorrectionStruct(String<TCorrection> &correctionList, String<TValue> &firstCorrectionForRead,TReadStore &store)
 	{
@@ -3419,8 +3412,9 @@ template <
 void traverseAndSearchCorrections(
 	TTreeIterator iter,
 	TFragmentStore &store,
-	String<TCorrections> & correctionList,
-	String<TValueId> &firstCorrectionForRead,
+	String<TCorrections> const & correctionList,
+	String<TValueId> const & firstCorrectionForRead,
+	String<CorrectionCandidate> & candidates,
 	FionaOptions & options,
 	Tag<TAlgorithm> const,
 	unsigned readLength,
@@ -3612,9 +3606,9 @@ if (LOOP_LEVEL != 0)
                 unsigned positionError = (*errorRead).i2 + commonPrefix;
 
 #ifdef FIONA_MAX_CORRECTIONS_PER_BASE
-                lockReading(correctionListLock);
+                // the linked list is read-only during the traversal, i.e. we only see corrections
+                // committed by previous traversals (super packages)
                 unsigned foundCorr = getFoundCorrections(correctionList, firstCorrectionForRead, errorReadId, positionError, store);
-                unlockReading(correctionListLock);
                 if (foundCorr >= FIONA_MAX_CORRECTIONS_PER_BASE)
                     continue;
 #endif
@@ -3954,7 +3948,7 @@ if (LOOP_LEVEL != 0)
                         if (overlapSum == 0)
                             continue;
 
-                        //create variables to use addCorrectionEntry this is critical for OMP
+                        //create variables to use queueCorrectionEntry
                         signed char indel = ((i & 1) == 0)? i / 2: -((i + 1) / 2);
 
 #ifdef FIONA_CONSENSUS
@@ -3997,22 +3991,17 @@ if (LOOP_LEVEL != 0)
                                     } */
 
                         // 1. add major mismatch/indel correction
-                        SEQAN_OMP_PRAGMA(critical(addCorrection))
-                        {
-                            ++resources.putCorrections;
-                            addCorrectionEntry(
-                                correctionList,
-                                firstCorrectionForRead,
-                                errorReadId,
-                                bestCorrection[i].readId,
-                                bestCorrection[i].correctPos,
-                                positionError,
-                                overlapSum,
-                                strand,
-                                indel,
-                                store,
-                                correctSeq);
-                        }
+                        ++resources.putCorrections;
+                        queueCorrectionEntry(
+                            candidates,
+                            errorReadId,
+                            bestCorrection[i].readId,
+                            bestCorrection[i].correctPos,
+                            positionError,
+                            overlapSum,
+                            strand,
+                            indel,
+                            correctSeq);
 
                         if (indel == 0)
                         {
@@ -4044,11 +4033,8 @@ if (LOOP_LEVEL != 0)
                                     correctSeq[0] = (Dna5)maxBase;
                                     if (strand)
                                         correctSeq[0] = FunctorComplement<Dna5>()(correctSeq[0]);
-                                    SEQAN_OMP_PRAGMA(critical(addCorrection))
-                                    {
-                                        ++resources.putCorrections;
-                                        addCorrectionEntry(correctionList,firstCorrectionForRead,errorReadId,bestCorrection[i].readId,bestCorrection[i].correctPos,itE-itEBegin,consOverlapSum,strand,indel,store,correctSeq);
-                                    }
+                                    ++resources.putCorrections;
+                                    queueCorrectionEntry(candidates,errorReadId,bestCorrection[i].readId,bestCorrection[i].correctPos,itE-itEBegin,consOverlapSum,strand,indel,correctSeq);
 
                                     //std::cout << "replace " << *itE << " at position " << (itE - itEBegin) << " in read " << errorReadId;
                                     //std::cout << " by " << (Dna5)maxBase << " (support=" << (*itCons).count[maxBase] << ")" << std::endl;
@@ -4092,15 +4078,12 @@ if (LOOP_LEVEL != 0)
 #else // FIONA_CONSENSUS
                         if (indel <= 0) //only get string if insertion in read or mismatch
                             getCorrectionString(correctSeq,indel,bestCorrection[i].readId,bestCorrection[i].correctPos,strand,store);
-                        SEQAN_OMP_PRAGMA(critical(addCorrection))
-                        {
              /*std::ofstream myfile;
 myfile.open ("EntryOutput.txt",std::ios::app);
 myfile << "beforeEntry " << " "<< errorReadId<< " "<<bestCorrection[i].readId<< " "<<bestCorrection[i].correctPos<< " "<<positionError<< " "<<(int)indel << " " << overlapSum << " " <<representative(iter) <<"endEntry" << std::endl;
 myfile.close();*/
-                            ++resources.putCorrections;
-                            addCorrectionEntry(correctionList,firstCorrectionForRead,errorReadId,bestCorrection[i].readId,bestCorrection[i].correctPos,positionError,overlapSum,strand,indel,store,correctSeq);
-                        }
+                        ++resources.putCorrections;
+                        queueCorrectionEntry(candidates,errorReadId,bestCorrection[i].readId,bestCorrection[i].correctPos,positionError,overlapSum,strand,indel,correctSeq);
 #endif // FIONA_CONSENSUS
                     }
 
@@ -4619,7 +4602,9 @@ unsigned correctReads(
 
 	/*the core of the correction method*/
     FionaResources resources;
-    traverseAndSearchCorrections<-1>(myConstrainedIterator, store, correctionList, firstCorrectionForRead, options, alg,maxReadLength, resources);
+    String<CorrectionCandidate> candidates;
+    traverseAndSearchCorrections<-1>(myConstrainedIterator, store, correctionList, firstCorrectionForRead, candidates, options, alg,maxReadLength, resources);
+    commitCorrectionEntries(correctionList, firstCorrectionForRead, candidates, store);
 
     if (options.verbosity >= 2)
         std::cerr << "Time for searching between given levels: "<< SEQAN_PROTIMEDIFF(search) << " seconds." << std::endl
@@ -4708,7 +4693,7 @@ unsigned correctReads(
         for (TQGramDirSize i = endBucket; i < dirLen - 1; ++i)
             dir[i] = (TQGramDirValue)-1;
 
-        resize(indexSA(qgramIndex), _qgramCummulativeSum(indexDir(qgramIndex), True(), True(), Unsigned<1>(), Parallel()), Exact());
+        resize(indexSA(qgramIndex), _qgramCummulativeSum(indexDir(qgramIndex), True(), True(), ConstUInt<1>(), Parallel()), Exact());
         _qgramFillSuffixArray(indexSA(qgramIndex), indexText(qgramIndex), indexShape(qgramIndex), indexDir(qgramIndex), qgramIndex.bucketMap, getStepSize(qgramIndex), True(), Parallel());
         _qgramPostprocessBuckets(indexDir(qgramIndex), Parallel());
         
@@ -4812,6 +4797,9 @@ unsigned correctReads(
 
     String<FionaResources> resourcesPerPackage;
     resize(resourcesPerPackage, length(packages) - 1, Exact());
+    // corrections found in a package are collected without locking and committed after the traversal
+    String<String<CorrectionCandidate> > candidatesPerPackage;
+    resize(candidatesPerPackage, length(packages) - 1, Exact());
 
 #if defined(FIONA_REDUCE_MEMORY) && !defined(FIONA_INTERNAL_MEMORY)
     flush(indexSA(qgramIndex));
@@ -4892,7 +4880,7 @@ unsigned correctReads(
         FionaResources &resources = resourcesPerPackage[i - 1];
         resources.bucketBegin = bktBegin;
         resources.bucketEnd = bktEnd;
-        traverseAndSearchCorrections<-1>(myConstrainedIterator, store, correctionList, firstCorrectionForRead, options, alg, maxReadLength, resources);
+        traverseAndSearchCorrections<-1>(myConstrainedIterator, store, correctionList, firstCorrectionForRead, candidatesPerPackage[i - 1], options, alg, maxReadLength, resources);
 /*    if (options.loopLevel == 0)
                 traverseAndSearchCorrections<0>(myConstrainedIterator, store, correctionList, firstCorrectionForRead, options, alg, maxReadLength, resources);
     if (options.loopLevel == 1)
@@ -4941,6 +4929,11 @@ unsigned correctReads(
 	if (inTerm && options.verbosity >= 1)
         std::cerr << "done. (" << SEQAN_PROTIMEDIFF(search) << " seconds)" << std::endl;
 
+    // enter the corrections into the linked list in package order (independent of the thread schedule)
+    for (unsigned i = 0; i < length(candidatesPerPackage); ++i)
+        commitCorrectionEntries(correctionList, firstCorrectionForRead, candidatesPerPackage[i], store);
+    clear(candidatesPerPackage);
+
     std::sort(begin(resourcesPerPackage, Standard()), end(resourcesPerPackage, Standard()));
 	if (inTerm && options.verbosity >= 2)
     {
@@ -5516,6 +5509,7 @@ int main(int argc, const char* argv[])
 	String<double> roundsDone;
 	double lastAdjRSquare = 0;
 	unsigned nfamprev = 0;
+	unsigned unchangedCycles = 0;
     if (options.verbosity >= 1)
     {
         std::cerr << "number iters: " << options.cycles << std::endl;
@@ -5554,6 +5548,17 @@ int main(int argc, const char* argv[])
                 numCorrected = correctReads(store, options, FionaExpected());
                 break;
         }
+        // without any correction the reads are unchanged and a further cycle would rebuild the same index,
+        // once every depth sample offset has been traversed without success there is nothing left to find
+        unchangedCycles = (numCorrected == 0)? unchangedCycles + 1: 0;
+        if (unchangedCycles >= (unsigned)_max(options.depthSampleRate, 1))
+        {
+            if (options.verbosity >= 1)
+                std::cerr << std::endl << "Stopped at cycle " << options.cycle << " as no read was corrected." << std::endl;
+            ++options.cycle;
+            break;
+        }
+
 		//Todo (Hugues) adjust error rate estimate between rounds
 		//
         if (options.verbosity >= 1)
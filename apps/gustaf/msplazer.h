@@ -90,6 +90,8 @@ struct MSplazerOptions
     bool pairedEndMode;             // Whether or not to run Gustaf in paired-end mode
     bool revCompl;                  // Whether or not to rev-compl the second input file
 
+    // Parallelism options
+    unsigned threadCount;           // Number of threads for stellar, graph construction and chaining
 
     MSplazerOptions() :
         databaseFile("reference.fa"),
@@ -113,7 +115,8 @@ struct MSplazerOptions
         libSize(0),
         libError(0),
         pairedEndMode(false),
-        revCompl(true){}
+        revCompl(true),
+        threadCount(1){}
 };
 
 // ----------------------------------------------------------------------------
@@ -35,6 +35,7 @@
 #ifndef SEQAN_APPS_GUSTAF_MSPLAZER_ALGORITHMS_H_
 #define SEQAN_APPS_GUSTAF_MSPLAZER_ALGORITHMS_H_
 
+#include <seqan/parallel.h>
 #include "msplazer.h"
 // #include <seqan/PathEnumeration.h>
 // #include "../../../andreotti/include/seqan/PathEnumeration.h"
@@ -812,6 +813,7 @@ void _chainMatchesReference(QueryMatches<StellarMatch<TSequence, TId> > & queryM
 }
 
 // Chain all matches of each query
+// Note: the read graphs are independent of each other and constructed in parallel
 template <typename TSequence, typename TId, typename TScoreAlloc, typename TMSplazerChain>
 void _chainQueryMatches(StringSet<QueryMatches<StellarMatch<TSequence, TId> > > & stellarMatches,
                         String<TScoreAlloc> & distanceScores,
@@ -821,11 +823,16 @@ void _chainQueryMatches(StringSet<QueryMatches<StellarMatch<TSequence, TId> > >
                         String<unsigned> & readJoinPositions,
                         MSplazerOptions const & msplazerOptions)
 {
+    // The chains of all queries are constructed in parallel...
+    TScoreAlloc noScores;
+    String<TMSplazerChain> chains;
+    resize(chains, length(stellarMatches), TMSplazerChain(noScores), Exact());
 
-    for (unsigned i = 0; i < length(stellarMatches); ++i)
+    SEQAN_OMP_PRAGMA(parallel for num_threads(msplazerOptions.threadCount) schedule(dynamic, 1))
+    for (int i = 0; i < (int)length(stellarMatches); ++i)
     {
-        TScoreAlloc matchDistanceScores = distanceScores[i];
-        TMSplazerChain chain(matchDistanceScores);
+        TMSplazerChain & chain = chains[i];
+        chain.matchDistanceScores = distanceScores[i];
         if (msplazerOptions.pairedEndMode)
             chain.mateJoinPosition = readJoinPositions[i];
         // TMSplazerChain chain(matchDistanceScores, readJoinPositions[i]);
@@ -865,19 +872,24 @@ void _chainQueryMatches(StringSet<QueryMatches<StellarMatch<TSequence, TId> > >
 
         }
         // Reevaluate chains with translocations/duplications
-        appendValue(queryChains, chain);
     }
+
+    // ...and appended sequentially. Copying a graph reverses its adjacency lists, which decides ties between
+    // shortest paths, so the chains are copied exactly as often as before.
+    for (unsigned i = 0; i < length(chains); ++i)
+        appendValue(queryChains, chains[i]);
 }
 
 // Analyze chains in read graph by calling DAG shortest path algorithm
 template <typename TMSplazerChain>
-void _analyzeChains(String<TMSplazerChain> & queryChains)
+void _analyzeChains(String<TMSplazerChain> & queryChains, MSplazerOptions const & msplazerOptions)
 {
     InternalPropertyMap<int> weightMap;
     // typedef typename TMSplazerChain::TGraph TGraph;
     // typedef typename Size<TGraph>::Type TGraphSize;
 
-    for (unsigned i = 0; i < length(queryChains); ++i)
+    SEQAN_OMP_PRAGMA(parallel for num_threads(msplazerOptions.threadCount) schedule(dynamic, 1))
+    for (int i = 0; i < (int)length(queryChains); ++i)
     {
         if (!queryChains[i].isEmpty)
         {
@@ -1630,14 +1642,27 @@ void _findAllBestChains(String<TMSplazerChain> & queryChains,
     String<TBreakpoint> globalBreakends;
     unsigned brokenChainCount = 0;
     unsigned similarBPId = 0;
-    for (unsigned i = 0; i < length(queryChains); ++i)
+
+    // Best chains and their breakpoints are extracted in parallel for all reads...
+    String<String<TBreakpoint> > readBreakpoints;
+    String<bool> foundChain;
+    resize(readBreakpoints, length(queryChains));
+    resize(foundChain, length(queryChains), false);
+
+    SEQAN_OMP_PRAGMA(parallel for num_threads(msplazerOptions.threadCount) schedule(dynamic, 1) reduction(+:brokenChainCount))
+    for (int i = 0; i < (int)length(queryChains); ++i)
     {
-        String<TBreakpoint> tmpGlobalBreakpoints;
         // String<TBreakpoint> tmpStellarIndels;
-        if (_findBestChain(queryChains[i], queryMatches[i].matches, tmpGlobalBreakpoints, // msplazerOptions,
-                           brokenChainCount))
+        foundChain[i] = _findBestChain(queryChains[i], queryMatches[i].matches, readBreakpoints[i], // msplazerOptions,
+                                       brokenChainCount);
+    }
+
+    // ...and merged in the order of the reads, s.t. breakpoint support and ids do not depend on the thread count
+    for (unsigned i = 0; i < length(queryChains); ++i)
+    {
+        if (foundChain[i])
         {
-            _insertBreakpoints(globalBreakpoints, globalBreakends, tmpGlobalBreakpoints, msplazerOptions, similarBPId);
+            _insertBreakpoints(globalBreakpoints, globalBreakends, readBreakpoints[i], msplazerOptions, similarBPId);
             // get small indels from matches
             // _getChainIndels(queryChains[i].bestChains, globalStellarIndels, queryIds[i], queries[i]);
             /*
@@ -228,7 +228,7 @@ int msplazer(StellarOptions & stellarOptions, MSplazerOptions & msplazerOptions)
     // Analyze chains
 
     std::cout << "Analyzing graphs... ";
-    _analyzeChains(queryChains);
+    _analyzeChains(queryChains, msplazerOptions);
     std::cout << "done" << std::endl;
 
     // ///////////////////////////////////////////////////////////////////////
@@ -114,6 +114,11 @@ _parseOptions(ArgumentParser & parser, StellarOptions & options, MSplazerOptions
 
     getOptionValue(options.verbose, parser, "verbose");
 
+#ifdef _OPENMP
+    getOptionValue(msplazerOptions.threadCount, parser, "thread-count");
+#endif  // #ifdef _OPENMP
+    options.threadCount = msplazerOptions.threadCount;
+
     if (isSet(parser, "kmer") && options.qGram >= 1 / options.epsilon)
     {
         std::cerr << "Invalid parameter value: Please choose q-gram length lower than 1/epsilon." << std::endl;
@@ -287,6 +292,18 @@ void _setupArgumentParser(ArgumentParser & parser)
                                      "space.", ArgParseArgument::INTEGER));
     setDefaultValue(parser, "s", "500");
 
+#ifdef _OPENMP
+    addSection(parser, "Parallelism Options");
+#endif  // #ifdef _OPENMP
+    addOption(parser, ArgParseOption("tc", "thread-count",
+                                     "Number of threads. If larger than 1, the reads are split into batches that are "
+                                     "searched, chained and analyzed in parallel.", ArgParseArgument::INTEGER));
+    setMinValue(parser, "thread-count", "1");
+    setDefaultValue(parser, "thread-count", "1");
+#ifndef _OPENMP
+    hideOption(parser, "tc");
+#endif  // #ifndef _OPENMP
+
     /*
      * Stellar output options are not supported bc. no Stellar output is supported
     addSection(parser, "Output Options");
@@ -37,6 +37,7 @@
 
 #include <seqan/basic.h>
 #include <seqan/sequence.h>
+#include <seqan/parallel.h>
 
 #include "../stellar/stellar.h"
 #include "create_stellarmatches_from_file.h"
@@ -146,6 +147,8 @@ void _convertStellarReverseMatches(TSequence & database, TID & databaseID,
 // Compute Stellar matches using stellar function
 // Note: requires to convert matches on reverse strand: StellarMatches of the reverse Strand are being modified,
 //  in the sense that they correspond to the right positions within the forward strand
+// Note: the queries are split into batches that are searched in parallel, each with its own q-gram index and pattern.
+//  The database sequences and their reverse complements are shared by all threads.
 template <typename TSequence, typename TMatches>
 void _getStellarMatches(StringSet<TSequence> & queries, StringSet<TSequence> & databases,
                         StringSet<CharString> & databaseIDs, StellarOptions & stellarOptions, TMatches & stellarMatches)
@@ -155,76 +158,92 @@ void _getStellarMatches(StringSet<TSequence> & queries, StringSet<TSequence> & d
     // typedef Finder<TSequence, Swift<SwiftLocal> > TFinder;
 
     // Using Stellars structure for queries
-    typedef Index<StringSet<TSequence, Dependent<> >, IndexQGram<SimpleShape, OpenAddressing> > TQGramIndex;
+    typedef StringSet<TSequence, Dependent<> > TQueryBatch;
+    typedef Index<TQueryBatch, IndexQGram<SimpleShape, OpenAddressing> > TQGramIndex;
     // typedef Index<StringSet<TSequence, Dependent<> >, IndexQGram<SimpleShape> > TQGramIndex;
-    TQGramIndex qgramIndex(queries);
-    resize(indexShape(qgramIndex), stellarOptions.qGram);
-
-    // pattern
-    /*
-    //Using FragmenStore
-    typedef Index<StringSet<TSequence, Owner<ConcatDirect<> > >, IndexQGram<SimpleShape, OpenAddressing> > TQGramIndexFrSt;
-    TQGramIndexFrSt qgramIndexFrSt(fragments.readSeqStore);
-    stellarOptions.qGram = 4;
-    resize(indexShape(qgramIndexFrSt), stellarOptions.qGram);
-    typedef Pattern<TQGramIndexFrSt, Swift<SwiftLocal> > TPatternFrSt;
-    TPatternFrSt swiftPatternFrSt(qgramIndexFrSt);
-    std::cout << "FrStPattern: " << value(host(needle(swiftPatternFrSt)),0) << std::endl;
-    // Construct index
-    std::cout << "Constructing index..." << std::endl;
-    indexRequire(qgramIndexFrSt, QGramSADir());
-    std::cout << std::endl;
-    */
-
-    // Using Stellars structure for queries
     typedef Pattern<TQGramIndex, Swift<SwiftLocal> > TPattern;
-    TPattern swiftPattern(qgramIndex);
 
-    // Construct index
-    std::cout << "Constructing index..." << std::endl;
-    indexRequire(qgramIndex, QGramSADir());
-    std::cout << std::endl;
+    // Reverse complements are computed once and shared, the forward databases stay untouched
+    StringSet<TSequence> complementDatabases;
+    if (stellarOptions.reverse)
+    {
+        complementDatabases = databases;
+        for (unsigned i = 0; i < length(complementDatabases); ++i)
+            reverseComplement(complementDatabases[i]);
+    }
 
+    // A single batch for one thread, otherwise several batches per thread for load balancing
+    unsigned batchCount = (stellarOptions.threadCount > 1) ? 4 * stellarOptions.threadCount : 1;
+    unsigned batchSize = (length(queries) + batchCount - 1) / batchCount;
+    if (batchSize == 0)
+        batchSize = 1;
+    batchCount = (length(queries) + batchSize - 1) / batchSize;
 
-    // Call Stellar for each database sequence
+    // Call Stellar for each batch of queries and each database sequence
     double start = sysTime();
-    for (unsigned i = 0; i < length(databases); ++i)
+    SEQAN_OMP_PRAGMA(parallel for num_threads(stellarOptions.threadCount) schedule(dynamic, 1))
+    for (int b = 0; b < (int)batchCount; ++b)
     {
-        // Using long stellar() to calculate stellarMatches on + strand
-        if (stellarOptions.forward)
-        {
-            TFinder swiftFinder(databases[i], stellarOptions.minRepeatLength, stellarOptions.maxRepeatPeriod);
-            stellar(swiftFinder, swiftPattern, stellarOptions.epsilon, stellarOptions.minLength, stellarOptions.xDrop,
-                    stellarOptions.disableThresh, stellarOptions.compactThresh, stellarOptions.numMatches,
-                    stellarOptions.verbose, databaseIDs[i], true, stellarMatches, AllLocal());
-        }
+        unsigned batchBegin = b * batchSize;
+        unsigned batchEnd = _min(batchBegin + batchSize, (unsigned)length(queries));
 
-        // Store reverse matches in temporary container and transform before appending to stellarMatches
-        TMatches stRevMatches;
-        resize(stRevMatches, length(queries));
+        TQueryBatch batchQueries;
+        for (unsigned k = batchBegin; k < batchEnd; ++k)
+            appendValue(batchQueries, queries[k]);
 
-        // - strand
-        if (stellarOptions.reverse)
+        TQGramIndex qgramIndex(batchQueries);
+        resize(indexShape(qgramIndex), stellarOptions.qGram);
+        TPattern swiftPattern(qgramIndex);
+
+        // Construct index
+        indexRequire(qgramIndex, QGramSADir());
+
+        // Each batch raises its own compaction threshold
+        unsigned compactThresh = stellarOptions.compactThresh;
+
+        TMatches batchMatches;
+        resize(batchMatches, batchEnd - batchBegin);
+
+        for (unsigned i = 0; i < length(databases); ++i)
         {
-            reverseComplement(databases[i]);
-            TFinder revSwiftFinder(databases[i], stellarOptions.minRepeatLength, stellarOptions.maxRepeatPeriod);
-            stellar(revSwiftFinder,
-                    swiftPattern,
-                    stellarOptions.epsilon,
-                    stellarOptions.minLength,
-                    stellarOptions.xDrop,
-                    stellarOptions.disableThresh,
-                    stellarOptions.compactThresh,
-                    stellarOptions.numMatches,
-                    stellarOptions.verbose,
-                    databaseIDs[i],
-                    false,
-                    stRevMatches, // stellarMatches, // Replace with stRevMatches
-                    AllLocal());
-            // Convert stRevMatches and append to stellarMatches
-            _convertStellarReverseMatches(databases[i], databaseIDs[i], stellarMatches, stRevMatches);
-            reverseComplement(databases[i]);
+            // Using long stellar() to calculate stellarMatches on + strand
+            if (stellarOptions.forward)
+            {
+                TFinder swiftFinder(databases[i], stellarOptions.minRepeatLength, stellarOptions.maxRepeatPeriod);
+                stellar(swiftFinder, swiftPattern, stellarOptions.epsilon, stellarOptions.minLength, stellarOptions.xDrop,
+                        stellarOptions.disableThresh, compactThresh, stellarOptions.numMatches,
+                        stellarOptions.verbose, databaseIDs[i], true, batchMatches, AllLocal());
+            }
+
+            // - strand
+            if (stellarOptions.reverse)
+            {
+                // Store reverse matches in temporary container and transform before appending to batchMatches
+                TMatches stRevMatches;
+                resize(stRevMatches, batchEnd - batchBegin);
+
+                TFinder revSwiftFinder(complementDatabases[i], stellarOptions.minRepeatLength,
+                                       stellarOptions.maxRepeatPeriod);
+                stellar(revSwiftFinder,
+                        swiftPattern,
+                        stellarOptions.epsilon,
+                        stellarOptions.minLength,
+                        stellarOptions.xDrop,
+                        stellarOptions.disableThresh,
+                        compactThresh,
+                        stellarOptions.numMatches,
+                        stellarOptions.verbose,
+                        databaseIDs[i],
+                        false,
+                        stRevMatches,
+                        AllLocal());
+                // Convert stRevMatches to the forward strand and append to batchMatches
+                _convertStellarReverseMatches(databases[i], databaseIDs[i], batchMatches, stRevMatches);
+            }
         }
+
+        for (unsigned k = batchBegin; k < batchEnd; ++k)
+            stellarMatches[k] = batchMatches[k - batchBegin];
     }
     std::cout << "TIME stellar " << (sysTime() - start) << "s" << std::endl;
 }
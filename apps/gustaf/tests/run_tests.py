@@ -240,6 +240,29 @@ def main(source_base, binary_base):
     #out="st1_l30"
     #${GUSTAF} adeno.fa adeno_modified_reads.fa -st 1 -l 30 -gff ${out}.gff -vcf ${out}.vcf > ${out}.stdout 2> ${out}.stderr
 
+    # ============================================================
+    # -st 1 -l 30 -tc 4, same output as the serial run
+    # ============================================================
+
+    conf = app_tests.TestConf(
+        program=path_to_program,
+        redir_stdout=ph.outFile('st1_l30_tc4.stdout'),
+        redir_stderr=ph.outFile('st1_l30_tc4.stderr'),
+        args=[ph.inFile('adeno.fa'),
+              ph.inFile('adeno_modified_reads.fa'),
+              '-gff', ph.outFile('st1_l30_tc4.gff'),
+              '-vcf', ph.outFile('st1_l30_tc4.vcf'),
+              '-st', str(1),
+              '-l', str(30),
+              '-tc', str(4),
+              ],
+        to_diff=[(ph.inFile('st1_l30.vcf'),
+                  ph.outFile('st1_l30_tc4.vcf'),
+                  transforms),
+                 (ph.inFile('st1_l30.gff'),
+                  ph.outFile('st1_l30_tc4.gff'))])
+    conf_list.append(conf)
+
     # ============================================================
     # -st 1 -m stellar.gff
     # ============================================================
@@ -350,6 +373,34 @@ def main(source_base, binary_base):
     #${GUSTAF} adeno.fa adeno_modified_reads_mates1.fa adeno_modified_reads_mates2.fa -m stellar_joinedMates_l30.gff -st 1
     #-mst 1 -ll 1000 -le 30 -rc -gff ${out}.gff -vcf ${out}.vcf > ${out}.stdout 2> ${out}.stderr
 
+    # ============================================================
+    # paired-end -tc 4, same output as the serial run
+    # ============================================================
+
+    conf = app_tests.TestConf(
+        program=path_to_program,
+        redir_stdout=ph.outFile('pairedEnd_st1_l30_tc4.stdout'),
+        redir_stderr=ph.outFile('pairedEnd_st1_l30_tc4.stderr'),
+        args=[ph.inFile('adeno.fa'),
+              ph.inFile('adeno_modified_reads_mates1.fa'),
+              ph.inFile('adeno_modified_reads_mates2.fa'),
+              '-m', ph.inFile('stellar_joinedMates_l30.gff'),
+              '-gff', ph.outFile('pairedEnd_st1_l30_tc4.gff'),
+              '-vcf', ph.outFile('pairedEnd_st1_l30_tc4.vcf'),
+              '-st', str(1),
+              '-mst', str(1),
+              '-ll', str(1000),
+              '-le', str(100),
+              '-rc',
+              '-tc', str(4),
+              ],
+        to_diff=[(ph.inFile('pairedEnd_st1_l30.vcf'),
+                  ph.outFile('pairedEnd_st1_l30_tc4.vcf'),
+                  transforms),
+                 (ph.inFile('pairedEnd_st1_l30.gff'),
+                  ph.outFile('pairedEnd_st1_l30_tc4.gff'))])
+    conf_list.append(conf)
+
     # ============================================================
     # Sanity check multiple references
     # -st 1 -l 30
@@ -132,6 +132,7 @@ std::ostream & operator<<(std::ostream & out, StructuralVariantRecord const & re
 
 int VariantMaterializer::_runImpl(
         seqan::Dna5String * resultSeq,
+        TJournaledHaplotype * journaledSeq,
         PositionMap * posMap,
         MethylationLevels * resultLvls,
         std::vector<SmallVarInfo> & varInfos,
@@ -140,13 +141,21 @@ int VariantMaterializer::_runImpl(
         MethylationLevels const * refLvls,
         int haplotypeId)
 {
+    SEQAN_ASSERT((resultSeq != 0) != (journaledSeq != 0));
+
     breakpoints.clear();
-    clear(*resultSeq);
     if (resultLvls)
         resultLvls->clear();
 
+    // Fixing the methylation levels at the variation points requires the sequence, so we build it temporarily for
+    // journaled haplotypes with levels.  Otherwise, only the lengths of the intermediate sequences are tracked.
+    seqan::Dna5String tmpSeq;
+    if (!resultSeq && resultLvls)
+        resultSeq = &tmpSeq;
+
     // Apply small variants.  We get a sequence with the small variants and a journal of the difference to contig.
-    seqan::Dna5String seqSmallVariants;
+    seqan::Dna5String smallVariantsStr;
+    MaterializedSequence seqSmallVariants(resultSeq ? &smallVariantsStr : 0);
     TJournalEntries journal;
     MethylationLevels levelsSmallVariants;  // only used if revLevels != 0
     MethylationLevels * smallLvlsPtr = refLvls ? &levelsSmallVariants : 0;
@@ -159,10 +168,19 @@ int VariantMaterializer::_runImpl(
     posMap->reinit(journal);  // build mapping from small variant to reference positions
 
     // Apply structural variants and build the interval tree of posMap
-    if (_materializeLargeVariants(*resultSeq, resultLvls, varInfos, breakpoints, *posMap, journal, seqSmallVariants,
-                                  smallVarInfos, *variants, smallLvlsPtr, haplotypeId) != 0)
+    MaterializedSequence seqLargeVariants(resultSeq);
+    if (_materializeLargeVariants(seqLargeVariants, resultLvls, varInfos, breakpoints, *posMap, journal,
+                                  seqSmallVariants, smallVarInfos, *variants, smallLvlsPtr, haplotypeId) != 0)
         return 1;
 
+    // Build the journaled haplotype.  The host is not modified through the journal.
+    if (journaledSeq)
+    {
+        setHost(*journaledSeq, const_cast<seqan::Dna5String &>(*ref));
+        _applyVariantsToJournal(*journaledSeq, journal, *variants, haplotypeId);
+        SEQAN_ASSERT_EQ(length(*journaledSeq), length(seqLargeVariants));
+    }
+
     // Sort resulting variant infos.
     std::sort(varInfos.begin(), varInfos.end());
 
@@ -182,7 +200,7 @@ int VariantMaterializer::_runImpl(
 // ----------------------------------------------------------------------------
 
 int VariantMaterializer::_materializeSmallVariants(
-        seqan::Dna5String & seq,
+        MaterializedSequence & seq,
         TJournalEntries & journal,
         MethylationLevels * levelsSmallVariants,
         std::vector<SmallVarInfo> & smallVarInfos,
@@ -355,7 +373,7 @@ int VariantMaterializer::_materializeSmallVariants(
         SEQAN_ASSERT_EQ(length(seq), length(levelsSmallVariants->forward));
         SEQAN_ASSERT_EQ(length(seq), length(levelsSmallVariants->reverse));
 
-        fixVariationLevels(*levelsSmallVariants, *rng, seq, varPoints, *methSimOptions);
+        fixVariationLevels(*levelsSmallVariants, *rng, *seq.str, varPoints, *methSimOptions);
     }
 
     return 0;
@@ -366,13 +384,13 @@ int VariantMaterializer::_materializeSmallVariants(
 // ----------------------------------------------------------------------------
 
 int VariantMaterializer::_materializeLargeVariants(
-        seqan::Dna5String & seq,
+        MaterializedSequence & seq,
         MethylationLevels * levelsLargeVariants,
         std::vector<SmallVarInfo> & varInfos,
         std::vector<std::pair<int, int> > & breakpoints,
         PositionMap & positionMap,
         TJournalEntries const & journal,
-        seqan::Dna5String const & contig,
+        MaterializedSequence const & contig,
         std::vector<SmallVarInfo> const & smallVarInfos,
         Variants const & variants,
         MethylationLevels const * levels,
@@ -523,7 +541,8 @@ int VariantMaterializer::_materializeLargeVariants(
 
                     if (verbosity >= 3)
                         std::cerr << "append(seq, infix(contig, " << svRecord.pos << ", " << svRecord.pos + svRecord.size << ") " << __LINE__ << " (inversion)\n";
-                    reverseComplement(infix(seq, oldLen, length(seq)));
+                    if (seq.str)
+                        reverseComplement(infix(*seq.str, oldLen, length(seq)));
                     lastPos = svRecord.pos + svRecord.size;
                     SEQAN_ASSERT_LT(lastPos, (int)length(contig));
 
@@ -669,7 +688,7 @@ int VariantMaterializer::_materializeLargeVariants(
         SEQAN_ASSERT_EQ(length(seq), length(levelsLargeVariants->forward));
         SEQAN_ASSERT_EQ(length(seq), length(levelsLargeVariants->reverse));
 
-        fixVariationLevels(*levelsLargeVariants, *rng, seq, varPoints, *methSimOptions);
+        fixVariationLevels(*levelsLargeVariants, *rng, *seq.str, varPoints, *methSimOptions);
     }
     if (currentPos != length(seq))
         appendValue(intervals, GenomicInterval(currentPos, length(seq), lastPos, length(contig),
@@ -698,6 +717,94 @@ int VariantMaterializer::_materializeLargeVariants(
     return 0;
 }
 
+// ----------------------------------------------------------------------------
+// Function VariantMaterializer::_applyVariantsToJournal()
+// ----------------------------------------------------------------------------
+
+void VariantMaterializer::_applyVariantsToJournal(TJournaledHaplotype & seq,
+                                                  TJournalEntries const & journal,
+                                                  Variants const & variants,
+                                                  int hId)
+{
+    // The variants are applied from right to left such that applying a variant does not shift the positions of the
+    // variants left of it.  This yields the same sequence as _materializeSmallVariants() and
+    // _materializeLargeVariants() which go from left to right.
+
+    // Apply the small variants, they are given in reference coordinates.  At the same position, the indel comes
+    // before the SNP when going from left to right.
+    int snpsIdx = (int)length(variants.snps) - 1;
+    int smallIndelIdx = (int)length(variants.smallIndels) - 1;
+    while (snpsIdx >= 0 || smallIndelIdx >= 0)
+    {
+        if (smallIndelIdx < 0 ||
+            (snpsIdx >= 0 && !(variants.snps[snpsIdx].getPos() < variants.smallIndels[smallIndelIdx].getPos())))
+        {
+            SnpRecord const & snpRecord = variants.snps[snpsIdx--];
+            if (snpRecord.haplotype == hId)
+                assignValue(seq, snpRecord.pos, snpRecord.to);
+        }
+        else
+        {
+            SmallIndelRecord const & smallIndelRecord = variants.smallIndels[smallIndelIdx--];
+            if (smallIndelRecord.haplotype != hId)
+                continue;
+            if (smallIndelRecord.size > 0)
+                insert(seq, smallIndelRecord.pos, seqan::Dna5String(smallIndelRecord.seq));
+            else
+                erase(seq, smallIndelRecord.pos, smallIndelRecord.pos - smallIndelRecord.size);
+        }
+    }
+
+    // Apply the structural variants, translated to positions in the sequence with small variants in the same way as
+    // in _materializeLargeVariants().
+    for (int i = (int)length(variants.svRecords) - 1; i >= 0; --i)
+    {
+        if (variants.svRecords[i].haplotype != hId)
+            continue;
+        StructuralVariantRecord svRecord = variants.svRecords[i];
+        svRecord.pos = hostToVirtualPosition(journal, svRecord.pos);
+        if (svRecord.kind != StructuralVariantRecord::INDEL || svRecord.size < 0)
+            svRecord.size = hostToVirtualPosition(journal, svRecord.pos + svRecord.size) -
+                    hostToVirtualPosition(journal, svRecord.pos);
+        if (svRecord.targetPos != -1)
+            svRecord.targetPos = hostToVirtualPosition(journal, svRecord.targetPos);
+
+        switch (svRecord.kind)
+        {
+            case StructuralVariantRecord::INDEL:
+                if (svRecord.size > 0)  // insertion
+                    insert(seq, svRecord.pos, seqan::Dna5String(svRecord.seq));
+                else  // deletion
+                    erase(seq, svRecord.pos, svRecord.pos - svRecord.size);
+                break;
+            case StructuralVariantRecord::INVERSION:
+                {
+                    seqan::Dna5String segment = infix(seq, svRecord.pos, svRecord.pos + svRecord.size);
+                    reverseComplement(segment);
+                    assignInfix(seq, svRecord.pos, svRecord.pos + svRecord.size, segment);
+                }
+                break;
+            case StructuralVariantRecord::TRANSLOCATION:
+                {
+                    // Move the segment behind the sequence up to the target position.
+                    seqan::Dna5String segment = infix(seq, svRecord.pos, svRecord.pos + svRecord.size);
+                    insert(seq, svRecord.targetPos, segment);
+                    erase(seq, svRecord.pos, svRecord.pos + svRecord.size);
+                }
+                break;
+            case StructuralVariantRecord::DUPLICATION:
+                {
+                    // Insert a copy of the segment at the target position.
+                    seqan::Dna5String segment = infix(seq, svRecord.pos, svRecord.pos + svRecord.size);
+                    insert(seq, svRecord.targetPos, segment);
+                }
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 // --------------------------------------------------------------------------
 // Function PositionMap::overlapsWithBreakpoint()
 // --------------------------------------------------------------------------
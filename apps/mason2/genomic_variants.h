@@ -48,6 +48,7 @@
 
 #include <seqan/align.h>
 #include <seqan/misc/interval_tree.h>
+#include <seqan/sequence_journaled.h>
 
 #include "methylation_levels.h"
 
@@ -57,6 +58,10 @@
 
 typedef seqan::JournalEntries<seqan::JournalEntry<unsigned, int>, seqan::SortedArray> TJournalEntries;
 
+// A haplotype of a contig, stored as a journal of the differences to the reference contig which is used as the host.
+// The memory required for a haplotype is linear in the size of the variants instead of the contig length.
+typedef seqan::String<seqan::Dna5, seqan::Journaled<seqan::Alloc<>, seqan::SortedArray> > TJournaledHaplotype;
+
 // ============================================================================
 // Tags, Classes, Enums
 // ============================================================================
@@ -469,6 +474,40 @@ public:
     void reinit(TJournalEntries const & journal);
 };
 
+// --------------------------------------------------------------------------
+// Class MaterializedSequence
+// --------------------------------------------------------------------------
+
+// Output sequence of the VariantMaterializer.
+//
+// Appends to the string that str points to.  If str is NULL, only the length of the resulting sequence is tracked.
+// This allows the VariantMaterializer to compute the breakpoints, small variant infos, and the PositionMap of a
+// journaled haplotype without building the haplotype as a whole.
+
+class MaterializedSequence
+{
+public:
+    seqan::Dna5String * str;
+    unsigned len;
+
+    explicit MaterializedSequence(seqan::Dna5String * str) : str(str), len(0)
+    {
+        if (str)
+            clear(*str);
+    }
+};
+
+// Infix of a MaterializedSequence, appended to another MaterializedSequence.
+struct MaterializedSequenceInfix
+{
+    MaterializedSequence const * seq;
+    unsigned beginPos, endPos;
+
+    MaterializedSequenceInfix(MaterializedSequence const & seq, unsigned beginPos, unsigned endPos) :
+            seq(&seq), beginPos(beginPos), endPos(endPos)
+    {}
+};
+
 // --------------------------------------------------------------------------
 // Class VariantMaterializer
 // --------------------------------------------------------------------------
@@ -514,7 +553,7 @@ public:
             seqan::Dna5String const & refSeq,
             int haplotypeId)
     {
-        return _runImpl(&resultSeq, &posMap, 0, smallVars, breakpoints, &refSeq, 0, haplotypeId);
+        return _runImpl(&resultSeq, 0, &posMap, 0, smallVars, breakpoints, &refSeq, 0, haplotypeId);
     }
 
     // Same as the run() above, but including reference levels.
@@ -527,12 +566,40 @@ public:
             MethylationLevels const & refLvls,
             int haplotypeId)
     {
-        return _runImpl(&resultSeq, &posMap, &resultLvls, smallVars, breakpoints, &refSeq, &refLvls, haplotypeId);
+        return _runImpl(&resultSeq, 0, &posMap, &resultLvls, smallVars, breakpoints, &refSeq, &refLvls, haplotypeId);
+    }
+
+    // Same as the run() above but the result is built as a journal with refSeq as the host.  The haplotype is not
+    // materialized as a whole, refSeq has to outlive resultSeq.
+    int run(TJournaledHaplotype & resultSeq,
+            PositionMap & posMap,
+            std::vector<SmallVarInfo> & smallVars,
+            std::vector<std::pair<int, int> > & breakpoints,
+            seqan::Dna5String const & refSeq,
+            int haplotypeId)
+    {
+        return _runImpl(0, &resultSeq, &posMap, 0, smallVars, breakpoints, &refSeq, 0, haplotypeId);
+    }
+
+    // Same as the run() above, but including reference levels.  The levels are stored in full, the haplotype is only
+    // materialized temporarily for fixing the levels at the variation points.
+    int run(TJournaledHaplotype & resultSeq,
+            PositionMap & posMap,
+            MethylationLevels & resultLvls,
+            std::vector<SmallVarInfo> & smallVars,
+            std::vector<std::pair<int, int> > & breakpoints,
+            seqan::Dna5String const & refSeq,
+            MethylationLevels const & refLvls,
+            int haplotypeId)
+    {
+        return _runImpl(0, &resultSeq, &posMap, &resultLvls, smallVars, breakpoints, &refSeq, &refLvls, haplotypeId);
     }
 
     // Implementation of the materialization, uses pointers instead of references for deciding whether materializing
-    // levels or not.
+    // levels or not and whether to build a materialized or journaled haplotype (exactly one of resultSeq and
+    // journaledSeq must be set).
     int _runImpl(seqan::Dna5String * resultSeq,
+                 TJournaledHaplotype * journaledSeq,
                  PositionMap * posMap,
                  MethylationLevels * resultLvls,
                  std::vector<SmallVarInfo> & smallVars,
@@ -544,7 +611,7 @@ public:
     // Materialization of the small variants.
     //
     // Levels passed as NULL if not given.
-    int _materializeSmallVariants(seqan::Dna5String & seq,
+    int _materializeSmallVariants(MaterializedSequence & seq,
                                   TJournalEntries & journal,
                                   MethylationLevels * levelsSmallVariants,
                                   std::vector<SmallVarInfo> & smallVarInfos,
@@ -556,17 +623,21 @@ public:
     // Materialization of the large variants.
     //
     // Levels passed as NULL if not given.
-    int _materializeLargeVariants(seqan::Dna5String & seq,
+    int _materializeLargeVariants(MaterializedSequence & seq,
                                   MethylationLevels * levelsLargeVariants,
                                   std::vector<SmallVarInfo> & varInfos,
                                   std::vector<std::pair<int, int> > & breakpoints,
                                   PositionMap & positionMap,
                                   TJournalEntries const & journal,
-                                  seqan::Dna5String const & contig,
+                                  MaterializedSequence const & contig,
                                   std::vector<SmallVarInfo> const & smallVarInfos,
                                   Variants const & variants,
                                   MethylationLevels const * levels,
                                   int hId);
+
+    // Apply the variants of haplotype hId to the journaled string seq which has the contig as its host.
+    void _applyVariantsToJournal(TJournaledHaplotype & seq, TJournalEntries const & journal, Variants const & variants,
+                                 int hId);
 };
 
 // ============================================================================
@@ -577,4 +648,47 @@ public:
 // Functions
 // ============================================================================
 
+// --------------------------------------------------------------------------
+// Functions for MaterializedSequence
+// --------------------------------------------------------------------------
+
+inline unsigned length(MaterializedSequence const & seq)
+{
+    return seq.len;
+}
+
+inline MaterializedSequenceInfix infix(MaterializedSequence const & seq, unsigned beginPos, unsigned endPos)
+{
+    return MaterializedSequenceInfix(seq, beginPos, endPos);
+}
+
+template <typename TSource>
+inline void append(MaterializedSequence & seq, TSource const & source)
+{
+    if (seq.str)
+        append(*seq.str, source);
+    seq.len += length(source);
+}
+
+template <typename TSource>
+inline void append(MaterializedSequence & seq, TSource & source)
+{
+    append(seq, const_cast<TSource const &>(source));
+}
+
+inline void append(MaterializedSequence & seq, MaterializedSequenceInfix const & source)
+{
+    SEQAN_ASSERT_LEQ(source.beginPos, source.endPos);
+    if (seq.str)
+        append(*seq.str, infix(*source.seq->str, source.beginPos, source.endPos));
+    seq.len += source.endPos - source.beginPos;
+}
+
+inline void appendValue(MaterializedSequence & seq, seqan::Dna5 c)
+{
+    if (seq.str)
+        appendValue(*seq.str, c);
+    seq.len += 1;
+}
+
 #endif  // #ifndef APPS_MASON2_GENOMIC_VARIANTS_H_
@@ -189,9 +189,11 @@ int main(int argc, char const ** argv)
                                           options.rocheOptions, options.sangerOptions);
     std::SEQAN_AUTO_PTR_NAME<SequencingSimulator> sim = simFactory.make();
 
-    // Buffers for reading in fragments.
+    // Buffers for reading in fragments.  The sequencing simulator takes fragments of journaled sequences, so we use
+    // the fragment as the host of a journaled sequence without any changes.
     seqan::CharString fragId;
     seqan::Dna5String fragSeq;
+    TJournaledHaplotype fragJournal;
     // Buffers for simulated reads.
     seqan::Dna5String seqL, seqR;
     seqan::CharString qualsL, qualsR;
@@ -211,13 +213,14 @@ int main(int argc, char const ** argv)
 
         // Read fragment to simulate from.
         readRecord(fragId, fragSeq, inFragments);
+        setHost(fragJournal, fragSeq);
 
         // Trim fragment identifier after first whitespace.
         trimAfterSpace(fragId);
 
         if (empty(options.outFileNameRight))  // Single-end sequencing.
         {
-            sim->simulateSingleEnd(seqL, qualsL, simInfoL, infix(fragSeq, 0, length(fragSeq)));
+            sim->simulateSingleEnd(seqL, qualsL, simInfoL, infix(fragJournal, 0, length(fragJournal)));
             ssL << options.seqOptions.readNamePrefix << readId;
             if (options.seqOptions.embedReadInfo)
             {
@@ -229,7 +232,7 @@ int main(int argc, char const ** argv)
         }
         else  // Paired sequencing.
         {
-            sim->simulatePairedEnd(seqL, qualsL, simInfoL, seqR, qualsR, simInfoR, infix(fragSeq, 0, length(fragSeq)));
+            sim->simulatePairedEnd(seqL, qualsL, simInfoL, seqR, qualsR, simInfoR, infix(fragJournal, 0, length(fragJournal)));
             ssL << options.seqOptions.readNamePrefix << readId;
             ssR << options.seqOptions.readNamePrefix << readId;
             if (options.seqOptions.embedReadInfo)
@@ -41,9 +41,11 @@
 // Note: We treat all given variants as phased.
 
 #include <fstream>
+#include <vector>
 
 #include <seqan/arg_parse.h>
 #include <seqan/basic.h>
+#include <seqan/parallel.h>
 #include <seqan/seq_io.h>
 #include <seqan/sequence.h>
 #include <seqan/vcf_io.h>
@@ -129,48 +131,59 @@ public:
         std::cerr << "\n__MATERIALIZING______________________________________________________________\n"
                   << "\n";
 
-        // The identifiers of the just materialized data.
-        int rID = 0, hID = 0;
-        seqan::Dna5String seq;
+        // Materialize the haplotypes of each contig in chunks of numThreads haplotypes.  Each haplotype gets its own
+        // random number generator seeded by haplotypeSeed() so the result does not depend on the number of threads.
+        // The haplotypes are journals of the contig's reference sequence.
+        bool simulateLevels = options.methOptions.simulateMethylationLevels;
         std::cerr << "Materializing...";
-        MethylationLevels levels;
-        std::vector<SmallVarInfo> varInfos;  // small variants for counting in read alignments
-        std::vector<std::pair<int, int> > breakpoints;
-        if (options.methOptions.simulateMethylationLevels)  // methylation level simulation
-            while (vcfMat.materializeNext(seq, levels, varInfos, breakpoints, rID, hID))
-            {
-                std::stringstream ssName;
-                ssName << contigNames(context(vcfMat.vcfFileIn))[rID] << options.haplotypeNameSep << (hID + 1);
-                std::cerr << " " << ssName.str();
-
-                writeRecord(outStream, ssName.str(), seq);
-
-                if (!empty(options.outputBreakpointFile))
-                    for (std::vector<std::pair<int, int> >::const_iterator it = breakpoints.begin(); it != breakpoints.end(); ++it)
-                        breakpointsOut << ssName.str() << "\t" << vcfMat.contigVariants.getVariantName(it->second)
-                                       << "\t" << (it->first + 1) << "\n";
-
-                std::stringstream ssTop;
-                ssTop << ssName.str() << "/TOP";
-                writeRecord(outMethLevelStream, ssTop.str(), levels.forward);
-                std::stringstream ssBottom;
-                ssBottom << ssName.str() << "/BOT";
-                writeRecord(outMethLevelStream, ssBottom.str(), levels.reverse);
-            }
-        else  // NO methylation level simulation
-            while (vcfMat.materializeNext(seq, varInfos, breakpoints, rID, hID))
+        int rID = 0;
+        while (vcfMat.loadNextContig(rID))
+        {
+            for (int hBegin = 0; hBegin < vcfMat.numHaplotypes; hBegin += options.numThreads)
             {
-                std::stringstream ssName;
-                ssName << contigNames(context(vcfMat.vcfFileIn))[rID] << options.haplotypeNameSep << (hID + 1);
-                std::cerr << " " << ssName.str();
-
-                writeRecord(outStream, ssName.str(), seq);
-
-                if (!empty(options.outputBreakpointFile))
-                    for (std::vector<std::pair<int, int> >::const_iterator it = breakpoints.begin(); it != breakpoints.end(); ++it)
-                        breakpointsOut << ssName.str() << "\t" << vcfMat.contigVariants.getVariantName(it->second)
-                                       << "\t" << (it->first + 1) << "\n";
+                int hEnd = std::min(hBegin + options.numThreads, vcfMat.numHaplotypes);
+                std::vector<TJournaledHaplotype> seqs(hEnd - hBegin);
+                std::vector<MethylationLevels> levels(hEnd - hBegin);
+                std::vector<std::vector<std::pair<int, int> > > breakpoints(hEnd - hBegin);
+
+                SEQAN_OMP_PRAGMA(parallel for num_threads(options.numThreads) schedule(dynamic, 1))
+                for (int hID = hBegin; hID < hEnd; ++hID)
+                {
+                    TRng hRng(haplotypeSeed(options.seed, rID, hID));
+                    PositionMap posMap;
+                    std::vector<SmallVarInfo> varInfos;  // small variants for counting in read alignments
+                    vcfMat.materializeHaplotype(seqs[hID - hBegin], posMap,
+                                                simulateLevels ? &levels[hID - hBegin] : 0,
+                                                varInfos, breakpoints[hID - hBegin], hRng, hID);
+                }
+
+                // Write out the haplotypes in order.
+                for (int hID = hBegin; hID < hEnd; ++hID)
+                {
+                    std::stringstream ssName;
+                    ssName << contigNames(context(vcfMat.vcfFileIn))[rID] << options.haplotypeNameSep << (hID + 1);
+                    std::cerr << " " << ssName.str();
+
+                    writeRecord(outStream, ssName.str(), seqs[hID - hBegin]);
+
+                    std::vector<std::pair<int, int> > const & bps = breakpoints[hID - hBegin];
+                    if (!empty(options.outputBreakpointFile))
+                        for (std::vector<std::pair<int, int> >::const_iterator it = bps.begin(); it != bps.end(); ++it)
+                            breakpointsOut << ssName.str() << "\t" << vcfMat.contigVariants.getVariantName(it->second)
+                                           << "\t" << (it->first + 1) << "\n";
+
+                    if (simulateLevels)
+                    {
+                        std::stringstream ssTop;
+                        ssTop << ssName.str() << "/TOP";
+                        writeRecord(outMethLevelStream, ssTop.str(), levels[hID - hBegin].forward);
+                        std::stringstream ssBottom;
+                        ssBottom << ssName.str() << "/BOT";
+                        writeRecord(outMethLevelStream, ssBottom.str(), levels[hID - hBegin].reverse);
+                    }
+                }
             }
+        }
         std::cerr << " DONE\n";
 
         std::cerr << "\nDone materializing VCF file.\n";
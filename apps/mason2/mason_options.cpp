@@ -1312,6 +1312,11 @@ void MasonMaterializerOptions::addOptions(seqan::ArgumentParser & parser) const
                                             seqan::ArgParseOption::INTEGER, "Int"));
     setDefaultValue(parser, "meth-seed", "0");
 
+    addOption(parser, seqan::ArgParseOption("", "num-threads", "Number of threads to use for materializing the "
+                                            "haplotypes of a contig.", seqan::ArgParseOption::INTEGER, "NUM"));
+    setMinValue(parser, "num-threads", "1");
+    setDefaultValue(parser, "num-threads", "1");
+
     addOption(parser, seqan::ArgParseOption("o", "out", "Output of materialized contigs.",
                                             seqan::ArgParseOption::OUTPUT_FILE, "OUT"));
     setRequired(parser, "out");
@@ -1365,6 +1370,11 @@ void MasonMaterializerOptions::getOptionValues(seqan::ArgumentParser const & par
         verbosity = 3;
     getOptionValue(seed, parser, "seed");
     getOptionValue(methSeed, parser, "meth-seed");
+#if SEQAN_HAS_OPENMP
+    getOptionValue(numThreads, parser, "num-threads");
+#else  // #if SEQAN_HAS_OPENMP
+    numThreads = 1;
+#endif  // #if SEQAN_HAS_OPENMP
     getOptionValue(outputFileName, parser, "out");
     getOptionValue(outputBreakpointFile, parser, "out-breakpoints");
     getOptionValue(haplotypeNameSep, parser, "haplotype-name-sep");
@@ -1396,6 +1406,7 @@ void MasonMaterializerOptions::print(std::ostream & out) const
         << "\n"
         << "SEED                    \t" << seed << "\n"
         << "METHYLATION SEED        \t" << methSeed << "\n"
+        << "NUM THREADS             \t" << numThreads << "\n"
         << "\n"
         << "OUTPUT FILE             \t" << outputFileName << "\n"
         << "BREAKPOINT TSV OUT      \t" << outputBreakpointFile << "\n"
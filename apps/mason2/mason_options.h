@@ -719,6 +719,8 @@ struct MasonMaterializerOptions
     int seed;
     // Seed to use in RNG for methylation simulation.
     int methSeed;
+    // Number of threads to use for materializing the haplotypes of a contig.
+    int numThreads;
 
     // Options for the materializer.
     MaterializerOptions matOptions;
@@ -736,7 +738,7 @@ struct MasonMaterializerOptions
     // FASTA file to write the methylation levels to.
     seqan::CharString methFastaOutFile;
 
-    MasonMaterializerOptions() : verbosity(1), seed(0), methSeed(0)
+    MasonMaterializerOptions() : verbosity(1), seed(0), methSeed(0), numThreads(1)
     {}
 
     // Add options to the argument parser.
@@ -680,7 +680,7 @@ public:
         str = ss.str();
     }
 
-    void _simulatePairedEnd(seqan::Dna5String const & seq,
+    void _simulatePairedEnd(TJournaledHaplotype const & seq,
                             std::vector<SmallVarInfo> const & varInfos,
                             PositionMap const & posMap,
                             seqan::CharString const & refName,
@@ -747,7 +747,7 @@ public:
         return result;
     }
 
-    void _simulateSingleEnd(seqan::Dna5String /*const*/ & seq,
+    void _simulateSingleEnd(TJournaledHaplotype const & seq,
                             std::vector<SmallVarInfo> const & varInfos,
                             PositionMap const & posMap,
                             seqan::CharString const & refName,
@@ -780,7 +780,7 @@ public:
     }
 
     // Simulate next chunk.
-    void run(seqan::Dna5String /*const*/ & seq,
+    void run(TJournaledHaplotype const & seq,
              std::vector<std::pair<int, int> > const & gapIntervals,
              std::vector<SmallVarInfo> const & varInfos,
              PositionMap const & posMap,
@@ -916,21 +916,24 @@ public:
     //
     // Used for fragment exclusion downstream.
     void buildGapIntervals(std::vector<std::pair<int, int> > & intervals,
-                           seqan::Dna5String const & contigSeq,
+                           TJournaledHaplotype const & contigSeq,
                            unsigned minNs = 3)
     {
+        typedef seqan::Iterator<TJournaledHaplotype const, seqan::Standard>::Type TIter;
+
         intervals.clear();
 
         bool inN = false;
         unsigned beginPos = 0;
-        for (unsigned pos = 0; pos < length(contigSeq); ++pos)
+        TIter it = begin(contigSeq, seqan::Standard());
+        for (unsigned pos = 0; pos < length(contigSeq); ++pos, ++it)
         {
-            if (contigSeq[pos] == 'N' && !inN)
+            if (*it == 'N' && !inN)
             {
                 beginPos = pos;
                 inN = true;
             }
-            else if (contigSeq[pos] != 'N' && inN)
+            else if (*it != 'N' && inN)
             {
                 if (pos - beginPos >= minNs)
                     intervals.push_back(std::make_pair(beginPos, pos));
@@ -947,13 +950,12 @@ public:
     {
         std::cerr << "\nSimulating Reads:\n";
         int haplotypeCount = vcfMat.numHaplotypes;
-        seqan::Dna5String contigSeq;  // materialized contig
+        TJournaledHaplotype contigSeq;  // materialized contig, journal of the reference sequence
         int rID = 0;  // current reference id
         int hID = 0;  // current haplotype id
         int contigFragmentCount = 0;  // number of reads on the contig
         // Note that all shared variables are correctly synchronized by implicit flushes at the critical sections below.
         MethylationLevels levels;
-        seqan::Dna5String refSeq;  // reference sequence
         std::vector<SmallVarInfo> varInfos;  // small variants for counting in read alignments
         std::vector<std::pair<int, int> > breakpoints;  // unused/ignored
         while ((options.seqOptions.bsSeqOptions.bsSimEnabled &&
@@ -963,7 +965,12 @@ public:
         {
             std::cerr << "  " << sequenceName(vcfMat.faiIndex, rID) << " (allele " << (hID + 1) << ") ";
             contigFragmentCount = 0;
-            readSequence(refSeq, vcfMat.faiIndex, rID);
+            // The reference sequence is the host of the journaled contig.
+            seqan::Dna5String & refSeq = host(contigSeq);
+
+            // Build gap intervals.
+            std::vector<std::pair<int, int> > gapIntervals;
+            buildGapIntervals(gapIntervals, contigSeq);
 
             while (true)  // Execute as long as there are fragments left.
             {
@@ -985,10 +992,6 @@ public:
                     threads[tID].fragmentIds.resize(numRead);
                 }
 
-                // Build gap intervals.
-                std::vector<std::pair<int, int> > gapIntervals;
-                buildGapIntervals(gapIntervals, contigSeq);
-
                 // Perform the simulation.
                 SEQAN_OMP_PRAGMA(parallel num_threads(options.numThreads))
                 {
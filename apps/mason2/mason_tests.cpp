@@ -413,6 +413,59 @@ SEQAN_DEFINE_TEST(mason_tests_position_map_original_to_small_var)
     }
 }
 
+SEQAN_DEFINE_TEST(mason_tests_variant_materializer_journaled)
+{
+    // Build pseudo-random reference.
+    seqan::Dna5String ref;
+    for (unsigned i = 0; i < 200; ++i)
+        appendValue(ref, seqan::Dna5((i * 7 + i / 3) % 4));
+
+    // Variants on two haplotypes, with small and structural variants of all kinds on haplotype 0.
+    Variants variants;
+    appendValue(variants.snps, SnpRecord(0, 0, 5, 'N'));
+    appendValue(variants.snps, SnpRecord(1, 0, 6, 'N'));
+    appendValue(variants.snps, SnpRecord(0, 0, 20, 'N'));
+    appendValue(variants.smallIndels, SmallIndelRecord(0, 0, 20, 3, "ACG"));
+    appendValue(variants.smallIndels, SmallIndelRecord(0, 0, 30, -4, ""));
+    appendValue(variants.smallIndels, SmallIndelRecord(1, 0, 40, 2, "TT"));
+    appendValue(variants.svRecords, StructuralVariantRecord(StructuralVariantRecord::INVERSION, 0, 0, 50, 10));
+    appendValue(variants.svRecords, StructuralVariantRecord(StructuralVariantRecord::TRANSLOCATION, 0, 0, 80, 10,
+                                                            0, 100));
+    appendValue(variants.svRecords, StructuralVariantRecord(StructuralVariantRecord::DUPLICATION, 0, 0, 120, 8,
+                                                            0, 135));
+    appendValue(variants.svRecords, StructuralVariantRecord(StructuralVariantRecord::INDEL, 0, 0, 150, -5));
+    appendValue(variants.svRecords, StructuralVariantRecord(StructuralVariantRecord::INDEL, 1, 0, 160, 4));
+    back(variants.svRecords).seq = "GGGG";
+    appendValue(variants.svRecords, StructuralVariantRecord(StructuralVariantRecord::INDEL, 0, 0, 170, 4));
+    back(variants.svRecords).seq = "TTTT";
+
+    TRng rng(0);
+    VariantMaterializer varMat(rng, variants);
+    for (int hId = 0; hId < 2; ++hId)
+    {
+        seqan::Dna5String seq;
+        PositionMap posMap;
+        std::vector<SmallVarInfo> varInfos;
+        std::vector<std::pair<int, int> > breakpoints;
+        varMat.run(seq, posMap, varInfos, breakpoints, ref, hId);
+
+        TJournaledHaplotype journaledSeq;
+        PositionMap journaledPosMap;
+        std::vector<SmallVarInfo> journaledVarInfos;
+        std::vector<std::pair<int, int> > journaledBreakpoints;
+        varMat.run(journaledSeq, journaledPosMap, journaledVarInfos, journaledBreakpoints, ref, hId);
+
+        SEQAN_ASSERT(&host(journaledSeq) == &ref);
+        SEQAN_ASSERT_EQ(seq, seqan::Dna5String(journaledSeq));
+        SEQAN_ASSERT(breakpoints == journaledBreakpoints);
+        SEQAN_ASSERT_EQ(varInfos.size(), journaledVarInfos.size());
+        for (unsigned i = 0; i < varInfos.size(); ++i)
+            SEQAN_ASSERT_EQ(varInfos[i].pos, journaledVarInfos[i].pos);
+        for (unsigned pos = 0; pos < length(seq); ++pos)
+            SEQAN_ASSERT(posMap.getGenomicInterval(pos) == journaledPosMap.getGenomicInterval(pos));
+    }
+}
+
 SEQAN_BEGIN_TESTSUITE(mason_tests)
 {
     SEQAN_CALL_TEST(mason_tests_append_orientation_elementary_operations);
@@ -424,5 +477,7 @@ SEQAN_BEGIN_TESTSUITE(mason_tests)
     SEQAN_CALL_TEST(mason_tests_position_map_to_original_interval);
 
     SEQAN_CALL_TEST(mason_tests_position_map_original_to_small_var);
+
+    SEQAN_CALL_TEST(mason_tests_variant_materializer_journaled);
 }
 SEQAN_END_TESTSUITE
@@ -77,4 +77,48 @@ public:
 // Functions
 // ============================================================================
 
+// ----------------------------------------------------------------------------
+// Function _splitMix64()
+// ----------------------------------------------------------------------------
+
+// The splitmix64 finalizer, a bijective mixing function on 64 bit values.
+
+inline __uint64 _splitMix64(__uint64 x)
+{
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+// ----------------------------------------------------------------------------
+// Function contigSeed()
+// ----------------------------------------------------------------------------
+
+// Seed for the random number generator that simulates the variants of contig rId.  Each contig gets its own random
+// number stream such that contigs can be simulated in parallel and the result does not depend on the number of
+// threads.  The components are mixed with splitmix64 so that the streams of neighbouring seeds do not overlap.
+
+inline __uint64 _contigSeed64(int seed, int rId)
+{
+    return _splitMix64(_splitMix64((__uint32)seed) ^ (__uint32)rId);
+}
+
+inline unsigned contigSeed(int seed, int rId)
+{
+    return (unsigned)(_contigSeed64(seed, rId) >> 32);
+}
+
+// ----------------------------------------------------------------------------
+// Function haplotypeSeed()
+// ----------------------------------------------------------------------------
+
+// Seed for the random number generator used when materializing haplotype hId of contig rId.  mason_variator and
+// mason_materializer both use this, so they yield the same methylation levels for the same seed.
+
+inline unsigned haplotypeSeed(int seed, int rId, int hId)
+{
+    return (unsigned)(_splitMix64(_contigSeed64(seed, rId) ^ ((__uint64)(__uint32)hId + 1)) >> 32);
+}
+
 #endif  // #ifndef APPS_MASON2_MASON_TYPES_H_
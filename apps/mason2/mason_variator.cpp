@@ -41,7 +41,12 @@
 // TODO(holtgrew): Allow inversion in translocation.
 // TODO(holtgrew): Simulate different SNPs/small variations for duplications, input for repeat separation.
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include <seqan/arg_parse.h>
+#include <seqan/parallel.h>
 #include <seqan/random.h>
 #include <seqan/sequence.h>
 #include <seqan/seq_io.h>
@@ -76,6 +81,9 @@ struct MasonVariatorOptions
     // Seed for RNG.
     int seed;
 
+    // Number of threads to use for simulating contigs in parallel.
+    int numThreads;
+
     // ----------------------------------------------------------------------
     // Input / Output Options
     // ----------------------------------------------------------------------
@@ -143,7 +151,7 @@ struct MasonVariatorOptions
     MethylationLevelSimulatorOptions methSimOptions;
 
     MasonVariatorOptions() :
-            verbosity(1), seed(0), genVarIDs(true), numHaplotypes(0),
+            verbosity(1), seed(0), numThreads(1), genVarIDs(true), numHaplotypes(0),
             snpRate(0), smallIndelRate(0), minSmallIndelSize(0), maxSmallIndelSize(0), svIndelRate(0),
             svInversionRate(0), svTranslocationRate(0), svDuplicationRate(0), minSVSize(0), maxSVSize(0)
     {}
@@ -161,6 +169,8 @@ void print(std::ostream & out, MasonVariatorOptions const & options)
         << "BREAKPOINT TSV OUT   \t" << options.outputBreakpointFile << "\n"
         << "METHYLATION IN FILE  \t" << options.methFastaInFile << "\n"
         << "\n"
+        << "NUM THREADS          \t" << options.numThreads << "\n"
+        << "\n"
         << "GENERATE VAR IDS     \t" << getYesNoStr(options.genVarIDs) << "\n"
         << "\n"
         << "NUM HAPLOTYPES       \t" << options.numHaplotypes << "\n"
@@ -254,6 +264,14 @@ public:
         _distributeVariations();
     }
 
+    // Use the configuration and the distribution of the variations to contigs from other but simulate with rng.  The
+    // numbering of the variants starts at zero again.
+    StructuralVariantSimulator(TRng & rng, StructuralVariantSimulator const & other) :
+            rng(rng), faiIndex(other.faiIndex), options(other.options),
+            variationSizeRecords(other.variationSizeRecords), variationToContig(other.variationToContig),
+            nextIndelNo(0), nextInvNo(0), nextTransNo(0), nextDupNo(0)
+    {}
+
     // Distribute variations to contigs.
     void _distributeVariations()
     {
@@ -752,11 +770,25 @@ public:
 class MasonVariatorApp
 {
 public:
-    // Random number generator for variant simulation and methylation level simulation.  We need separate random number
-    // generations since we interleave variant and methylation level simulation and we want mason_materializer and
-    // mason_variator to yield the same results.
+    // The result of simulating one contig, kept until it is written out.
+    struct ContigSimulation
+    {
+        // The reference sequence of the contig and the simulated variants.
+        seqan::Dna5String contig;
+        Variants variants;
+        // The methylation levels of the reference, empty if not simulated.
+        MethylationLevels methLevels;
+        // The haplotypes with the variants applied as journals with contig as the host, their methylation levels, and
+        // breakpoints.
+        std::vector<TJournaledHaplotype> haplotypes;
+        std::vector<MethylationLevels> haplotypeLevels;
+        std::vector<std::vector<std::pair<int, int> > > breakpoints;
+    };
+
+    // Random number generator for distributing the variations to the contigs.  The contigs themselves are simulated
+    // with random number generators seeded by contigSeed() and haplotypeSeed() such that the result does not depend
+    // on the number of threads and mason_materializer yields the same haplotypes.
     TRng & rng;
-    TRng & methRng;
 
     MasonVariatorOptions options;
 
@@ -779,9 +811,8 @@ public:
     // Numeric id of the variation that is written out next.
     int nextVarNo;
 
-    MasonVariatorApp(TRng & rng, TRng & methRng, seqan::FaiIndex const & faiIndex,
-                     MasonVariatorOptions const & options) :
-            rng(rng), methRng(methRng), options(options), faiIndex(faiIndex), nextVarNo(0)
+    MasonVariatorApp(TRng & rng, seqan::FaiIndex const & faiIndex, MasonVariatorOptions const & options) :
+            rng(rng), options(options), faiIndex(faiIndex), nextVarNo(0)
     {
         _init();
     }
@@ -890,47 +921,32 @@ public:
         if (_readVariationSizes() != 0)
             return 1;
 
-        // Actually perform the variant simulation.
+        // Actually perform the variant simulation.  The contigs are simulated in chunks of numThreads contigs in
+        // parallel and then written out in order.
         if (options.verbosity >= 1)
             std::cerr << "\nSimulation...\n";
         StructuralVariantSimulator svSim(rng, faiIndex, variationSizeRecords, options);
-        SmallVariantSimulator smallSim(rng, faiIndex, options);
-        for (int rId = 0; rId < (int)numSeqs(faiIndex); ++rId)  // ref seqs
+        std::map<std::string, int> idOffsets;
+        int numContigs = numSeqs(faiIndex);
+        for (int rBegin = 0; rBegin < numContigs; rBegin += options.numThreads)
         {
-            // Simulate methylation levels if configured to do so and write out for reference.  We always pass the
-            // levels down into _simulateContigs() but it can be empty and ignored if methylation levels are not of
-            // interest.
-            MethylationLevels methLevels;
-            if (options.methSimOptions.simulateMethylationLevels)
+            int rEnd = std::min(rBegin + options.numThreads, numContigs);
+            std::vector<ContigSimulation> sims(rEnd - rBegin);
+            std::vector<int> results(rEnd - rBegin, 0);
+
+            SEQAN_OMP_PRAGMA(parallel for num_threads(options.numThreads) schedule(dynamic, 1))
+            for (int rId = rBegin; rId < rEnd; ++rId)
+                results[rId - rBegin] = _simulateContig(sims[rId - rBegin], svSim, rId);
+
+            for (int rId = rBegin; rId < rEnd; ++rId)
             {
-                if (!empty(options.methFastaInFile))
-                {
-                    std::stringstream ssTop, ssBottom;
-                    ssTop << sequenceName(faiIndex, rId) << "/TOP";
-                    unsigned idx = 0;
-                    if (!getIdByName(idx, methFaiIndex, ssTop.str().c_str()))
-                    {
-                        std::cerr << "\nERROR: Could not find " << ssTop.str()
-                                  << " in methylation input file.\n";
-                        return 1;
-                    }
-                    readSequence(methLevels.forward, methFaiIndex, idx);
-                    ssBottom << sequenceName(faiIndex, rId) << "/BOT";
-                    if (!getIdByName(idx, methFaiIndex, ssBottom.str().c_str()))
-                    {
-                        std::cerr << "\nERROR: Could not find " << ssBottom.str()
-                                  << " in methylation input file.\n";
-                        return 1;
-                    }
-                    readSequence(methLevels.reverse, methFaiIndex, idx);
-                }
-                else
-                {
-                    _simulateMethLevels(methLevels, rId);
-                }
+                if (results[rId - rBegin] != 0)
+                    return 1;
+                if (options.genVarIDs)
+                    _renumberVariantIDs(sims[rId - rBegin].variants, idOffsets);
+                if (_writeContig(sims[rId - rBegin], rId) != 0)
+                    return 1;
             }
-            // Simulate contigs.
-            _simulateContig(svSim, smallSim, methLevels, options, rId);
         }
         if (options.verbosity >= 1)
             std::cerr << "OK.\n\n";
@@ -938,8 +954,35 @@ public:
         return 0;
     }
 
+    // Load or simulate methylation levels for the reference contig rId.
+    int _loadMethLevels(MethylationLevels & levels, TRng & methRng, int rId)
+    {
+        if (empty(options.methFastaInFile))
+            return _simulateMethLevels(levels, methRng, rId);
+
+        std::stringstream ssTop, ssBottom;
+        ssTop << sequenceName(faiIndex, rId) << "/TOP";
+        unsigned idx = 0;
+        if (!getIdByName(idx, methFaiIndex, ssTop.str().c_str()))
+        {
+            SEQAN_OMP_PRAGMA(critical (mason_variator_cerr))
+            std::cerr << "\nERROR: Could not find " << ssTop.str() << " in methylation input file.\n";
+            return 1;
+        }
+        readSequence(levels.forward, methFaiIndex, idx);
+        ssBottom << sequenceName(faiIndex, rId) << "/BOT";
+        if (!getIdByName(idx, methFaiIndex, ssBottom.str().c_str()))
+        {
+            SEQAN_OMP_PRAGMA(critical (mason_variator_cerr))
+            std::cerr << "\nERROR: Could not find " << ssBottom.str() << " in methylation input file.\n";
+            return 1;
+        }
+        readSequence(levels.reverse, methFaiIndex, idx);
+        return 0;
+    }
+
     // Simulate methylation levels.
-    int _simulateMethLevels(MethylationLevels & levels, int rId)
+    int _simulateMethLevels(MethylationLevels & levels, TRng & methRng, int rId)
     {
         MethylationLevelSimulator methSim(methRng, options.methSimOptions);
         seqan::Dna5String contig;
@@ -1016,100 +1059,137 @@ public:
 
     // Perform simulation of one contig.
     //
-    // If options.simulateMethylationLevels then methLevels will be used, otherwise it can be (and is) empty.
+    // Simulates the variants and, if configured, the methylation levels of the contig and the haplotypes into sim.
+    // This does not write to any output file and uses random number generators of its own such that it can be called
+    // for multiple contigs in parallel.
     //
-    // svSim -- simulator for structural variants
-    // smallSim -- simulator for small variants
-    // methLevels -- methylation level information for reference
-    // options -- configuration
+    // sim -- the simulation result
+    // svSimProto -- simulator for structural variants with the distribution of variations to contigs
     // rId -- ID of reference sequence that we are using now
-    int _simulateContig(StructuralVariantSimulator & svSim,
-                        SmallVariantSimulator & smallSim,
-                        MethylationLevels const & methLevels,
-                        MasonVariatorOptions const & options,
-                        int rId)
+    int _simulateContig(ContigSimulation & sim, StructuralVariantSimulator const & svSimProto, int rId)
     {
-        if (options.verbosity >= 1)
-            std::cerr << "  " << sequenceName(faiIndex, rId) << "\n";
+        TRng contigRng(contigSeed(options.seed, rId));
+        TRng contigMethRng(contigSeed(options.seed, rId));
+
+        // Simulate methylation levels if configured to do so.  The levels are empty and ignored otherwise.
+        if (options.methSimOptions.simulateMethylationLevels)
+            if (_loadMethLevels(sim.methLevels, contigMethRng, rId) != 0)
+                return 1;
 
         // Simulate variants.
-        Variants variants;
-        svSim.simulateContig(variants, rId, options.numHaplotypes);
-        std::sort(begin(variants.svRecords, seqan::Standard()),
-                  end(variants.svRecords, seqan::Standard()));
-        smallSim.simulateContig(variants, rId, options.numHaplotypes);
-        // TODO(holtgrew): This list is wrong.
-        if (options.verbosity >= 1)
-            std::cerr << "  snps:                " << length(variants.snps) << "\n"
-                      << "  small indels:        " << length(variants.smallIndels) << "\n"
-                      << "  structural variants: " << length(variants.svRecords) << "\n";
+        StructuralVariantSimulator svSim(contigRng, svSimProto);
+        SmallVariantSimulator smallSim(contigRng, faiIndex, options);
+        svSim.simulateContig(sim.variants, rId, options.numHaplotypes);
+        std::sort(begin(sim.variants.svRecords, seqan::Standard()),
+                  end(sim.variants.svRecords, seqan::Standard()));
+        smallSim.simulateContig(sim.variants, rId, options.numHaplotypes);
 
         // Load contig seq.
-        // TODO(holtgrew): Pass from outside, could reuse sequence from methylation levels.
-        seqan::Dna5String contig;
-        readSequence(contig, faiIndex, rId);
-
-        // Write out variants for contig to VCF file.
-        if (_writeVcf(contig, variants, rId) != 0)
-            return 1;
+        readSequence(sim.contig, faiIndex, rId);
 
-        // Apply variants to contigs and write out.
+        // Apply variations to contigs.
         if (!empty(options.fastaOutFile))
         {
-            // Write out methylation levels for reference except when they were already in the input.
-            if (options.methSimOptions.simulateMethylationLevels && !empty(options.methFastaOutFile) &&
-                empty(options.methFastaInFile))
-                if (_writeMethylationLevels(methLevels, -1, rId) != 0)
-                    return 1;
-            // Apply variations to contigs and write out.
+            sim.haplotypes.resize(options.numHaplotypes);
+            sim.haplotypeLevels.resize(options.numHaplotypes);
+            sim.breakpoints.resize(options.numHaplotypes);
             for (int hId = 0; hId < options.numHaplotypes; ++hId)
             {
-                if (_writeContigs(contig, variants, methLevels, rId, hId) != 0)
-                    return 1;
+                TRng hRng(haplotypeSeed(options.seed, rId, hId));
+                VariantMaterializer varMat(hRng, sim.variants, options.methSimOptions);
+                PositionMap posMap;  // unused, though
+                std::vector<SmallVarInfo> varInfos;  // small variants for counting in read alignments
+                if (options.methSimOptions.simulateMethylationLevels)
+                    varMat.run(sim.haplotypes[hId], posMap, sim.haplotypeLevels[hId], varInfos, sim.breakpoints[hId],
+                               sim.contig, sim.methLevels, hId);
+                else
+                    varMat.run(sim.haplotypes[hId], posMap, varInfos, sim.breakpoints[hId], sim.contig, hId);
             }
         }
 
         return 0;
     }
 
-    int _writeContigs(seqan::Dna5String const & contig, Variants const & variants, MethylationLevels const & levels, int rId, int hId)
+    // Shift the numbers of the generated variant ids of one contig by the number of ids with the same prefix (e.g.
+    // "sim_snp_") on the previous contigs and update idOffsets.  Each contig is numbered from zero when simulated in
+    // parallel, this makes the ids unique again.
+    void _renumberVariantIDs(Variants & variants, std::map<std::string, int> & idOffsets)
     {
-        // Create contig with the small and large variants.
-        VariantMaterializer varMat(methRng, variants, options.methSimOptions);
-        seqan::Dna5String seqVariants;
-        std::vector<std::pair<int, int> > breakpoints;
-        if (options.methSimOptions.simulateMethylationLevels)
+        std::map<std::string, int> counts;
+        _renumberIDs(variants.snpIDs, counts, idOffsets);
+        _renumberIDs(variants.smallIndelIDs, counts, idOffsets);
+        _renumberIDs(variants.svIDs, counts, idOffsets);
+        for (std::map<std::string, int>::const_iterator it = counts.begin(); it != counts.end(); ++it)
+            idOffsets[it->first] += it->second;
+    }
+
+    void _renumberIDs(seqan::StringSet<seqan::CharString> & ids, std::map<std::string, int> & counts,
+                      std::map<std::string, int> const & idOffsets)
+    {
+        for (unsigned i = 0; i < length(ids); ++i)
         {
-            MethylationLevels levelsVariants;
-            PositionMap posMap;  // unused, though
-            std::vector<SmallVarInfo> varInfos;  // small variants for counting in read alignments
-            varMat.run(seqVariants, posMap, levelsVariants, varInfos, breakpoints, contig, levels, hId);
-            // Write out methylation levels if necessary.
-            if (!empty(options.methFastaOutFile))
-                if (_writeMethylationLevels(levelsVariants, hId, rId) != 0)
-                    return 1;
+            std::string id(toCString(ids[i]));
+            size_t pos = id.rfind('_') + 1;
+            std::string prefix = id.substr(0, pos);
+            int no = atoi(id.c_str() + pos);
+            counts[prefix] = std::max(counts[prefix], no + 1);
+
+            std::map<std::string, int>::const_iterator it = idOffsets.find(prefix);
+            if (it == idOffsets.end())
+                continue;
+            std::stringstream ss;
+            ss << prefix << (no + it->second);
+            ids[i] = ss.str();
         }
-        else
+    }
+
+    // Write out the simulation result for contig rId to the VCF, FASTA, methylation, and breakpoint files.
+    int _writeContig(ContigSimulation const & sim, int rId)
+    {
+        // TODO(holtgrew): This list is wrong.
+        if (options.verbosity >= 1)
+            std::cerr << "  " << sequenceName(faiIndex, rId) << "\n"
+                      << "  snps:                " << length(sim.variants.snps) << "\n"
+                      << "  small indels:        " << length(sim.variants.smallIndels) << "\n"
+                      << "  structural variants: " << length(sim.variants.svRecords) << "\n";
+
+        // Write out variants for contig to VCF file.
+        if (_writeVcf(sim.contig, sim.variants, rId) != 0)
+            return 1;
+
+        if (empty(options.fastaOutFile))
+            return 0;
+
+        // Write out methylation levels for reference except when they were already in the input.
+        bool writeLevels = options.methSimOptions.simulateMethylationLevels && !empty(options.methFastaOutFile);
+        if (writeLevels && empty(options.methFastaInFile))
+            if (_writeMethylationLevels(sim.methLevels, -1, rId) != 0)
+                return 1;
+
+        for (int hId = 0; hId < options.numHaplotypes; ++hId)
         {
-            PositionMap posMap;  // unused, though
-            std::vector<SmallVarInfo> varInfos;  // small variants for counting in read alignments
-            varMat.run(seqVariants, posMap, varInfos, breakpoints, contig, hId);
-        }
+            // Write out methylation levels if necessary.
+            if (writeLevels)
+                if (_writeMethylationLevels(sim.haplotypeLevels[hId], hId, rId) != 0)
+                    return 1;
 
-        // Build sequence id.
-        seqan::CharString id = sequenceName(faiIndex, rId);
-        append(id, options.haplotypeSep);
-        char buffer[20];
-        snprintf(buffer, 19, "%d", hId + 1);
-        append(id, buffer);
+            // Build sequence id.
+            seqan::CharString id = sequenceName(faiIndex, rId);
+            append(id, options.haplotypeSep);
+            char buffer[20];
+            snprintf(buffer, 19, "%d", hId + 1);
+            append(id, buffer);
 
-        // Write out breakpoints.
-        if (!empty(options.outputBreakpointFile))
-            for (std::vector<std::pair<int, int> >::const_iterator it = breakpoints.begin(); it != breakpoints.end(); ++it)
-                breakpointsOut << id << "\t" << variants.getVariantName(it->second) << "\t" << (it->first + 1) << "\n";
+            // Write out breakpoints.
+            std::vector<std::pair<int, int> > const & breakpoints = sim.breakpoints[hId];
+            if (!empty(options.outputBreakpointFile))
+                for (std::vector<std::pair<int, int> >::const_iterator it = breakpoints.begin(); it != breakpoints.end(); ++it)
+                    breakpointsOut << id << "\t" << sim.variants.getVariantName(it->second) << "\t" << (it->first + 1) << "\n";
+
+            // Write out sequence with variants.
+            writeRecord(outSeqStream, id, sim.haplotypes[hId]);
+        }
 
-        // Write out sequence with variants.
-        writeRecord(outSeqStream, id, seqVariants);
         return 0;
     }
 
@@ -1675,6 +1755,11 @@ parseCommandLine(MasonVariatorOptions & options, int argc, char const ** argv)
                                             seqan::ArgParseOption::INTEGER, "INT"));
     setDefaultValue(parser, "seed", "0");
 
+    addOption(parser, seqan::ArgParseOption("", "num-threads", "Number of threads to use for simulating contigs in "
+                                            "parallel.", seqan::ArgParseOption::INTEGER, "INT"));
+    setMinValue(parser, "num-threads", "1");
+    setDefaultValue(parser, "num-threads", "1");
+
     // ----------------------------------------------------------------------
     // Input / Output Options
     // ----------------------------------------------------------------------
@@ -1894,6 +1979,11 @@ parseCommandLine(MasonVariatorOptions & options, int argc, char const ** argv)
         options.verbosity = 3;
 
     getOptionValue(options.seed, parser, "seed");
+#if SEQAN_HAS_OPENMP
+    getOptionValue(options.numThreads, parser, "num-threads");
+#else  // #if SEQAN_HAS_OPENMP
+    options.numThreads = 1;
+#endif  // #if SEQAN_HAS_OPENMP
 
     // getOptionValue(options.vcfInFile, parser, "in-vcf");
     getOptionValue(options.fastaInFile, parser, "in-reference");
@@ -1945,10 +2035,8 @@ int main(int argc, char const ** argv)
     if (res != seqan::ArgumentParser::PARSE_OK)
         return res == seqan::ArgumentParser::PARSE_ERROR;
 
-    // Initialize random number generators.  We need two so mason_variator and mason_materializer can yield the same
-    // result.
+    // Initialize random number generator for distributing the variations to the contigs.
     TRng rng(options.seed);
-    TRng methRng(options.seed);
 
     std::cerr << "MASON VARIATOR\n"
               << "==============\n\n";
@@ -1988,7 +2076,7 @@ int main(int argc, char const ** argv)
     std::cerr << "\n__SIMULATION__________________________________________________________________\n"
               << "\n";
 
-    MasonVariatorApp app(rng, methRng, faiIndex, options);
+    MasonVariatorApp app(rng, faiIndex, options);
     app.run();
 
     std::cerr << "\nDONE.\n";
@@ -47,6 +47,7 @@
 
 #include "mason_options.h"
 #include "methylation_levels.h"
+#include "genomic_variants.h"
 
 // ============================================================================
 // Forwards
@@ -62,7 +63,8 @@ class Roche454Model;
 typedef seqan::Dna5String TRead;
 typedef seqan::CharString TQualities;
 typedef seqan::Rng<seqan::MersenneTwister> TRng;
-typedef seqan::Infix<seqan::Dna5String const>::Type TFragment;
+// Fragments are taken from journaled haplotypes, see TJournaledHaplotype.
+typedef seqan::Infix<TJournaledHaplotype const>::Type TFragment;
 typedef seqan::String<seqan::CigarElement<> > TCigarString;
 
 // ----------------------------------------------------------------------------
@@ -163,6 +165,8 @@ public:
 
     // Buffer for the materialization of BS-seq treated fragments.
     seqan::Dna5String methFrag;
+    // Journaled sequence with methFrag as the host, for passing methFrag as a TFragment.
+    TJournaledHaplotype methFragJournal;
 
     SequencingSimulator(TRng & rng, TRng & methRng, SequencingOptions const & _options) :
             rng(rng), methRng(methRng), seqOptions(&_options)
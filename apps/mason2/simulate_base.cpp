@@ -74,8 +74,9 @@ void SequencingSimulator::simulatePairedEnd(TRead & seqL, TQualities & qualsL, S
         if (seqOptions->bsSeqOptions.bsProtocol != BSSeqOptions::DIRECTIONAL)
             bsForward = (pickRandomNumber(methRng, seqan::Pdf<seqan::Uniform<int> >(0, 1)) == 1);
         _simulateBSTreatment(methFrag, frag, *levels, !bsForward);
+        setHost(methFragJournal, methFrag);
         _simulatePairedEnd(seqL, qualsL, infoL, seqR, qualsR, infoR,
-                           infix(methFrag, 0, length(methFrag)), isForward);
+                           infix(methFragJournal, 0, length(methFragJournal)), isForward);
     }
 }
 
@@ -106,7 +107,8 @@ void SequencingSimulator::simulateSingleEnd(TRead & seq, TQualities & quals, Seq
         if (seqOptions->bsSeqOptions.bsProtocol != BSSeqOptions::DIRECTIONAL)
             bsForward = (pickRandomNumber(methRng, seqan::Pdf<seqan::Uniform<int> >(0, 1)) == 1);
         _simulateBSTreatment(methFrag, frag, *levels, !bsForward);
-        _simulateSingleEnd(seq, quals, info, infix(methFrag, 0, length(methFrag)), isForward);
+        setHost(methFragJournal, methFrag);
+        _simulateSingleEnd(seq, quals, info, infix(methFragJournal, 0, length(methFragJournal)), isForward);
     }
 }
 
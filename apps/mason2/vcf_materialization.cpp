@@ -246,7 +246,7 @@ bool VcfMaterializer::materializeNext(seqan::Dna5String & seq,
                                       int & rID,
                                       int & haplotype)
 {
-    return _materializeNext(seq, 0, varInfos, breakpoints, rID, haplotype);
+    return _materializeNext(&seq, 0, 0, varInfos, breakpoints, rID, haplotype);
 }
 
 bool VcfMaterializer::materializeNext(seqan::Dna5String & seq,
@@ -256,14 +256,34 @@ bool VcfMaterializer::materializeNext(seqan::Dna5String & seq,
                                       int & rID,
                                       int & haplotype)
 {
-    return _materializeNext(seq, &levels, varInfos, breakpoints, rID, haplotype);
+    return _materializeNext(&seq, 0, &levels, varInfos, breakpoints, rID, haplotype);
+}
+
+bool VcfMaterializer::materializeNext(TJournaledHaplotype & seq,
+                                      std::vector<SmallVarInfo> & varInfos,
+                                      std::vector<std::pair<int, int> > & breakpoints,
+                                      int & rID,
+                                      int & haplotype)
+{
+    return _materializeNext(0, &seq, 0, varInfos, breakpoints, rID, haplotype);
+}
+
+bool VcfMaterializer::materializeNext(TJournaledHaplotype & seq,
+                                      MethylationLevels & levels,
+                                      std::vector<SmallVarInfo> & varInfos,
+                                      std::vector<std::pair<int, int> > & breakpoints,
+                                      int & rID,
+                                      int & haplotype)
+{
+    return _materializeNext(0, &seq, &levels, varInfos, breakpoints, rID, haplotype);
 }
 
 // ----------------------------------------------------------------------------
 // Function VcfMaterializer::_materializeNext()
 // ----------------------------------------------------------------------------
 
-bool VcfMaterializer::_materializeNext(seqan::Dna5String & seq,
+bool VcfMaterializer::_materializeNext(seqan::Dna5String * seq,
+                                       TJournaledHaplotype * journaledSeq,
                                        MethylationLevels * levels,
                                        std::vector<SmallVarInfo> & varInfos,
                                        std::vector<std::pair<int, int> > & breakpoints,
@@ -279,23 +299,22 @@ bool VcfMaterializer::_materializeNext(seqan::Dna5String & seq,
             return false;
         currRID += 1;
         rID = currRID;
-        readSequence(seq, faiIndex, currRID);
+        if (seq)
+        {
+            readSequence(*seq, faiIndex, currRID);
+        }
+        else
+        {
+            readSequence(contigSeq, faiIndex, currRID);
+            setHost(*journaledSeq, contigSeq);
+        }
         if (levels && !empty(methFastaFileName))
         {
             _loadLevels(currRID);
             swap(*levels, currentLevels);
         }
 
-        // Build identity PositionMap.
-        TJournalEntries journal;
-        reinit(journal, length(seq));
-        posMap.reinit(journal);
-        GenomicInterval gi(0, length(seq), 0, length(seq));
-        seqan::String<PositionMap::TInterval> intervals;
-        appendValue(intervals, PositionMap::TInterval(gi.svBeginPos, gi.svEndPos, gi));
-        createIntervalTree(posMap.svIntervalTree, intervals);
-        createIntervalTree(posMap.svIntervalTreeSTL, intervals);
-
+        _buildIdentityPosMap(posMap, seq ? length(*seq) : length(contigSeq));
         return true;
     }
 
@@ -320,10 +339,14 @@ bool VcfMaterializer::_materializeNext(seqan::Dna5String & seq,
 
     // Materialize variants for the current haplotype.
     VariantMaterializer varMat(rng, contigVariants, *methOptions);
-    if (levels)
-        varMat.run(seq, posMap, *levels, varInfos, breakpoints, contigSeq, currentLevels, nextHaplotype);
+    if (seq && levels)
+        varMat.run(*seq, posMap, *levels, varInfos, breakpoints, contigSeq, currentLevels, nextHaplotype);
+    else if (seq)
+        varMat.run(*seq, posMap, varInfos, breakpoints, contigSeq, nextHaplotype);
+    else if (levels)
+        varMat.run(*journaledSeq, posMap, *levels, varInfos, breakpoints, contigSeq, currentLevels, nextHaplotype);
     else
-        varMat.run(seq, posMap, varInfos, breakpoints, contigSeq, nextHaplotype);
+        varMat.run(*journaledSeq, posMap, varInfos, breakpoints, contigSeq, nextHaplotype);
 
     // Write out rID and haploty
     rID = currRID;
@@ -331,6 +354,81 @@ bool VcfMaterializer::_materializeNext(seqan::Dna5String & seq,
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// Function VcfMaterializer::loadNextContig()
+// ----------------------------------------------------------------------------
+
+bool VcfMaterializer::loadNextContig(int & rID)
+{
+    int numContigs = empty(vcfFileName) ? (int)numSeqs(faiIndex) : (int)length(contigNames(context(vcfFileIn)));
+    if (currRID >= numContigs - 1)
+        return false;
+
+    currRID += 1;
+    if (!empty(vcfFileName))
+        _loadVariantsForContig(contigVariants, currRID);
+    else
+        contigVariants.clear();
+    readSequence(contigSeq, faiIndex, currRID);
+    if (!empty(methFastaFileName))
+        _loadLevels(currRID);
+
+    // All haplotypes of the contig are materialized through materializeHaplotype().
+    nextHaplotype = numHaplotypes;
+    rID = currRID;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function VcfMaterializer::materializeHaplotype()
+// ----------------------------------------------------------------------------
+
+void VcfMaterializer::materializeHaplotype(TJournaledHaplotype & seq,
+                                           PositionMap & posMap,
+                                           MethylationLevels * levels,
+                                           std::vector<SmallVarInfo> & varInfos,
+                                           std::vector<std::pair<int, int> > & breakpoints,
+                                           TRng & rng,
+                                           int hID) const
+{
+    if (levels)
+        SEQAN_CHECK(!empty(methFastaFileName), "Must initialize with methylation FASTA file for levels");
+
+    if (empty(vcfFileName))
+    {
+        // Without variants, the haplotype is the reference itself.  The host is not modified through the journal.
+        setHost(seq, const_cast<seqan::Dna5String &>(contigSeq));
+        if (levels)
+            *levels = currentLevels;
+        varInfos.clear();
+        breakpoints.clear();
+        _buildIdentityPosMap(posMap, length(seq));
+        return;
+    }
+
+    VariantMaterializer varMat(rng, contigVariants, *methOptions);
+    if (levels)
+        varMat.run(seq, posMap, *levels, varInfos, breakpoints, contigSeq, currentLevels, hID);
+    else
+        varMat.run(seq, posMap, varInfos, breakpoints, contigSeq, hID);
+}
+
+// ----------------------------------------------------------------------------
+// Function VcfMaterializer::_buildIdentityPosMap()
+// ----------------------------------------------------------------------------
+
+void VcfMaterializer::_buildIdentityPosMap(PositionMap & posMap, unsigned contigLength)
+{
+    TJournalEntries journal;
+    reinit(journal, contigLength);
+    posMap.reinit(journal);
+    GenomicInterval gi(0, contigLength, 0, contigLength);
+    seqan::String<PositionMap::TInterval> intervals;
+    appendValue(intervals, PositionMap::TInterval(gi.svBeginPos, gi.svEndPos, gi));
+    createIntervalTree(posMap.svIntervalTree, intervals);
+    createIntervalTree(posMap.svIntervalTreeSTL, intervals);
+}
+
 // ----------------------------------------------------------------------------
 // Function VcfMaterializer::_loadVariantsForContig()
 // ----------------------------------------------------------------------------
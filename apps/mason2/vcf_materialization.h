@@ -153,9 +153,45 @@ public:
                          std::vector<std::pair<int, int> > & breakpoints,
                          int & rID, int & haplotype);
 
+    // Similar to the ones above but the haplotype is built as a journal with contigSeq as the host.  seq is valid
+    // until the next contig is loaded.
+    bool materializeNext(TJournaledHaplotype & seq,
+                         std::vector<SmallVarInfo> & varInfos,
+                         std::vector<std::pair<int, int> > & breakpoints,
+                         int & rID, int & haplotype);
+
+    bool materializeNext(TJournaledHaplotype & seq,
+                         MethylationLevels & levels,
+                         std::vector<SmallVarInfo> & varInfos,
+                         std::vector<std::pair<int, int> > & breakpoints,
+                         int & rID, int & haplotype);
+
+    // Load the variants, reference sequence, and (if methFastaFileName is set) methylation levels of the next contig
+    // into contigVariants, contigSeq, and currentLevels.  Writes the contig's index to rID, returns false if there are
+    // no more contigs.  Afterwards, the haplotypes of the contig can be built with materializeHaplotype().
+    //
+    // Call init() before calling loadNextContig(), do not mix with materializeNext().
+    //
+    // Throws: MasonIOException
+    bool loadNextContig(int & rID);
+
+    // Materialize haplotype hID of the contig loaded by loadNextContig() as a journal with contigSeq as the host.
+    //
+    // This does not modify the VcfMaterializer and takes its own PositionMap and random number generator, such that
+    // the haplotypes of one contig can be materialized in parallel.  Pass levels == 0 if no methylation levels are to
+    // be built.  seq is valid until the next contig is loaded.
+    void materializeHaplotype(TJournaledHaplotype & seq,
+                              PositionMap & posMap,
+                              MethylationLevels * levels,
+                              std::vector<SmallVarInfo> & varInfos,
+                              std::vector<std::pair<int, int> > & breakpoints,
+                              TRng & rng,
+                              int hID) const;
+
 private:
 
-    bool _materializeNext(seqan::Dna5String & seq, MethylationLevels * levels,
+    // Exactly one of seq and journaledSeq is set.
+    bool _materializeNext(seqan::Dna5String * seq, TJournaledHaplotype * journaledSeq, MethylationLevels * levels,
                           std::vector<SmallVarInfo> & varInfos,
                           std::vector<std::pair<int, int> > & breakpoints,
                           int & rID, int & haplotype);
@@ -171,6 +207,9 @@ private:
 
     // Load the levels for the contig with the given rID.
     void _loadLevels(int rID);
+
+    // Build identity PositionMap for a contig of the given length into posMap.
+    static void _buildIdentityPosMap(PositionMap & posMap, unsigned contigLength);
 };
 
 // ============================================================================
@@ -528,8 +528,11 @@ int dumpMatches(
         }
 
     // how many 0's should be padded?
+    __uint64 readCount = length(store.readSeqStore);
+    if (options.readBlockSize != 0)     // the store holds only the current read block
+        readCount = sum(options.readLengths);
     int pzeros = 0;
-    for (unsigned l = length(store.readSeqStore); l > 9; l = l / 10)
+    for (__uint64 l = readCount; l > 9; l = l / 10)
         ++pzeros;
 
     int gzeros = 0;
@@ -553,11 +556,26 @@ int dumpMatches(
         scoreType.data_mismatch = -1;
     resize(rows(align), 2);
 
+    // in read block mode, the matches of all but the first block are appended
+    bool appendOutput = (options.readIdOffset != 0);
+    std::ofstream appendFile;
+    if (appendOutput && !isEqual(options.output, "-"))
+    {
+        appendFile.open(toCString(options.output), std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+        if (!appendFile.is_open())
+        {
+            std::cerr << "Failed to open output file" << std::endl;
+            return false;
+        }
+    }
+
     VirtualStream<char, Output> file;
     if (options.outputFormat != 4)   // not SAM
     {
         bool success;
-        if (!isEqual(options.output, "-"))
+        if (appendFile.is_open())
+            success = open(file, appendFile, Nothing());
+        else if (!isEqual(options.output, "-"))
             success = open(file, toCString(options.output));
         else
             success = open(file, std::cout, Nothing());
@@ -599,6 +617,10 @@ int dumpMatches(
     String<int> libSize;    // store outer library size for each pair match (indexed by pairMatchId)
     calculateInsertSizes(libSize, store);
 
+    // in read block mode, the pair match ids of a block follow those of the previous blocks
+    __uint64 pairMatchIdOffset = options.pairMatchIdOffset;
+    options.pairMatchIdOffset += length(libSize);
+
 #ifdef RAZERS_PROFILE
     timelineBeginTask(TASK_SORT);
 #endif  // #ifdef RAZERS_PROFILE
@@ -693,7 +715,7 @@ int dumpMatches(
                 case 1:
                     append(line, readName);
                     appendValue(line, '#');
-                    sprintf(intBuf, "%09u", ar.readId + 1);
+                    sprintf(intBuf, "%09u", (unsigned)(options.readIdOffset + ar.readId + 1));
                     append(line, intBuf);
                     //file.fill('0');
                     //file << readName << '#' << std::setw(pzeros) << ar.readId + 1;
@@ -755,7 +777,7 @@ int dumpMatches(
                 if (ar.pairMatchId != TAlignedRead::INVALID_ID)
                 {
                     appendValue(line, _sep_);
-                    appendNumber(line, ar.pairMatchId);
+                    appendNumber(line, pairMatchIdOffset + ar.pairMatchId);
                     appendValue(line, _sep_);
                     appendNumber(line, (int)store.alignQualityStore[ar.id].pairScore);
                     appendValue(line, _sep_);
@@ -835,7 +857,7 @@ int dumpMatches(
             assign(fastaID, store.readNameStore[(*it).readId]);
 
             std::string id = fastaID;
-            int fragId = (*it).readId;
+            int fragId = options.readIdOffset + (*it).readId;
             bool appendMatchId = options.maxHits > 1;
 
             size_t left = fastaID.find_first_of('[');
@@ -902,7 +924,7 @@ int dumpMatches(
             // 1..filename is the read filename + seqNo
             case 1:
                 file.fill('0');
-                file << readName << '#' << std::setw(pzeros) << it->readId + 1  << _sep_;
+                file << readName << '#' << std::setw(pzeros) << options.readIdOffset + it->readId + 1  << _sep_;
                 break;
             }
 
@@ -1173,7 +1195,9 @@ int dumpMatches(
             BamFileOut bamFile;
 
             bool success;
-            if (!isEqual(options.output, "-"))
+            if (appendFile.is_open())
+                success = open(bamFile, appendFile, Sam());
+            else if (!isEqual(options.output, "-"))
                 success = open(bamFile, toCString(options.output));
             else
                 success = open(bamFile, std::cout, Sam());
@@ -1201,7 +1225,8 @@ int dumpMatches(
             }
 
             // write header to file.
-            writeRecord(bamFile, header);
+            if (!appendOutput)
+                writeRecord(bamFile, header);
 
             // 2. write aligments
             if (options.dontShrinkAlignments)
@@ -1234,7 +1259,7 @@ int dumpMatches(
     if (!empty(options.mismatchFilename))
     {
         std::ofstream mismatchFile;
-        mismatchFile.open(toCString(options.mismatchFilename), std::ios_base::out | std::ios_base::trunc);
+        mismatchFile.open(toCString(options.mismatchFilename), std::ios_base::out | (appendOutput ? std::ios_base::app : std::ios_base::trunc));
         if (mismatchFile.is_open())
             writeMismatchFile(mismatchFile, store, options);
         else
@@ -179,8 +179,37 @@ int mapReads(
     // Step 1: Load reads
     SEQAN_PROTIMESTART(load_time);
 
+    SeqFileIn mateFile;     // right mates file (read block mode)
+    if (options.readBlockSize != 0)
+    {
+        // In read block mode, we only collect the read statistics now and rewind
+        // the read files.  The reads are loaded block by block in step 3.
+        bool success;
+#ifdef RAZERS_MATEPAIRS
+        if (length(readFileNames) == 2)
+            success = open(mateFile, toCString(readFileNames[1])) &&
+                      scanReadStatistics(store, options.readFile, mateFile, options);
+        else
+#endif
+        success = scanReadStatistics(store, options.readFile, options);
+
+        close(options.readFile);
+        success = success && open(options.readFile, toCString(readFileNames[0]));
 #ifdef RAZERS_MATEPAIRS
-    if (length(readFileNames) == 2)
+        if (length(readFileNames) == 2)
+        {
+            close(mateFile);
+            success = success && open(mateFile, toCString(readFileNames[1]));
+        }
+#endif
+        if (!success)
+        {
+            cerr << "Failed to load reads" << endl;
+            return RAZERS_READS_FAILED;
+        }
+    }
+#ifdef RAZERS_MATEPAIRS
+    else if (length(readFileNames) == 2)
     {
         if (!loadReads(store, options.readFile, toCString(readFileNames[1]), options))
         {
@@ -199,7 +228,7 @@ int mapReads(
         }
     }
 
-    if (options._debugLevel >= 1)
+    if (options._debugLevel >= 1 && options.readBlockSize == 0)
         cerr << lengthSum(store.readSeqStore) << " bps of " << length(store.readSeqStore) << " reads loaded." << endl;
     options.timeLoadFiles = SEQAN_PROTIMEDIFF(load_time);
 
@@ -232,33 +261,72 @@ int mapReads(
     //////////////////////////////////////////////////////////////////////////////
     // Step 3: Find matches using SWIFT
     loadContigs(store, genomeFileNames, false); // add filenames to the contig store (they are loaded on-demand)
-    int error = _mapReads(store, stats, (RazerSCoreOptions<TSpec>&)options);
-    if (error != 0)
+
+    // In read block mode, steps 3 and 4 are repeated for every block of reads.
+    // The contigs are shared between all blocks.
+    __int64 compactThresh = options.compactThresh;
+    unsigned maxHits = options.maxHits;     // dumpMatches changes it for the Eland format
+    options.readIdOffset = 0;
+    options.pairMatchIdOffset = 0;
+    do
     {
-        switch (error)
+        if (options.readBlockSize != 0)
         {
-        case RAZERS_GENOME_FAILED:
-            cerr << "Failed to load genomes" << endl;
-            break;
+            clearReads(store);
+            clear(store.matePairStore);
+            clear(store.alignedReadStore);
+            clear(store.alignQualityStore);
+            clear(stats);
 
-        case RAZERS_INVALID_SHAPE:
-            cerr << "Invalid Shape" << endl;
-            break;
+            bool success;
+#ifdef RAZERS_MATEPAIRS
+            if (length(readFileNames) == 2)
+                success = loadReadBlock(store, options.readFile, mateFile, options);
+            else
+#endif
+            success = loadReadBlock(store, options.readFile, options);
+            if (!success)
+                break;
+
+            // map each block with the same options, mate-pair match ids are unique across blocks
+            options.compactThresh = compactThresh;
+            options.maxHits = maxHits;
+
+            if (options._debugLevel >= 1)
+                cerr << endl << "Mapping block of " << length(store.readSeqStore) << " reads starting at read " << options.readIdOffset + 1 << endl;
         }
-        return error;
-    }
 
-    //////////////////////////////////////////////////////////////////////////////
-    // Step 4: Remove duplicates and output matches
+        int error = _mapReads(store, stats, (RazerSCoreOptions<TSpec>&)options);
+        if (error != 0)
+        {
+            switch (error)
+            {
+            case RAZERS_GENOME_FAILED:
+                cerr << "Failed to load genomes" << endl;
+                break;
+
+            case RAZERS_INVALID_SHAPE:
+                cerr << "Invalid Shape" << endl;
+                break;
+            }
+            return error;
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        // Step 4: Remove duplicates and output matches
 #ifdef RAZERS_PROFILE
-    timelineBeginTask(TASK_DUMP_MATCHES);
+        timelineBeginTask(TASK_DUMP_MATCHES);
 #endif  // #ifdef RAZERS_PROFILE
-    if (!options.spec.DONT_DUMP_RESULTS)
-        dumpMatches(store, stats, readFileNames[0], options);
+        if (!options.spec.DONT_DUMP_RESULTS)
+            dumpMatches(store, stats, readFileNames[0], options);
 #ifdef RAZERS_PROFILE
-    timelineEndTask(TASK_DUMP_MATCHES);
+        timelineEndTask(TASK_DUMP_MATCHES);
 #endif  // #ifdef RAZERS_PROFILE
 
+        options.readIdOffset += length(store.readSeqStore);
+    }
+    while (options.readBlockSize != 0);
+
     return 0;
 }
 
@@ -449,6 +517,8 @@ void setUpArgumentParser(ArgumentParser & parser, RazerSOptions<> & options, Par
     setMinValue(parser, "no-compact-frac", "0");
     setMaxValue(parser, "no-compact-frac", "1");
     setDefaultValue(parser, "no-compact-frac", options.noCompactFrac);
+    addOption(parser, ArgParseOption("rbs", "read-block-size", "Map reads in blocks of this many reads (or mate-pairs) to limit the memory consumption. The genome is scanned once per block. Requires a read file (not stdin), read number sort order, and no GFF, BAM or AFG output. Default: map all reads at once.", ArgParseOption::INTEGER));
+    setMinValue(parser, "read-block-size", "1");
 
 #ifdef _OPENMP
     addSection(parser, "Parallelism Options");
@@ -574,6 +644,7 @@ extractOptions(
     getOptionValue(options.positionFormat, parser, "position-format");
     getOptionValue(options.compactMult, parser, "compact-mult");
     getOptionValue(options.noCompactFrac, parser, "no-compact-frac");
+    getOptionValue(options.readBlockSize, parser, "read-block-size");
     getOptionValue(options.dontShrinkAlignments, parser, "dont-shrink-alignments");
     getOptionValue(options.computeGlobal, parser, "global-alignment");
     getOptionValue(options.shape, parser, "shape");
@@ -709,6 +780,19 @@ extractOptions(
             cerr << "Warning: Shape should contain at least 7 and at most " << maxOnes << " '1's" << endl;
         options.delta = ones + zeros;
     }
+    if (options.readBlockSize != 0)
+    {
+        // blocks are read twice and their matches are written one after another
+        for (unsigned i = 0; i < length(readFileNames); ++i)
+            if (readFileNames[i] == "-" && (stop = true))
+                cerr << "Read blocks can't be used when reading from stdin" << endl;
+        if (options.sortOrder != 0 && (stop = true))
+            cerr << "Read blocks can only be used with sort order 0" << endl;
+        if ((options.outputFormat == 3 || options.outputFormat == 5 || endsWith(tmp, ".bam")) && (stop = true))
+            cerr << "Read blocks can't be used for GFF, BAM or AFG output" << endl;
+        if (!empty(options.errorPrbFileName) && (stop = true))
+            cerr << "Read blocks can't be used together with an error distribution file" << endl;
+    }
     if (getArgumentValueCount(parser, 1) == 1)
         options.libraryLength = -1;     // only 1 readset -> disable mate-pair mapping
     if ((getArgumentValueCount(parser, 1) > maxReadFiles) && (stop = true))
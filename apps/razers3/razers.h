@@ -256,6 +256,9 @@ struct RazerSCoreOptions
     double      noCompactFrac;          // If in last noCompactFrac of genome, don't compact.
     double      compactMult;            // Multiplicator for compaction threshold.
     __int64     compactThresh;          // compact match array if larger than compactThresh
+    unsigned    readBlockSize;          // map reads in blocks of this many reads/mate-pairs (0..all at once)
+    __uint64    readIdOffset;           // number of reads mapped in previous read blocks
+    __uint64    pairMatchIdOffset;      // number of pair matches output in previous read blocks
 
     // multi-threading
 
@@ -335,6 +338,9 @@ struct RazerSCoreOptions
         compactMult = 2.2;
         compactThresh = 1024;
         // compactThresh = 40;
+        readBlockSize = 0;
+        readIdOffset = 0;
+        pairMatchIdOffset = 0;
 
         absMaxQualSumErrors = 100;      // maximum for sum of mism qualities in total readlength
         lowMemory = false;          // set maximum shape weight to 13 to limit size of q-gram index
@@ -664,16 +670,19 @@ int getGenomeFileNameList(CharString filename, StringSet<CharString> & genomeFil
 }
 
 //////////////////////////////////////////////////////////////////////////////
-// Load multi-Fasta sequences with or w/o quality values
-template <typename TFSSpec, typename TFSConfig, typename TRazerSOptions>
-bool loadReads(
+// Load at most maxReads multi-Fasta sequences with or w/o quality values
+// and count read lengths and quality values
+template <typename TFSSpec, typename TFSConfig, typename TReadLengths, typename TQualSum, typename TRazerSOptions>
+unsigned _loadReads(
     FragmentStore<TFSSpec, TFSConfig> & store,
 	SeqFileIn &seqFile,
-    TRazerSOptions & options)
+    TReadLengths & readLengths,
+    TQualSum & qualSum,
+    TRazerSOptions & options,
+    __uint64 maxReads)
 {
     bool countN = !(options.matchN || options.outputFormat == 1);
 
-    String<__uint64> qualSum;
     String<Dna5Q>    seq;
     CharString       qual;
     CharString       seqId;
@@ -681,7 +690,7 @@ bool loadReads(
     unsigned seqCount = 0;
     unsigned kickoutcount = 0;
 
-    while (!atEnd(seqFile))
+    while (!atEnd(seqFile) && seqCount < maxReads)
     {
         readRecord(seqId, seq, qual, seqFile);
         ++seqCount;
@@ -726,9 +735,9 @@ bool loadReads(
         if (length(qualSum) <= len)
         {
             resize(qualSum, len, 0u);
-            resize(options.readLengths, len + 1, 0u);
+            resize(readLengths, len + 1, 0u);
         }
-        ++options.readLengths[len];
+        ++readLengths[len];
 
         for (unsigned i = 0; i < len; ++i)
             qualSum[i] += getQualityValue(seq[i]);
@@ -739,6 +748,17 @@ bool loadReads(
     shrinkToFit(store.readSeqStore.concat);
     shrinkToFit(store.readSeqStore.limits);
 
+    if (options._debugLevel > 1 && kickoutcount > 0)
+        std::cerr << "Ignoring " << kickoutcount << " low quality reads.\n";
+
+    return seqCount;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Compute the average quality profile and error probabilities
+template <typename TQualSum, typename TRazerSOptions>
+void _computeReadQualities(TQualSum const & qualSum, TRazerSOptions & options)
+{
     // compute error probabilities
     resize(options.avrgQuality, length(qualSum));
     unsigned coverage = 0;
@@ -749,6 +769,20 @@ bool loadReads(
         options.avrgQuality[i] = (double)qualSum[i] / (double)coverage;
     }
     estimateErrorDistributionFromQualities(options);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Load multi-Fasta sequences with or w/o quality values
+template <typename TFSSpec, typename TFSConfig, typename TRazerSOptions>
+bool loadReads(
+    FragmentStore<TFSSpec, TFSConfig> & store,
+	SeqFileIn &seqFile,
+    TRazerSOptions & options)
+{
+    String<__uint64> qualSum;
+    unsigned seqCount = _loadReads(store, seqFile, options.readLengths, qualSum, options, MaxValue<__uint64>::VALUE);
+
+    _computeReadQualities(qualSum, options);
 
     typedef Shape<Dna, SimpleShape> TShape;
     typedef typename SAValue<Index<StringSet<Dna5String>, IndexQGram<TShape, OpenAddressing> > >::Type TSAValue;
@@ -767,9 +801,6 @@ bool loadReads(
         seqCount = 0;
     }
 
-    if (options._debugLevel > 1 && kickoutcount > 0)
-        std::cerr << "Ignoring " << kickoutcount << " low quality reads.\n";
-
     if (options._debugLevel > 1)
     {
         std::cerr << std::endl;
@@ -811,6 +842,44 @@ bool loadReads(
     return seqCount > 0;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Collect read length and quality statistics of all reads without keeping
+// the reads (read block mode needs them in advance to configure the filter)
+template <typename TFSSpec, typename TFSConfig, typename TRazerSOptions>
+bool scanReadStatistics(
+    FragmentStore<TFSSpec, TFSConfig> & store,
+	SeqFileIn &seqFile,
+    TRazerSOptions & options)
+{
+    String<__uint64> qualSum;
+    __uint64 seqCount = 0;
+
+    while (!atEnd(seqFile))
+    {
+        clearReads(store);
+        seqCount += _loadReads(store, seqFile, options.readLengths, qualSum, options, options.readBlockSize);
+    }
+    clearReads(store);
+
+    _computeReadQualities(qualSum, options);
+    return seqCount > 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Load the next block of at most readBlockSize reads
+template <typename TFSSpec, typename TFSConfig, typename TRazerSOptions>
+bool loadReadBlock(
+    FragmentStore<TFSSpec, TFSConfig> & store,
+	SeqFileIn &seqFile,
+    TRazerSOptions & options)
+{
+    // the statistics of all reads were already collected by scanReadStatistics
+    String<unsigned> readLengths;
+    String<__uint64> qualSum;
+
+    return _loadReads(store, seqFile, readLengths, qualSum, options, options.readBlockSize) > 0;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 // Read the first sequence of a multi-sequence file
 // and return its length
@@ -2775,6 +2844,23 @@ unsigned estimatePigeonholeLosses(TEstLosses & estLosses, TDelta const & delta,
     return overlap;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// In read block mode the q-gram index contains only the current block. Use the
+// step size of the whole read set to apply the same filter to all blocks.
+template <typename TIndex, typename TPigeonholeSpec, typename TOptions>
+void _applyReadBlockStepSize(Pattern<TIndex, Pigeonhole<TPigeonholeSpec> > & filterPattern, TOptions const & options)
+{
+    if (options.readBlockSize == 0 || filterPattern.params.delta != 0)
+        return;
+
+    String<unsigned> delta;
+    computeQGramLengths(delta, options);
+
+    unsigned ol = filterPattern.params.overlap;
+    if (ol < length(delta) && delta[ol] != MaxValue<unsigned>::VALUE)
+        filterPattern.params.delta = delta[ol];
+}
+
 template <typename TIndex, typename TPigeonholeSpec, typename TOptions>
 void _applyFilterOptions(Pattern<TIndex, Pigeonhole<TPigeonholeSpec> > & filterPattern, TOptions const & options)
 {
@@ -2782,6 +2868,7 @@ void _applyFilterOptions(Pattern<TIndex, Pigeonhole<TPigeonholeSpec> > & filterP
     {
         filterPattern.params.delta = options.delta;
         filterPattern.params.overlap = options.overlap;
+        _applyReadBlockStepSize(filterPattern, options);
         _patternInit(filterPattern, options.errorRate);
 
         if (options._debugLevel >= 2)
@@ -2821,6 +2908,7 @@ void _applyFilterOptions(Pattern<TIndex, Pigeonhole<TPigeonholeSpec> > & filterP
             }
 
         filterPattern.params.overlap = estimatePigeonholeLosses(estLosses, delta, options);
+        _applyReadBlockStepSize(filterPattern, options);
         _patternInit(filterPattern, options.errorRate);
 
         if (options._debugLevel >= 2)
@@ -2884,6 +2972,7 @@ void _applyFilterOptions(Pattern<TIndex, Pigeonhole<TPigeonholeSpec> > & filterP
     {
         // lossless filtration
         filterPattern.params.overlap = 0;
+        _applyReadBlockStepSize(filterPattern, options);
     }
 
 }
@@ -105,38 +105,27 @@ inline bool _qgramDisableBuckets(Index<TMPReadSet, IndexQGram<TShape> > & index)
 #endif
 
 //////////////////////////////////////////////////////////////////////////////
-// Load multi-Fasta sequences
-template <typename TFSSpec, typename TFSConfig, typename TRazerSOptions>
-bool loadReads(
+// Load at most maxPairs mate-pairs and count read lengths and quality values
+template <typename TFSSpec, typename TFSConfig, typename TReadLengths, typename TQualSum, typename TRazerSOptions>
+unsigned _loadReads(
     FragmentStore<TFSSpec, TFSConfig>   & store,
 	SeqFileIn                           & leftMates,        // left mates file
-    const char                          * fileNameR,        // right mates file
-    TRazerSOptions & options)
+	SeqFileIn                           & rightMates,       // right mates file
+    TReadLengths                        & readLengths,
+    TQualSum                            & qualSum,
+    TRazerSOptions & options,
+    __uint64 maxPairs)
 {
     bool countN = !(options.matchN || options.outputFormat == 1);
 
-    SeqFileIn rightMates;
-
-    bool success;
-    if (!isEqual(fileNameR, "-"))
-        success = open(rightMates, fileNameR);
-    else
-        success = open(rightMates, std::cin);
-
-    if (!success)
-        return false;
-
-
-    String<__uint64>    qualSum;
     String<Dna5Q>       seq[2];
     CharString          qual[2];
     CharString          seqId[2];
 
     unsigned seqCount = 0;
     unsigned kickoutcount = 0;
-    unsigned maxReadLength = 0;
 
-	while (!atEnd(leftMates) && !atEnd(rightMates))
+	while (!atEnd(leftMates) && !atEnd(rightMates) && seqCount < maxPairs)
     {
         ++seqCount;
         
@@ -197,18 +186,14 @@ bool loadReads(
             if (length(qualSum) <= len)
             {
                 resize(qualSum, len, 0u);
-                resize(options.readLengths, len + 1, 0u);
+                resize(readLengths, len + 1, 0u);
             }
-            ++options.readLengths[len];
+            ++readLengths[len];
 
             for (unsigned i = 0; i < len; ++i)
                 qualSum[i] += getQualityValue(seq[j][i]);
         }
         appendMatePair(store, seq[0], seq[1], seqId[0], seqId[1]);
-        if (maxReadLength < length(seq[0]))
-            maxReadLength = length(seq[0]);
-        if (maxReadLength < length(seq[1]))
-            maxReadLength = length(seq[1]);
     }
 
 
@@ -217,7 +202,7 @@ bool loadReads(
         if (options._debugLevel > 1)
         {
             std::cerr << "Warning: Unexpected end in one of both paired-end files.\n";
-            return false;
+            return 0;
 
         }
     }
@@ -227,16 +212,35 @@ bool loadReads(
     shrinkToFit(store.readSeqStore.concat);
     shrinkToFit(store.readSeqStore.limits);
 
-    // compute error probabilities
-    resize(options.avrgQuality, length(qualSum));
-    unsigned coverage = 0;
-    for (unsigned i = length(qualSum); i != 0; )
-    {
-        coverage += options.readLengths[i];
-        --i;
-        options.avrgQuality[i] = (double)qualSum[i] / (double)coverage;
-    }
-    estimateErrorDistributionFromQualities(options);
+    if (options._debugLevel > 1 && kickoutcount > 0)
+        std::cerr << "Ignoring " << kickoutcount << " low quality mate-pairs.\n";
+    return seqCount;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// Load multi-Fasta sequences
+template <typename TFSSpec, typename TFSConfig, typename TRazerSOptions>
+bool loadReads(
+    FragmentStore<TFSSpec, TFSConfig>   & store,
+	SeqFileIn                           & leftMates,        // left mates file
+    const char                          * fileNameR,        // right mates file
+    TRazerSOptions & options)
+{
+    SeqFileIn rightMates;
+
+    bool success;
+    if (!isEqual(fileNameR, "-"))
+        success = open(rightMates, fileNameR);
+    else
+        success = open(rightMates, std::cin);
+
+    if (!success)
+        return false;
+
+    String<__uint64> qualSum;
+    unsigned seqCount = _loadReads(store, leftMates, rightMates, options.readLengths, qualSum, options, MaxValue<__uint64>::VALUE);
+
+    _computeReadQualities(qualSum, options);
 
     typedef Shape<Dna, SimpleShape> TShape;
     typedef typename SAValue<Index<StringSet<Dna5String>, IndexQGram<TShape, OpenAddressing> > >::Type TSAValue;
@@ -249,17 +253,59 @@ bool loadReads(
         std::cerr << "Maximal read number of " << (unsigned)sa.i1 + 1 << " exceeded. Please remove \"#define RAZERS_MEMOPT\" in razers.cpp and recompile." << std::endl;
         seqCount = 0;
     }
-    if ((unsigned)sa.i2 < maxReadLength - 1)
+    if ((unsigned)sa.i2 < length(options.readLengths) - 2)
     {
         std::cerr << "Maximal read length of " << (unsigned)sa.i2 + 1 << " bps exceeded. Please remove \"#define RAZERS_MEMOPT\" in razers.cpp and recompile." << std::endl;
         seqCount = 0;
     }
+    return seqCount > 0;
+}
 
-    if (options._debugLevel > 1 && kickoutcount > 0)
-        std::cerr << "Ignoring " << kickoutcount << " low quality mate-pairs.\n";
+//////////////////////////////////////////////////////////////////////////////
+// Collect read length and quality statistics of all mate-pairs without
+// keeping them (read block mode needs them in advance to configure the filter)
+template <typename TFSSpec, typename TFSConfig, typename TRazerSOptions>
+bool scanReadStatistics(
+    FragmentStore<TFSSpec, TFSConfig>   & store,
+	SeqFileIn                           & leftMates,        // left mates file
+	SeqFileIn                           & rightMates,       // right mates file
+    TRazerSOptions & options)
+{
+    String<__uint64> qualSum;
+    __uint64 seqCount = 0;
+
+    while (!atEnd(leftMates) && !atEnd(rightMates))
+    {
+        clearReads(store);
+        clear(store.matePairStore);
+        unsigned count = _loadReads(store, leftMates, rightMates, options.readLengths, qualSum, options, options.readBlockSize);
+        if (count == 0)
+            return false;
+        seqCount += count;
+    }
+    clearReads(store);
+    clear(store.matePairStore);
+
+    _computeReadQualities(qualSum, options);
     return seqCount > 0;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+// Load the next block of at most readBlockSize mate-pairs
+template <typename TFSSpec, typename TFSConfig, typename TRazerSOptions>
+bool loadReadBlock(
+    FragmentStore<TFSSpec, TFSConfig>   & store,
+	SeqFileIn                           & leftMates,        // left mates file
+	SeqFileIn                           & rightMates,       // right mates file
+    TRazerSOptions & options)
+{
+    // the statistics of all mate-pairs were already collected by scanReadStatistics
+    String<unsigned> readLengths;
+    String<__uint64> qualSum;
+
+    return _loadReads(store, leftMates, rightMates, readLengths, qualSum, options, options.readBlockSize) > 0;
+}
+
 template <typename TFragmentStore>
 struct LessPairScore :
     public std::binary_function<
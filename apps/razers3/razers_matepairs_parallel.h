@@ -1145,7 +1145,7 @@ void _mapMatePairReadsParallel(
     // -----------------------------------------------------------------------
     // Perform filtration.
     // -----------------------------------------------------------------------
-    TaskQueue<TVerificationJob, OmpLock> taskQueue;
+    WorkStealingPool<TVerificationJob> taskPool(options.threadCount);
     volatile unsigned leaderWindowsDone = 0;  // Number of windows done in leaders.
     volatile unsigned threadsFiltering = options.threadCount;
 
@@ -1281,7 +1281,8 @@ void _mapMatePairReadsParallel(
                     appendValue(jobs, TVerificationJob(tls.threadId, tls.verificationResults, store, contigId, orientation, previousLeftHits, previousLeftHitsSplitters[i], previousLeftHitsSplitters[i + 1], leftHits, leftHitsSplitters[i], leftHitsSplitters[i + 1], rightHits, rightHitsSplitters[i], rightHitsSplitters[i + 1], rightWindowBegin, *tls.globalOptions, tls.filterPatternL, tls.filterPatternR));
                 }
 
-                pushFront(taskQueue, jobs);
+                for (unsigned i = 0; i < length(jobs); ++i)
+                    pushTask(taskPool, tls.threadId, jobs[i]);
             }
             tls.options.timeFiltration += sysTime() - filterStart;
 #ifdef RAZERS_PROFILE
@@ -1292,7 +1293,7 @@ void _mapMatePairReadsParallel(
             while (leaderWindowsDone == windowsDone)
             {
                 TVerificationJob job;
-                if (!popFront(job, taskQueue))
+                if (!popTask(job, taskPool, tls.threadId))
                     break;
                 workVerification(tls, job, splitters);
             }
@@ -1323,10 +1324,10 @@ void _mapMatePairReadsParallel(
         threadsFiltering -= 1;
 
         // Continue to try to help verify.
-        while (threadsFiltering > 0u)
+        while (threadsFiltering > 0u || !empty(taskPool))
         {
             TVerificationJob job;
-            if (popFront(job, taskQueue))
+            if (popTask(job, taskPool, tls.threadId))
                 workVerification(tls, job, splitters);
         }
 
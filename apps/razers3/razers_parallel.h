@@ -33,19 +33,30 @@ public:
 template <typename TMatches>
 struct SingleVerificationResult
 {
-    std::shared_ptr<TMatches> matches;
+    std::shared_ptr<TMatches> matches;     // NULL if the job of the result was split, one more result will follow
     unsigned hitGroupId;
     unsigned windowNo;
+    unsigned hitBegin;
 
     SingleVerificationResult() :
-        hitGroupId(0), windowNo(0)
+        hitGroupId(0), windowNo(0), hitBegin(0)
     {}
 
-    SingleVerificationResult(std::shared_ptr<TMatches> & matches_, unsigned hitGroupId_, unsigned windowNo_) :
-        matches(matches_), hitGroupId(hitGroupId_), windowNo(windowNo_)
+    SingleVerificationResult(std::shared_ptr<TMatches> & matches_, unsigned hitGroupId_, unsigned windowNo_, unsigned hitBegin_) :
+        matches(matches_), hitGroupId(hitGroupId_), windowNo(windowNo_), hitBegin(hitBegin_)
     {}
 };
 
+// Orders the verification results of one window by their first SWIFT hit.
+template <typename TMatches>
+struct LessSingleVerificationResult
+{
+    bool operator()(SingleVerificationResult<TMatches> const & a, SingleVerificationResult<TMatches> const & b) const
+    {
+        return a.hitBegin < b.hitBegin;
+    }
+};
+
 // Stores the results of the verification.
 //
 // Put into its own class so it can be locked independently of other class
@@ -303,7 +314,7 @@ void workVerification(ThreadLocalStorage<MapSingleReads<TMatches, TFragmentStore
 //         std::cerr << "length(*localMatches) == " << length(*localMatches) << std::endl;
 //     }
 
-    appendToVerificationResults(*job.verificationResults, SingleVerificationResult<TMatches>(localMatches, job.hitGroupId, job.windowNo));
+    appendToVerificationResults(*job.verificationResults, SingleVerificationResult<TMatches>(localMatches, job.hitGroupId, job.windowNo, job.hitBegin));
     tls.options.timeVerification += sysTime() - start;
 
 #ifdef RAZERS_PROFILE
@@ -342,7 +353,13 @@ writeBackToLocal(ThreadLocalStorage<MapSingleReads<TMatches, TFragmentStore, TFi
         // verificationHits[i].windowNo;
 // SEQAN_OMP_PRAGMA(critical)
 //         std::cerr << "thread " << omp_get_thread_num() << " got (" << verificationHits[i].windowNo << ", " << verificationHits[i].hitGroupId << ")" << std::endl;
-        tls.verificationResultBuckets[verificationHits[i].windowNo][verificationHits[i].hitGroupId] = verificationHits[i];
+        if (!verificationHits[i].matches)
+        {
+            // A job was split, the results of both parts will follow.
+            tls.missingInBucket[verificationHits[i].windowNo] += 1;
+            continue;
+        }
+        appendValue(tls.verificationResultBuckets[verificationHits[i].windowNo], verificationHits[i]);
         tls.missingInBucket[verificationHits[i].windowNo] -= 1;
 // SEQAN_OMP_PRAGMA(critical)
 //         std::cerr << "thread " << omp_get_thread_num() << " {windowNo == " << verificationHits[i].windowNo << "--(" << tls.missingInBucket[verificationHits[i].windowNo] << ")}" << std::endl;
@@ -363,6 +380,8 @@ writeBackToLocal(ThreadLocalStorage<MapSingleReads<TMatches, TFragmentStore, TFi
         // (2 a) Compute new size, reserve memory, copy data.
         size_t originalSize = length(tls.matches);
         unsigned idx = tls.nextBucketToWriteBack;
+        std::sort(begin(tls.verificationResultBuckets[idx], Standard()), end(tls.verificationResultBuckets[idx], Standard()),
+                  LessSingleVerificationResult<TMatches>());
 // SEQAN_OMP_PRAGMA(critical)
 //         std::cerr << "\n";
         for (unsigned i = 0; i < length(tls.verificationResultBuckets[idx]); ++i)
@@ -470,13 +489,15 @@ writeBackToLocal(ThreadLocalStorage<MapSingleReads<TMatches, TFragmentStore, TFi
     }
 #else  // #ifdef RAZERS_DEFER_COMPACTION
     for (unsigned i = 0; i < length(verificationHits); ++i)
-        newSize += length(*verificationHits[i].matches);
+        if (verificationHits[i].matches)
+            newSize += length(*verificationHits[i].matches);
 
     reserve(tls.matches, newSize);
 
     // Write back all matches from verification to the block local store.
     for (unsigned i = 0; i < length(verificationHits); ++i)
-        append(tls.matches, *verificationHits[i].matches);
+        if (verificationHits[i].matches)
+            append(tls.matches, *verificationHits[i].matches);
 
     // Possibly compact matches.
     if (!dontCompact && length(tls.matches) > tls.options.compactThresh)
@@ -527,13 +548,47 @@ void clearLocalMatches(String<SingleVerificationResult<TMatches> > & localMatche
     clear(localMatches);
 }
 
+// Pops a verification job from the task pool.
+//
+// If other threads are idle and the own deque ran dry, the job is split in
+// halves and the second half is pushed to the own deque where it can be
+// stolen.  The owner of the job is notified first, s.t. it waits for the
+// results of both halves.
+template <typename TMatches, typename TFragmentStore, typename THitString, typename TOptions, typename TFilterPattern>
+inline bool
+popVerificationJob(Job<SingleVerification<TMatches, TFragmentStore, THitString, TOptions, TFilterPattern> > & job,
+                   WorkStealingPool<Job<SingleVerification<TMatches, TFragmentStore, THitString, TOptions, TFilterPattern> > > & taskPool,
+                   unsigned threadId,
+                   TOptions const & options)
+{
+    typedef Job<SingleVerification<TMatches, TFragmentStore, THitString, TOptions, TFilterPattern> > TJob;
+
+    if (!popTask(job, taskPool, threadId))
+        return false;
+
+    unsigned minSize = _max(1u, options.verificationPackageSize / 4);
+    if (job.hitEnd - job.hitBegin >= 2 * minSize && idleThreads(taskPool) > 0u && empty(*taskPool.deques[threadId]))
+    {
+        SingleVerificationResult<TMatches> splitNotice;
+        splitNotice.windowNo = job.windowNo;
+        appendToVerificationResults(*job.verificationResults, splitNotice);
+
+        TJob secondHalf = job;
+        secondHalf.hitBegin = job.hitEnd = job.hitBegin + (job.hitEnd - job.hitBegin) / 2;
+        pushTask(taskPool, threadId, secondHalf);
+    }
+    return true;
+}
+
 // Find read matches in one genome sequence.
 //
 // The parallelization is simple.  We perform the filtering window-wise.
 // Then, we generate verification jobs from the swift hits.  The SWIFT hits
 // are distributed by a simple static load balancing of adjacent hits.  These
 // are then processed by all "leading" threads, where leading threads are
-// those with the largest number of processed windows.
+// those with the largest number of processed windows.  Each thread pushes its
+// jobs to its own deque of a work-stealing pool, idle threads steal the oldest
+// jobs of other threads.
 template <
     typename TFSSpec,
     typename TFSConfig,
@@ -625,7 +680,7 @@ void _mapSingleReadsParallelToContig(
     // -----------------------------------------------------------------------
     // Perform filtration.
     // -----------------------------------------------------------------------
-    TaskQueue<TVerificationJob, OmpLock> taskQueue;
+    WorkStealingPool<TVerificationJob> taskPool(options.threadCount);
     volatile unsigned leaderWindowsDone = 0;  // Number of windows done in leaders.
     volatile unsigned threadsFiltering = options.threadCount;
 
@@ -712,23 +767,18 @@ void _mapSingleReadsParallelToContig(
                 unsigned packageCount = tls.options.maxVerificationPackageCount * omp_get_max_threads();
                 computeSplittersBySlotSize(splitters, length(hits), tls.options.verificationPackageSize, packageCount);
 
-                // Push verification jobs to the job queue.
-                String<TVerificationJob> jobs;
-                reserve(jobs, length(splitters) - 1);
+                // Preallocate space in bucket and initialize "to do" counter.
+                clear(tls.verificationResultBuckets[windowsDone - 1]);
+                reserve(tls.verificationResultBuckets[windowsDone - 1], length(splitters) - 1);
+                tls.missingInBucket[windowsDone - 1] = length(splitters) - 1;
+
+                // Push verification jobs to the own deque of the task pool.
                 for (unsigned i = 1; i < length(splitters); ++i)
                 {
 // SEQAN_OMP_PRAGMA(critical)
-//                     std::cerr << "\n";
-                    appendValue(jobs, TVerificationJob(tls.threadId, tls.verificationResults, store, contigId, windowsDone - 1, hitsPtr, i - 1, splitters[i - 1], splitters[i], *tls.globalOptions, tls.filterPattern));
-// SEQAN_OMP_PRAGMA(critical)
 //                     std::cerr << "new job(" << tls.threadId << ", tls.verificationResults, store, " << contigId << ", " << windowsDone - 1 << ", hitsPtr, " << i - 1 << ", " << splitters[i - 1] << ", " << splitters[i] << ", *tls.globalOptions, tls.filterPattern)" << std::endl;
+                    pushTask(taskPool, tls.threadId, TVerificationJob(tls.threadId, tls.verificationResults, store, contigId, windowsDone - 1, hitsPtr, i - 1, splitters[i - 1], splitters[i], *tls.globalOptions, tls.filterPattern));
                 }
-                pushFront(taskQueue, jobs);
-
-                // Preallocate space in bucket and initialize "to do" counter.
-                clear(tls.verificationResultBuckets[windowsDone - 1]);
-                resize(tls.verificationResultBuckets[windowsDone - 1], length(splitters) - 1);
-                tls.missingInBucket[windowsDone - 1] = length(splitters) - 1;
                 // for (unsigned i = 0; i < length(splitters) - 1; ++i)
                 //     tls.missingInBucket[windowsDone - 1] -= splitters[i] == splitters[i + 1];
             }
@@ -745,7 +795,7 @@ void _mapSingleReadsParallelToContig(
             while (leaderWindowsDone == windowsDone)
             {
                 TVerificationJob job;
-                if (!popFront(job, taskQueue))
+                if (!popVerificationJob(job, taskPool, tls.threadId, tls.options))
                     break;
                 // fprintf(stderr, "[verify]");
                 workVerification(tls, job, splitters);
@@ -779,10 +829,10 @@ void _mapSingleReadsParallelToContig(
         threadsFiltering -= 1;
 
         // Continue to try to help verify.
-        while (threadsFiltering > 0u)
+        while (threadsFiltering > 0u || !empty(taskPool))
         {
             TVerificationJob job;
-            if (popFront(job, taskQueue))
+            if (popVerificationJob(job, taskPool, tls.threadId, tls.options))
                 workVerification(tls, job, splitters);
         }
 
@@ -1103,6 +1153,10 @@ int _mapSingleReadsParallel(
         // remove duplicates when mapping with gaps or using pigeonhole filter
         if (IsSameType<TGapMode, RazerSGapped>::VALUE || options.threshold == 0)
             maskDuplicates(threadLocalStorages[omp_get_thread_num()].matches, options, mode);
+#else  // #ifndef RAZERS_DEFER_COMPACTION
+        // in read block mode, remove the duplicates left by the incremental masking of the (small) blocks
+        if (options.readBlockSize != 0 && (IsSameType<TGapMode, RazerSGapped>::VALUE || options.threshold == 0))
+            maskDuplicates(threadLocalStorages[omp_get_thread_num()].matches, options, mode);
 #endif  // #ifndef RAZERS_DEFER_COMPACTION
         Nothing nothing;
         // std::cerr << "BEFORE FINAL COMPACTION " << length(threadLocalStorages[omp_get_thread_num()].matches) << std::endl;
@@ -101,6 +101,19 @@ def main(source_base, binary_base, num_threads=1):
                       ph.outFile('se-adeno-reads%d_1-tc%d.stdout' % (rl, num_threads)))])
         conf_list.append(conf)
 
+        # Map in read blocks, the output must equal the one of mapping all reads at once.
+        conf = app_tests.TestConf(
+            program=path_to_program,
+            redir_stdout=ph.outFile('se-adeno-reads%d_1-rbs-tc%d.stdout' % (rl, num_threads)),
+            args=['-tc', str(num_threads),
+                  '-rbs', '37',
+                  ph.inFile('adeno-genome.fa'),
+                  ph.inFile('adeno-reads%d_1.fa' % rl),
+                  '-o', ph.outFile('se-adeno-reads%d_1-rbs-tc%d.razers' % (rl, num_threads))],
+            to_diff=[(ph.inFile('se-adeno-reads%d_1-tc%d.razers' % (rl, num_threads)),
+                      ph.outFile('se-adeno-reads%d_1-rbs-tc%d.razers' % (rl, num_threads)))])
+        conf_list.append(conf)
+
         # Allow indels.
         conf = app_tests.TestConf(
             program=path_to_program,
@@ -208,6 +221,21 @@ def main(source_base, binary_base, num_threads=1):
                       ph.outFile('pe-adeno-reads%d_2-tc%d.stdout' % (rl, num_threads)))])
         conf_list.append(conf)
 
+        # Map in read blocks, the output must equal the one of mapping all mate-pairs at once.
+        conf = app_tests.TestConf(
+            program=path_to_program,
+            redir_stdout=ph.outFile('pe-adeno-reads%d_2-rbs-tc%d.stdout' % (rl, num_threads)),
+            args=['-tc', str(num_threads),
+                  '-rbs', '37',
+                  ph.inFile('adeno-genome.fa'),
+                  ph.inFile('adeno-reads%d_1.fa' % rl),
+                  ph.inFile('adeno-reads%d_2.fa' % rl),
+                  '-o', ph.outFile('pe-adeno-reads%d_2-rbs-tc%d.razers' % (rl, num_threads))],
+            to_diff=[(ph.inFile('pe-adeno-reads%d_2-tc%d.razers' % (rl, num_threads)),
+                      ph.outFile('pe-adeno-reads%d_2-rbs-tc%d.razers' % (rl, num_threads)),
+                      razers_transforms)])
+        conf_list.append(conf)
+
         # Allow indels.
         conf = app_tests.TestConf(
             program=path_to_program,
@@ -576,6 +576,42 @@ void execute(DbFinder<TText, TIndex, TDbQuerySpec, TDelegate, TSpec> & dbFinder)
         _find(finderApx, dbFinder, StageInitial_());
         clear(finderApx);
     }
+
+    flush(dbFinder.verifier, dbFinder.delegate);
+}
+
+// ----------------------------------------------------------------------------
+// Function _findParallel()                                [DbFinder<Parallel>]
+// ----------------------------------------------------------------------------
+// Each thread starts with a contiguous range of seeds, idle threads steal the
+// remaining seeds of the others.
+
+template <typename TText, typename TIndex, typename TDbQuerySpec, typename TDelegate, typename TFinders>
+void _findParallel(DbFinder<TText, TIndex, TDbQuerySpec, TDelegate, Parallel> & dbFinder, TFinders & finders)
+{
+    unsigned threadsCount = omp_get_max_threads();
+    unsigned findersCount = length(finders);
+    WorkStealingPool<unsigned> pool(threadsCount);
+
+    SEQAN_OMP_PRAGMA(parallel num_threads(threadsCount))
+    {
+        unsigned threadId = omp_get_thread_num();
+        unsigned seedsBegin = (__uint64)findersCount * threadId / threadsCount;
+        unsigned seedsEnd = (__uint64)findersCount * (threadId + 1) / threadsCount;
+
+        // The owner takes its seeds from the back, so push them in reverse order.
+        for (unsigned finderId = seedsEnd; finderId > seedsBegin; --finderId)
+            pushTask(pool, threadId, finderId - 1);
+
+        SEQAN_OMP_PRAGMA(barrier)
+
+        unsigned finderId;
+        while (popTask(finderId, pool, threadId))
+        {
+            _find(finders[finderId], dbFinder, StageInitial_());
+            clear(finders[finderId]);
+        }
+    }
 }
 
 // ----------------------------------------------------------------------------
@@ -587,12 +623,8 @@ void execute(DbFinder<TText, TIndex, TDbQuerySpec, TDelegate, Parallel> & dbFind
 {
     typedef Backtracking<EditDistance, Top>                                     TBacktrackingApx;
     typedef Backtracking<HammingDistance, Top>                                  TBacktrackingExt;
-    typedef Backtracking<EditDistance, Bottom>                                  TBacktrackingApxBottom;
-    typedef Backtracking<HammingDistance, Bottom>                               TBacktrackingExtBottom;
     typedef Finder_<TIndex, TIndex, TBacktrackingApx>                           TFinderApx;
     typedef Finder_<TIndex, TIndex, TBacktrackingExt>                           TFinderExt;
-    typedef Finder_<TIndex, TIndex, TBacktrackingApxBottom>                     TFinderApxBottom;
-    typedef Finder_<TIndex, TIndex, TBacktrackingExtBottom>                     TFinderExtBottom;
     typedef typename TextIterator_<TIndex, TIndex, TBacktrackingApx>::Type      TTextIterator;
     typedef typename PatternIterator_<TIndex, TIndex, TBacktrackingApx>::Type   TPatternIterator;
 
@@ -639,21 +671,10 @@ void execute(DbFinder<TText, TIndex, TDbQuerySpec, TDelegate, Parallel> & dbFind
     std::cout << "Ext jobs count:\t\t\t\t" << findersExtCount << std::endl;
     std::cout << "Apx jobs count:\t\t\t\t" << findersApxCount << std::endl;
 
-    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
-    for (int finderExt = 0; finderExt < (int)findersExtCount; ++finderExt)
-    {
-        TFinderExtBottom & finderBottom = dbFinder.findersExt[finderExt];
-        _find(finderBottom, dbFinder, StageInitial_());
-        clear(finderBottom);
-    }
+    _findParallel(dbFinder, dbFinder.findersExt);
+    _findParallel(dbFinder, dbFinder.findersApx);
 
-    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
-    for (int finderApx = 0; finderApx < (int)findersApxCount; ++finderApx)
-    {
-        TFinderApxBottom & finderBottom = dbFinder.findersApx[finderApx];
-        _find(finderBottom, dbFinder, StageInitial_());
-        clear(finderBottom);
-    }
+    flush(dbFinder.verifier, dbFinder.delegate);
 }
 
 // ----------------------------------------------------------------------------
@@ -793,6 +814,7 @@ void execute(DbFinder<TText, TIndex, TDbQuerySpec, TDelegate, Online> & dbFinder
     for (TDbSSize dbId1 = 0; dbId1 < dbSize; ++dbId1)
         for (TDbSSize dbId2 = dbId1 + 1; dbId2 < dbQuerySize; ++dbId2)
             dbFinder.verifier(dbId1, dbId2, dbFinder.delegate);
+    flush(dbFinder.verifier, dbFinder.delegate);
 }
 
 template <typename TText, typename TIndex, typename TDelegate>
@@ -812,6 +834,7 @@ void execute(DbFinder<TText, TIndex, Query, TDelegate, Online> & dbFinder)
     for (TDbSSize dbId = 0; dbId < dbSize; ++dbId)
         for (TDbQuerySSize queryId = 0; queryId < dbQuerySize; ++queryId)
             dbFinder.verifier(dbId, queryId, dbFinder.delegate);
+    flush(dbFinder.verifier, dbFinder.delegate);
 }
 
 #endif  // #ifndef SANDBOX_ESIRAGUSA_APPS_SEARCHJOIN_DBFINDER_H_
@@ -40,6 +40,7 @@
 #include <seqan/basic.h>
 #include <seqan/sequence.h>
 #include <seqan/find.h>
+#include <seqan/parallel.h>
 
 using namespace seqan;
 
@@ -47,6 +48,29 @@ using namespace seqan;
 // Tags, Classes, Enums
 // ============================================================================
 
+// ----------------------------------------------------------------------------
+// Type VerifierLanes_
+// ----------------------------------------------------------------------------
+// One bit-vector per candidate pair, the compiler maps it to SSE/AVX registers.
+
+typedef __uint64 VerifierWord_;
+typedef VerifierWord_ VerifierLanes_ __attribute__ ((__vector_size__ (32)));
+
+// ----------------------------------------------------------------------------
+// Class VerifierBatch_
+// ----------------------------------------------------------------------------
+
+template <typename TDbSize, typename TDbQuerySize>
+struct VerifierBatch_
+{
+    static const unsigned LANES = sizeof(VerifierLanes_) / sizeof(VerifierWord_);
+    static const unsigned CAPACITY = 64 * LANES;
+
+    typedef String<Pair<TDbSize, TDbQuerySize> >    TCandidates;
+
+    TCandidates     candidates;
+};
+
 // ----------------------------------------------------------------------------
 // Class Verifier
 // ----------------------------------------------------------------------------
@@ -54,28 +78,34 @@ using namespace seqan;
 template <typename TText, typename TSpec = void>
 struct Verifier
 {
-    typedef Db<TText>           TDb;
-    typedef Db<TText, TSpec>    TDbQuery;
+    typedef Db<TText>                                   TDb;
+    typedef Db<TText, TSpec>                            TDbQuery;
+    typedef typename Size<TDb>::Type                    TDbSize;
+    typedef typename Size<TDbQuery>::Type               TDbQuerySize;
+    typedef VerifierBatch_<TDbSize, TDbQuerySize>       TBatch;
 
     TDb /* const */         & db;
     Holder<TDbQuery>        query;
     unsigned long           lengthFilter;
     unsigned long           verifications;
 
+    // Candidate pairs of short strings are collected per thread and verified in batches.
+    String<TBatch>          batches;
+
     Verifier(TDb /* const */ & db) :
         db(db),
         query(),
         lengthFilter(0),
         verifications(0)
-    {}
+    {
+        resize(batches, omp_get_max_threads(), Exact());
+    }
 
     template <typename TDelegate>
-    inline bool
-    operator() (typename Size<TDb>::Type dbId,
-                typename Size<TDbQuery>::Type queryId,
-                TDelegate & delegate)
+    inline void
+    operator() (TDbSize dbId, TDbQuerySize queryId, TDelegate & delegate)
     {
-        return _verify(*this, dbId, queryId, delegate);
+        _verify(*this, dbId, queryId, delegate);
     }
 };
 
@@ -92,20 +122,17 @@ struct Verifier
 // ----------------------------------------------------------------------------
 
 template <typename TText, typename TSpec, typename TDelegate>
-inline bool
+inline void
 _verify(Verifier<TText, TSpec> & verifier,
         typename Size<Db<TText> >::Type dbId,
         typename Size<Db<TText, TSpec> >::Type queryId,
         TDelegate & delegate)
 {
-    //typedef Db<TText> /* const */                           TDb;
-    //typedef typename Size<TDb>::Type                        TDbSize;
+    typedef Verifier<TText, TSpec>                          TVerifier;
+    typedef typename TVerifier::TBatch                      TBatch;
     typedef typename Value<TText>::Type                     TTextReference;
     typedef typename Size<TTextReference>::Type             TTextSize;
     typedef typename Size<TTextReference>::Type             TErrors;
-    //typedef Finder<TTextReference>                          TFinder;
-    //typedef MyersUkkonenGlobalBanded                        TAlgorithmSpec;
-    //typedef PatternState_<TTextReference, TAlgorithmSpec>   TPatternState;
 
     // Get texts from database.
     TTextReference text1 = verifier.db.text[dbId];
@@ -120,7 +147,19 @@ _verify(Verifier<TText, TSpec> & verifier,
         SEQAN_OMP_PRAGMA(atomic)
         verifier.lengthFilter++;
 
-        return false;
+        return;
+    }
+
+    // Queries fitting into a machine word are verified in batches.
+    if (maxErrors > 0 && length2 > 0 && length2 <= BitsPerValue<VerifierWord_>::VALUE)
+    {
+        TBatch & batch = verifier.batches[omp_get_thread_num()];
+        appendValue(batch.candidates, typename Value<typename TBatch::TCandidates>::Type(dbId, queryId));
+
+        if (length(batch.candidates) >= TBatch::CAPACITY)
+            _verifyBatch(verifier, batch, delegate);
+
+        return;
     }
 
     SEQAN_OMP_PRAGMA(atomic)
@@ -129,19 +168,143 @@ _verify(Verifier<TText, TSpec> & verifier,
     if (maxErrors == 0)
     {
         if (text1 != text2)
-            return false;
+            return;
     }
     else
     {
         TErrors errors = _computeEditDistanceBanded(text1, text2, maxErrors);
 
         if (errors > maxErrors)
-            return false;
+            return;
     }
 
     delegate(dbId, queryId);
+}
+
+// ----------------------------------------------------------------------------
+// Function _verifyBatch()                                           [Verifier]
+// ----------------------------------------------------------------------------
+// Computes the edit distances of all candidate pairs in the batch with the
+// bit-parallel algorithm of Myers, one pair per SIMD lane.  The query of each
+// pair is the pattern, lanes whose database text ended keep their state.
+
+template <typename TText, typename TSpec, typename TBatch, typename TDelegate>
+inline void
+_verifyBatch(Verifier<TText, TSpec> & verifier, TBatch & batch, TDelegate & delegate)
+{
+    typedef typename Value<TText>::Type                             TString;
+    typedef typename Value<TString>::Type                           TAlphabet;
+    typedef typename Iterator<TString const, Standard>::Type        TIter;
+    typedef typename Size<TString>::Type                            TTextSize;
+    typedef typename Size<Db<TText> >::Type                         TDbSize;
+    typedef typename Size<Db<TText, TSpec> >::Type                  TDbQuerySize;
+    typedef typename Value<typename TBatch::TCandidates>::Type      TCandidate;
+
+    static const unsigned LANES = TBatch::LANES;
+    static const unsigned SIGMA = ValueSize<TAlphabet>::VALUE;
+
+    unsigned candidatesCount = length(batch.candidates);
 
-    return true;
+    SEQAN_OMP_PRAGMA(atomic)
+    verifier.verifications += candidatesCount;
+
+    VerifierWord_ peq[LANES][SIGMA];
+    for (unsigned lane = 0; lane < LANES; ++lane)
+        for (unsigned c = 0; c < SIGMA; ++c)
+            peq[lane][c] = 0;
+
+    for (unsigned groupBegin = 0; groupBegin < candidatesCount; groupBegin += LANES)
+    {
+        unsigned groupSize = _min(LANES, candidatesCount - groupBegin);
+
+        TIter textIt[LANES];
+        TTextSize textLength[LANES];
+        TTextSize maxTextLength = 0;
+        VerifierLanes_ VP, VN, score, highBit;
+
+        // Initialize the lanes.
+        for (unsigned lane = 0; lane < LANES; ++lane)
+        {
+            textLength[lane] = 0;
+            VP[lane] = ~(VerifierWord_)0;
+            VN[lane] = 0;
+            score[lane] = 0;
+            highBit[lane] = 0;
+
+            if (lane >= groupSize)
+                continue;
+
+            TDbSize dbId = batch.candidates[groupBegin + lane].i1;
+            TDbQuerySize queryId = batch.candidates[groupBegin + lane].i2;
+
+            TIter patternIt = begin(value(verifier.query).text[queryId], Standard());
+            TTextSize patternLength = length(value(verifier.query).text[queryId]);
+            for (TTextSize i = 0; i < patternLength; ++i, ++patternIt)
+                peq[lane][ordValue(*patternIt)] |= (VerifierWord_)1 << i;
+
+            textIt[lane] = begin(verifier.db.text[dbId], Standard());
+            textLength[lane] = length(verifier.db.text[dbId]);
+            maxTextLength = _max(maxTextLength, textLength[lane]);
+            score[lane] = patternLength;
+            highBit[lane] = (VerifierWord_)1 << (patternLength - 1);
+        }
+
+        // Scan the texts column by column.
+        VerifierLanes_ zero = VP ^ VP;
+        for (TTextSize j = 0; j < maxTextLength; ++j)
+        {
+            VerifierLanes_ Eq, active;
+            for (unsigned lane = 0; lane < LANES; ++lane)
+            {
+                bool inText = j < textLength[lane];
+                Eq[lane] = inText ? peq[lane][ordValue(textIt[lane][j])] : 0;
+                active[lane] = inText ? ~(VerifierWord_)0 : 0;
+            }
+
+            VerifierLanes_ Xv = Eq | VN;
+            VerifierLanes_ Xh = (((Eq & VP) + VP) ^ VP) | Eq;
+            VerifierLanes_ Ph = VN | ~(Xh | VP);
+            VerifierLanes_ Mh = VP & Xh;
+
+            score -= (VerifierLanes_)((Ph & highBit) != zero) & active;
+            score += (VerifierLanes_)((Mh & highBit) != zero) & active;
+
+            Ph = (Ph << 1) | 1;
+            Mh <<= 1;
+
+            VP = ((Mh | ~(Xv | Ph)) & active) | (VP & ~active);
+            VN = ((Ph & Xv) & active) | (VN & ~active);
+        }
+
+        // Report the pairs within the error threshold and clear the pattern masks.
+        for (unsigned lane = 0; lane < groupSize; ++lane)
+        {
+            TCandidate candidate = batch.candidates[groupBegin + lane];
+
+            TIter patternIt = begin(value(verifier.query).text[candidate.i2], Standard());
+            TIter patternEnd = end(value(verifier.query).text[candidate.i2], Standard());
+            for (; patternIt != patternEnd; ++patternIt)
+                peq[lane][ordValue(*patternIt)] = 0;
+
+            if (score[lane] <= (VerifierWord_)getErrors(value(verifier.query), candidate.i2))
+                delegate(candidate.i1, candidate.i2);
+        }
+    }
+
+    clear(batch.candidates);
+}
+
+// ----------------------------------------------------------------------------
+// Function flush()                                                  [Verifier]
+// ----------------------------------------------------------------------------
+// Verifies the candidate pairs left in the batches of all threads.
+
+template <typename TText, typename TSpec, typename TDelegate>
+inline void
+flush(Verifier<TText, TSpec> & verifier, TDelegate & delegate)
+{
+    for (unsigned threadId = 0; threadId < length(verifier.batches); ++threadId)
+        _verifyBatch(verifier, verifier.batches[threadId], delegate);
 }
 
 #endif  // #ifndef SEQAN_APPS_SEARCHJOIN_VERIFIER_H_
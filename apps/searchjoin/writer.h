@@ -41,6 +41,7 @@
 #include <seqan/sequence.h>
 #include <seqan/file.h>
 #include <seqan/stream.h>
+#include <seqan/parallel.h>
 
 using namespace seqan;
 
@@ -72,6 +73,8 @@ struct Writer
     typedef std::ofstream                                           TOutputStream;
     typedef typename DirectionIterator<TOutputStream, Output>::Type TOutputIt;
 
+    static const unsigned BUFFER_SIZE = 1 << 16;
+
     TDb const       & db;
     TDbQuery /* const */  & query;
     TOutputStream   outputFile;
@@ -79,13 +82,18 @@ struct Writer
     unsigned long   recordsCount;
     ReadWriteLock   writeLock;
 
+    // Records are collected per thread and written in blocks.
+    String<CharString>  buffers;
+
     Writer(TDb /* const */ & db, TDbQuery /* const */ & query) :
         db(db),
         query(query),
         outputFile(),
         outputIt(),
         recordsCount(0)
-    {}
+    {
+        resize(buffers, omp_get_max_threads(), Exact());
+    }
 
     ~Writer()
     {
@@ -119,6 +127,21 @@ struct Writer<TDb, TDb, Join> : public Writer<TDb, TDb>
 // Functions
 // ============================================================================
 
+// ----------------------------------------------------------------------------
+//  Function _writeBuffer()                                            [Writer]
+// ----------------------------------------------------------------------------
+
+template <typename TDb, typename TDbQuery, typename TSpec>
+inline void
+_writeBuffer(Writer<TDb, TDbQuery, TSpec> & writer, CharString & buffer)
+{
+    lockWriting(writer.writeLock);
+    write(writer.outputIt, buffer);
+    unlockWriting(writer.writeLock);
+
+    clear(buffer);
+}
+
 // ----------------------------------------------------------------------------
 //  Function _writeRecord()                                            [Writer]
 // ----------------------------------------------------------------------------
@@ -127,14 +150,28 @@ template <typename TDb, typename TDbQuery, typename TSpec, typename TString1, ty
 inline void
 _writeRecord(Writer<TDb, TDbQuery, TSpec> & writer, TString1 const & id1, TString2 const & id2)
 {
-    lockWriting(writer.writeLock);
+    CharString & buffer = writer.buffers[omp_get_thread_num()];
 
-    write(writer.outputIt, id1);
-    writeValue(writer.outputIt, ':');
-    write(writer.outputIt, id2);
-    writeValue(writer.outputIt, '\n');
+    append(buffer, id1);
+    appendValue(buffer, ':');
+    append(buffer, id2);
+    appendValue(buffer, '\n');
 
-    unlockWriting(writer.writeLock);
+    if (length(buffer) >= Writer<TDb, TDbQuery, TSpec>::BUFFER_SIZE)
+        _writeBuffer(writer, buffer);
+}
+
+// ----------------------------------------------------------------------------
+//  Function _writeBuffers()                                           [Writer]
+// ----------------------------------------------------------------------------
+
+template <typename TDb, typename TDbQuery, typename TSpec>
+inline void
+_writeBuffers(Writer<TDb, TDbQuery, TSpec> & writer)
+{
+    for (unsigned threadId = 0; threadId < length(writer.buffers); ++threadId)
+        if (!empty(writer.buffers[threadId]))
+            _writeBuffer(writer, writer.buffers[threadId]);
 }
 
 // ----------------------------------------------------------------------------
@@ -181,6 +218,8 @@ inline bool open(Writer<TDb, TDbQuery, TSpec> & writer, TFileName const & fileNa
 template <typename TDb, typename TDbQuery, typename TSpec>
 inline bool close(Writer<TDb, TDbQuery, TSpec> & writer)
 {
+    _writeBuffers(writer);
+
     return close(writer.outputFile);
 }
 
@@ -198,6 +237,8 @@ inline bool close(Writer<TDb, TDb, Join> & writer)
 
     atomicAdd(writer.recordsCount, dbSize);
 
+    _writeBuffers(writer);
+
     return close(writer.outputFile);
 }
 
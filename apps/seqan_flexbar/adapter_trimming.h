@@ -95,6 +95,20 @@ struct User : Mode
 	User (int m, int e): min_length(m), errors(e) {}
 };
 
+//Bit-parallel representation of an adapter with at most 64 bases.
+//Bit i of masks[c] is set if the adapter has nucleotide c at position i,
+//bit i of called is set if position i is not an N.
+struct AdapterMasks
+{
+	__uint64 masks[4];
+	__uint64 called;
+	unsigned length;
+	AdapterMasks() : called(0), length(0)
+	{
+		std::fill(masks, masks + 4, 0u);
+	}
+};
+
 struct AdapterTrimmingStats
 {
 	unsigned a1count, a2count;
@@ -362,6 +376,73 @@ inline bool isMatch(int overlap, int mismatches, const User& userOptions)
 	return overlap >= userOptions.min_length && mismatches <= userOptions.errors;
 }
 
+//Fills the bit masks of an adapter. Returns false if the adapter is too long
+//to fit into a machine word, in which case the DP alignment has to be used.
+template <typename TAdapter>
+bool initAdapterMasks(AdapterMasks& masks, TAdapter& adapter)
+{
+	masks = AdapterMasks();
+	if (length(adapter) > 64u)
+    {
+		return false;
+    }
+	masks.length = length(adapter);
+	for (unsigned i = 0; i < masks.length; ++i)
+	{
+		unsigned c = ordValue(Dna5(value(adapter, i)));
+		if (c < 4)
+		{
+			masks.masks[c] |= (__uint64)1 << i;
+			masks.called |= (__uint64)1 << i;
+		}
+	}
+	return true;
+}
+
+//Ungapped counterpart of alignAdapter() for adapters given as bit masks.
+//The last min(|seq|, |adapter|) bases of the read are encoded like the adapter,
+//so that every overlap of a read suffix with an adapter prefix is scored with
+//a handful of word operations instead of a column of the DP matrix.
+//Gapped alignments can't win, since the gap penalty of -100 exceeds any
+//possible overlap score, and on ties the shortest overlap is chosen like the
+//traceback of alignAdapter() does. Returns the score, the overlap is stored in overlap.
+template <typename TSeq>
+int alignAdapter(unsigned& overlap, TSeq& seq, AdapterMasks const & adapter)
+{
+	unsigned const seqLength = length(seq);
+	unsigned const w = std::min(seqLength, adapter.length);
+	__uint64 readMasks[4] = {0u, 0u, 0u, 0u};
+	__uint64 readCalled = 0u;
+	for (unsigned p = 0; p < w; ++p)
+	{
+		unsigned c = ordValue(Dna5(value(seq, seqLength - w + p)));
+		if (c < 4)
+		{
+			readMasks[c] |= (__uint64)1 << p;
+			readCalled |= (__uint64)1 << p;
+		}
+	}
+	// An overlap of k aligns read bit w-k+i with adapter bit i.
+	int bestScore = 0;
+	overlap = 0;
+	for (unsigned k = 1; k <= w; ++k)
+	{
+		unsigned shift = w - k;
+		__uint64 matches = (readMasks[0] & (adapter.masks[0] << shift)) |
+		                   (readMasks[1] & (adapter.masks[1] << shift)) |
+		                   (readMasks[2] & (adapter.masks[2] << shift)) |
+		                   (readMasks[3] & (adapter.masks[3] << shift));
+		int called = popCount(readCalled & (adapter.called << shift));
+		int score = 2 * (int)popCount(matches) - called;
+		if (score > bestScore)
+		{
+			bestScore = score;
+			overlap = k;
+		}
+	}
+	return bestScore;
+}
+
 template <typename TSeq, typename TAdapter, typename TSpec>
 unsigned stripAdapter(TSeq& seq, TAdapter& adapter, TSpec const & spec)
 {
@@ -381,6 +462,28 @@ unsigned stripAdapter(TSeq& seq, TAdapter& adapter, TSpec const & spec)
 	    return 0;
     }
 }
+//Overload using the bit-parallel adapter representation.
+template <typename TSeq, typename TAdapter, typename TSpec>
+unsigned stripAdapter(TSeq& seq, TAdapter& adapter, AdapterMasks const & masks, TSpec const & spec)
+{
+	// The banded DP never reports an overlap for single-base reads, keep its results there.
+	if (length(seq) < 2)
+    {
+		return stripAdapter(seq, adapter, spec);
+    }
+	unsigned overlap;
+	int score = alignAdapter(overlap, seq, masks);
+	int mismatches = ((int)overlap - score) / 2;
+	if (isMatch(overlap, mismatches, spec))
+	{
+		seqan::erase(seq, length(seq) - overlap, length(seq));
+		return overlap;
+	}
+    else
+    {
+	    return 0;
+    }
+}
 template <typename TSeq, typename TId, typename TAdapter, typename TSpec>
 unsigned stripAdapterBatch(seqan::StringSet<TSeq>& set, seqan::StringSet<TId>& idSet, TAdapter& adapter, TSpec const & spec,
 		AdapterTrimmingStats& stats, bool reverse = false, bool tagOpt = false)
@@ -392,11 +495,22 @@ unsigned stripAdapterBatch(seqan::StringSet<TSeq>& set, seqan::StringSet<TId>& i
 	seqan::String<unsigned> maxOverlap;
 	seqan::resize(minOverlap, t_num, std::numeric_limits<unsigned>::max());
 	seqan::resize(maxOverlap, t_num, 0);
+	// Adapters fitting into a machine word are scored bit-parallel.
+	AdapterMasks masks;
+	bool const useMasks = initAdapterMasks(masks, adapter);
 	int len = length(set);
 	SEQAN_OMP_PRAGMA(parallel for schedule(static) reduction(+:a_count, overlapSum))
 	for (int i=0; i < len; ++i)
 	{
-        unsigned over = stripAdapter(value(set, i), adapter, spec);
+        unsigned over;
+        if (useMasks)
+        {
+            over = stripAdapter(value(set, i), adapter, masks, spec);
+        }
+        else
+        {
+            over = stripAdapter(value(set, i), adapter, spec);
+        }
 		overlapSum += over;
 		a_count += (over != 0);
 		// Thread saves local min/max seen in the batch it processed.
@@ -55,6 +55,7 @@
 #include <seqan/sequence.h>
 #include <seqan/seq_io.h>
 #include <seqan/arg_parse.h>
+#include <seqan/parallel.h>
 
 #ifdef _WIN32
 #include <direct.h>
@@ -1567,6 +1568,263 @@ void postprocessingStage(TSeqSet& seqSet, TIdSet& idSet, TSeqSet& seqSet2, TIdSe
     }    
 }
 
+// PROCESSING PIPELINE ---------------------
+// The reads are processed in blocks. The main thread parses the blocks, a pool of processing
+// threads runs the program stages on them and the block that is next in input order is written
+// by the thread that finished it, so that the output files keep the order of the input.
+
+// A block of reads passed from the parser through a processing thread to the output files.
+struct ReadBatch
+{
+    seqan::String<seqan::StringSet<seqan::CharString> > idSet1, idSet2;
+    seqan::String<seqan::StringSet<Dna5QString> > seqSet1, seqSet2;
+    seqan::String<unsigned> map;    // Maps the groups of the block to their output streams.
+    unsigned readCount;
+    int result;                     // Nonzero if the block couldn't be processed.
+
+    ReadBatch() : readCount(0), result(0) {};
+};
+
+// Parameters and statistics of the program stages. Every processing thread works on its own
+// copy, the statistics are merged after all reads have been processed.
+struct StageParams
+{
+    ProcessingParams processing;
+    DemultiplexingParams demultiplexing;
+    AdapterTrimmingParams adapterTrimming;
+    QualityTrimmingParams qualityTrimming;
+    GeneralStats generalStats;
+    double processTime;
+
+    StageParams() : processTime(0) {};
+};
+
+// Writes the processed blocks in input order. Called by the serializer.
+struct BatchWriter
+{
+    OutputStreams * outputStreams;
+    DemultiplexingParams * demultiplexingParams;
+    ProgramParams * programParams;
+    volatile bool * failed;
+    double writeTime;
+
+    BatchWriter() : outputStreams(NULL), demultiplexingParams(NULL), programParams(NULL), failed(NULL), writeTime(0) {};
+
+    bool operator() (ReadBatch & batch)
+    {
+        // Blocks after a failed one are dropped, like the sequential loop stopped at the first error.
+        if (batch.result != 0)
+            *failed = true;
+        if (*failed)
+            return true;
+
+        SEQAN_PROTIMESTART(writeStart);
+        programParams->readCount += batch.readCount;
+        if (programParams->fileCount == 1)
+        {
+            outputStreams->writeSeqs(batch.idSet1, batch.seqSet1, batch.map, demultiplexingParams->barcodeIds);
+            std::cout << "\r" << programParams->readCount;
+        }
+        else
+        {
+            outputStreams->writeSeqs(batch.idSet1, batch.seqSet1, batch.idSet2, batch.seqSet2, batch.map,
+                                     demultiplexingParams->barcodeIds);
+            std::cout << "\r" << 2*programParams->readCount;
+        }
+        writeTime += SEQAN_PROTIMEDIFF(writeStart);
+        // Always succeed, the serializer stops recycling blocks otherwise.
+        return true;
+    }
+};
+
+typedef seqan::ConcurrentQueue<ReadBatch *, seqan::Suspendable<seqan::Limit> > TBatchQueue;
+typedef seqan::Serializer<ReadBatch, BatchWriter> TBatchSerializer;
+
+// Runs all program stages on one block of reads.
+template <typename TFinder>
+int processBatch(ReadBatch & batch, StageParams & params, TFinder & esaFinder, seqan::ArgumentParser const & parser,
+                 bool tagOpt)
+{
+    clear(batch.map);
+    appendValue(batch.map, 0);
+    if (empty(batch.idSet2))
+    {
+        // Preprocessing and Filtering
+        preprocessingStage(batch.seqSet1[0], batch.idSet1[0], params.demultiplexing, params.processing, parser,
+                           params.generalStats);
+
+        // Demultiplexing
+        if (demultiplexingStage(params.demultiplexing, batch.seqSet1, batch.idSet1, esaFinder, batch.map,
+                                params.generalStats) != 0)
+            return 1;
+
+        // Adapter trimming
+        adapterTrimmingStage(params.adapterTrimming, batch.seqSet1, batch.idSet1, tagOpt);
+
+        // Quality trimming
+        qualityTrimmingStage(params.qualityTrimming, batch.idSet1, batch.seqSet1, tagOpt);
+
+        // Postprocessing
+        postprocessingStage(batch.seqSet1, batch.idSet1, params.processing, params.generalStats);
+    }
+    else
+    {
+        // Generall Processing
+        preprocessingStage(batch.seqSet1[0], batch.idSet1[0], batch.seqSet2[0], batch.idSet2[0],
+                           params.demultiplexing, params.processing, parser, params.generalStats);
+
+        // Demultiplexing.
+        if (demultiplexingStage(params.demultiplexing, batch.seqSet1, batch.seqSet2, batch.idSet1, batch.idSet2,
+                                esaFinder, batch.map, params.generalStats) != 0)
+            return 1;
+
+        // Adapter trimming.
+        adapterTrimmingStage(params.adapterTrimming, batch.seqSet1, batch.idSet1, batch.seqSet2, batch.idSet2,
+                             tagOpt);
+
+        // Quality trimming.
+        qualityTrimmingStage(params.qualityTrimming, batch.idSet1, batch.seqSet1, batch.idSet2, batch.seqSet2,
+                             tagOpt);
+
+        // Postprocessing
+        postprocessingStage(batch.seqSet1, batch.idSet1, batch.seqSet2, batch.idSet2, params.processing,
+                            params.generalStats);
+    }
+    return 0;
+}
+
+// Takes blocks from the queue until the parser has finished, processes them and hands them to the serializer.
+template <typename TFinder>
+struct ProcessingThread
+{
+    TBatchQueue * batchQueue;
+    TBatchSerializer * serializer;
+    StageParams params;
+    TFinder * esaFinder;
+    seqan::ArgumentParser const * parser;
+    bool tagOpt;
+    volatile bool * failed;
+
+    void operator()()
+    {
+        seqan::ScopedReadLock<TBatchQueue> readLock(*batchQueue);
+        // The stages are parallelized with OpenMP themselves, here each thread works on its own block.
+        omp_set_num_threads(1);
+
+        ReadBatch * batch = NULL;
+        while (popFront(batch, *batchQueue))
+        {
+            if (!*failed)
+            {
+                SEQAN_PROTIMESTART(processTime);
+                batch->result = processBatch(*batch, params, *esaFinder, *parser, tagOpt);
+                params.processTime += SEQAN_PROTIMEDIFF(processTime);
+            }
+            releaseValue(*serializer, batch);
+        }
+    }
+};
+
+// Adds the statistics gathered by a processing thread to the global ones.
+void mergeStats(StageParams & target, StageParams const & source)
+{
+    target.generalStats.removedSeqs += source.generalStats.removedSeqs;
+    target.generalStats.uncalledBases += source.generalStats.uncalledBases;
+    target.generalStats.removedSeqsShort += source.generalStats.removedSeqsShort;
+
+    for (unsigned i = 0; i < length(target.demultiplexing.stats.groups); ++i)
+        target.demultiplexing.stats.groups[i] += source.demultiplexing.stats.groups[i];
+
+    AdapterTrimmingStats & adapterStats = target.adapterTrimming.stats;
+    adapterStats.a1count += source.adapterTrimming.stats.a1count;
+    adapterStats.a2count += source.adapterTrimming.stats.a2count;
+    adapterStats.overlapSum += source.adapterTrimming.stats.overlapSum;
+    adapterStats.minOverlap = std::min(adapterStats.minOverlap, source.adapterTrimming.stats.minOverlap);
+    adapterStats.maxOverlap = std::max(adapterStats.maxOverlap, source.adapterTrimming.stats.maxOverlap);
+
+    target.qualityTrimming.stats.dropped_1 += source.qualityTrimming.stats.dropped_1;
+    target.qualityTrimming.stats.dropped_2 += source.qualityTrimming.stats.dropped_2;
+
+    target.processTime += source.processTime;
+}
+
+// Streams all reads through the program stages using threadCount processing threads.
+// At most two blocks per thread are in flight, the parser waits until the oldest one was written.
+template <typename TFinder>
+int processReads(StageParams & stageParams, ProgramParams & programParams, OutputStreams & outputStreams,
+                 TFinder & esaFinder, seqan::ArgumentParser const & parser, unsigned records, unsigned threadCount,
+                 bool tagOpt)
+{
+    unsigned const maxBatches = 2 * threadCount;
+    volatile bool failed = false;
+
+    BatchWriter writer;
+    writer.outputStreams = &outputStreams;
+    writer.demultiplexingParams = &stageParams.demultiplexing;
+    writer.programParams = &programParams;
+    writer.failed = &failed;
+
+    TBatchSerializer serializer(writer, maxBatches);
+    TBatchQueue batchQueue(maxBatches);
+    setReaderWriterCount(batchQueue, threadCount, 1);
+
+    seqan::Thread<ProcessingThread<TFinder> > * threads = new seqan::Thread<ProcessingThread<TFinder> >[threadCount];
+    for (unsigned i = 0; i < threadCount; ++i)
+    {
+        ProcessingThread<TFinder> & worker = threads[i].worker;
+        worker.batchQueue = &batchQueue;
+        worker.serializer = &serializer;
+        worker.params = stageParams;
+        worker.esaFinder = &esaFinder;
+        worker.parser = &parser;
+        worker.tagOpt = tagOpt;
+        worker.failed = &failed;
+        run(threads[i]);
+    }
+
+    double readTime = 0;
+    {
+        seqan::ScopedWriteLock<TBatchQueue> writeLock(batchQueue);
+        bool paired = programParams.fileCount == 2;
+        while (!failed && !(atEnd(programParams.fileStream1) || (paired && atEnd(programParams.fileStream2))))
+        {
+            // Blocks until one of the blocks in flight was written.
+            ReadBatch * batch = aquireValue(serializer);
+            SEQAN_PROTIMESTART(readStart);
+
+            clear(batch->idSet1);
+            clear(batch->seqSet1);
+            clear(batch->idSet2);
+            clear(batch->seqSet2);
+            resize(batch->idSet1, 1);
+            resize(batch->seqSet1, 1);
+            readRecords(batch->idSet1[0], batch->seqSet1[0], programParams.fileStream1, records);
+            if (paired)
+            {
+                resize(batch->idSet2, 1);
+                resize(batch->seqSet2, 1);
+                readRecords(batch->idSet2[0], batch->seqSet2[0], programParams.fileStream2, records);
+            }
+            batch->readCount = length(batch->idSet1[0]);
+            batch->result = 0;
+
+            readTime += SEQAN_PROTIMEDIFF(readStart);
+            appendValue(batchQueue, batch);
+        }
+    }
+
+    for (unsigned i = 0; i < threadCount; ++i)
+        waitFor(threads[i]);
+
+    for (unsigned i = 0; i < threadCount; ++i)
+        mergeStats(stageParams, threads[i].worker.params);
+    delete[] threads;
+    programParams.processTime += stageParams.processTime;
+    programParams.ioTime += readTime + serializer.worker.writeTime;
+
+    return failed;
+}
+
 // END PROGRAM STAGES ---------------------
 void printStatistics(ProgramParams& programParams, GeneralStats& generalStats, DemultiplexingParams& demultiplexParams,
                 AdapterTrimmingParams& adapterParams, QualityTrimmingParams& qualityParams, bool timing)
@@ -1708,7 +1966,8 @@ void printStatistics(ProgramParams& programParams, GeneralStats& generalStats, D
         std::cout << "Min: " << adapterParams.stats.minOverlap << ",  Mean: " << mean
                 << ", Max: " << adapterParams.stats.maxOverlap << "\n\n";
     }
-    // Print processing and IO time. IO is (approx.) the whole loop without the processing part.
+    // Print processing and IO time. Processing time is summed up over all processing threads,
+    // IO is the time spent parsing and writing the reads.
     if (timing)
     {
         std::cout << "Time statistics:\n";
@@ -1728,7 +1987,6 @@ void printStatistics(ProgramParams& programParams, GeneralStats& generalStats, D
 
 int flexbarMain(int argc, char const ** argv)
 {
-    SEQAN_PROTIMESTART(loopTime);
     seqan::ArgumentParser parser = initParser();
 
     // Additional checks
@@ -2115,107 +2373,32 @@ int flexbarMain(int argc, char const ** argv)
     {
         if (!demultiplexingParams.run)
             outputStreams.addStream("", 0, useDefault);
-
-        seqan::String<seqan::StringSet<seqan::CharString> > idSet;
-        seqan::String<seqan::StringSet<Dna5QString> > seqSet;
-
-        while (!atEnd(programParams.fileStream1))
-        {
-            clear(idSet);
-            clear(seqSet);
-
-            appendValue(idSet, seqan::StringSet<seqan::CharString>());
-            appendValue(seqSet, seqan::StringSet<Dna5QString>());
-
-            readRecords(idSet[0], seqSet[0], programParams.fileStream1, records);
-
-            programParams.readCount += length(idSet[0]);
-            SEQAN_PROTIMESTART(processTime);            // START of processing time.
-
-            loadMultiplex(multiplexInFile, demultiplexingParams, records);
-            if (demultiplexingParams.runx)
-                return 1;
-
-            // Preprocessing and Filtering
-            preprocessingStage(seqSet[0], idSet[0], demultiplexingParams, processingParams, parser, generalStats);
-
-            // Demultiplexing
-            if (demultiplexingStage(demultiplexingParams, seqSet, idSet, esaFinder, map, generalStats) != 0)
-                return 1;
-
-            // Adapter trimming
-            adapterTrimmingStage(adapterTrimmingParams, seqSet, idSet, tagOpt);
-
-            // Quality trimming
-            qualityTrimmingStage(qualityTrimmingParams, idSet, seqSet, tagOpt);
-
-            // Postprocessing
-            postprocessingStage(seqSet, idSet, processingParams, generalStats);
-            programParams.processTime += SEQAN_PROTIMEDIFF(processTime);    // END of processing time.
-
-            // Append to output file.
-            outputStreams.writeSeqs(idSet, seqSet, map, demultiplexingParams.barcodeIds);
-            // Information
-            std::cout << "\r" << programParams.readCount;
-        }
-     }
-     else
-     {
+    }
+    else
+    {
         if (!demultiplexingParams.run)
             outputStreams.addStreams("", "", 0, useDefault);
+    }
 
-        seqan::String<seqan::StringSet<seqan::CharString> > idSet1, idSet2;
-        seqan::String<seqan::StringSet<Dna5QString> > seqSet1, seqSet2;
-
-        while (!(atEnd(programParams.fileStream1) || atEnd(programParams.fileStream2)))
-        {
-            clear(idSet1); 
-            clear(idSet2);
-            clear(seqSet1); 
-            clear(seqSet2);
-
-            appendValue(idSet1, seqan::StringSet<seqan::CharString>());
-            appendValue(seqSet1, seqan::StringSet<Dna5QString>());
-            appendValue(idSet2, seqan::StringSet<seqan::CharString>());
-            appendValue(seqSet2, seqan::StringSet<Dna5QString>());
-
-            readRecords(idSet1[0], seqSet1[0], programParams.fileStream1, records);
-            readRecords(idSet2[0], seqSet2[0], programParams.fileStream2, records);
-
-            programParams.readCount += length(idSet1[0]);
-            SEQAN_PROTIMESTART(processTime); // START of processing time.
-
-            loadMultiplex(multiplexInFile, demultiplexingParams , records);
-            if (demultiplexingParams.runx)
-                return 1;
-
-            // Generall Processing
-            preprocessingStage(seqSet1[0], idSet1[0], seqSet2[0], idSet2[0], demultiplexingParams, processingParams,
-                               parser, generalStats);
-
-            // Demultiplexing.
-            if (demultiplexingStage(demultiplexingParams, seqSet1, seqSet2, idSet1, idSet2,
-                                esaFinder, map, generalStats) != 0)
-                return 1;
+    // Demultiplexing with a separate multiplex barcode file is not supported yet.
+    if (demultiplexingParams.runx && !atEnd(programParams.fileStream1))
+        return 1;
 
-            // Adapter trimming.
-            adapterTrimmingStage(adapterTrimmingParams, seqSet1, idSet1, seqSet2, idSet2, tagOpt);
+    StageParams stageParams;
+    stageParams.processing = processingParams;
+    stageParams.demultiplexing = demultiplexingParams;
+    stageParams.adapterTrimming = adapterTrimmingParams;
+    stageParams.qualityTrimming = qualityTrimmingParams;
+    stageParams.generalStats = generalStats;
 
-            // Quality trimming.
-            qualityTrimmingStage(qualityTrimmingParams, idSet1, seqSet1, idSet2, seqSet2, tagOpt);
+    if (processReads(stageParams, programParams, outputStreams, esaFinder, parser, records, threads, tagOpt) != 0)
+        return 1;
 
-            // Postprocessing
-            postprocessingStage(seqSet1, idSet1, seqSet2, idSet2, processingParams, generalStats);
-            programParams.processTime += SEQAN_PROTIMEDIFF(processTime); // END of processing time.
+    generalStats = stageParams.generalStats;
+    demultiplexingParams.stats = stageParams.demultiplexing.stats;
+    adapterTrimmingParams.stats = stageParams.adapterTrimming.stats;
+    qualityTrimmingParams.stats = stageParams.qualityTrimming.stats;
 
-            // Append to output file.
-            outputStreams.writeSeqs(idSet1, seqSet1, idSet2, seqSet2, map, demultiplexingParams.barcodeIds);
-            // Information
-            std::cout << "\r" << 2*programParams.readCount;
-        }
-    }
-    double loop = SEQAN_PROTIMEDIFF(loopTime);
-    programParams.ioTime = loop - programParams.processTime;
 
     printStatistics(programParams, generalStats, demultiplexingParams, adapterTrimmingParams, qualityTrimmingParams, !isSet(parser, "ni"));
 
@@ -213,6 +213,41 @@ SEQAN_DEFINE_TEST(align_adapter_test)
 	SEQAN_ASSERT_EQ(pair.i1, 5u);
 }
 
+SEQAN_DEFINE_TEST(align_adapter_masks_test)
+{
+	typedef seqan::String<seqan::Dna5Q> TSeq;
+	typedef seqan::String<seqan::Dna5> TAda;
+
+	TSeq seq("AAAAAAAAAATTTTT");
+	TAda ada("TTTTTTTTTTT");
+
+	AdapterMasks masks;
+	SEQAN_ASSERT(initAdapterMasks(masks, ada));
+	unsigned overlap = 0;
+	SEQAN_ASSERT_EQ(alignAdapter(overlap, seq, masks), 5);
+	SEQAN_ASSERT_EQ(overlap, 5u);
+
+	// Ties are resolved like the DP alignment: the shortest overlap wins.
+	TSeq seq2("CCCCCCGTAN");
+	TAda ada2("TANGTAC");
+	seqan::Pair<unsigned, seqan::Align<TSeq> > pair;
+	alignAdapter(pair, seq2, ada2);
+	SEQAN_ASSERT(initAdapterMasks(masks, ada2));
+	SEQAN_ASSERT_EQ(alignAdapter(overlap, seq2, masks), (int)pair.i1);
+	SEQAN_ASSERT_EQ(overlap, getOverlap(pair.i2));
+
+	// Adapters longer than a machine word are left to the DP alignment.
+	TAda ada3;
+	resize(ada3, 65, seqan::Dna5('A'));
+	SEQAN_ASSERT_NOT(initAdapterMasks(masks, ada3));
+
+	TSeq seq3("AAAAAAAAAATTTTT");
+	SEQAN_ASSERT(initAdapterMasks(masks, ada));
+	int removed = stripAdapter(seq3, ada, masks, Auto());
+	SEQAN_ASSERT_EQ(removed, 5);
+	SEQAN_ASSERT_EQ(length(seq3), 10u);
+}
+
 SEQAN_DEFINE_TEST(strip_pair_test)
 {
 	typedef seqan::String<seqan::Dna5Q> TSeq;
@@ -242,6 +277,7 @@ SEQAN_BEGIN_TESTSUITE(test_my_app_funcs)
 	SEQAN_CALL_TEST(match_test);
 	SEQAN_CALL_TEST(strip_adapter_test);
 	SEQAN_CALL_TEST(align_adapter_test);
+	SEQAN_CALL_TEST(align_adapter_masks_test);
 	SEQAN_CALL_TEST(strip_pair_test);
 }
 SEQAN_END_TESTSUITE
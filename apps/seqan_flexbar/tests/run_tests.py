@@ -121,6 +121,56 @@ def main(source_base, binary_base):
                   ph.outFile('test_de_multi_unidentified.fq'))])
     conf_list.append(conf)
 
+    # ============================================================
+    # Multiple threads and small read batches.
+    # ============================================================
+
+    # The read counter is printed once per batch, only the final count
+    # is compared.
+    transforms = [
+        app_tests.RegexpReplaceTransform(r'\r[0-9]+(?=\r[0-9])', ''),
+        ]
+
+    conf = app_tests.TestConf(
+        program=path_to_program[2],
+        redir_stdout=ph.outFile('out.stdout'),
+        args=[ph.inFile('testsample.fq'), '-a',
+        ph.inFile('adapter.fa'),
+        '-o', ph.outFile('ar_test_tnum4.fq'), '-ni',
+        '-tnum', '4', '-r', '10'],
+        to_diff=[(ph.inFile('ar_test.stdout'),
+                  ph.outFile('out.stdout'),
+                  transforms),
+                 (ph.inFile('gold_ar_test.fq'),
+                  ph.outFile('ar_test_tnum4.fq'))])
+    conf_list.append(conf)
+
+    conf = app_tests.TestConf(
+        program=path_to_program[3],
+        redir_stdout=ph.outFile('out.stdout'),
+        args=[ph.inFile('testsample_multiplex.fq'), '-b',
+        ph.inFile('barcodes.fa'),
+        '-o', ph.outFile('test_de_multi_tnum4.fq'), '-ni',
+        '-tnum', '4', '-r', '10'],
+        to_diff=[(ph.inFile('gold_de_multi.stdout'),
+                  ph.outFile('out.stdout'),
+                  transforms),
+                 (ph.inFile('gold_de_multi_Sample-1.fq'),
+                  ph.outFile('test_de_multi_tnum4_Sample-1.fq')),
+                 (ph.inFile('gold_de_multi_Sample26.fq'),
+                  ph.outFile('test_de_multi_tnum4_Sample26.fq')),
+                 (ph.inFile('gold_de_multi_Sample-2.fq'),
+                  ph.outFile('test_de_multi_tnum4_Sample-2.fq')),
+                 (ph.inFile('gold_de_multi_Sample0.fq'),
+                  ph.outFile('test_de_multi_tnum4_Sample0.fq')),
+                 (ph.inFile('gold_de_multi_Sample1458.fq'),
+                  ph.outFile('test_de_multi_tnum4_Sample1458.fq')),
+                 (ph.inFile('gold_de_multi_Sample37.fq'),
+                  ph.outFile('test_de_multi_tnum4_Sample37.fq')),
+                 (ph.inFile('gold_de_multi_unidentified.fq'),
+                  ph.outFile('test_de_multi_tnum4_unidentified.fq'))])
+    conf_list.append(conf)
+
     # ============================================================
     # Execute the tests.
     # ============================================================
@@ -227,6 +227,8 @@ _initMsaParams(ArgumentParser& parser, TScore& scMat)
         msaOpt.build = 3;
     else if (optionVal == "wavg")
         msaOpt.build = 4;
+    else if (optionVal == "mbed")
+        msaOpt.build = 5;
 
     // Set alignment evaluation	options
     getOptionValue(msaOpt.infile, parser, "infile");
@@ -408,11 +410,13 @@ _setUpArgumentParser(ArgumentParser & parser)
                     "Method to build the tree. "
                     "Following methods are provided: \\fINeighbor-Joining\\fP (\\fBnj\\fP), \\fIUPGMA single linkage\\fP "
                     "(\\fBmin\\fP), \\fIUPGMA complete linkage\\fP (\\fBmax\\fP), \\fIUPGMA average linkage\\fP "
-                    "(\\fBavg\\fP), \\fIUPGMA weighted average linkage\\fP (\\fBwavg\\fP). "
-                    "\\fINeighbor-Joining\\fP creates an unrooted tree, which we root at the last joined pair.",
+                    "(\\fBavg\\fP), \\fIUPGMA weighted average linkage\\fP (\\fBwavg\\fP), \\fImBed\\fP (\\fBmbed\\fP). "
+                    "\\fINeighbor-Joining\\fP creates an unrooted tree, which we root at the last joined pair. "
+                    "\\fImBed\\fP clusters the sequences by their k-mer distances to a few seed sequences and "
+                    "needs no full distance matrix, use it for large numbers of sequences.",
                     ArgParseArgument::STRING));
     setDefaultValue(parser, "build", "nj");
-    setValidValues(parser, "build", "nj min max avg wavg");
+    setValidValues(parser, "build", "nj min max avg wavg mbed");
 
     addSection(parser, "Alignment Evaluation Options:");
     addOption(
@@ -421,6 +425,18 @@ _setUpArgumentParser(ArgumentParser & parser)
                            ArgParseArgument::INPUT_FILE));
     setValidValues(parser, "infile", getFileExtensions(Fasta()));  // allow only fasta files as input
 
+#ifdef _OPENMP
+    addSection(parser, "Parallelism Options:");
+#endif  // #ifdef _OPENMP
+    addOption(parser, ArgParseOption("tc", "thread-count",
+                                     "Number of threads. The pairwise alignments, the triplet extension and the "
+                                     "progressive alignment of independent subtrees are computed in parallel.",
+                                     ArgParseArgument::INTEGER));
+    setMinValue(parser, "thread-count", "1");
+    setDefaultValue(parser, "thread-count", "1");
+#ifndef _OPENMP
+    hideOption(parser, "tc");
+#endif  // #ifndef _OPENMP
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -449,6 +465,9 @@ int main(int argc, const char *argv [])
     // Basic command line options
     String<char> alphabet;
     getOptionValue(alphabet, parser, "alphabet");
+    unsigned threadCount = 1;
+    getOptionValue(threadCount, parser, "thread-count");
+    omp_set_num_threads(threadCount);
 
     // Initialize scoring matrices
     if (alphabet == "dna")
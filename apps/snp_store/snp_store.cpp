@@ -35,6 +35,7 @@
 #include <seqan/consensus.h>
 #include <seqan/stream.h>
 #include <seqan/bam_io.h>
+#include <seqan/parallel.h>
 
 
 #ifdef PLATFORM_WINDOWS
@@ -199,6 +200,105 @@ copyNextWindowMatchesAndReads(TFragmentStore &fragmentStore,
 }
 
 
+// Output of a single window.  Windows are called in parallel and their output is
+// written to the result files in genomic order afterwards.  is_open() reflects whether
+// the corresponding result file is open, which the dump functions rely on.
+struct WindowOutputBuffer :
+    public std::ostringstream
+{
+    bool fileIsOpen;
+
+    WindowOutputBuffer() : fileIsOpen(false)
+    {}
+
+    bool is_open() const
+    {
+        return fileIsOpen;
+    }
+};
+
+namespace seqan {
+
+template <>
+struct Value<WindowOutputBuffer> :
+    Value<std::ostringstream> {};
+
+template <>
+SEQAN_CONCEPT_IMPL((WindowOutputBuffer), (OutputStreamConcept));
+
+}
+
+// a genomic window whose matches and reads have been parsed and that is ready for calling
+template<typename TFragmentStore, typename TReadCounts, typename TReadClips, typename TReadCigars>
+struct SnpCallingWindow
+{
+    typedef typename TFragmentStore::TContigPos TContigPos;
+
+    TFragmentStore      fragmentStore;
+    TReadCounts         readCounts;
+    TReadClips          readClips;
+    TReadCigars         readCigars;
+
+    unsigned            contigId;
+    TContigPos          startCoord;         // begin of the contig infix stored in fragmentStore
+    TContigPos          windowBegin;
+    TContigPos          windowEnd;
+
+    WindowOutputBuffer  snpOut;
+    WindowOutputBuffer  indelOut;
+};
+
+// call SNPs and indels in one window, output goes to the window buffers
+template<typename TWindow, typename TGenomeNames, typename TOptions>
+void
+callVariantsInWindow(TWindow &window,
+                     TGenomeNames &genomeNames,
+                     TOptions &options)
+{
+    // check for indels
+    if (options.outputIndel != "")
+    {
+        if(options._debugLevel > 1) ::std::cout << "Check for indels..." << std::endl;
+        if(!options.realign) dumpShortIndelPolymorphismsBatch(window.fragmentStore, window.readCigars, window.fragmentStore.contigStore[0].seq, genomeNames[window.contigId], window.startCoord, window.windowBegin, window.windowEnd, window.indelOut, options);
+    }
+
+    if (options.outputSNP != "")
+    {
+        if(options._debugLevel > 1) ::std::cout << "Check for SNPs..." << std::endl;
+        if(options.realign)
+            dumpVariantsRealignBatchWrap(window.fragmentStore, window.readCigars, window.readCounts, genomeNames[window.contigId], window.startCoord, window.windowBegin, window.windowEnd, window.snpOut, window.indelOut, options);
+        else
+            dumpSNPsBatch(window.fragmentStore, window.readCigars, window.readCounts, genomeNames[window.contigId], window.startCoord, window.windowBegin, window.windowEnd, window.snpOut, options);
+    }
+}
+
+// call variants in all pending windows in parallel and write the results in window order
+template<typename TWindow, typename TGenomeNames, typename TOptions>
+void
+callVariantsInWindowBatch(String<TWindow *> &windows,
+                          TGenomeNames &genomeNames,
+                          ::std::ofstream &snpFileStream,
+                          ::std::ofstream &indelFileStream,
+                          TOptions &options)
+{
+    int numWindows = length(windows);
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 1))
+    for (int k = 0; k < numWindows; ++k)
+        callVariantsInWindow(*windows[k], genomeNames, options);
+
+    for (int k = 0; k < numWindows; ++k)
+    {
+        if (snpFileStream.is_open())
+            snpFileStream << windows[k]->snpOut.str();
+        if (indelFileStream.is_open())
+            indelFileStream << windows[k]->indelOut.str();
+        delete windows[k];
+    }
+    clear(windows);
+}
+
+
 // little helper
 template<typename TMatch>
 char
@@ -617,6 +717,7 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
     typedef String<unsigned>                TReadCounts;
     typedef String<Pair<int,int> >              TReadClips;
     typedef StringSet<String<Pair<char,int> > >     TReadCigars;
+    typedef SnpCallingWindow<TFragmentStore, TReadCounts, TReadClips, TReadCigars> TWindow;
 
     TGenomeSet              genomes;
     StringSet<CharString>           genomeFileNameList; // filenamen
@@ -794,6 +895,12 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
 
     bool firstCall = true;
 
+    // Windows are parsed sequentially.  Their variants are called in parallel in batches
+    // of 2*threadCount windows, the output is written in window order.
+    String<TWindow *> pendingWindows;
+    unsigned windowBatchSize = (options.threadCount > 1) ? 2 * options.threadCount : 1;
+    omp_set_num_threads(options.threadCount);
+
     /////////////////////////////////////////////////////////////////////////////
     // Start scanning for SNPs/indels
     // for each chromosome
@@ -837,10 +944,11 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
             if(options._debugLevel > 0)
                 ::std::cout << "Sequence number " << i << " window " << currentWindowBegin << ".." << currentWindowEnd << "\n";
 
-            TFragmentStore fragmentStore;
-            TReadCounts readCounts;  // Count number of reads that are identical to the given one. Useful for micro RNA data where there were millions of identical reads. Must be in GFF input, not supported for SAM input.
-            TReadClips readClips;  // Soft clipping information and/or clipping information from GFF/SAM tag. Clipping is postponed after pileup correction.
-            TReadCigars readCigars; // Currently only stored for split-mapped reads. Split-mapped reads need special handling, especially for realignment.
+            TWindow *window = new TWindow();
+            TFragmentStore &fragmentStore = window->fragmentStore;
+            TReadCounts &readCounts = window->readCounts;  // Count number of reads that are identical to the given one. Useful for micro RNA data where there were millions of identical reads. Must be in GFF input, not supported for SAM input.
+            TReadClips &readClips = window->readClips;  // Soft clipping information and/or clipping information from GFF/SAM tag. Clipping is postponed after pileup correction.
+            TReadCigars &readCigars = window->readCigars; // Currently only stored for split-mapped reads. Split-mapped reads need special handling, especially for realignment.
 
             // add the matches that were overlapping with this and the last window (copied in order to avoid 2 x makeGlobal)
             if(!empty(tmpMatches))
@@ -887,6 +995,12 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
                                                          i, currentWindowBegin, currentWindowEnd, highestChrId[j], options, firstCall);
                 firstCall = false;
 
+                if (result == CALLSNPS_GFF_FAILED || result > 0)
+                {
+                    // write the variants of the windows parsed so far
+                    delete window;
+                    callVariantsInWindowBatch(pendingWindows, genomeNames, snpFileStream, indelFileStream, options);
+                }
                 if (result == CALLSNPS_GFF_FAILED)
                 {
                     std::cerr << "Failed to open read file " << options.readFNames[j] << ::std::endl;
@@ -959,41 +1073,44 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
                 // clip Reads if clipping is switched on and there were clip tags in the gff file
                 if((!options.dontClip && options.clipTagsInFile) || options.softClipTagsInFile)
                 {
+                    // pending windows are called in the quality mode they were parsed with
+                    if(options.useBaseQuality)
+                        callVariantsInWindowBatch(pendingWindows, genomeNames, snpFileStream, indelFileStream, options);
                     options.useBaseQuality = false; // activate "average read quality"-mode for snp calling, low quality bases should be clipped anyway
                     clipReads(fragmentStore,readClips,(unsigned)0,(unsigned)length(fragmentStore.alignedReadStore),options);
                 }
 
-                // check for indels
-                if (options.outputIndel != "")
-                {
-                    if(options._debugLevel > 1) ::std::cout << "Check for indels..." << std::endl;
-                    if(!options.realign) dumpShortIndelPolymorphismsBatch(fragmentStore, readCigars, fragmentStore.contigStore[0].seq, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, indelFileStream, options);
-                }
-
-                // // check for CNVs
-                //              if (*options.outputCNV != 0)
-                //                  dumpCopyNumberPolymorphismsBatch(fragmentStore, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, cnvFileStream, options);
+                window->contigId = i;
+                window->startCoord = startCoord;
+                window->windowBegin = currentWindowBegin;
+                window->windowEnd = currentWindowEnd;
+                window->snpOut.fileIsOpen = snpFileStream.is_open();
+                window->indelOut.fileIsOpen = indelFileStream.is_open();
 
-#ifdef SNPSTORE_DEBUG
-                CharString strstr = "test";
-                //              _dumpMatches(fragmentStore, strstr );
-#endif
-                if (options.outputSNP != "")
-                {
-                    if(options._debugLevel > 1) ::std::cout << "Check for SNPs..." << std::endl;
-                    if(options.realign)
-                        dumpVariantsRealignBatchWrap(fragmentStore, readCigars, readCounts, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, snpFileStream,indelFileStream,options);
-                    else
-                        dumpSNPsBatch(fragmentStore, readCigars, readCounts, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, snpFileStream,options);
-                }
                 if(positionStatsOnly)
                 {
+                    // position output of a window follows its indel output
+                    callVariantsInWindow(*window, genomeNames, options);
+                    if(indelFileStream.is_open())
+                        indelFileStream << window->indelOut.str();
+
                     if(options._debugLevel > 1) ::std::cout << "Dumping info for query positions..." << std::endl;
                     if(options.realign)
                         dumpPositionsRealignBatchWrap(fragmentStore, inspectPosIt, inspectPosItEnd, readCigars, readCounts, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, posFileStream, options);
                     else dumpPosBatch(fragmentStore, inspectPosIt, inspectPosItEnd, readCigars, readCounts, genomeNames[i], startCoord, currentWindowBegin, currentWindowEnd, posFileStream, options);
+                    delete window;
+                }
+                else
+                {
+                    appendValue(pendingWindows, window);
+                    if(length(pendingWindows) >= windowBatchSize)
+                        callVariantsInWindowBatch(pendingWindows, genomeNames, snpFileStream, indelFileStream, options);
                 }
             }
+            else
+            {
+                delete window;
+            }
 //            else
 //            {
                 if(positionStatsOnly && !empty(positions))
@@ -1013,6 +1130,8 @@ int detectSNPs(SNPCallingOptions<TSpec> &options)
         }
 
     }
+    callVariantsInWindowBatch(pendingWindows, genomeNames, snpFileStream, indelFileStream, options);
+
     if (options.outputSNP != "")
         snpFileStream.close();
 
@@ -1244,6 +1363,12 @@ parseCommandLine(SNPCallingOptions<TSpec> & options, int argc, char const ** arg
 
     addSection(parser, "Other options");
     addOption(parser, ArgParseOption("lf", "log-file", "Write log to FILE.", ArgParseArgument::STRING));
+    addOption(parser, ArgParseOption("tc", "thread-count", "Number of threads. Variants in different parse windows are called in parallel.", ArgParseArgument::INTEGER));
+    setMinValue(parser, "thread-count", "1");
+    setDefaultValue(parser, "thread-count", options.threadCount);
+#ifndef _OPENMP
+    hideOption(parser, "tc");
+#endif  // #ifndef _OPENMP
     addOption(parser, ArgParseOption("v", "verbose", "Enable verbose output."));
     addOption(parser, ArgParseOption("vv", "very-verbose", "Enable very verbose output."));
     addOption(parser, ArgParseOption("q", "quiet", "Set verbosity to a minimum."));
@@ -1318,6 +1443,7 @@ parseCommandLine(SNPCallingOptions<TSpec> & options, int argc, char const ** arg
     getOptionValue(options.cnvWindowSize, parser, "cnv-window-size");
     // Other Options:
     getOptionValue(options.outputLog, parser, "log-file");
+    getOptionValue(options.threadCount, parser, "thread-count");
     if (isSet(parser, "verbose"))
         options._debugLevel = max(options._debugLevel, 1);
     if (isSet(parser, "very-verbose"))
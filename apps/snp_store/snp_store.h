@@ -199,6 +199,7 @@ struct FragmentStoreConfig<SnpStoreGroupSpec_> :
 
         unsigned    windowSize;                 // genomic window size for read parsing
         unsigned    windowBuff;                 // reads within windowBuff base pairs of current window are also kept (-> overlapping windows)
+        unsigned    threadCount;                // number of threads calling variants in different windows in parallel
 
         // cnv calling related // not in use
         unsigned    expectedReadsPerBin;
@@ -297,6 +298,7 @@ struct FragmentStoreConfig<SnpStoreGroupSpec_> :
 
             windowSize = 1000000;
             windowBuff = 70;
+            threadCount = 1;
             minCoord = maxValue<unsigned>();
             maxCoord = 0;
             maxHitLength = 1;
@@ -3815,10 +3817,14 @@ void dumpVariantsRealignBatch(
     ::std::ofstream logfile;
     if(options.outputLog != "")
     {
-        logfile.open(toCString(options.outputLog), ::std::ios_base::out | ::std::ios_base::app);
-        if (!logfile.is_open())
-            ::std::cerr << "Failed to write to log file" << ::std::endl;
-        logfile << "#stats for window " << currStart << " " << currEnd << " of " << genomeID << std::endl;
+        // windows may be called in parallel
+        SEQAN_OMP_PRAGMA(critical (snp_store_log_file))
+        {
+            logfile.open(toCString(options.outputLog), ::std::ios_base::out | ::std::ios_base::app);
+            if (!logfile.is_open())
+                ::std::cerr << "Failed to write to log file" << ::std::endl;
+            logfile << "#stats for window " << currStart << " " << currEnd << " of " << genomeID << std::endl;
+        }
     }
 
     if(options._debugLevel > 1) ::std::cout << "Scanning chromosome " << genomeID << " window (" << currStart<<","<< currEnd << ") for SNPs..." << ::std::endl;
@@ -4601,10 +4607,14 @@ void dumpSNPsBatch(
     ::std::ofstream logfile;
     if(options.outputLog != "")
     {
-        logfile.open(toCString(options.outputLog), ::std::ios_base::out | ::std::ios_base::app);
-        if (!logfile.is_open())
-            ::std::cerr << "Failed to write to log file" << ::std::endl;
-        logfile << "#stats for window " << currStart << " " << currEnd << " of " << genomeID << std::endl;
+        // windows may be called in parallel
+        SEQAN_OMP_PRAGMA(critical (snp_store_log_file))
+        {
+            logfile.open(toCString(options.outputLog), ::std::ios_base::out | ::std::ios_base::app);
+            if (!logfile.is_open())
+                ::std::cerr << "Failed to write to log file" << ::std::endl;
+            logfile << "#stats for window " << currStart << " " << currEnd << " of " << genomeID << std::endl;
+        }
     }
 
     TMatchIterator matchIt  = begin(matches, Standard());
@@ -80,6 +80,28 @@ def main(source_base, binary_base):
                   ph.outFile('indels_default.gff',))])
     conf_list.append(conf)
 
+    # default, with small parse windows called by several threads
+    tc_transforms = transforms + [
+        app_tests.ReplaceTransform('_default_tc4', '_default'),
+        app_tests.ReplaceTransform(' -tc 4 -pws 1000', ''),
+        ]
+    conf = app_tests.TestConf(
+        program=path_to_program,
+        redir_stdout=ph.outFile('snp_store_default_tc4.stdout'),
+        args=[ph.inFile('human-chr22-inf2.fa'),
+              ph.inFile('human-reads2.gff'),
+              '-o', ph.outFile('snps_default_tc4.vcf'),
+              '-id', ph.outFile('indels_default_tc4.gff'),
+              '-tc', str(4), '-pws', str(1000)],
+        to_diff=[(ph.inFile('snp_store_default.stdout'),
+                  ph.outFile('snp_store_default_tc4.stdout')),
+                 (ph.inFile('snps_default.vcf'),
+                  ph.outFile('snps_default_tc4.vcf'),
+                  tc_transforms),
+                 (ph.inFile('indels_default.gff'),
+                  ph.outFile('indels_default_tc4.gff',))])
+    conf_list.append(conf)
+
     # test 2
     conf = app_tests.TestConf(
         program=path_to_program,
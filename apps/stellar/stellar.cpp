@@ -78,6 +78,183 @@ _stellarOnOne(TSequence & database,
     return true;
 }
 
+#ifdef _OPENMP
+///////////////////////////////////////////////////////////////////////////////
+// Verifies a swift hit with the verification strategy selected in the options
+template <typename TSequence, typename TQueries, typename TId, typename TQueryMatches>
+inline void
+_stellarVerifyHitOnOne(StellarSwiftHit const & hit,
+                       TSequence & database,
+                       TQueries & queries,
+                       TId & databaseID,
+                       bool databaseStrand,
+                       TQueryMatches & hitMatches,
+                       StellarOptions const & options)
+{
+    if (options.fastOption == CharString("exact"))
+        _stellarVerifyHit(hit, database, queries, options.epsilon, options.minLength, options.xDrop,
+                          databaseID, databaseStrand, hitMatches, AllLocal());
+    else if (options.fastOption == "bestLocal")
+        _stellarVerifyHit(hit, database, queries, options.epsilon, options.minLength, options.xDrop,
+                          databaseID, databaseStrand, hitMatches, BestLocal());
+    else if (options.fastOption == "bandedGlobal")
+        _stellarVerifyHit(hit, database, queries, options.epsilon, options.minLength, options.xDrop,
+                          databaseID, databaseStrand, hitMatches, BandedGlobal());
+    else if (options.fastOption == "bandedGlobalExtend")
+        _stellarVerifyHit(hit, database, queries, options.epsilon, options.minLength, options.xDrop,
+                          databaseID, databaseStrand, hitMatches, BandedGlobalExtend());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Searches all database strands in parallel, the matches are the same as in _stellarOnOne.
+//  1. The database strands are filtered in parallel, each with one swift finder, s.t. the hits of
+//     a strand are reported in the same order as in the sequential search. Reverse complemented
+//     strands are computed by the thread that filters them.
+//  2. The hits of a strand are verified in parallel.
+//  3. The matches of each hit are inserted in the order of the hits, s.t. the removal of
+//     overlapping matches and the disabling of queries are the same as in the sequential search.
+template <typename TSequence, typename TId, typename TQGramIndex, typename TMatches>
+inline bool
+_stellarOnAllParallel(StringSet<TSequence> & databases,
+                      StringSet<TId> & databaseIDs,
+                      TQGramIndex & qgramIndex,
+                      TMatches & matches,
+                      StellarOptions & options)
+{
+    typedef Finder<TSequence, Swift<SwiftLocal> >       TFinder;
+    typedef Pattern<TQGramIndex, Swift<SwiftLocal> >    TPattern;
+    typedef typename Value<TMatches>::Type              TQueryMatches;
+    typedef typename Fibre<TQGramIndex, QGramText>::Type TQueries;
+
+    if (options.fastOption != CharString("exact") && options.fastOption != "bestLocal" &&
+        options.fastOption != "bandedGlobal" && options.fastOption != "bandedGlobalExtend")
+    {
+        std::cerr << "\nUnknown verification strategy: " << options.fastOption << std::endl;
+        return false;
+    }
+
+    TQueries & queries = indexText(qgramIndex);
+
+    // database strands (number of the database sequence, positive strand) in the order of the sequential search
+    String<Pair<unsigned, bool> > strands;
+    for (unsigned i = 0; i < length(databases); ++i)
+    {
+        if (options.forward)
+            appendValue(strands, Pair<unsigned, bool>(i, true));
+        if (options.reverse && options.alphabet != "protein" && options.alphabet != "char")
+            appendValue(strands, Pair<unsigned, bool>(i, false));
+    }
+
+    // 1. filter all strands
+    String<String<StellarSwiftHit> > strandHits;
+    resize(strandHits, length(strands));
+
+    SEQAN_OMP_PRAGMA(parallel num_threads(options.threadCount))
+    {
+        // each thread has its own pattern with its own buckets
+        TPattern swiftPattern(qgramIndex);
+        TSequence complement;
+
+        SEQAN_OMP_PRAGMA(for schedule(dynamic, 1))
+        for (int s = 0; s < (int)length(strands); ++s)
+        {
+            TSequence & database = databases[strands[s].i1];
+            if (strands[s].i2)
+            {
+                TFinder swiftFinder(database, options.minRepeatLength, options.maxRepeatPeriod);
+                _stellarFilter(swiftFinder, swiftPattern, options.epsilon, options.minLength, strandHits[s]);
+            }
+            else
+            {
+                complement = database;
+                reverseComplement(complement);
+                TFinder swiftFinder(complement, options.minRepeatLength, options.maxRepeatPeriod);
+                _stellarFilter(swiftFinder, swiftPattern, options.epsilon, options.minLength, strandHits[s]);
+            }
+        }
+    }
+
+    String<TQueryMatches> hitMatches;
+    const unsigned batchSize = 1024 * options.threadCount;
+
+    for (unsigned s = 0; s < length(strands); ++s)
+    {
+        TSequence & database = databases[strands[s].i1];
+        TId & databaseID = databaseIDs[strands[s].i1];
+        bool databaseStrand = strands[s].i2;
+        String<StellarSwiftHit> & hits = strandHits[s];
+
+        std::cout << "  " << databaseID;
+        if (!databaseStrand)
+            std::cout << ", complement";
+        std::cout << std::flush;
+
+        // matches refer to the database sequence, which is reverse complemented in place as in the sequential search
+        if (!databaseStrand)
+            reverseComplement(database);
+
+        if (options.verbose && !empty(hits))
+        {
+            __int64 maxLength = 0;
+            __int64 totalLength = 0;
+            for (unsigned h = 0; h < length(hits); ++h)
+            {
+                totalLength += hits[h].hstkEnd - hits[h].hstkBegin;
+                maxLength = _max(maxLength, hits[h].hstkEnd - hits[h].hstkBegin);
+            }
+            std::cout << std::endl << "    # SWIFT hits      : " << length(hits);
+            std::cout << std::endl << "    Longest hit       : " << maxLength;
+            std::cout << std::endl << "    Avg hit length    : " << totalLength / (__int64)length(hits);
+        }
+
+        for (unsigned batchBegin = 0; batchBegin < length(hits); batchBegin += batchSize)
+        {
+            unsigned batchEnd = _min(batchBegin + batchSize, (unsigned)length(hits));
+            clear(hitMatches);
+            resize(hitMatches, batchEnd - batchBegin);
+
+            // 2. verify hits of queries that are not disabled yet
+            SEQAN_OMP_PRAGMA(parallel for num_threads(options.threadCount) schedule(dynamic, 1))
+            for (int h = batchBegin; h < (int)batchEnd; ++h)
+                if (!matches[hits[h].ndlSeqNo].disabled)
+                    _stellarVerifyHitOnOne(hits[h], database, queries, databaseID, databaseStrand,
+                                           hitMatches[h - batchBegin], options);
+
+            // 3. insert matches in the order of the sequential search
+            for (unsigned h = batchBegin; h < batchEnd; ++h)
+            {
+                TQueryMatches & queryMatches = matches[hits[h].ndlSeqNo];
+                String<StellarMatch<TSequence, TId> > & newMatches = hitMatches[h - batchBegin].matches;
+                if (queryMatches.disabled)
+                    continue;
+                for (unsigned m = 0; m < length(newMatches); ++m)
+                    if (!_insertMatch(queryMatches, newMatches[m], options.minLength, options.disableThresh,
+                                      options.compactThresh, options.numMatches))
+                        break;
+            }
+        }
+        clear(hits);
+        shrinkToFit(hits);
+
+        for (unsigned i = 0; i < length(matches); ++i)
+        {
+            TQueryMatches & queryMatches = matches[i];
+            if (length(queryMatches.matches) > 0 && !queryMatches.disabled)
+            {
+                maskOverlaps(queryMatches.matches, options.minLength);      // remove overlaps and duplicates
+                compactMatches(queryMatches.matches, options.numMatches);   // keep only the <numMatches> longest matches
+            }
+        }
+
+        if (!databaseStrand)
+            reverseComplement(database);
+        std::cout << std::endl;
+    }
+    return true;
+}
+#endif  // #ifdef _OPENMP
+
+
 //////////////////////////////////////////////////////////////////////////////
 namespace SEQAN_NAMESPACE_MAIN {
 
@@ -166,22 +343,32 @@ _stellarOnAll(StringSet<TSequence> & databases,
     resize(matches, length(queries));
 
     std::cout << "Aligning all query sequences to database sequence..." << std::endl;
-    for (unsigned i = 0; i < length(databases); ++i)
+#ifdef _OPENMP
+    if (options.threadCount > 1)
     {
-        // positive database strand
-        if (options.forward)
-        {
-            if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, true, matches, options))
-                return 1;
-        }
-        // negative (reverse complemented) database strand
-        if (options.reverse && options.alphabet != "protein" && options.alphabet != "char")
+        if (!_stellarOnAllParallel(databases, databaseIDs, qgramIndex, matches, options))
+            return 1;
+    }
+    else
+#endif  // #ifdef _OPENMP
+    {
+        for (unsigned i = 0; i < length(databases); ++i)
         {
-            reverseComplement(databases[i]);
-            if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, false, matches, options))
-                return 1;
+            // positive database strand
+            if (options.forward)
+            {
+                if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, true, matches, options))
+                    return 1;
+            }
+            // negative (reverse complemented) database strand
+            if (options.reverse && options.alphabet != "protein" && options.alphabet != "char")
+            {
+                reverseComplement(databases[i]);
+                if (!_stellarOnOne(databases[i], databaseIDs[i], swiftPattern, false, matches, options))
+                    return 1;
 
-            reverseComplement(databases[i]);
+                reverseComplement(databases[i]);
+            }
         }
     }
     std::cout << std::endl;
@@ -388,6 +575,10 @@ _writeSpecifiedParams(TOptions & options)
     }
     std::cout << "  maximal number of matches        : " << options.numMatches << std::endl;
     std::cout << "  duplicate removal every          : " << options.compactThresh << std::endl;
+    if (options.threadCount > 1)
+    {
+        std::cout << "  number of threads                : " << options.threadCount << std::endl;
+    }
     if (options.maxRepeatPeriod != 1 || options.minRepeatLength != 1000)
     {
         std::cout << "  max low complexity repeat period : " << options.maxRepeatPeriod << std::endl;
@@ -464,6 +655,10 @@ _parseOptions(ArgumentParser & parser, TOptions & options)
 
     getOptionValue(options.verbose, parser, "verbose");
 
+#ifdef _OPENMP
+    getOptionValue(options.threadCount, parser, "thread-count");
+#endif  // #ifdef _OPENMP
+
     if (isSet(parser, "kmer") && options.qGram >= 1 / options.epsilon)
     {
         std::cerr << "Invalid parameter value: Please choose q-gram length lower than 1/epsilon." << std::endl;
@@ -574,6 +769,18 @@ void _setParser(ArgumentParser & parser)
     addOption(parser, ArgParseOption("t", "no-rt", "Suppress printing running time."));
     hideOption(parser, "t");
 
+#ifdef _OPENMP
+    addSection(parser, "Parallelism Options");
+#endif  // #ifdef _OPENMP
+    addOption(parser, ArgParseOption("tc", "thread-count",
+                                     "Number of threads. If larger than 1, the database strands are filtered and the "
+                                     "hits are verified in parallel.", ArgParseArgument::INTEGER));
+    setMinValue(parser, "thread-count", "1");
+    setDefaultValue(parser, "thread-count", "1");
+#ifndef _OPENMP
+    hideOption(parser, "tc");
+#endif  // #ifndef _OPENMP
+
     addTextSection(parser, "References");
     addText(parser, "Kehr, B., Weese, D., Reinert, K.: STELLAR: fast and exact local alignments. BMC Bioinformatics, "
                     "12(Suppl 9):S15, 2011.");
@@ -645,6 +645,68 @@ verifySwiftHit(Segment<TInfix, InfixSegment> const & infH,
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Calls swift filter on a database strand and collects the swift hits in the order they are reported,
+//  s.t. they can be verified later in the order of a sequential search.
+template<typename TText, typename TIndex, typename TSize>
+void _stellarFilter(Finder<TText, Swift<SwiftLocal> > & finder,
+                    Pattern<TIndex, Swift<SwiftLocal> > & pattern,
+                    double epsilon,
+                    TSize minLength,
+                    String<StellarSwiftHit> & hits) {
+	typedef typename Fibre<TIndex, QGramText>::Type TNeedle;
+	typedef typename GetSequenceByNo<TNeedle>::Type TPatternSeq;
+	typedef typename Infix<TText>::Type TInfix;
+
+	while (find(finder, pattern, epsilon, minLength)) {
+		TInfix finderInfix = infix(finder);
+		TPatternSeq patternSeq = getSequenceByNo(pattern.curSeqNo, indexText(needle(pattern)));
+		typename Infix<TPatternSeq>::Type patternInfix = infix(pattern, patternSeq);
+
+		StellarSwiftHit hit;
+		hit.ndlSeqNo = pattern.curSeqNo;
+		hit.hstkBegin = beginPosition(finderInfix) - beginPosition(haystack(finder));
+		hit.hstkEnd = endPosition(finderInfix) - beginPosition(haystack(finder));
+		hit.ndlBegin = beginPosition(patternInfix) - beginPosition(patternSeq);
+		hit.ndlEnd = endPosition(patternInfix) - beginPosition(patternSeq);
+		hit.delta = pattern.bucketParams[0].delta + pattern.bucketParams[0].overlap;
+
+		appendValue(hits, hit);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Verifies a swift hit collected by _stellarFilter and appends all eps-matches
+//  in the order they are found. The matches are neither compacted nor limited in number.
+template<typename TSequence, typename TQuery, typename TStringSetSpec, typename TSize, typename TDrop,
+         typename TSource, typename TId, typename TTag>
+void _stellarVerifyHit(StellarSwiftHit const & hit,
+                       TSequence & database,
+                       StringSet<TQuery, TStringSetSpec> & queries,
+                       double epsilon,
+                       TSize minLength,
+                       TDrop xDrop,
+                       TId & databaseID,
+                       bool dbStrand,
+                       QueryMatches<StellarMatch<TSource, TId> > & hitMatches,
+                       TTag tag) {
+	typedef typename GetSequenceByNo<StringSet<TQuery, TStringSetSpec> >::Type TPatternSeq;
+	typedef typename Infix<TSequence>::Type TInfix;
+
+	TInfix finderInfixSeq = infix(database, 0, length(database));
+	Segment<TInfix, InfixSegment> finderSegment(finderInfixSeq, hit.hstkBegin, hit.hstkEnd);
+
+	TPatternSeq patternSeq = getSequenceByNo(hit.ndlSeqNo, queries);
+	typename Infix<TPatternSeq>::Type patternInfixSeq = infix(patternSeq, 0, length(patternSeq));
+	Segment<typename Infix<TPatternSeq>::Type, InfixSegment> patternSegment(patternInfixSeq,
+		hit.ndlBegin, hit.ndlEnd);
+
+	unsigned maxValue = (unsigned)-1;
+	unsigned compactThresh = maxValue;
+	verifySwiftHit(finderSegment, patternSegment, epsilon, minLength, xDrop, hit.delta,
+				   maxValue, compactThresh, maxValue, databaseID, dbStrand, hitMatches, tag);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Calls swift filter and verifies swift hits. = Computes eps-matches.
 template<typename TText, typename TStringSetSpec, typename TIndexSpec, typename TSize, typename TDrop, typename TSize1,
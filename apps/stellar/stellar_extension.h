@@ -326,14 +326,13 @@ _align_banded_nw_best_ends(TTrace& trace,
 				hori_len = *lenIt;
 			} else {			
 				// Usual initialization for first row and column
+				// (linear gap costs do not depend on the characters, there is no character at position -1)
 				if (actualRow == 0) {
-					*matIt = actualCol * scoreGapExtendHorizontal(sc, sequenceEntryForScore(sc, str1, ((int) actualCol - 1)),
-					                                              sequenceEntryForScore(sc, str2, -1));
+					*matIt = actualCol * scoreGap(sc);
 					*lenIt = actualCol;
 				}
 				else {
-					*matIt = actualRow * scoreGapExtendVertical(sc, sequenceEntryForScore(sc, str1, -1),
-					                                            sequenceEntryForScore(sc, str2, ((int) actualRow - 1)));
+					*matIt = actualRow * scoreGap(sc);
 					*lenIt = actualRow;
 					hori_val = *matIt;
 					hori_len = actualRow;
@@ -356,24 +355,11 @@ _align_banded_nw_best_ends(TTrace& trace,
 	resize(bestEnds, newLength + 1);
 }
 
-///////////////////////////////////////////////////////////////////////////////
-// Reverses the infixes of the left extension in place in hosts of infH and infV.
-template<typename TSequenceA, typename TSequenceB, typename TSeed>
-void
-_reverseLeftExtension(Segment<TSequenceA, InfixSegment> const & infH,
-					  Segment<TSequenceB, InfixSegment> const & infV,
-					  TSeed & seed,
-					  TSeed & seedOld) {
-	Segment<TSequenceA, InfixSegment> infixH(host(infH), beginPositionH(seed), beginPositionH(seedOld));
-	Segment<TSequenceB, InfixSegment> infixV(host(infV), beginPositionV(seed), beginPositionV(seedOld));
-	reverse(infixH);
-	reverse(infixV);
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 // Computes the banded alignment matrix for the left extension and 
 //   returns a string with possible start positions of an eps-match.
-// Caution: The infixes of the left extension is reversed in place in hosts of infH and infV!
+// The matrix is computed on reversed copies of the infixes of the left extension,
+//   the hosts of infH and infV are not modified and can be shared between threads.
 template<typename TMatrix, typename TPossEnd, typename TSequence, typename TSeed, typename TScore>
 void
 _fillMatrixBestEndsLeft(TMatrix & matrixLeft,
@@ -384,17 +370,14 @@ _fillMatrixBestEndsLeft(TMatrix & matrixLeft,
 						TSeed & seedOld,
 						TScore const & scoreMatrix) {
 
-	typedef Segment<TSequence, InfixSegment> TInfix;
-
-	TInfix infixH(host(infH), beginPositionH(seed), beginPositionH(seedOld));
-	TInfix infixV(host(infV), beginPositionV(seed), beginPositionV(seedOld));
-
-	reverse(infixH);
-	reverse(infixV);
+	typedef String<typename Value<TSequence>::Type> TReversed;
 
-	StringSet<TInfix> str;
-	appendValue(str, infixH);
-	appendValue(str, infixV);
+	StringSet<TReversed> str;
+	resize(str, 2);
+	str[0] = infix(host(infH), beginPositionH(seed), beginPositionH(seedOld));
+	str[1] = infix(host(infV), beginPositionV(seed), beginPositionV(seedOld));
+	reverse(str[0]);
+	reverse(str[1]);
 
 	// _align_banded_nw_best_ends(matrixLeft, possibleEndsLeft, str, scoreMatrix,
 	// 						   upperDiagonal(seedOld) - upperDiagonal(seed),
@@ -695,7 +678,6 @@ _bestExtension(TInfix const & infH,
 	// fill banded matrix and gaps string for ...
 	if (direction == EXTEND_BOTH || direction == EXTEND_LEFT) { // ... extension to the left
 		_fillMatrixBestEndsLeft(matrixLeft, possibleEndsLeft, infH, infV, seed, seedOld, scoreMatrix);
-		// Caution: left extension infix is now reversed in host(infH and infV) !!!
         SEQAN_ASSERT_NOT(empty(possibleEndsLeft));
 	} else appendValue(possibleEndsLeft, TEndInfo());
 	if (direction == EXTEND_BOTH || direction == EXTEND_RIGHT) { // ... extension to the right
@@ -706,11 +688,8 @@ _bestExtension(TInfix const & infH,
 	// longest eps match on poss ends string
 	Pair<TEndIterator> endPair = longestEpsMatch(possibleEndsLeft, possibleEndsRight, alignLen, alignErr, minLength, eps);
 
-	if (endPair == Pair<TEndIterator>(0, 0)) { // no eps-match found
-		if (direction != 1) 
-			_reverseLeftExtension(infH, infV, seed, seedOld); // back to original orientation
+	if (endPair == Pair<TEndIterator>(0, 0)) // no eps-match found
 		return false;
-	}
 
 	// determine end positions of maximal eps-match in ...
 	TPos endLeftH = 0, endLeftV = 0;
@@ -751,9 +730,6 @@ _bestExtension(TInfix const & infH,
 	}
     SEQAN_ASSERT_EQ(length(row(align, 0)), length(row(align, 1)));
 
-	if (direction == EXTEND_BOTH || direction == EXTEND_LEFT)
-		_reverseLeftExtension(infH, infV, seed, seedOld); // back to original orientation
-
 	return true;
 }
 
@@ -58,6 +58,9 @@ struct StellarOptions {
 	double qgramAbundanceCut;
 	bool verbose;				// verbose mode
 
+	// parallelization options
+	unsigned threadCount;		// number of threads, database strands are searched in parallel if > 1
+
 
 	StellarOptions() {
 		outputFile = "stellar.gff";
@@ -81,10 +84,26 @@ struct StellarOptions {
 		minRepeatLength = 1000;
 		qgramAbundanceCut = 1;
 		verbose = false;
+
+		threadCount = 1;
 	}
 }; 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// Swift hit of a database strand that is verified after filtering
+struct StellarSwiftHit {
+	unsigned ndlSeqNo;			// number of the query sequence
+	__int64 hstkBegin;			// begin position of the hit in the database sequence
+	__int64 hstkEnd;			// end position of the hit in the database sequence
+	__int64 ndlBegin;			// begin position of the hit in the query sequence
+	__int64 ndlEnd;				// end position of the hit in the query sequence
+	int delta;					// delta + overlap of the swift buckets
+
+	StellarSwiftHit() : ndlSeqNo(0), hstkBegin(0), hstkEnd(0), ndlBegin(0), ndlEnd(0), delta(0)
+	{}
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Container for storing local alignment matches of one query sequence
 template<typename TMatch_>
@@ -95,6 +95,20 @@ def main(source_base, binary_base):
                   transforms)])
     conf_list.append(conf)
 
+    # Error rate 0.05, multiple threads (same matches as the sequential search):
+    conf = app_tests.TestConf(
+        program=path_to_program,
+        redir_stdout=ph.outFile('5e-2_tc4.stdout'),
+        args=['-e', '0.05', '-l', '50', '-x', '10', '-k', '7', '-n', '5000',
+              '-s', '10000', '-f', '-v', '-t', '-tc', '4',
+              '-o', ph.outFile('5e-2_tc4.gff'),
+              ph.inFile('512_simSeq1_5e-2.fa'),
+              ph.inFile('512_simSeq2_5e-2.fa')],
+        to_diff=[(ph.inFile('5e-2.gff'),
+                  ph.outFile('5e-2_tc4.gff'),
+                  transforms)])
+    conf_list.append(conf)
+
     # Error rate 0.25:
     conf = app_tests.TestConf(
         program=path_to_program,
@@ -290,10 +290,16 @@ readBatch(TRecords & records, SmartFile<Bam, Input, TSpec> & file, TSize maxReco
  *
  * @signature int writeRecord(bamFileOut, header);
  * @signature int writeRecord(bamFileOut, record);
+ * @signature int writeRecord(bamFileOut, record, index);
  *
  * @param[in,out] bamFileOut    The @link BamFileOut @endlink object to write to.
  * @param[in]     header        The @link BamAlignmentHeader @endlink to write out.
  * @param[in]     record        The @link BamAlignmentRecord @endlink to write out.
+ * @param[in,out] index         A @link BaiBamIndex @endlink to update with the written record.
+ *
+ * The variant with an <tt>index</tt> builds a BAI index while a coordinate-sorted BAM file is written.  The BGZF
+ * block position of each record is tracked, such that no second pass over the file is necessary.  After the last
+ * record, the index must be completed with @link BamIndex#finalizeIndex @endlink.
 */
 
 // support for dynamically chosen file formats
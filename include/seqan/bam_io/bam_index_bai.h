@@ -89,6 +89,31 @@ struct BaiBamIndexBinData_
     String<Pair<__uint64, __uint64> > chunkBegEnds;
 };
 
+// ----------------------------------------------------------------------------
+// Helper Class BaiBamIndexBuilder_
+// ----------------------------------------------------------------------------
+
+// State for building the index while the records are read or written.
+
+struct BaiBamIndexBuilder_
+{
+    bool     valid;         // false if the records were not coordinate-sorted
+    bool     hasRecords;    // true if at least one record was indexed
+    __int32  refId;         // reference id of the previous record
+    __int32  lastPos;       // begin position of the previous record
+    __uint32 bin;           // bin of the current chunk
+    __uint64 binBegin;      // begin offset of the current chunk
+    __uint64 refBegin;      // begin offset of the first record on the current reference
+    __uint64 lastEnd;       // end offset of the previous record
+    __uint64 numMapped;     // number of mapped records on the current reference
+    __uint64 numUnmapped;   // number of placed but unmapped records on the current reference
+
+    BaiBamIndexBuilder_() :
+        valid(true), hasRecords(false), refId(BamAlignmentRecord::INVALID_REFID), lastPos(0), bin(0), binBegin(0),
+        refBegin(0), lastEnd(0), numMapped(0), numUnmapped(0)
+    {}
+};
+
 // ----------------------------------------------------------------------------
 // Spec BAI BamIndex
 // ----------------------------------------------------------------------------
@@ -125,9 +150,12 @@ public:
 
     // 1<<14 is the size of the minimum bin.
     static const __int32 BAM_LIDX_SHIFT = 14;
+    // Pseudo bin that stores the offset range and the number of mapped/unmapped records of a reference.
+    static const __uint32 BAM_META_BIN = 37450;
 
     String<TBinIndex_> _binIndices;
     String<TLinearIndex_> _linearIndices;
+    BaiBamIndexBuilder_ _builder;
 
     BamIndex() : _unalignedCount(maxValue<__uint64>())
     {}
@@ -382,6 +410,258 @@ bool jumpToOrphans(SmartFile<Bam, Input, TSpec> & bamFile,
     return true;
 }
 
+// ----------------------------------------------------------------------------
+// Helper Function _baiCollectChunks()
+// ----------------------------------------------------------------------------
+
+// Append all chunks [beg, end) of virtual offsets that may contain alignments overlapping [pos, posEnd) on refId.
+
+inline void
+_baiCollectChunks(String<Pair<__uint64, __uint64> > & chunks,
+                  BamIndex<Bai> const & index,
+                  __int32 refId,
+                  __int32 pos,
+                  __int32 posEnd)
+{
+    typedef BamIndex<Bai>::TBinIndex_                   TBinIndex;
+    typedef TBinIndex::const_iterator                   TBinIndexIter;
+    typedef String<Pair<__uint64, __uint64> > const     TChunks;
+    typedef Iterator<TChunks, Standard>::Type           TChunkIter;
+
+    // Chunks ending left of the linear index entry of the first window cannot contain overlapping alignments.
+    BamIndex<Bai>::TLinearIndex_ const & linearIndex = index._linearIndices[refId];
+    __uint64 linearMinOffset = 0;
+    unsigned windowIdx = pos >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+    if (windowIdx < length(linearIndex))
+        linearMinOffset = linearIndex[windowIdx];
+    else if (!empty(linearIndex))
+        linearMinOffset = back(linearIndex);
+
+    String<__uint16> candidateBins;
+    _baiReg2bins(candidateBins, pos, posEnd);
+
+    TBinIndex const & binIndex = index._binIndices[refId];
+    for (unsigned i = 0; i < length(candidateBins); ++i)
+    {
+        TBinIndexIter mIt = binIndex.find(candidateBins[i]);
+        if (mIt == binIndex.end())
+            continue;  // Candidate is not in index!
+
+        TChunkIter itEnd = end(mIt->second.chunkBegEnds, Standard());
+        for (TChunkIter it = begin(mIt->second.chunkBegEnds, Standard()); it != itEnd; ++it)
+            if (it->i2 > linearMinOffset)
+                appendValue(chunks, *it);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _baiMergeChunks()
+// ----------------------------------------------------------------------------
+
+// Sort chunks by begin offset and merge overlapping chunks as well as chunks that are separated by less than one
+// BGZF block.  Reading over such a gap is cheaper than seeking and decompressing the same block twice.
+
+inline void
+_baiMergeChunks(String<Pair<__uint64, __uint64> > & chunks)
+{
+    if (empty(chunks))
+        return;
+
+    std::sort(begin(chunks, Standard()), end(chunks, Standard()));
+
+    unsigned j = 0;
+    for (unsigned i = 1; i < length(chunks); ++i)
+    {
+        if ((chunks[i].i1 >> 16) <= (chunks[j].i2 >> 16))
+        {
+            if (chunks[j].i2 < chunks[i].i2)
+                chunks[j].i2 = chunks[i].i2;
+        }
+        else
+        {
+            chunks[++j] = chunks[i];
+        }
+    }
+    resize(chunks, j + 1);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Functions _baiRegionBegin(), _baiRegionEnd()
+// ----------------------------------------------------------------------------
+
+template <typename TRegion>
+inline __int32
+_baiRegionBegin(TRegion const & region)
+{
+    return (region.beginPos < 0) ? 0 : region.beginPos;
+}
+
+template <typename TRegion>
+inline __int32
+_baiRegionEnd(TRegion const & region)
+{
+    // Negative end positions select everything up to the end of the reference, cf. GenomicRegion.
+    return (region.endPos < 0) ? static_cast<__int32>(1u << 29) : region.endPos;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Class BaiRegionLess_
+// ----------------------------------------------------------------------------
+
+// Orders region ids by (rID, beginPos) of the regions they refer to.
+
+template <typename TRegions>
+struct BaiRegionLess_
+{
+    TRegions const & regions;
+
+    BaiRegionLess_(TRegions const & regions) : regions(regions)
+    {}
+
+    template <typename TId>
+    bool operator()(TId a, TId b) const
+    {
+        if (regions[a].rID != regions[b].rID)
+            return regions[a].rID < regions[b].rID;
+        return _baiRegionBegin(regions[a]) < _baiRegionBegin(regions[b]);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Function queryRegions()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamFileIn#queryRegions
+ * @brief Retrieve all alignments overlapping a batch of regions using an index.
+ *
+ * @signature bool queryRegions(bamFile, index, regions, callback);
+ *
+ * @param[in,out] bamFile   The @link BamFileIn @endlink to read from.
+ * @param[in]     index     The @link BaiBamIndex @endlink to use for seeking.
+ * @param[in]     regions   A random access container of regions, e.g. a <tt>String&lt;GenomicRegion&gt;</tt>.  Each
+ *                          region must provide the members <tt>rID</tt>, <tt>beginPos</tt>, and <tt>endPos</tt>
+ *                          describing the interval <tt>[beginPos, endPos)</tt>.  A negative <tt>beginPos</tt>
+ *                          (<tt>endPos</tt>) selects the reference from its begin (up to its end).
+ * @param[in,out] callback  A functor that is called as <tt>callback(record, regionId)</tt> for each pair of
+ *                          @link BamAlignmentRecord @endlink and overlapping region, where <tt>regionId</tt> is the
+ *                          position of the region in <tt>regions</tt>.
+ *
+ * @return bool true if all regions could be queried, false if the file is not a BAM file or a region refers to an
+ *              invalid reference.
+ *
+ * @section Remarks
+ *
+ * In contrast to calling @link BamFileIn#jumpToRegion @endlink for each region, the BAI chunks of all regions are
+ * collected first, sorted by their virtual offset and merged.  The file is then read in a single forward pass over the
+ * merged chunks, such that each BGZF block is decompressed at most once, even if it is shared by overlapping or
+ * adjacent regions.  Since the seeks only move forward, blocks that were already read ahead by the decompression
+ * threads of the BGZF stream are reused.
+ *
+ * Each alignment is passed once for each region it overlaps.  The alignments are passed in file order, the order of the
+ * regions does not matter.  Unmapped alignments and alignments without a CIGAR string are considered to cover one
+ * base.
+ */
+
+template <typename TSpec, typename TRegions, typename TCallback>
+inline bool
+queryRegions(SmartFile<Bam, Input, TSpec> & bamFile,
+             BamIndex<Bai> const & index,
+             TRegions const & regions,
+             TCallback & callback)
+{
+    typedef typename Size<TRegions>::Type               TRegionId;
+    typedef String<TRegionId>                           TRegionIds;
+    typedef Pair<__uint64, __uint64>                    TChunk;
+    typedef String<TChunk>                              TChunks;
+    typedef typename Iterator<TRegionIds, Standard>::Type TRegionIdIter;
+
+    if (!isEqual(format(bamFile), Bam()))
+        return false;
+
+    // ------------------------------------------------------------------------
+    // Collect and merge the chunks of all regions.
+    // ------------------------------------------------------------------------
+
+    TRegionIds regionIds;
+    TChunks chunks;
+    reserve(regionIds, length(regions), Exact());
+    for (TRegionId i = 0; i < length(regions); ++i)
+    {
+        __int32 refId = regions[i].rID;
+        if (refId < 0 || static_cast<unsigned>(refId) >= length(index._binIndices))
+            return false;  // Cannot query invalid reference.
+
+        __int32 pos = _baiRegionBegin(regions[i]);
+        __int32 posEnd = _baiRegionEnd(regions[i]);
+        if (pos >= posEnd)
+            continue;
+
+        _baiCollectChunks(chunks, index, refId, pos, posEnd);
+        appendValue(regionIds, i);
+    }
+    _baiMergeChunks(chunks);
+
+    // Sort regions by begin position and compute the maximal end position of all preceding regions on the same
+    // reference.  This allows to find all regions overlapping an alignment with a binary search and a short scan.
+    std::sort(begin(regionIds, Standard()), end(regionIds, Standard()), BaiRegionLess_<TRegions>(regions));
+
+    String<__int32> maxEnds;
+    resize(maxEnds, length(regionIds), Exact());
+    for (unsigned i = 0; i < length(regionIds); ++i)
+    {
+        maxEnds[i] = _baiRegionEnd(regions[regionIds[i]]);
+        if (i > 0 && regions[regionIds[i - 1]].rID == regions[regionIds[i]].rID && maxEnds[i - 1] > maxEnds[i])
+            maxEnds[i] = maxEnds[i - 1];
+    }
+
+    // ------------------------------------------------------------------------
+    // Read the merged chunks in one forward pass.
+    // ------------------------------------------------------------------------
+
+    BamAlignmentRecord record;
+    for (unsigned c = 0; c < length(chunks); ++c)
+    {
+        if (static_cast<__uint64>(position(bamFile)) != chunks[c].i1 && !setPosition(bamFile, chunks[c].i1))
+            return false;  // Error while seeking.
+
+        while (!atEnd(bamFile) && static_cast<__uint64>(position(bamFile)) < chunks[c].i2)
+        {
+            readRecord(record, bamFile);
+            if (record.rID < 0)
+                continue;
+
+            __int32 recBegin = record.beginPos;
+            __int32 recEnd = recBegin + std::max(getAlignmentLengthInRef(record), 1u);
+
+            // The regions overlapping the record are among those left of the first region beginning at recEnd.
+            TRegionIdIter itBegin = begin(regionIds, Standard());
+            TRegionIdIter it = itBegin;
+            TRegionIdIter itEnd = end(regionIds, Standard());
+            while (it != itEnd)
+            {
+                TRegionIdIter itMid = it + (itEnd - it) / 2;
+                if (regions[*itMid].rID < record.rID ||
+                    (regions[*itMid].rID == record.rID && _baiRegionBegin(regions[*itMid]) < recEnd))
+                    it = itMid + 1;
+                else
+                    itEnd = itMid;
+            }
+
+            while (it != itBegin)
+            {
+                --it;
+                if (regions[*it].rID != record.rID || maxEnds[it - itBegin] <= recBegin)
+                    break;
+                if (_baiRegionEnd(regions[*it]) > recBegin)
+                    callback(record, *it);
+            }
+        }
+    }
+
+    return true;
+}
+
 // ----------------------------------------------------------------------------
 // Function getUnalignedCount()
 // ----------------------------------------------------------------------------
@@ -521,12 +801,23 @@ open(BamIndex<Bai> & index, char * filename)
 }
 
 // ----------------------------------------------------------------------------
-// Function buildIndex()
+// Function save()
 // ----------------------------------------------------------------------------
 
-inline bool _saveIndex(BamIndex<Bai> const & index, char const * filename)
+/*!
+ * @fn BamIndex#save
+ * @brief Write a BAM index to a given file name.
+ * @signature bool save(index, filename);
+
+ * @param[in] index    The index to write.
+ * @param[in] filename Path to the file to write. Types: char const *
+ *
+ * @return    bool     true on success, false on errors.
+ */
+
+inline bool
+save(BamIndex<Bai> const & index, char const * filename)
 {
-    std::cerr << "WRITE INDEX TO " << filename << std::endl;
     // Open output stream.
     std::ofstream out(filename, std::ios::binary | std::ios::out);
 
@@ -567,7 +858,7 @@ inline bool _saveIndex(BamIndex<Bai> const & index, char const * filename)
         }
 
         // Write out linear index.
-        __int32 numIntervals = length(index._linearIndices);
+        __int32 numIntervals = length(linearIndex);
         out.write(reinterpret_cast<char *>(&numIntervals), 4);
         typedef Iterator<String<__uint64> const, Rooted>::Type TLinearIndexIter;
         for (TLinearIndexIter it = begin(linearIndex, Rooted()); !atEnd(it); goNext(it))
@@ -575,192 +866,374 @@ inline bool _saveIndex(BamIndex<Bai> const & index, char const * filename)
     }
 
     // Write the number of unaligned reads if set.
-    std::cerr << "UNALIGNED\t" << index._unalignedCount << std::endl;
     if (index._unalignedCount != maxValue<__uint64>())
         out.write(reinterpret_cast<char const *>(&index._unalignedCount), 8);
 
     return out.good();  // false on error, true on success.
 }
 
-inline void _baiAddAlignmentChunkToBin(BamIndex<Bai> & index,
-                                       __uint32 currBin,
-                                       __uint32 currOffset,
-                                       __uint64 prevOffset)
+inline bool
+save(BamIndex<Bai> const & index, char * filename)
 {
-    // If this is not the first reference sequence then add previous reference data.
-    Pair<__uint64> newChunk(currOffset, prevOffset);
+    return save(index, static_cast<char const *>(filename));
+}
 
-    // If no interest exists yet for this bin, create one and store alignment chunk.
-    BamIndex<Bai>::TBinIndex_::iterator binIter = back(index._binIndices).find(currBin);
-    if (binIter == back(index._binIndices).end())
+// ----------------------------------------------------------------------------
+// Helper Functions for Index Construction
+// ----------------------------------------------------------------------------
+
+// The index is built from a coordinate-sorted sequence of records and their begin and end offsets.  The offsets may
+// either be BGZF virtual offsets (when reading) or block positions of the BGZF writer (when writing).  The latter are
+// translated into virtual offsets when the index is finalized, after all blocks have been compressed.
+
+inline void
+_baiClear(BamIndex<Bai> & index)
+{
+    clear(index._binIndices);
+    clear(index._linearIndices);
+    index._unalignedCount = 0;
+    index._builder = BaiBamIndexBuilder_();
+}
+
+inline void
+_baiAppendChunk(BamIndex<Bai>::TBinIndex_ & binIndex, __uint32 bin, __uint64 beginOfs, __uint64 endOfs)
+{
+    String<Pair<__uint64, __uint64> > & chunks = binIndex[bin].chunkBegEnds;
+
+    // Extend the previous chunk of this bin if the new one starts where it ends.
+    if (!empty(chunks) && back(chunks).i2 == beginOfs)
+        back(chunks).i2 = endOfs;
+    else
+        appendValue(chunks, Pair<__uint64, __uint64>(beginOfs, endOfs));
+}
+
+// Close the last chunk of the current reference and store its meta data in the pseudo bin.
+
+inline void
+_baiFinishReference(BamIndex<Bai> & index)
+{
+    BaiBamIndexBuilder_ & builder = index._builder;
+    if (builder.refId < 0)
+        return;
+
+    BamIndex<Bai>::TBinIndex_ & binIndex = index._binIndices[builder.refId];
+    _baiAppendChunk(binIndex, builder.bin, builder.binBegin, builder.lastEnd);
+
+    __uint32 metaBin = BamIndex<Bai>::BAM_META_BIN;
+    String<Pair<__uint64, __uint64> > & meta = binIndex[metaBin].chunkBegEnds;
+    clear(meta);
+    appendValue(meta, Pair<__uint64, __uint64>(builder.refBegin, builder.lastEnd));
+    appendValue(meta, Pair<__uint64, __uint64>(builder.numMapped, builder.numUnmapped));
+}
+
+// Add a record occupying [beginOfs, endOfs) to the index, returns false if the records are not coordinate-sorted.
+
+inline bool
+_baiIndexRecord(BamIndex<Bai> & index, BamAlignmentRecord const & record, __uint64 beginOfs, __uint64 endOfs)
+{
+    BaiBamIndexBuilder_ & builder = index._builder;
+    if (!builder.valid)
+        return false;
+
+    if (!builder.hasRecords || record.rID != builder.refId)
+    {
+        if (builder.hasRecords && (builder.refId < 0 || (record.rID >= 0 && record.rID < builder.refId)))
+            return builder.valid = false;  // Unsorted, unaligned records must come last.
+
+        if (builder.hasRecords)
+            _baiFinishReference(index);
+
+        builder.hasRecords = true;
+        builder.refId = record.rID;
+        if (record.rID >= 0)
+        {
+            if (length(index._binIndices) <= static_cast<unsigned>(record.rID))
+            {
+                resize(index._binIndices, record.rID + 1);
+                resize(index._linearIndices, record.rID + 1);
+            }
+            builder.bin = record.bin;
+            builder.binBegin = beginOfs;
+            builder.refBegin = beginOfs;
+            builder.numMapped = 0;
+            builder.numUnmapped = 0;
+        }
+    }
+    else if (record.beginPos < builder.lastPos)
+    {
+        return builder.valid = false;  // Unsorted.
+    }
+
+    builder.lastPos = record.beginPos;
+    builder.lastEnd = endOfs;
+
+    if (record.rID < 0)
+    {
+        ++index._unalignedCount;
+        return true;
+    }
+
+    // Close the current chunk if the bin changes.
+    if (record.bin != builder.bin)
     {
-        BaiBamIndexBinData_ binData;
-        appendValue(binData.chunkBegEnds, newChunk);
-        back(index._binIndices).insert(std::make_pair(currBin, binData));
+        _baiAppendChunk(index._binIndices[record.rID], builder.bin, builder.binBegin, beginOfs);
+        builder.bin = record.bin;
+        builder.binBegin = beginOfs;
     }
+
+    if (hasFlagUnmapped(record))
+        ++builder.numUnmapped;
     else
+        ++builder.numMapped;
+
+    // Store the record offset for all windows of the linear index that are covered by the record and have no offset.
+    if (record.beginPos >= 0)
     {
-        // Otherwise, just append alignment chunk.
-        appendValue(binIter->second.chunkBegEnds, newChunk);
+        BamIndex<Bai>::TLinearIndex_ & linearIndex = index._linearIndices[record.rID];
+        unsigned len = std::max(getAlignmentLengthInRef(record), 1u);
+        unsigned windowBegin = record.beginPos >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+        unsigned windowEnd = (record.beginPos + len - 1) >> BamIndex<Bai>::BAM_LIDX_SHIFT;
+        if (length(linearIndex) <= windowEnd)
+            resize(linearIndex, windowEnd + 1, maxValue<__uint64>());
+        for (unsigned i = windowBegin; i <= windowEnd; ++i)
+            if (linearIndex[i] == maxValue<__uint64>())
+                linearIndex[i] = beginOfs;
     }
+
+    return true;
 }
 
+// Close the last reference and add empty indices for all references without records.
+
 inline bool
-buildIndex(BamIndex<Bai> & index, char const * filename)
+_baiFinishIndex(BamIndex<Bai> & index, unsigned numRefSeqs)
 {
-    SEQAN_FAIL("This does not work yet!");
-
-    index._unalignedCount = 0;
-    clear(index._binIndices);
-    clear(index._linearIndices);
+    if (!index._builder.hasRecords)
+        _baiClear(index);
+    if (!index._builder.valid)
+        return false;
 
-    // Open BAM file for reading.
-    BamFileIn bamFile;
-    if (!open(bamFile, filename))
-        return false;  // Could not open BAM file.
+    _baiFinishReference(index);
+    index._builder.refId = BamAlignmentRecord::INVALID_REFID;
 
-    // Read BAM header.
-    BamHeader header;
-    readRecord(header, bamFile);
+    if (length(index._binIndices) < numRefSeqs)
+    {
+        resize(index._binIndices, numRefSeqs);
+        resize(index._linearIndices, numRefSeqs);
+    }
+    return true;
+}
 
-    __uint32 numRefSeqs = length(contigNames(context(bamFile)));
+// Translate all block positions of the BGZF writer into virtual offsets.
 
-    // Scan over BAM file and create index.
-    BamAlignmentRecord record;
-    __uint32 currBin    = maxValue<__uint32>();
-    __uint32 prevBin    = maxValue<__uint32>();
-    __int32 currRefId   = BamAlignmentRecord::INVALID_REFID;
-    __int32 prevRefId   = BamAlignmentRecord::INVALID_REFID;
-    __uint64 currOffset = position(bamFile);
-    __uint64 prevOffset = currOffset;
-    __int32 prevPos     = minValue<__int32>();
+template <typename TBgzfStreamBuf>
+inline void
+_baiTranslateOffsets(BamIndex<Bai> & index, TBgzfStreamBuf const & streamBuf)
+{
+    typedef BamIndex<Bai>::TBinIndex_::iterator TBinIndexIter;
 
-    while (!atEnd(bamFile))
+    for (unsigned i = 0; i < length(index._binIndices); ++i)
     {
-        // Load next record.
-        readRecord(record, bamFile);
-
-        // Check ordering.
-        if (prevRefId == record.rID && prevPos > record.beginPos)
-            return false;
-
-        // The reference sequence changed, close bins for previous reference.
-        if (prevRefId != record.rID)
+        for (TBinIndexIter it = index._binIndices[i].begin(); it != index._binIndices[i].end(); ++it)
         {
-            if (prevRefId != BamAlignmentRecord::INVALID_REFID)
+            String<Pair<__uint64, __uint64> > & chunks = it->second.chunkBegEnds;
+            // The second entry of the meta bin stores the record counts.
+            unsigned numChunks = (it->first == BamIndex<Bai>::BAM_META_BIN) ? 1 : length(chunks);
+            for (unsigned j = 0; j < numChunks; ++j)
             {
-                _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
+                chunks[j].i1 = streamBuf.virtualOffset(chunks[j].i1);
+                chunks[j].i2 = streamBuf.virtualOffset(chunks[j].i2);
+            }
+        }
 
-                // Add an index for all empty references between prevRefId (excluded) and record.rID (included).
-                for (int i = prevRefId + 1; i < record.rID; ++i)
-                {
-                    BamIndex<Bai>::TBinIndex_ binIndex;
-                    appendValue(index._binIndices, binIndex);
-                    BamIndex<Bai>::TLinearIndex_ linearIndex;
-                    appendValue(index._linearIndices, linearIndex);
-                }
+        for (unsigned j = 0; j < length(index._linearIndices[i]); ++j)
+            if (index._linearIndices[i][j] != maxValue<__uint64>())
+                index._linearIndices[i][j] = streamBuf.virtualOffset(index._linearIndices[i][j]);
+    }
+}
 
-                // Update bin book keeping.
-                currOffset = prevOffset;
-                currBin    = record.bin;
-                prevBin    = record.bin;
-                currRefId  = record.rID;
-            }
-            else
-            {
-                // Otherwise, this is the first pass.  Create an index for all empty references up to and including
-                // current refId.
-                for (int i = 0; i < record.rID; ++i)
-                {
-                    BamIndex<Bai>::TBinIndex_ binIndex;
-                    appendValue(index._binIndices, binIndex);
-                    BamIndex<Bai>::TLinearIndex_ linearIndex;
-                    appendValue(index._linearIndices, linearIndex);
-                }
-            }
+// Merge chunks of a bin that end and begin in the same BGZF block and fill the gaps of the linear index.
 
-            // Update reference book keeping.
-            prevRefId = record.rID;
-            prevBin = minValue<__int32>();
-        }
+inline void
+_baiCompactIndex(BamIndex<Bai> & index)
+{
+    typedef BamIndex<Bai>::TBinIndex_::iterator TBinIndexIter;
 
-        // If the alignment's reference id is valid and its bin is not a leaf.
-        if (record.rID >= 0 && record.bin < 4681)
+    for (unsigned i = 0; i < length(index._binIndices); ++i)
+    {
+        for (TBinIndexIter it = index._binIndices[i].begin(); it != index._binIndices[i].end(); ++it)
         {
-            __int32 beginOffset = record.beginPos >> BamIndex<Bai>::BAM_LIDX_SHIFT;
-            __int32 endPos      = getAlignmentLengthInRef(record);
-            __int32 endOffset   = (endPos - 1) >> BamIndex<Bai>::BAM_LIDX_SHIFT;
-
-            // Resize linear index if necessary.
-            unsigned oldSize = length(index._linearIndices);
-            unsigned newSize = endOffset + 1;
-            if (oldSize < newSize)
-                resize(back(index._linearIndices), newSize, 0);
-
-            // Store offset.
-            for (int i = beginOffset + 1; i <= endOffset; ++i)
-                if (back(index._linearIndices)[i] == 0u)
-                    back(index._linearIndices)[i] = prevOffset;
+            if (it->first == BamIndex<Bai>::BAM_META_BIN)
+                continue;
+
+            String<Pair<__uint64, __uint64> > & chunks = it->second.chunkBegEnds;
+            unsigned k = 0;
+            for (unsigned j = 1; j < length(chunks); ++j)
+            {
+                if ((chunks[j].i1 >> 16) == (chunks[k].i2 >> 16))
+                    chunks[k].i2 = chunks[j].i2;
+                else
+                    chunks[++k] = chunks[j];
+            }
+            if (!empty(chunks))
+                resize(chunks, k + 1);
         }
 
-        // Handle the case if we changed to a new BAI bin.
-        if (record.bin != prevBin)
+        BamIndex<Bai>::TLinearIndex_ & linearIndex = index._linearIndices[i];
+        __uint64 prevOffset = 0;
+        for (unsigned j = 0; j < length(linearIndex); ++j)
         {
-            // If not first bin of reference, save previous bin data.
-            if (currBin != maxValue<__uint32>())
-                _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
-
-            // Update markers.
-            currOffset = prevOffset;
-            currBin    = record.bin;
-            prevBin    = record.bin;
-            currRefId  = record.rID;
-
-            // If the reference id is invalid then break out.
-            if (currRefId < 0)
-                break;
+            if (linearIndex[j] == maxValue<__uint64>())
+                linearIndex[j] = prevOffset;
+            else
+                prevOffset = linearIndex[j];
         }
+    }
+}
 
-        // Make sure that the current file pointer is beyond prevOffset.
-        if (position(bamFile) <= static_cast<__int64>(prevOffset))
-            return false;  // Calculating offsets failed.
+// ----------------------------------------------------------------------------
+// Function buildIndex()
+// ----------------------------------------------------------------------------
 
-        // Update prevOffset and prevPos.
-        prevOffset = position(bamFile);
-        prevPos    = record.beginPos;
-    }
+/*!
+ * @fn BamIndex#buildIndex
+ * @brief Build a BAI index for a coordinate-sorted BAM file.
+ *
+ * @signature bool buildIndex(index, bamFileIn);
+ * @signature bool buildIndex(index, filename);
+ *
+ * @param[out]    index     The @link BaiBamIndex @endlink to build.
+ * @param[in,out] bamFileIn The @link BamFileIn @endlink to read the records from.  The header must already be read.
+ * @param[in]     filename  Path to the BAM file to index.  The index is written to <tt>filename + ".bai"</tt>.
+ *
+ * @return bool true on success, false if the file is not a BAM file, not sorted by coordinate, or writing failed.
+ *
+ * @see BamFileOut#writeRecord
+ */
+
+template <typename TSpec>
+inline bool
+buildIndex(BamIndex<Bai> & index, SmartFile<Bam, Input, TSpec> & bamFile)
+{
+    _baiClear(index);
+    if (!isEqual(format(bamFile), Bam()))
+        return false;
 
-    // Count remaining unaligned records.
+    BamAlignmentRecord record;
     while (!atEnd(bamFile))
     {
-        SEQAN_ASSERT_GT(index._unalignedCount, 0u);
-
+        __uint64 beginOfs = position(bamFile);
         readRecord(record, bamFile);
-        if (record.rID >= 0)
-            return false;  // Could not read record.
-
-        index._unalignedCount += 1;
+        if (!_baiIndexRecord(index, record, beginOfs, position(bamFile)))
+            return false;
     }
 
-    // After loading all alignments, if any data was read, perform checks.
-    if (currRefId >= 0)
-    {
-        // Store last alignment chunk to its bin and then write last reference entry with data.
-        _baiAddAlignmentChunkToBin(index, currBin, currOffset, prevOffset);
+    if (!_baiFinishIndex(index, length(contigNames(context(bamFile)))))
+        return false;
+    _baiCompactIndex(index);
+    return true;
+}
 
-        // Finally, write any empty references remaining at end of file.
-        SEQAN_ASSERT_GEQ(numRefSeqs, length(index._binIndices));
-        BamIndex<Bai>::TBinIndex_ binIndex;
-        resize(index._binIndices, numRefSeqs, binIndex);  // TODO(holtgrew): binIndex is unnecessary if resize used T() as default value as vector.resize() does.
-    }
+inline bool
+buildIndex(BamIndex<Bai> & index, char const * filename)
+{
+    BamFileIn bamFile;
+    if (!open(bamFile, filename))
+        return false;  // Could not open BAM file.
 
-    // Merge small bins if possible.
-    SEQAN_FAIL("TODO: Merge bins!");
+    BamHeader header;
+    readRecord(header, bamFile);
+
+    if (!buildIndex(index, bamFile))
+        return false;
 
-    // Write out index.
     CharString baiFilename(filename);
     append(baiFilename, ".bai");
-    return _saveIndex(index, toCString(baiFilename));
+    return save(index, toCString(baiFilename));
+}
+
+// ----------------------------------------------------------------------------
+// Function writeRecord()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec>
+inline basic_bgzf_streambuf<char> *
+_baiBgzfStreamBuf(SmartFile<Bam, Output, TSpec> & bamFile)
+{
+    if (!isEqual(format(bamFile), Bam()))
+        return NULL;
+    return dynamic_cast<basic_bgzf_streambuf<char> *>(bamFile.stream.rdbuf());
+}
+
+template <typename TSpec>
+inline void
+writeRecord(SmartFile<Bam, Output, TSpec> & bamFile, BamAlignmentRecord const & record, BamIndex<Bai> & index)
+{
+    basic_bgzf_streambuf<char> * streamBuf = _baiBgzfStreamBuf(bamFile);
+    if (streamBuf == NULL)
+    {
+        writeRecord(bamFile, record);
+        index._builder.valid = false;  // Can only index BGZF compressed BAM.
+        return;
+    }
+
+    if (!index._builder.hasRecords)
+        _baiClear(index);
+
+    __uint64 beginPos = streamBuf->blockPosition();
+    writeRecord(bamFile, record);
+    _baiIndexRecord(index, record, beginPos, streamBuf->blockPosition());
+}
+
+// ----------------------------------------------------------------------------
+// Function finalizeIndex()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn BamIndex#finalizeIndex
+ * @brief Complete a BAI index that was built while writing a BAM file.
+ *
+ * @signature bool finalizeIndex(index, bamFileOut);
+ *
+ * @param[in,out] index      The @link BaiBamIndex @endlink that was passed to
+ *                           @link BamFileOut#writeRecord @endlink.
+ * @param[in,out] bamFileOut The @link BamFileOut @endlink the records were written to.
+ *
+ * @return bool true on success, false if the output was not a BAM file or the records were not sorted by coordinate.
+ *
+ * Flushes the compressed stream and translates the recorded block positions into virtual offsets.  Afterwards, the
+ * index can be written with @link BamIndex#save @endlink or used for reading the BAM file.
+ *
+ * @section Example
+ *
+ * @code{.cpp}
+ * BamFileOut bamFileOut("out.bam");
+ * BamIndex<Bai> baiIndex;
+ *
+ * writeRecord(bamFileOut, header);
+ * for (unsigned i = 0; i < length(records); ++i)
+ *     writeRecord(bamFileOut, records[i], baiIndex);
+ *
+ * if (!finalizeIndex(baiIndex, bamFileOut) || !save(baiIndex, "out.bam.bai"))
+ *     std::cerr << "ERROR: Could not write index.\n";
+ * @endcode
+ */
+
+template <typename TSpec>
+inline bool
+finalizeIndex(BamIndex<Bai> & index, SmartFile<Bam, Output, TSpec> & bamFile)
+{
+    basic_bgzf_streambuf<char> * streamBuf = _baiBgzfStreamBuf(bamFile);
+    if (streamBuf == NULL)
+        return false;
+
+    streamBuf->flush();
+
+    if (!_baiFinishIndex(index, length(contigNames(context(bamFile)))))
+        return false;
+    _baiTranslateOffsets(index, *streamBuf);
+    _baiCompactIndex(index);
+    return true;
 }
 
 }  // namespace seqan
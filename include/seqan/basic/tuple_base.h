@@ -157,8 +157,10 @@ struct Tuple<TValue, SIZE, Pack>
         return i[k];
     }
 
+    // A packed member can't be bound to a reference, return a copy instead
+    // of a reference to a temporary.
     template <typename TPos>
-    inline typename StoredTupleValue_<TValue>::Type const &
+    inline typename StoredTupleValue_<TValue>::Type
     operator[](TPos k) const
     {
         SEQAN_ASSERT_GEQ(static_cast<__int64>(k), 0);
@@ -307,6 +307,118 @@ struct LessMsaEdgeCargo_ :
 
 //////////////////////////////////////////////////////////////////////////////
 
+// The triplet extension collects the new edges in maps that are partitioned by the first vertex of an
+// edge, partition i holds the edges (v1, v2) with i * partitionSpan <= v1 < (i + 1) * partitionSpan.
+// The weights of the out-edges of a vertex are computed in parallel, the partitions are updated in
+// parallel, and each weight is added in the same order as by a sequential extension.
+
+template<typename TGraph, typename TEdgeMaps>
+inline typename VertexDescriptor<TGraph>::Type
+_initTripletEdgeMaps(TGraph const& g,
+					 TEdgeMaps& edgeMaps)
+{
+	typedef typename VertexDescriptor<TGraph>::Type TVertexDescriptor;
+
+	TVertexDescriptor nParts = omp_get_max_threads();
+	TVertexDescriptor nVertices = getIdUpperBound(_getVertexIdManager(g));
+	clear(edgeMaps);
+	resize(edgeMaps, nParts, Exact());
+	return _max((nVertices + nParts - 1) / nParts, (TVertexDescriptor) 1);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TGraph, typename TEdgeString, typename TEdgeMaps, typename TVertexDescriptor>
+inline void
+_tripletLibraryExtension(TGraph const& g,
+						 TEdgeString const& fullEdges,
+						 TEdgeMaps& edgeMaps,
+						 TVertexDescriptor partitionSpan)
+{
+	typedef typename Value<TEdgeString>::Type TEdge;
+	typedef typename Value<TEdgeMaps>::Type TEdgeMap;
+	typedef typename TEdgeMap::iterator TEdgeMapIter;
+	typedef typename TEdgeMap::key_type TNewEdge;
+	typedef typename TEdgeMap::mapped_type TCargo;
+	typedef typename Size<TEdgeString>::Type TSize;
+	typedef typename Iterator<TEdgeString const, Standard>::Type TEdgeIter;
+	typedef String<TEdge> TEdgeBuffer;
+	typedef typename Iterator<TEdgeBuffer, Standard>::Type TBufferIter;
+
+	// Begin of the out-edges of each vertex
+	String<TSize> vertexBegin;
+	for(TSize i = 0; i < length(fullEdges); ++i)
+		if ((i == 0) || (fullEdges[i].v1 != fullEdges[i - 1].v1)) appendValue(vertexBegin, i, Generous());
+	appendValue(vertexBegin, length(fullEdges), Generous());
+	TSize nVertices = length(vertexBegin) - 1;
+
+	// Vertices are processed in blocks of chunks, the new edges are buffered per chunk and partition
+	TSize const chunkSize = 256;
+	TSize const blockSize = 64 * chunkSize;
+	int nParts = length(edgeMaps);
+	String<TEdgeBuffer> buffers;
+	resize(buffers, 64 * nParts);
+	for(TSize blockBegin = 0; blockBegin < nVertices; blockBegin += blockSize) {
+		TSize blockEnd = _min(blockBegin + blockSize, nVertices);
+		int nChunks = (blockEnd - blockBegin + chunkSize - 1) / chunkSize;
+
+		// Collect the new edges of each vertex
+		SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+		for(int chunk = 0; chunk < nChunks; ++chunk) {
+			TSize vEnd = _min(blockBegin + (chunk + 1) * chunkSize, blockEnd);
+			for(TSize v = blockBegin + chunk * chunkSize; v < vEnd; ++v) {
+				TEdgeIter itEdges1 = begin(fullEdges, Standard()) + vertexBegin[v];
+				TEdgeIter itEdgesEnd = begin(fullEdges, Standard()) + vertexBegin[v + 1];
+				for(; itEdges1 != itEdgesEnd; ++itEdges1) {
+					for(TEdgeIter itEdges2 = itEdges1; ++itEdges2 != itEdgesEnd;) {
+						if (sequenceId(g, (*itEdges1).v2) != sequenceId(g, (*itEdges2).v2)) {
+							TCargo weight = ((*itEdges1).c < (*itEdges2).c) ? (*itEdges1).c : (*itEdges2).c;
+							TVertexDescriptor first = _min((*itEdges1).v2, (*itEdges2).v2);
+							TVertexDescriptor second = _max((*itEdges1).v2, (*itEdges2).v2);
+							appendValue(buffers[chunk * nParts + first / partitionSpan], TEdge(first, second, weight), Generous());
+						}
+					}
+				}
+			}
+		}
+
+		// Add the new edges to the edge maps
+		SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+		for(int part = 0; part < nParts; ++part) {
+			TEdgeMap& newEMap = edgeMaps[part];
+			for(int chunk = 0; chunk < nChunks; ++chunk) {
+				TEdgeBuffer& buffer = buffers[chunk * nParts + part];
+				for(TBufferIter itBuf = begin(buffer, Standard()); itBuf != end(buffer, Standard()); ++itBuf) {
+					TEdgeMapIter pos = newEMap.find(TNewEdge((*itBuf).v1, (*itBuf).v2));
+					if (pos != newEMap.end()) (*pos).second += (*itBuf).c;
+					else newEMap.insert(std::make_pair(TNewEdge((*itBuf).v1, (*itBuf).v2), (*itBuf).c));
+				}
+				clear(buffer);
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TGraph, typename TEdgeMaps>
+inline void
+_insertTripletEdges(TGraph& g,
+					TEdgeMaps& edgeMaps)
+{
+	typedef typename Value<TEdgeMaps>::Type TEdgeMap;
+	typedef typename TEdgeMap::iterator TEdgeMapIter;
+
+	for(unsigned part = 0; part < length(edgeMaps); ++part) {
+		TEdgeMap& newEMap = edgeMaps[part];
+		for(TEdgeMapIter itE = newEMap.begin(); itE != newEMap.end(); ++itE) 
+			addEdge(g, (*itE).first.first, (*itE).first.second, (*itE).second);
+		newEMap.clear();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
 /*!
  * @fn tripletLibraryExtension
  * @headerfile <seqan/graph_msa.h>
@@ -334,8 +446,8 @@ tripletLibraryExtension(Graph<Alignment<TStringSet, TCargo, TSpec> >& g)
 	// Store all edges
 	typedef std::pair<TVertexDescriptor, TVertexDescriptor> TNewEdge;
 	typedef std::map<TNewEdge, TCargo> TEdgeMap;
-	typedef typename TEdgeMap::iterator TEdgeMapIter;
-	TEdgeMap newEMap;
+	String<TEdgeMap> edgeMaps;
+	TVertexDescriptor partitionSpan = _initTripletEdgeMaps(g, edgeMaps);
 	typedef MsaEdgeCargo_<TVertexDescriptor, TCargo> TEdge;
 	typedef String<TEdge> TEdgeString;
 	TEdgeString fullEdges;
@@ -346,37 +458,17 @@ tripletLibraryExtension(Graph<Alignment<TStringSet, TCargo, TSpec> >& g)
 		TCargo c = cargo(*itE);
 		appendValue(fullEdges, TEdge(sV, tV, c), Generous());
 		appendValue(fullEdges, TEdge(tV, sV, c), Generous());
-		newEMap.insert(std::make_pair(TNewEdge(sV, tV), c));
+		edgeMaps[sV / partitionSpan].insert(std::make_pair(TNewEdge(sV, tV), c));
 	}
 	clearEdges(g);
 	std::sort(begin(fullEdges, Standard()), end(fullEdges, Standard()), LessMsaEdgeCargo_<TVertexDescriptor, TCargo>() );
 	
 	// Perform triplet extension
-	typedef typename Iterator<TEdgeString, Standard>::Type TEdgeIter;
-	TEdgeIter itEdges1 = begin(fullEdges, Standard());
-	TEdgeIter itEdgesEnd = end(fullEdges, Standard());
-	for(; itEdges1 != itEdgesEnd; ++itEdges1) {
-		for(TEdgeIter itEdges2 = itEdges1; ++itEdges2 != itEdgesEnd;) {
-			if ((*itEdges1).v1 != (*itEdges2).v1) break;
-			if (sequenceId(g, (*itEdges1).v2) != sequenceId(g, (*itEdges2).v2)) {
-				TCargo weight = ((*itEdges1).c < (*itEdges2).c) ? (*itEdges1).c : (*itEdges2).c;
-				if ((*itEdges1).v2 < (*itEdges2).v2) {
-					TEdgeMapIter pos = newEMap.find(TNewEdge((*itEdges1).v2, (*itEdges2).v2));
-					if (pos != newEMap.end()) (*pos).second += weight;
-					else newEMap.insert(std::make_pair(TNewEdge((*itEdges1).v2, (*itEdges2).v2), weight));
-				} else {
-					TEdgeMapIter pos = newEMap.find(TNewEdge((*itEdges2).v2, (*itEdges1).v2));
-					if (pos != newEMap.end()) (*pos).second += weight;
-					else newEMap.insert(std::make_pair(TNewEdge((*itEdges2).v2, (*itEdges1).v2), weight));
-				}	
-			}
-		}
-	}
+	_tripletLibraryExtension(g, fullEdges, edgeMaps, partitionSpan);
 	clear(fullEdges);
 
 	// Insert edges
-	for(TEdgeMapIter itE = newEMap.begin(); itE != newEMap.end(); ++itE) 
-		addEdge(g, (*itE).first.first, (*itE).first.second, (*itE).second);
+	_insertTripletEdges(g, edgeMaps);
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -552,8 +644,8 @@ tripletLibraryExtension(Graph<Alignment<TStringSet, TCargo, TSpec> >& g,
 	// Store all edges
 	typedef std::pair<TVertexDescriptor, TVertexDescriptor> TNewEdge;
 	typedef std::map<TNewEdge, TCargo> TEdgeMap;
-	typedef typename TEdgeMap::iterator TEdgeMapIter;
-	TEdgeMap newEMap;
+	String<TEdgeMap> edgeMaps;
+	TVertexDescriptor partitionSpan = _initTripletEdgeMaps(g, edgeMaps);
 	typedef MsaEdgeCargo_<TVertexDescriptor, TCargo> TEdge;
 	typedef String<TEdge> TEdgeString;
 	TEdgeString initialEdges;
@@ -563,7 +655,7 @@ tripletLibraryExtension(Graph<Alignment<TStringSet, TCargo, TSpec> >& g,
 		TVertexDescriptor tV = targetVertex(itE);
 		TCargo c = cargo(*itE);
 		appendValue(initialEdges, TEdge(sV, tV, c), Generous());
-		newEMap.insert(std::make_pair(TNewEdge(sV, tV), c));
+		edgeMaps[sV / partitionSpan].insert(std::make_pair(TNewEdge(sV, tV), c));
 	}
 	clearEdges(g);
 
@@ -583,32 +675,12 @@ tripletLibraryExtension(Graph<Alignment<TStringSet, TCargo, TSpec> >& g,
 			}
 		}
 		std::sort(begin(fullEdges, Standard()), end(fullEdges, Standard()), LessMsaEdgeCargo_<TVertexDescriptor, TCargo>() );
-		typedef typename Iterator<TEdgeString, Standard>::Type TEdgeIter;
-		TEdgeIter itEdges1 = begin(fullEdges, Standard());
-		TEdgeIter itEdgesEnd = end(fullEdges, Standard());
-		for(; itEdges1 != itEdgesEnd; ++itEdges1) {
-			for(TEdgeIter itEdges2 = itEdges1; ++itEdges2 != itEdgesEnd;) {
-				if ((*itEdges1).v1 != (*itEdges2).v1) break;
-				if (sequenceId(g, (*itEdges1).v2) != sequenceId(g, (*itEdges2).v2)) {
-					TCargo weight = ((*itEdges1).c < (*itEdges2).c) ? (*itEdges1).c : (*itEdges2).c;
-					if ((*itEdges1).v2 < (*itEdges2).v2) {
-						TEdgeMapIter pos = newEMap.find(TNewEdge((*itEdges1).v2, (*itEdges2).v2));
-						if (pos != newEMap.end()) (*pos).second += weight;
-						else newEMap.insert(std::make_pair(TNewEdge((*itEdges1).v2, (*itEdges2).v2), weight));
-					} else {
-						TEdgeMapIter pos = newEMap.find(TNewEdge((*itEdges2).v2, (*itEdges1).v2));
-						if (pos != newEMap.end()) (*pos).second += weight;
-						else newEMap.insert(std::make_pair(TNewEdge((*itEdges2).v2, (*itEdges1).v2), weight));
-					}
-				}
-			}
-		}
+		_tripletLibraryExtension(g, fullEdges, edgeMaps, partitionSpan);
 		clear(fullEdges);
 	}
 
 	// Insert edges
-	for(TEdgeMapIter itE = newEMap.begin(); itE != newEMap.end(); ++itE) 
-		addEdge(g, (*itE).first.first, (*itE).first.second, (*itE).second);
+	_insertTripletEdges(g, edgeMaps);
 }
 
 //////////////////////////////////////////////////////////////////////////////
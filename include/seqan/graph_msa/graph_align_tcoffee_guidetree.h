@@ -900,6 +900,326 @@ upgmaTree(TDistance& dist,
 }
 
 
+//////////////////////////////////////////////////////////////////////////////
+// mBed
+//////////////////////////////////////////////////////////////////////////////
+
+// K-mer distance of two sorted k-mer strings, see getKmerSimilarityMatrix.
+
+template<typename TTupelString>
+inline double
+_mbedKmerDistance(TTupelString const& tup1,
+				  TTupelString const& tup2)
+{
+	typedef typename Iterator<TTupelString const, Standard>::Type TIter;
+
+	double minVal = _min(length(tup1), length(tup2));
+	if (minVal == 0) return SEQAN_DISTANCE_UNITY;
+
+	// Number of common k-mers
+	double common = 0;
+	TIter it1 = begin(tup1, Standard());
+	TIter it1End = end(tup1, Standard());
+	TIter it2 = begin(tup2, Standard());
+	TIter it2End = end(tup2, Standard());
+	while ((it1 != it1End) && (it2 != it2End)) {
+		if (*it1 < *it2) ++it1;
+		else if (*it2 < *it1) ++it2;
+		else {
+			++common;
+			++it1;
+			++it2;
+		}
+	}
+	return SEQAN_DISTANCE_UNITY - (common * SEQAN_DISTANCE_UNITY) / minVal;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TSize>
+inline double
+_mbedSquaredDistance(String<double> const& coords,
+					 TSize point,
+					 String<double> const& center,
+					 TSize dim)
+{
+	double dist = 0;
+	for(TSize d = 0; d < dim; ++d) {
+		double diff = coords[point * dim + d] - center[d];
+		dist += diff * diff;
+	}
+	return dist;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Splits the members in two clusters with 2-means in the embedding space.  Returns the distance of the two
+// cluster centers.  Members that cannot be separated are split in halves.
+
+template<typename TMembers, typename TSize>
+inline double
+_mbedBisect(TMembers& left,
+			TMembers& right,
+			TMembers const& members,
+			String<double> const& coords,
+			TSize dim)
+{
+	TSize n = length(members);
+	String<double> center0;
+	String<double> center1;
+	resize(center0, dim, 0.0);
+	resize(center1, dim, 0.0);
+
+	// The first center is the member farthest from the mean, the second one the member farthest from the first
+	for(TSize i = 0; i < n; ++i)
+		for(TSize d = 0; d < dim; ++d) center1[d] += coords[members[i] * dim + d] / n;
+	TSize far0 = 0;
+	double maxDist = -1;
+	for(TSize i = 0; i < n; ++i) {
+		double dist = _mbedSquaredDistance(coords, (TSize) members[i], center1, dim);
+		if (dist > maxDist) { maxDist = dist; far0 = members[i]; }
+	}
+	for(TSize d = 0; d < dim; ++d) center0[d] = coords[far0 * dim + d];
+	TSize far1 = far0;
+	maxDist = 0;
+	for(TSize i = 0; i < n; ++i) {
+		double dist = _mbedSquaredDistance(coords, (TSize) members[i], center0, dim);
+		if (dist > maxDist) { maxDist = dist; far1 = members[i]; }
+	}
+	for(TSize d = 0; d < dim; ++d) center1[d] = coords[far1 * dim + d];
+
+	// Lloyd iterations
+	String<bool> side;
+	resize(side, n, false);
+	TSize size1 = 0;
+	TSize moved = (far0 != far1) ? 1 : 0;
+	for(unsigned iter = 0; (moved != 0) && (iter < 20); ++iter) {
+		moved = 0;
+		size1 = 0;
+		SEQAN_OMP_PRAGMA(parallel for reduction(+:moved, size1) if(n * dim > 100000))
+		for(int i = 0; i < (int) n; ++i) {
+			bool s = _mbedSquaredDistance(coords, (TSize) members[i], center1, dim) < _mbedSquaredDistance(coords, (TSize) members[i], center0, dim);
+			if (s != side[i]) {
+				side[i] = s;
+				++moved;
+			}
+			if (s) ++size1;
+		}
+		if ((size1 == 0) || (size1 == n)) break;
+
+		// New centers
+		arrayFill(begin(center0, Standard()), end(center0, Standard()), 0.0);
+		arrayFill(begin(center1, Standard()), end(center1, Standard()), 0.0);
+		for(TSize i = 0; i < n; ++i) {
+			if (side[i])
+				for(TSize d = 0; d < dim; ++d) center1[d] += coords[members[i] * dim + d] / size1;
+			else
+				for(TSize d = 0; d < dim; ++d) center0[d] += coords[members[i] * dim + d] / (n - size1);
+		}
+	}
+
+	clear(left);
+	clear(right);
+	if ((size1 == 0) || (size1 == n)) {
+		for(TSize i = 0; i < n; ++i) appendValue((i < n / 2) ? left : right, members[i]);
+		return 0;
+	}
+	for(TSize i = 0; i < n; ++i) appendValue(side[i] ? right : left, members[i]);
+	double centerDist = 0;
+	for(TSize d = 0; d < dim; ++d) centerDist += (center0[d] - center1[d]) * (center0[d] - center1[d]);
+	return std::sqrt(centerDist / dim);
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+// Adds the guide tree of a small cluster to the tree and returns its root.  The leaves of the subtree are the
+// members of the cluster.
+
+template<typename TCargo, typename TSpec, typename TMembers>
+inline typename VertexDescriptor<Graph<Tree<TCargo, TSpec> > >::Type
+_mbedInsertSubTree(Graph<Tree<TCargo, TSpec> >& tree,
+				   Graph<Tree<TCargo, TSpec> >& subTree,
+				   TMembers const& members)
+{
+	typedef Graph<Tree<TCargo, TSpec> > TTree;
+	typedef typename VertexDescriptor<TTree>::Type TVertexDescriptor;
+	typedef typename Iterator<TTree, OutEdgeIterator>::Type TOutEdgeIterator;
+
+	TVertexDescriptor nVertices = numVertices(subTree);
+	String<TVertexDescriptor> vertexMap;
+	resize(vertexMap, nVertices);
+	for(TVertexDescriptor v = 0; v < nVertices; ++v)
+		vertexMap[v] = (v < (TVertexDescriptor) length(members)) ? (TVertexDescriptor) members[v] : addVertex(tree);
+	for(TVertexDescriptor v = 0; v < nVertices; ++v)
+		for(TOutEdgeIterator itOut(subTree, v); !atEnd(itOut); goNext(itOut))
+			addEdge(tree, vertexMap[v], vertexMap[targetVertex(itOut)], cargo(*itOut));
+	return vertexMap[getRoot(subTree)];
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+/*!
+ * @fn mbedTree
+ * @headerfile <seqan/graph_msa.h>
+ * @brief Computes a guide tree for large sets of sequences without a full distance matrix.
+ *
+ * @signature void mbedTree(strSet, tree[, ktup, clusterSize][, alphabet]);
+ *
+ * @param[in]  strSet      A @link StringSet @endlink with the sequences.
+ * @param[out] tree        The resulting guide tree, leaf <tt>i</tt> is the sequence at position <tt>i</tt>.
+ * @param[in]  ktup        The length of the k-mers.  Default: 3.
+ * @param[in]  clusterSize The maximal number of sequences in a cluster.  Default: 100.
+ * @param[in]  alphabet    The alphabet used for k-mer counting (e.g. compressed alphabets).
+ *
+ * Each sequence is embedded as the vector of its k-mer distances to <tt>log2(n)^2</tt> seed sequences, which are
+ * taken at equal steps from the sequences sorted by length (mBed).  The vectors are bisected recursively with
+ * 2-means until the clusters have at most <tt>clusterSize</tt> members.  Only within these clusters a full k-mer
+ * distance matrix is computed and clustered with UPGMA (@link UpgmaConfiguratorTags#UpgmaAvg @endlink).
+ *
+ * Time and memory are in <tt>O(n log(n)^2)</tt> plus <tt>O(n * clusterSize)</tt> for the clusters.
+ */
+
+template<typename TString, typename TStrSpec, typename TCargo, typename TSpec, typename TSize, typename TAlphabet>
+inline void
+mbedTree(StringSet<TString, TStrSpec> const& strSet,
+		 Graph<Tree<TCargo, TSpec> >& tree,
+		 TSize ktup,
+		 TSize clusterSize,
+		 TAlphabet)
+{
+	typedef Graph<Tree<TCargo, TSpec> > TTree;
+	typedef typename VertexDescriptor<TTree>::Type TVertexDescriptor;
+	typedef String<TSize> TTupelString;
+	typedef String<TSize> TMembers;
+
+	// One leaf for each sequence
+	TSize nseq = length(strSet);
+	clearVertices(tree);
+	for(TSize i = 0; i < nseq; ++i) addVertex(tree);
+	if (nseq == 0) return;
+	if (nseq == 1) {
+		assignRoot(tree, 0);
+		return;
+	}
+	clusterSize = _max(clusterSize, (TSize) 1);
+
+	// Sorted k-mers of all sequences
+	String<TTupelString> tupSet;
+	resize(tupSet, nseq);
+	SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 64))
+	for(int i = 0; i < (int) nseq; ++i) {
+		_getTupelString(strSet[i], tupSet[i], ktup, TAlphabet());
+		std::sort(begin(tupSet[i], Standard()), end(tupSet[i], Standard()));
+	}
+
+	// Seed sequences, taken at equal steps from the sequences sorted by length
+	double log2n = std::log((double) nseq) / std::log(2.0);
+	TSize dim = _max(_min((TSize) (log2n * log2n), nseq), (TSize) 1);
+	String<Pair<TSize, TSize> > byLength;
+	resize(byLength, nseq);
+	for(TSize i = 0; i < nseq; ++i) byLength[i] = Pair<TSize, TSize>(length(strSet[i]), i);
+	std::sort(begin(byLength, Standard()), end(byLength, Standard()));
+	TMembers seeds;
+	resize(seeds, dim);
+	for(TSize s = 0; s < dim; ++s) seeds[s] = byLength[(s * nseq) / dim].i2;
+	clear(byLength);
+
+	// Embed each sequence by its distances to the seeds
+	String<double> coords;
+	resize(coords, nseq * dim);
+	SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 64))
+	for(int i = 0; i < (int) nseq; ++i)
+		for(TSize s = 0; s < dim; ++s)
+			coords[i * dim + s] = _mbedKmerDistance(tupSet[i], tupSet[seeds[s]]);
+
+	// Bisect the clusters until they are small, each bisection is an inner node of the tree
+	TVertexDescriptor nilVertex = getNil<TVertexDescriptor>();
+	String<TMembers> clusters;
+	String<TVertexDescriptor> clusterParent;
+	String<TCargo> clusterCargo;
+	String<TMembers> stackMembers;
+	String<TVertexDescriptor> stackParent;
+	String<TCargo> stackCargo;
+	resize(stackMembers, 1);
+	for(TSize i = 0; i < nseq; ++i) appendValue(stackMembers[0], i);
+	appendValue(stackParent, nilVertex);
+	appendValue(stackCargo, (TCargo) 0);
+	while (!empty(stackMembers)) {
+		TMembers members = back(stackMembers);
+		TVertexDescriptor parent = back(stackParent);
+		TCargo parentCargo = back(stackCargo);
+		eraseBack(stackMembers);
+		eraseBack(stackParent);
+		eraseBack(stackCargo);
+
+		if (length(members) <= clusterSize) {
+			appendValue(clusters, members);
+			appendValue(clusterParent, parent);
+			appendValue(clusterCargo, parentCargo);
+			continue;
+		}
+
+		TVertexDescriptor internalNode = addVertex(tree);
+		if (parent == nilVertex) assignRoot(tree, internalNode);
+		else addEdge(tree, parent, internalNode, parentCargo);
+
+		TMembers left;
+		TMembers right;
+		TCargo w = (TCargo) (_mbedBisect(left, right, members, coords, dim) * SEQAN_DISTANCE_UNITY / 2);
+		appendValue(stackMembers, right);
+		appendValue(stackParent, internalNode);
+		appendValue(stackCargo, w);
+		appendValue(stackMembers, left);
+		appendValue(stackParent, internalNode);
+		appendValue(stackCargo, w);
+	}
+	clear(stackMembers);
+	clear(coords);
+
+	// Guide trees of the small clusters from their k-mer distance matrices
+	String<TTree> subTrees;
+	resize(subTrees, length(clusters));
+	SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+	for(int c = 0; c < (int) length(clusters); ++c) {
+		TMembers const& members = clusters[c];
+		TSize n = length(members);
+		String<double> mat;
+		resize(mat, n * n, 0.0);
+		for(TSize i = 0; i < n; ++i)
+			for(TSize j = i + 1; j < n; ++j)
+				mat[i * n + j] = _mbedKmerDistance(tupSet[members[i]], tupSet[members[j]]);
+		upgmaTree(mat, subTrees[c], UpgmaAvg());
+	}
+
+	// Insert them
+	for(TSize c = 0; c < length(clusters); ++c) {
+		TVertexDescriptor subRoot = _mbedInsertSubTree(tree, subTrees[c], clusters[c]);
+		if (clusterParent[c] == nilVertex) assignRoot(tree, subRoot);
+		else addEdge(tree, clusterParent[c], subRoot, clusterCargo[c]);
+	}
+}
+
+template<typename TString, typename TStrSpec, typename TCargo, typename TSpec, typename TSize>
+inline void
+mbedTree(StringSet<TString, TStrSpec> const& strSet,
+		 Graph<Tree<TCargo, TSpec> >& tree,
+		 TSize ktup,
+		 TSize clusterSize)
+{
+	SEQAN_CHECKPOINT
+	mbedTree(strSet, tree, ktup, clusterSize, typename Value<TString>::Type());
+}
+
+template<typename TString, typename TStrSpec, typename TCargo, typename TSpec>
+inline void
+mbedTree(StringSet<TString, TStrSpec> const& strSet,
+		 Graph<Tree<TCargo, TSpec> >& tree)
+{
+	SEQAN_CHECKPOINT
+	mbedTree(strSet, tree, 3u, 100u);
+}
+
+
 }// namespace SEQAN_NAMESPACE_MAIN
 
 #endif //#ifndef SEQAN_HEADER_...
@@ -490,6 +490,54 @@ selectPairs(StringSet<TString, TSpec> const& str,
 }
 
 
+//////////////////////////////////////////////////////////////////////////////
+// Parallel pairwise alignments
+//////////////////////////////////////////////////////////////////////////////
+
+// The pairs of the pair list are aligned in blocks.  The pairs of a block are aligned in parallel into
+// separate buffers, which are then appended in the order of the pair list.  Thus, the segment matches
+// do not depend on the number of threads.
+
+template<typename TSize = unsigned>
+struct PairwiseLibraryBlockSize_
+{
+	static const TSize VALUE = 1024;
+};
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TString, typename TSpec, typename TSize2, typename TSpec2, typename TPos>
+inline void
+_assignPairSet(StringSet<TString, Dependent<TSpec> >& pairSet,
+			   StringSet<TString, Dependent<TSpec> > const& str,
+			   String<TSize2, TSpec2> const& pList,
+			   TPos pairNo)
+{
+	typedef StringSet<TString, Dependent<TSpec> > TStringSet;
+	clear(pairSet);
+	assignValueById(pairSet, const_cast<TStringSet&>(str), positionToId(str, pList[2 * pairNo]));
+	assignValueById(pairSet, const_cast<TStringSet&>(str), positionToId(str, pList[2 * pairNo + 1]));
+}
+
+//////////////////////////////////////////////////////////////////////////////
+
+template<typename TSegmentMatches, typename TScoreValues, typename TSize>
+inline void
+_appendPairwiseBlock(TSegmentMatches& matches,
+					 TScoreValues& scores,
+					 String<TSegmentMatches>& blockMatches,
+					 String<TScoreValues>& blockScores,
+					 TSize blockLength)
+{
+	for(TSize k = 0; k < blockLength; ++k) {
+		append(matches, blockMatches[k], Generous());
+		append(scores, blockScores[k], Generous());
+		clear(blockMatches[k]);
+		clear(blockScores[k]);
+	}
+}
+
+
 //////////////////////////////////////////////////////////////////////////////
 // Alignment statistics
 //////////////////////////////////////////////////////////////////////////////
@@ -529,8 +577,8 @@ getAlignmentStatistics(String<TFragment, TSpec1> const& matches,
 	TFragIter itFragEnd = itFrag;
 	itFrag += from;
 	itFragEnd += to;
-	TId id1 = sequenceId(*itFrag, 0);
-	TId id2 = sequenceId(*itFrag, 1);
+	TId id1 = (itFrag != itFragEnd) ? sequenceId(*itFrag, 0) : 0;
+	TId id2 = (itFrag != itFragEnd) ? sequenceId(*itFrag, 1) : 0;
 	TSize fragLen = 0;
 	TSize beginI = 0;
 	TSize beginJ = 0;
@@ -573,38 +621,35 @@ appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
 					 LcsLibrary)
 {
 	typedef StringSet<TString, Dependent<TSpec> > TStringSet;
-	typedef String<TSize2, TSpec2> TPairList;
 	typedef typename Size<TStringSet>::Type TSize;
-	typedef typename Id<TStringSet>::Type TId;
-	//typedef typename Value<TSegmentMatches>::Type TFragment;
-	//typedef typename Value<TScores>::Type TScoreValue;
-	typedef typename Iterator<TPairList const, Standard>::Type TPairIter;
+	typedef typename Iterator<TSegmentMatches, Standard>::Type TMatchIter;
+	typedef typename Iterator<TScores, Standard>::Type TScoreIter;
 
 	// Pairwise longest common subsequence
-	TPairIter itPair = begin(pList, Standard());
-	TPairIter itPairEnd = end(pList, Standard());
-	for(;itPair != itPairEnd; ++itPair) {
-		TStringSet pairSet;
-		TId id1 = positionToId(str, *itPair); ++itPair;
-		TId id2 = positionToId(str, *itPair);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
-
-		// Lcs between first and second string
-		TSize from = length(matches);
-		globalAlignment(matches, pairSet, Lcs());
-		TSize to = length(matches);
-
-		// Record the scores
-		resize(scores, to);
-		typedef typename Iterator<TSegmentMatches, Standard>::Type TMatchIter;
-		typedef typename Iterator<TScores, Standard>::Type TScoreIter;
-		TScoreIter itScore = begin(scores, Standard());
-		TScoreIter itScoreEnd = end(scores, Standard());
-		TMatchIter itMatch = begin(matches, Standard());
-		itScore+=from;
-		itMatch+=from;
-		for(;itScore != itScoreEnd; ++itScore, ++itMatch) *itScore = (*itMatch).len;
+	TSize nPairs = length(pList) / 2;
+	TSize blockSize = PairwiseLibraryBlockSize_<TSize>::VALUE;
+	String<TSegmentMatches> blockMatches;
+	String<TScores> blockScores;
+	resize(blockMatches, _min(nPairs, blockSize));
+	resize(blockScores, _min(nPairs, blockSize));
+	for(TSize blockBegin = 0; blockBegin < nPairs; blockBegin += blockSize) {
+		int blockLength = _min(nPairs - blockBegin, blockSize);
+		SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+		for(int k = 0; k < blockLength; ++k) {
+			TStringSet pairSet;
+			_assignPairSet(pairSet, str, pList, blockBegin + k);
+
+			// Lcs between first and second string
+			globalAlignment(blockMatches[k], pairSet, Lcs());
+
+			// Record the scores
+			resize(blockScores[k], length(blockMatches[k]));
+			TScoreIter itScore = begin(blockScores[k], Standard());
+			TScoreIter itScoreEnd = end(blockScores[k], Standard());
+			TMatchIter itMatch = begin(blockMatches[k], Standard());
+			for(;itScore != itScoreEnd; ++itScore, ++itMatch) *itScore = (*itMatch).len;
+		}
+		_appendPairwiseBlock(matches, scores, blockMatches, blockScores, (TSize) blockLength);
 	}
 }
 
@@ -708,23 +753,26 @@ appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
 					 LocalPairwiseLibrary)
 {
 	typedef StringSet<TString, Dependent<TSpec> > TStringSet;
-	typedef String<TSize2, TSpec2> TPairList;
-	//typedef typename Size<TStringSet>::Type TSize;
-	typedef typename Id<TStringSet>::Type TId;
-	typedef typename Iterator<TPairList const, Standard>::Type TPairIter;
+	typedef typename Size<TStringSet>::Type TSize;
 
 	// Pairwise alignments
-	TPairIter itPair = begin(pList, Standard());
-	TPairIter itPairEnd = end(pList, Standard());
-	for(;itPair != itPairEnd; ++itPair) {
-		// Make a pairwise string-set
-		TStringSet pairSet;
-		TId id1 = positionToId(str, *itPair); ++itPair;
-		TId id2 = positionToId(str, *itPair);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
-
-		_multiLocalAlignment(pairSet, matches, scores, score_type, 4, SmithWatermanClump());
+	TSize nPairs = length(pList) / 2;
+	TSize blockSize = PairwiseLibraryBlockSize_<TSize>::VALUE;
+	String<TSegmentMatches> blockMatches;
+	String<TScores> blockScores;
+	resize(blockMatches, _min(nPairs, blockSize));
+	resize(blockScores, _min(nPairs, blockSize));
+	for(TSize blockBegin = 0; blockBegin < nPairs; blockBegin += blockSize) {
+		int blockLength = _min(nPairs - blockBegin, blockSize);
+		SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+		for(int k = 0; k < blockLength; ++k) {
+			// Make a pairwise string-set
+			TStringSet pairSet;
+			_assignPairSet(pairSet, str, pList, blockBegin + k);
+
+			_multiLocalAlignment(pairSet, blockMatches[k], blockScores[k], score_type, 4, SmithWatermanClump());
+		}
+		_appendPairwiseBlock(matches, scores, blockMatches, blockScores, (TSize) blockLength);
 	}
 }
 
@@ -846,41 +894,40 @@ appendSegmentMatches(StringSet<TString, Dependent<TSpec> > const& str,
 {
 	SEQAN_CHECKPOINT
 	typedef StringSet<TString, Dependent<TSpec> > TStringSet;
-	typedef typename Id<TStringSet>::Type TId;
 	typedef typename Size<TStringSet>::Type TSize;
 	typedef typename Value<TScoreValues>::Type TScoreValue;
-	typedef typename Iterator<String<TSize2, TSpec2> const, Standard>::Type TPairIter;
 
 	// Initialization
 	TSize nseq = length(str);
 	_resizeWithRespectToDistance(dist, nseq);
 	
 	// Pairwise alignments
-	TPairIter itPair = begin(pList, Standard());
-	TPairIter itPairEnd = end(pList, Standard());
-	for(;itPair != itPairEnd; ++itPair) {
-		// Make a pairwise string-set
-		TStringSet pairSet;
-		TId id1 = positionToId(str, *itPair); ++itPair;
-		TId id2 = positionToId(str, *itPair);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id1);
-		assignValueById(pairSet, const_cast<TStringSet&>(str), id2);
-				
-		// Alignment
-		TSize from = length(matches);
-		TScoreValue myScore = globalAlignment(matches, pairSet, score_type, ac, Gotoh() );
-		TSize to = length(matches);
+	TSize nPairs = length(pList) / 2;
+	TSize blockSize = PairwiseLibraryBlockSize_<TSize>::VALUE;
+	String<TSegmentMatches> blockMatches;
+	String<TScoreValues> blockScores;
+	resize(blockMatches, _min(nPairs, blockSize));
+	resize(blockScores, _min(nPairs, blockSize));
+	for(TSize blockBegin = 0; blockBegin < nPairs; blockBegin += blockSize) {
+		int blockLength = _min(nPairs - blockBegin, blockSize);
+		SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+		for(int k = 0; k < blockLength; ++k) {
+			// Make a pairwise string-set
+			TStringSet pairSet;
+			_assignPairSet(pairSet, str, pList, blockBegin + k);
+
+			// Alignment and scores
+			TScoreValue myScore = globalAlignment(blockMatches[k], pairSet, score_type, ac, Gotoh() );
+			resize(blockScores[k], length(blockMatches[k]), myScore);
+		}
 
-		// Record the scores
-		resize(scores, to);
-		typedef typename Iterator<TScoreValues, Standard>::Type TScoreIter;
-		TScoreIter itScore = begin(scores, Standard());
-		TScoreIter itScoreEnd = end(scores, Standard());
-		itScore+=from;
-		for(;itScore != itScoreEnd; ++itScore) *itScore = myScore;
-			
-		// Get the alignment statistics
-		_setDistanceValue(matches, pairSet, dist, (TSize) *(itPair-1), (TSize) *itPair, (TSize) nseq, (TSize)from);
+		// Get the alignment statistics, the distance may be a graph
+		for(int k = 0; k < blockLength; ++k) {
+			TStringSet pairSet;
+			_assignPairSet(pairSet, str, pList, blockBegin + k);
+			_setDistanceValue(blockMatches[k], pairSet, dist, (TSize) pList[2 * (blockBegin + k)], (TSize) pList[2 * (blockBegin + k) + 1], (TSize) nseq, (TSize) 0);
+		}
+		_appendPairwiseBlock(matches, scores, blockMatches, blockScores, (TSize) blockLength);
 	}
 }
 
@@ -85,7 +85,7 @@ public:
      * @brief Methods for computing guide tre.
      *
      * 0 Neighbor-joining, 1 UPGMA single linkage, 2 UPGMA complete linkage,
-     * 3 UPGMA average linkage, 4 UPGMA weighted average linkage.
+     * 3 UPGMA average linkage, 4 UPGMA weighted average linkage, 5 mBed (see @link mbedTree @endlink).
      */
     unsigned build;
 
@@ -326,7 +326,13 @@ void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
         TIter begItEnd = end(msaOpt.method, Standard());
         for (; begIt != begItEnd; goNext(begIt))
         {
-            if (*begIt == 0)
+            if (*begIt == 0 && msaOpt.build == 5)
+            {
+                // mBed does not use the distance matrix
+                Nothing noth;
+                appendSegmentMatches(seqSet, pList, msaOpt.sc, matches, scores, noth, GlobalPairwiseLibrary());
+            }
+            else if (*begIt == 0)
                 appendSegmentMatches(seqSet, pList, msaOpt.sc, matches, scores, distanceMatrix, GlobalPairwiseLibrary());
             else if (*begIt == 1)
                 _appendSegmentMatches(seqSet, pList, msaOpt.sc, matches, scores);
@@ -403,6 +409,10 @@ void globalMsaAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> > & gAlign,
         read(strm_tree, guideTree, sequenceNames, NewickFormat());  // Read newick tree
         strm_tree.close();
     }
+    else if (msaOpt.build == 5)
+    {
+        mbedTree(seqSet, guideTree);
+    }
     else
     {
         // Check if we have a valid distance matrix
@@ -145,36 +145,60 @@ progressiveAlignment(Graph<Alignment<TStringSet, TCargo, TSpec> >& g,
 	// Initialization
 	TVertexDescriptor rootVertex = getRoot(tree);
 	TSize nVertices = numVertices(tree);
-
-	// Vertices in reversed bfs order
-	TVertexString vertices;
-	resize(vertices, nVertices);
+	TVertexDescriptor nilVertex = getNil<TVertexDescriptor>();
 
 	// All Strings of Strings of vertices for each node of the guide tree
 	String<TSegmentString> segString;
 	resize(segString, nVertices);
-	
-	// Walk through the tree in bfs order	
-	typedef typename Iterator<TVertexString, Standard>::Type TVertexIter;
-	TVertexIter itVert = begin(vertices, Standard());
-	TVertexIter itVertEnd = end(vertices, Standard());
-	--itVertEnd;
+
+	// Parent and number of unaligned children for each node of the guide tree
+	TVertexString parent;
+	resize(parent, nVertices, nilVertex);
+	String<unsigned> pendingChildren;
+	resize(pendingChildren, nVertices, 0);
+
+	// Walk through the tree in bfs order, the leaves are the first tasks
+	unsigned threadCount = omp_get_max_threads();
+	WorkStealingPool<TVertexDescriptor> pool(threadCount);
+	unsigned leafCount = 0;
 	TBfsIterator bfsIt(tree, rootVertex);
-	for(;!atEnd(bfsIt);goNext(bfsIt), --itVertEnd) 
-		*itVertEnd = *bfsIt;
+	for(;!atEnd(bfsIt);goNext(bfsIt)) {
+		if (isLeaf(tree, *bfsIt)) pushTask(pool, leafCount++ % threadCount, *bfsIt);
+		for(TAdjacencyIterator adjIt(tree, *bfsIt); !atEnd(adjIt); goNext(adjIt)) {
+			parent[*adjIt] = *bfsIt;
+			++pendingChildren[*bfsIt];
+		}
+	}
 
 	// Progressive alignment
-	itVert = begin(vertices, Standard());
-	itVertEnd = end(vertices, Standard());
-	for(;itVert != itVertEnd; ++itVert) {
-		if(isLeaf(tree, *itVert)) _buildLeafString(g, *itVert, segString[*itVert]);
-		else {
-			// Align the two children (Binary tree)
-			TAdjacencyIterator adjIt(tree, *itVert);
-			TVertexDescriptor child1 = *adjIt; goNext(adjIt);
-			heaviestCommonSubsequence(g, segString[child1], segString[*adjIt], segString[*itVert]);
-			clear(segString[child1]);
-			clear(segString[*adjIt]);
+	// Independent subtrees are aligned in parallel.  A node of the guide tree becomes a task as soon as
+	// its children are aligned.  The profile of a node only depends on the profiles of its children,
+	// so the alignment does not depend on the number of threads.
+	TSize volatile nodesDone = 0;
+	SEQAN_OMP_PRAGMA(parallel num_threads(threadCount))
+	{
+		unsigned threadId = omp_get_thread_num();
+		TVertexDescriptor node;
+		SpinDelay spinDelay;
+		while (nodesDone < nVertices) {
+			// Back off while the remaining nodes wait for children aligned by other threads
+			if (!popTask(node, pool, threadId)) {
+				waitFor(spinDelay);
+				continue;
+			}
+			clear(spinDelay);
+			if(isLeaf(tree, node)) _buildLeafString(g, node, segString[node]);
+			else {
+				// Align the two children (Binary tree)
+				TAdjacencyIterator adjIt(tree, node);
+				TVertexDescriptor child1 = *adjIt; goNext(adjIt);
+				heaviestCommonSubsequence(g, segString[child1], segString[*adjIt], segString[node]);
+				clear(segString[child1]);
+				clear(segString[*adjIt]);
+			}
+			if ((node != rootVertex) && (atomicDec(pendingChildren[parent[node]]) == 0u))
+				pushTask(pool, threadId, parent[node]);
+			atomicInc(nodesDone);
 		}
 	}
 
@@ -86,6 +86,7 @@
 #include <seqan/index/shape_threshold.h>
 #include <seqan/index/index_qgram.h>
 #include <seqan/index/index_qgram_openaddressing.h>
+#include <seqan/index/index_qgram_parallel.h>
 //#include <seqan/index/index_qgram_nested.h>
 
 // ----------------------------------------------------------------------------
@@ -1317,10 +1317,12 @@ namespace SEQAN_NAMESPACE_MAIN
  * @headerfile <seqan/index.h>
  * @brief Builds a <i>q</i>-gram index on a sequence.
  * 
- * @signature void createQGramIndex(index);
+ * @signature void createQGramIndex(index[, parallelTag]);
  * @signature void createQGramIndex(sa, dir, bucketMap, text, shape, stepSize); [DEPRECATED]
  * 
  * @param[out] index     The IndexQGram to create.
+ * @param[in]  parallelTag Tag to enable/disable parallelism, one of <tt>Serial</tt> and <tt>Parallel</tt>.
+ *                       The parallel variant does not preserve the text order of occurrences within a bucket.
  * @param[out] sa        The resulting list in which all <i>q</i>-grams are sorted alphabetically.
  * @param[out] dir       The resulting array that indicates at which position in index the corresponding <i>q</i>-grams
  * @param[in]  bucketMap Stores the <i>q</i>-gram hashes for the openaddressing hash maps, see
@@ -1609,7 +1611,10 @@ namespace SEQAN_NAMESPACE_MAIN
  * @brief Builds the directory of a <i>q</i>-gram index on a sequence.
  * 
  * @signature void createQGramIndexDirOnly(dir, bucketMap, text, shape, stepSize);
+ * @signature void createQGramIndexDirOnly(index, parallelTag);
  * 
+ * @param[out] index     The IndexQGram whose directory should be built.
+ * @param[in]  parallelTag Tag to enable/disable parallelism, one of <tt>Serial</tt> and <tt>Parallel</tt>.
  * @param[out] dir       The resulting array that indicates at which position in index the corresponding q-grams can be
  *                       found.
  * @param[out] bucketMap Stores the q-gram hashes for the openaddressing hash maps, see @link IndexQGram#indexBucketMap
@@ -45,23 +45,6 @@ namespace seqan {
 // Tags, Classes, Enums
 // ============================================================================
 
-// TODO(weese): should go to basic/metaprogramming...
-template <bool VALUE_>
-struct Bool: public Eval<VALUE_> {};
-
-template <unsigned VALUE_>
-struct Unsigned
-{
-    enum { VALUE = VALUE_ };
-};
-
-template <int VALUE_>
-struct Integer
-{
-    enum { VALUE = VALUE_ };
-};
-
-
 // ============================================================================
 // Metafunctions
 // ============================================================================
@@ -103,9 +86,9 @@ inline typename Value<TSequence>::Type
 _sumIgnoreDisabled(TSequence const &seq, Tag<TParallelTag>)
 {
     typedef typename Value<TSequence>::Type TValue;
-    register typename Iterator<TSequence const>::Type it = begin(seq, Standard());
-    register typename Iterator<TSequence const>::Type itEnd = end(seq, Standard());
-    register TValue sum = 0;
+    typename Iterator<TSequence const>::Type it = begin(seq, Standard());
+    typename Iterator<TSequence const>::Type itEnd = end(seq, Standard());
+    TValue sum = 0;
     for (; it != itEnd; ++it)
         if (*it != (TValue)-1)
             sum += *it;
@@ -211,7 +194,7 @@ SEQAN_CHECKPOINT
 
 template < typename TDir, typename TWithConstraints, typename TKeepDisabledBuckets, unsigned SHIFT, typename TParallelTag >
 inline typename Value<TDir>::Type
-_qgramCummulativeSum(TDir &dir, TWithConstraints, TKeepDisabledBuckets, Unsigned<SHIFT>, Tag<TParallelTag> parallelTag)
+_qgramCummulativeSum(TDir &dir, TWithConstraints, TKeepDisabledBuckets, ConstUInt<SHIFT>, Tag<TParallelTag> parallelTag)
 {
     typedef typename Value<TDir>::Type TValue;
     typedef typename Size<TDir>::Type TSize;
@@ -259,16 +242,16 @@ _qgramCummulativeSum(TDir &dir, TWithConstraints, TKeepDisabledBuckets, Unsigned
     SEQAN_OMP_PRAGMA(parallel for)
     for (int job = 0; job < (int)length(splitter); ++job)
     {
-        register TConstIterator itBegin = begin(dir, Standard()) + splitter[job];
-        register TIterator dstIt = begin(dir, Standard()) + splitter[job + 1];
-        register TValue sum = localSums[job];
+        TConstIterator itBegin = begin(dir, Standard()) + splitter[job];
+        TIterator dstIt = begin(dir, Standard()) + splitter[job + 1];
+        TValue sum = localSums[job];
 
         // read over our subinterval
         {
-            register TConstIterator it = begin(dir, Standard()) + splitter[job + 1] - SHIFT;
+            TConstIterator it = begin(dir, Standard()) + splitter[job + 1] - SHIFT;
             while (it != itBegin)
             {
-                register TValue counter = *(--it);
+                TValue counter = *(--it);
                 if (!TWithConstraints::VALUE || counter != (TValue)-1)
                     sum -= counter;
                 else
@@ -284,10 +267,10 @@ _qgramCummulativeSum(TDir &dir, TWithConstraints, TKeepDisabledBuckets, Unsigned
         // read suffix of the previous subinterval
         if (SHIFT != 0u)
         {
-            register TConstBufferIterator it = begin(prevCounts, Standard()) + (job + 1) * SHIFT;
+            TConstBufferIterator it = begin(prevCounts, Standard()) + (job + 1) * SHIFT;
             while (dstIt != itBegin)
             {
-                register TValue counter = *(--it);
+                TValue counter = *(--it);
                 if (!TWithConstraints::VALUE || counter != (TValue)-1)
                     sum -= counter;
                 else
@@ -351,13 +334,13 @@ SEQAN_CHECKPOINT
             TIterator itText = begin(text, Standard()) + pos;
 
             // first hash
-            register TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText));
+            TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText));
             if (!TWithConstraints::VALUE || *bktPtr != (TSize)-1)       // ignore disabled buckets
                 sa[atomicPostInc(*bktPtr, parallelTag)] = pos;          
 
             for (++pos; pos != posEnd; ++pos)
             {
-                register TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hashNext(shape, ++itText));
+                TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hashNext(shape, ++itText));
                 if (!TWithConstraints::VALUE || *bktPtr != (TSize)-1)   // ignore disabled buckets
                     sa[atomicPostInc(*bktPtr, parallelTag)] = pos;
             }
@@ -374,7 +357,7 @@ SEQAN_CHECKPOINT
 
             for (; pos != posEnd; pos += stepSize, itText += stepSize)
             {
-                register TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText));
+                TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText));
                 if (!TWithConstraints::VALUE || *bktPtr != (TSize)-1)   // ignore disabled buckets
                     sa[atomicPostInc(*bktPtr, parallelTag)] = pos;
             }
@@ -433,14 +416,14 @@ SEQAN_CHECKPOINT
 				assignValueI2(localPos, 0);
 
                 // first hash
-                register TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText));
+                TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText));
                 if (!TWithConstraints::VALUE || *bktPtr != (TSize)-1)       // ignore disabled buckets
                     sa[atomicPostInc(*bktPtr, parallelTag)] = localPos;          
 
                 for (++itText; itText != itTextEnd; ++itText)
                 {
                     posInc(localPos);
-                    register TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hashNext(shape, itText));
+                    TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hashNext(shape, itText));
                     if (!TWithConstraints::VALUE || *bktPtr != (TSize)-1)   // ignore disabled buckets
                         sa[atomicPostInc(*bktPtr, parallelTag)] = localPos;
                 }
@@ -467,7 +450,7 @@ SEQAN_CHECKPOINT
                 for (; itText != itTextEnd; ++itText)
                 {
                     posInc(localPos, stepSize);
-                    register TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText));
+                    TDirIterator const bktPtr = dirBegin1 + getBucket(bucketMap, hash(shape, itText));
                     if (!TWithConstraints::VALUE || *bktPtr != (TSize)-1)   // ignore disabled buckets
                         sa[atomicPostInc(*bktPtr, parallelTag)] = localPos;
                 }
@@ -494,9 +477,9 @@ SEQAN_CHECKPOINT
     SEQAN_OMP_PRAGMA(parallel for)
     for (int job = 0; job < (int)length(splitter); ++job)
     {
-        register TDirIterator it = splitter[job];
-        register TDirIterator itEnd = splitter[job + 1];
-        register TSize prev = (job == 0)? 0: (TSize)-1;
+        TDirIterator it = splitter[job];
+        TDirIterator itEnd = splitter[job + 1];
+        TSize prev = (job == 0)? 0: (TSize)-1;
         for (; it != itEnd; ++it)
             if (*it == (TSize)-1)
                 *it = prev;
@@ -512,9 +495,9 @@ SEQAN_CHECKPOINT
     SEQAN_OMP_PRAGMA(parallel for)
     for (int job = 1; job < (int)length(splitter); ++job)
     {
-        register TDirIterator it = splitter[job];
-        register TDirIterator itEnd = splitter[job + 1];
-        register TSize prev = last[job - 1];
+        TDirIterator it = splitter[job];
+        TDirIterator itEnd = splitter[job + 1];
+        TSize prev = last[job - 1];
         for (; it != itEnd && *it == (TSize)-1; ++it)
             *it = prev;
     }
@@ -542,7 +525,7 @@ void createQGramIndex(TIndex &index, Tag<TParallelTag> parallelTag)
         // with disabled buckets
         // disabled buckets should still be marked in the partial sum
         // shift all entries by one towards the end (will be corrected by _qgramFillSuffixArray)
-        _qgramCummulativeSum(dir, True(), True(), Unsigned<1>(), parallelTag);
+        _qgramCummulativeSum(dir, True(), True(), ConstUInt<1>(), parallelTag);
 
         // 4. fill suffix array
         _qgramFillSuffixArray(sa, text, shape, dir, bucketMap, getStepSize(index), True(), parallelTag);
@@ -556,7 +539,7 @@ void createQGramIndex(TIndex &index, Tag<TParallelTag> parallelTag)
 
         // without disabled buckets
         // shift all entries by one towards the end (will be corrected by _qgramFillSuffixArray)
-        _qgramCummulativeSum(dir, False(), False(), Unsigned<1>(), parallelTag);
+        _qgramCummulativeSum(dir, False(), False(), ConstUInt<1>(), parallelTag);
         
         // 4. fill suffix array
         _qgramFillSuffixArray(sa, text, shape, dir, bucketMap, getStepSize(index), False(), parallelTag);
@@ -584,16 +567,16 @@ void createQGramIndexDirOnly(TIndex &index, Tag<TParallelTag> parallelTag)
         // with disabled buckets
         // disabled buckets should not be marked in the partial sum
         // don't shift entries as there is no _qgramFillSuffixArray call
-        _qgramCummulativeSum(dir, True(), False(), Unsigned<0>(), parallelTag); // no shift
+        _qgramCummulativeSum(dir, True(), False(), ConstUInt<0>(), parallelTag); // no shift
     }
     else
     {
         // without disabled buckets
         // don't shift entries as there is no _qgramFillSuffixArray call
-        _qgramCummulativeSum(dir, False(), False(), Unsigned<0>(), parallelTag);
+        _qgramCummulativeSum(dir, False(), False(), ConstUInt<0>(), parallelTag);
     }
 }
 
-}
+}  // namespace seqan
 
 #endif  // #ifndef INCLUDE_SEQAN_INDEX_INDEX_QGRAM_PARALLEL_H_
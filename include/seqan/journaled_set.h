@@ -43,11 +43,14 @@
 
 #include <seqan/basic.h>  // Include the basics.
 #include <seqan/align.h>  // Include the alignment interface.
+#include <seqan/seeds.h>
 #include <seqan/score.h>
 #include <seqan/journaled_set/score_biaffine.h>
 #include <seqan/sequence.h>
 #include <seqan/sequence_journaled.h>
 #include <seqan/seq_io.h>
+#include <seqan/find.h>
+#include <seqan/parallel.h>
 
 
 // ===========================================================================
@@ -72,8 +75,15 @@
 // ----------------------------------------------------------------------------
 
 #include <seqan/journaled_set/journaled_set_join_config.h>
-#include <seqan/journaled_set/journaled_set_join.h>
 #include <seqan/journaled_set/journaled_set_join_global_align_manhatten.h>
 #include <seqan/journaled_set/journaled_set_join_global_align_compact.h>
+#include <seqan/journaled_set/journaled_set_join_global_chain.h>
+#include <seqan/journaled_set/journaled_set_join.h>
+
+// ----------------------------------------------------------------------------
+// Online Search
+// ----------------------------------------------------------------------------
+
+#include <seqan/journaled_set/journaled_set_find.h>
 
 #endif  // INCLUDE_SEQAN_JOURNALED_SET_H_
@@ -0,0 +1,339 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: Rene Rahn <rene.rahn@fu-berlin.de>
+// ==========================================================================
+
+// Online search of a pattern in all members of a JournaledSet.  The global
+// reference is scanned only once and its hits are reused for all regions of
+// the journaled strings that are copied from the reference.
+// ==========================================================================
+
+#ifndef INCLUDE_SEQAN_JOURNALED_SET_JOURNALED_SET_FIND_H_
+#define INCLUDE_SEQAN_JOURNALED_SET_JOURNALED_SET_FIND_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _journaledSetFindWindow()
+// ----------------------------------------------------------------------------
+
+// Returns the maximal number of text characters a hit of the pattern can span.  A hit whose window lies completely
+// within a part of a journaled string that is copied from the reference is a hit in the reference, too.
+
+template <typename TNeedle>
+inline unsigned
+_journaledSetFindWindow(Pattern<TNeedle, Horspool> const & pattern)
+{
+    return length(needle(pattern));
+}
+
+template <typename TNeedle>
+inline unsigned
+_journaledSetFindWindow(Pattern<TNeedle, ShiftAnd> const & pattern)
+{
+    return pattern.needleLength;
+}
+
+// Only infix search is supported for Myers, prefix search anchors hits at the beginning of the text.
+template <typename TNeedle, typename TFindBeginPatternSpec>
+inline unsigned
+_journaledSetFindWindow(Pattern<TNeedle, Myers<FindInfix, True, TFindBeginPatternSpec> > const & pattern)
+{
+    return pattern.needleSize - scoreLimit(pattern);
+}
+
+// ----------------------------------------------------------------------------
+// Function _journaledSetFindMinLength()
+// ----------------------------------------------------------------------------
+
+// Returns the minimal number of text characters of a hit.  Horspool requires the text to be at least as long as the
+// needle.
+
+template <typename TNeedle>
+inline unsigned
+_journaledSetFindMinLength(Pattern<TNeedle, Horspool> const & pattern)
+{
+    return length(needle(pattern));
+}
+
+template <typename TNeedle>
+inline unsigned
+_journaledSetFindMinLength(Pattern<TNeedle, ShiftAnd> const & pattern)
+{
+    return pattern.needleLength;
+}
+
+template <typename TNeedle, typename TFindBeginPatternSpec>
+inline unsigned
+_journaledSetFindMinLength(Pattern<TNeedle, Myers<FindInfix, True, TFindBeginPatternSpec> > const & pattern)
+{
+    return (static_cast<int>(pattern.needleSize) > -scoreLimit(pattern)) ? pattern.needleSize + scoreLimit(pattern) : 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function _journaledSetFindInText()
+// ----------------------------------------------------------------------------
+
+// Appends the end positions of all hits in text that are greater than minEnd, shifted by offset.
+
+template <typename TEnds, typename TText, typename TPattern, typename TPos>
+inline void
+_journaledSetFindInText(TEnds & ends,
+                        TText & text,
+                        TPattern & pattern,
+                        TPos offset,
+                        TPos minEnd)
+{
+    typedef Finder<TText> TFinder;
+
+    if (length(text) < _journaledSetFindMinLength(pattern))
+        return;
+
+    TFinder finder(text);
+    while (find(finder, pattern))
+    {
+        TPos endPos = offset + endPosition(finder);
+        if (endPos > minEnd)
+            appendValue(ends, endPos);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _journaledSetFindInWindow()
+// ----------------------------------------------------------------------------
+
+// Searches all hits whose last character lies in [beginPos, endPos) of the journaled string.  The window including
+// the preceding context is copied into buffer such that the pattern runs over contiguous memory.
+
+template <typename TEnds, typename TBuffer, typename TString, typename TPattern, typename TPos>
+inline void
+_journaledSetFindInWindow(TEnds & ends,
+                          TBuffer & buffer,
+                          TString const & journaledString,
+                          TPattern & pattern,
+                          TPos beginPos,
+                          TPos endPos,
+                          unsigned window)
+{
+    TPos contextBegin = (beginPos + 1 > static_cast<TPos>(window)) ? beginPos + 1 - window : 0;
+    assign(buffer, infix(journaledString, contextBegin, endPos));
+    _journaledSetFindInText(ends, buffer, pattern, contextBegin, beginPos);
+}
+
+// ----------------------------------------------------------------------------
+// Function _journaledSetFindInString()
+// ----------------------------------------------------------------------------
+
+// Collects the hits in one journaled string.  The journal entries are traversed in virtual order: Hits in regions
+// copied from the global reference are translated from hostEnds, all other regions are searched explicitly.
+
+template <typename TEnds, typename TValue, typename THostSpec, typename TJournalSpec, typename TBufferSpec,
+          typename THost, typename THostEnds, typename TPattern>
+inline void
+_journaledSetFindInString(TEnds & ends,
+                          String<TValue, Journaled<THostSpec, TJournalSpec, TBufferSpec> > const & journaledString,
+                          THost const & globalRef,
+                          THostEnds const & hostEnds,
+                          TPattern & pattern,
+                          unsigned window)
+{
+    typedef String<TValue, Journaled<THostSpec, TJournalSpec, TBufferSpec> > TString;
+    typedef typename TString::TJournalEntries                               TJournalEntries;
+    typedef typename Iterator<TJournalEntries const, Standard>::Type        TEntriesIterator;
+    typedef typename Position<TString>::Type                                TPos;
+    typedef typename Iterator<THostEnds const, Standard>::Type              THostEndsIterator;
+
+    THost buffer;
+    TPos pos = 0;  // First last-character position that is not covered yet.
+
+    // Strings that are not journaled against the global reference are searched completely.
+    if (!empty(journaledString._holder) && &value(journaledString._holder) == &globalRef)
+    {
+        for (TEntriesIterator it = begin(journaledString._journalEntries, Standard()),
+             itEnd = end(journaledString._journalEntries, Standard()); it != itEnd; ++it)
+        {
+            if (it->segmentSource != SOURCE_ORIGINAL)
+                continue;
+
+            // Range of last-character positions whose window lies within the entry.  A prefix of the reference
+            // that is also a prefix of the journaled string shares the left-truncated windows, too.
+            TPos sharedBegin = it->virtualPosition + window - 1;
+            if (it->virtualPosition == 0u && it->physicalPosition == 0u)
+                sharedBegin = 0;
+            TPos sharedEnd = it->virtualPosition + it->length;
+            if (sharedBegin >= sharedEnd)
+                continue;
+
+            // Search the context window of the variants since the last shared range.
+            if (pos < sharedBegin)
+                _journaledSetFindInWindow(ends, buffer, journaledString, pattern, pos, sharedBegin, window);
+
+            // Translate the hits of the reference.
+            TPos physicalBegin = it->physicalPosition + (sharedBegin - it->virtualPosition);
+            TPos physicalEnd = it->physicalPosition + it->length;
+            THostEndsIterator hostIt = std::upper_bound(begin(hostEnds, Standard()), end(hostEnds, Standard()),
+                                                        physicalBegin);
+            for (; hostIt != end(hostEnds, Standard()) && *hostIt <= physicalEnd; ++hostIt)
+                appendValue(ends, *hostIt - it->physicalPosition + it->virtualPosition);
+
+            pos = sharedEnd;
+        }
+    }
+
+    if (pos < length(journaledString))
+        _journaledSetFindInWindow(ends, buffer, journaledString, pattern, pos, (TPos)length(journaledString), window);
+}
+
+// ----------------------------------------------------------------------------
+// Function find()                                              [JournaledSet]
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn JournaledSet#find
+ * @brief Searches a pattern in all strings of a @link JournaledSet @endlink.
+ *
+ * @signature void find(hits, stringSet, pattern[, parallelTag]);
+ *
+ * @param[out]    hits        A @link String @endlink of @link Pair @endlink objects <tt>(seqNo, endPos)</tt>.  Each
+ *                            pair stores the index of the journaled string and the end position of a hit in it as
+ *                            returned by @link Finder#endPosition @endlink.  The hits are sorted by seqNo and endPos.
+ * @param[in]     stringSet   The JournaledSet to search in.  The strings have to be @link JournaledString
+ *                            @endlink objects.
+ * @param[in,out] pattern     The pattern to search for.  Types: @link HorspoolPattern @endlink,
+ *                            @link ShiftAndPattern @endlink and @link MyersPattern @endlink with
+ *                            <tt>FindInfix</tt>.
+ * @param[in]     parallelTag Tag to enable/disable parallelism, one of <tt>Serial</tt> and <tt>Parallel</tt>,
+ *                            default is <tt>Serial</tt>.
+ *
+ * The global reference is searched once, in parallel over chunks of the reference.  Hits whose window lies in a
+ * region a journaled string copies from the reference are translated from these hits.  Only the windows around the
+ * journal's deletions, insertions and substitutions are searched in each string separately.  Strings whose host is
+ * not the global reference of the set are searched completely.
+ *
+ * The result equals searching each string with a @link Finder @endlink and collecting @link Finder#endPosition
+ * @endlink of each hit.
+ */
+
+template <typename THits, typename TString, typename TNeedle, typename TPatternSpec, typename TParallelTag>
+inline void
+find(THits & hits,
+     StringSet<TString, Owner<JournaledSet> > const & journalSet,
+     Pattern<TNeedle, TPatternSpec> & pattern,
+     Tag<TParallelTag> parallelTag)
+{
+    typedef StringSet<TString, Owner<JournaledSet> >                TJournaledSet;
+    typedef typename Host<TJournaledSet const>::Type                THost;
+    typedef typename Infix<THost>::Type                             THostInfix;
+    typedef typename Position<THost>::Type                          TPos;
+    typedef typename Value<THits>::Type                             THit;
+    typedef typename Value<THit, 1>::Type                           TSeqNo;
+    typedef String<TPos>                                            TEnds;
+    typedef Pattern<TNeedle, TPatternSpec>                          TPattern;
+
+    clear(hits);
+    if (empty(journalSet))
+        return;
+
+    unsigned window = _journaledSetFindWindow(pattern);
+    SEQAN_ASSERT_GT(window, 0u);
+
+    // Scan the global reference in chunks.  Each chunk reports the hits whose last character lies in the chunk and
+    // starts window - 1 characters earlier.
+    String<TEnds> hostChunkEnds;
+    TEnds hostEnds;
+    THost & globalRef = host(journalSet);
+    if (!empty(globalRef))
+    {
+        Splitter<TPos> splitter(0, length(globalRef), parallelTag);
+        resize(hostChunkEnds, length(splitter), Exact());
+
+        SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+        for (int job = 0; job < (int)length(splitter); ++job)
+        {
+            TPattern localPattern(pattern);
+            TPos chunkBegin = splitter[job];
+            TPos contextBegin = (chunkBegin + 1 > static_cast<TPos>(window)) ? chunkBegin + 1 - window : 0;
+            THostInfix chunk = infix(globalRef, contextBegin, splitter[job + 1]);
+            _journaledSetFindInText(hostChunkEnds[job], chunk, localPattern, contextBegin, chunkBegin);
+        }
+
+        for (unsigned job = 0; job < length(hostChunkEnds); ++job)
+            append(hostEnds, hostChunkEnds[job]);
+    }
+
+    // Search the variant windows of each journaled string and translate the shared hits.
+    String<TEnds> seqEnds;
+    resize(seqEnds, length(journalSet), Exact());
+
+    Splitter<unsigned> seqSplitter(0, length(journalSet), parallelTag);
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for (int job = 0; job < (int)length(seqSplitter); ++job)
+    {
+        TPattern localPattern(pattern);
+        for (unsigned seqNo = seqSplitter[job]; seqNo < seqSplitter[job + 1]; ++seqNo)
+            _journaledSetFindInString(seqEnds[seqNo], value(journalSet, seqNo), globalRef, hostEnds, localPattern,
+                                      window);
+    }
+
+    for (unsigned seqNo = 0; seqNo < length(seqEnds); ++seqNo)
+        for (unsigned i = 0; i < length(seqEnds[seqNo]); ++i)
+            appendValue(hits, THit(static_cast<TSeqNo>(seqNo), seqEnds[seqNo][i]));
+}
+
+template <typename THits, typename TString, typename TNeedle, typename TPatternSpec>
+inline void
+find(THits & hits,
+     StringSet<TString, Owner<JournaledSet> > const & journalSet,
+     Pattern<TNeedle, TPatternSpec> & pattern)
+{
+    find(hits, journalSet, pattern, Serial());
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef INCLUDE_SEQAN_JOURNALED_SET_JOURNALED_SET_FIND_H_
@@ -125,6 +125,74 @@ join(StringSet<TString, Owner<JournaledSet> > & journalSet,
    join(journalSet, journalIdx, JoinConfig<GlobalAlign<JournaledManhatten> >());
 }
 
+// ----------------------------------------------------------------------------
+// Function _joinAll()
+// ----------------------------------------------------------------------------
+
+template <typename TString, typename TSpec, typename TParallelTag>
+inline void
+_joinAll(StringSet<TString, Owner<JournaledSet> > & journalSet,
+         JoinConfig<TSpec> const & joinConfig,
+         Tag<TParallelTag> parallelTag)
+{
+    Splitter<unsigned> splitter(0, length(journalSet), parallelTag);
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for (int job = 0; job < (int)length(splitter); ++job)
+        for (unsigned journalIdx = splitter[job]; journalIdx < splitter[job + 1]; ++journalIdx)
+            _joinInternal(value(journalSet, journalIdx), journalSet, joinConfig);
+}
+
+// The anchor table of the global reference is built only once and shared by all joins.
+template <typename TString, typename TSpec, typename TParallelTag>
+inline void
+_joinAll(StringSet<TString, Owner<JournaledSet> > & journalSet,
+         JoinConfig<GlobalChain<TSpec> > const & joinConfig,
+         Tag<TParallelTag> parallelTag)
+{
+    typedef typename Host<TString>::Type THost;
+
+    JoinSeedTable_<THost> table;
+    _joinBuildSeedTable(table, host(journalSet), seedLength(joinConfig), parallelTag);
+
+    Splitter<unsigned> splitter(0, length(journalSet), parallelTag);
+
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic))
+    for (int job = 0; job < (int)length(splitter); ++job)
+        for (unsigned journalIdx = splitter[job]; journalIdx < splitter[job + 1]; ++journalIdx)
+            _joinGlobalChain(value(journalSet, journalIdx), journalSet, table, joinConfig);
+}
+
+// ----------------------------------------------------------------------------
+// Function join()                                                  [All Strings]
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn JournaledSet#join
+ * @brief Joins all strings of a @link JournaledSet @endlink to its global reference sequence.
+ *
+ * @signature void join(stringSet, joinConfig, parallelTag);
+ *
+ * @param[in,out] stringSet   The JournaledSet to join.
+ * @param[in]     joinConfig  A @link JoinConfig @endlink object that specifies the method and the method's strategy
+ *                            to compute the differences.
+ * @param[in]     parallelTag Tag to enable/disable parallelism, one of <tt>Serial</tt> and <tt>Parallel</tt>.  The
+ *                            strings are joined in parallel, each string by one thread.
+ */
+
+template <typename TString, typename TSpec, typename TParallelTag>
+inline void
+join(StringSet<TString, Owner<JournaledSet> > & journalSet,
+     JoinConfig<TSpec> const & joinConfig,
+     Tag<TParallelTag> parallelTag)
+{
+   if (empty(host(journalSet)))
+   {
+       std::cerr << "No reference set! Join aborted!" << std::endl;
+   }
+   _joinAll(journalSet, joinConfig, parallelTag);
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef INCLUDE_SEQAN_JOURNALED_SET_JOURNALED_SET_JOIN_H_
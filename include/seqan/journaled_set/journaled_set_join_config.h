@@ -70,6 +70,19 @@ struct JoinConfig<GlobalAlign<JournaledCompact> >
     {}
 };
 
+template <typename TSpec>
+struct JoinConfig<GlobalChain<TSpec> >
+{
+    typedef Score<int, Simple> TScoringScheme;
+    TScoringScheme _score;
+    unsigned _seedLength;
+    unsigned _bandExtension;
+
+    JoinConfig() : _score(1, -2, -1, -6),
+                   _seedLength(20),
+                   _bandExtension(15)
+    {}
+};
 
 // ============================================================================
 // Metafunctions
@@ -155,6 +168,77 @@ setScoringScheme(JoinConfig<GlobalAlign<JournaledCompact> > & joinConfig, Score<
     setScoreMismatch(joinConfig._score, -100000);   // Explicitly forbid mis matches in context with journaling.
 }
 
+// ----------------------------------------------------------------------------
+// Function scoringScheme()                                       [GlobalChain]
+// ----------------------------------------------------------------------------
+
+template <typename TSpec>
+inline Score<int, Simple> &
+scoringScheme(JoinConfig<GlobalChain<TSpec> > & joinConfig)
+{
+    return joinConfig._score;
+}
+
+template <typename TSpec>
+inline Score<int, Simple> const &
+scoringScheme(JoinConfig<GlobalChain<TSpec> > const & joinConfig)
+{
+    return joinConfig._score;
+}
+
+// ----------------------------------------------------------------------------
+// Function setScoringScheme()                                    [GlobalChain]
+// ----------------------------------------------------------------------------
+
+template <typename TSpec>
+inline void
+setScoringScheme(JoinConfig<GlobalChain<TSpec> > & joinConfig, Score<int, Simple> const & scoringScheme)
+{
+    joinConfig._score = scoringScheme;
+}
+
+// ----------------------------------------------------------------------------
+// Function seedLength()                                          [GlobalChain]
+// ----------------------------------------------------------------------------
+
+// Length of the k-mers used to anchor a sequence to the global reference.
+template <typename TSpec>
+inline unsigned seedLength(JoinConfig<GlobalChain<TSpec> > const & joinConfig)
+{
+    return joinConfig._seedLength;
+}
+
+// ----------------------------------------------------------------------------
+// Function setSeedLength()                                       [GlobalChain]
+// ----------------------------------------------------------------------------
+
+template <typename TSpec>
+inline void setSeedLength(JoinConfig<GlobalChain<TSpec> > & joinConfig, unsigned seedLength)
+{
+    joinConfig._seedLength = seedLength;
+}
+
+// ----------------------------------------------------------------------------
+// Function bandExtension()                                       [GlobalChain]
+// ----------------------------------------------------------------------------
+
+// Number of diagonals the band around the anchors is extended by in the banded chain alignment.
+template <typename TSpec>
+inline unsigned bandExtension(JoinConfig<GlobalChain<TSpec> > const & joinConfig)
+{
+    return joinConfig._bandExtension;
+}
+
+// ----------------------------------------------------------------------------
+// Function setBandExtension()                                    [GlobalChain]
+// ----------------------------------------------------------------------------
+
+template <typename TSpec>
+inline void setBandExtension(JoinConfig<GlobalChain<TSpec> > & joinConfig, unsigned bandExtension)
+{
+    joinConfig._bandExtension = bandExtension;
+}
+
 }  // namespace seqan
 
 #endif  // #ifndef INCLUDE_SEQAN_JOURNALED_SET_JOURNALED_SET_JOIN_CONFIG_H_
@@ -0,0 +1,386 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: Rene Rahn <rene.rahn@fu-berlin.de>
+// ==========================================================================
+
+
+#ifndef INCLUDE_SEQAN_JOURNALED_SET_JOURNALED_SET_JOIN_GLOBAL_CHAIN_H_
+#define INCLUDE_SEQAN_JOURNALED_SET_JOURNALED_SET_JOIN_GLOBAL_CHAIN_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class JoinSeedTable_
+// ----------------------------------------------------------------------------
+
+// Hashes of the k-mers that occur exactly once in the global reference, sorted by hash.  The table is built once per
+// reference and shared by all joins, lookups are read-only.
+
+template <typename THost>
+class JoinSeedTable_
+{
+public:
+    typedef typename Position<THost>::Type TPosition;
+    typedef Pair<__uint64, TPosition>      TEntry;
+
+    String<TEntry> entries;
+    unsigned seedLength;
+
+    JoinSeedTable_() : seedLength(0)
+    {}
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _joinSeedHash()
+// ----------------------------------------------------------------------------
+
+// Rolling hash over the ordinal values of the k-mer characters, overflow is intended.
+
+template <typename TIter>
+inline __uint64
+_joinSeedHash(TIter it, unsigned seedLength)
+{
+    __uint64 hash = 0;
+    for (unsigned i = 0; i < seedLength; ++i, ++it)
+        hash = hash * 1099511628211ull + ordValue(*it) + 1;
+    return hash;
+}
+
+// ----------------------------------------------------------------------------
+// Function _joinSeedHashPower()
+// ----------------------------------------------------------------------------
+
+inline __uint64
+_joinSeedHashPower(unsigned seedLength)
+{
+    __uint64 power = 1;
+    for (unsigned i = 1; i < seedLength; ++i)
+        power *= 1099511628211ull;
+    return power;
+}
+
+// ----------------------------------------------------------------------------
+// Function _joinBuildSeedTable()
+// ----------------------------------------------------------------------------
+
+template <typename THost, typename TParallelTag>
+inline void
+_joinBuildSeedTable(JoinSeedTable_<THost> & table,
+                    THost const & ref,
+                    unsigned seedLength,
+                    Tag<TParallelTag> parallelTag)
+{
+    typedef JoinSeedTable_<THost>                             TTable;
+    typedef typename TTable::TPosition                        TPosition;
+    typedef typename TTable::TEntry                           TEntry;
+    typedef typename Iterator<THost const, Standard>::Type    TIter;
+
+    SEQAN_ASSERT_GT(seedLength, 0u);
+
+    table.seedLength = seedLength;
+    clear(table.entries);
+    if (length(ref) < seedLength)
+        return;
+
+    String<TEntry> kmers;
+    resize(kmers, length(ref) - seedLength + 1, Exact());
+
+    // Hash all k-mers in parallel over chunks of the reference.
+    __uint64 power = _joinSeedHashPower(seedLength);
+    Splitter<TPosition> splitter(0, length(kmers), parallelTag);
+    SEQAN_OMP_PRAGMA(parallel for)
+    for (int job = 0; job < (int)length(splitter); ++job)
+    {
+        TIter it = begin(ref, Standard()) + splitter[job];
+        __uint64 hash = _joinSeedHash(it, seedLength);
+        for (TPosition pos = splitter[job]; pos < splitter[job + 1]; ++pos, ++it)
+        {
+            kmers[pos] = TEntry(hash, pos);
+            if (pos + seedLength < length(ref))
+                hash = (hash - (ordValue(*it) + 1) * power) * 1099511628211ull + ordValue(*(it + seedLength)) + 1;
+        }
+    }
+    sort(kmers, parallelTag);
+
+    // Keep the unique hashes only, repeats do not give reliable anchors.
+    for (unsigned i = 0; i < length(kmers); ++i)
+        if ((i == 0 || kmers[i - 1].i1 != kmers[i].i1) && (i + 1 == length(kmers) || kmers[i + 1].i1 != kmers[i].i1))
+            appendValue(table.entries, kmers[i]);
+}
+
+// ----------------------------------------------------------------------------
+// Function _joinFindAnchors()
+// ----------------------------------------------------------------------------
+
+// Anchors seq to the reference by unique k-mer matches.  Each match is extended to a maximal exact match and the
+// k-mers covered by it are skipped, so the anchors do not overlap in seq.
+
+template <typename TSeeds, typename TSequence, typename THost>
+inline void
+_joinFindAnchors(TSeeds & anchors,
+                 TSequence const & seq,
+                 THost const & ref,
+                 JoinSeedTable_<THost> const & table)
+{
+    typedef JoinSeedTable_<THost>                                   TTable;
+    typedef typename TTable::TPosition                              TPosition;
+    typedef typename TTable::TEntry                                 TEntry;
+    typedef typename Iterator<String<TEntry> const, Standard>::Type TEntryIter;
+    typedef typename Value<TSeeds>::Type                            TSeed;
+
+    unsigned seedLength = table.seedLength;
+    clear(anchors);
+    if (length(seq) < seedLength || empty(table.entries))
+        return;
+
+    __uint64 power = _joinSeedHashPower(seedLength);
+    __uint64 hash = _joinSeedHash(begin(seq, Standard()), seedLength);
+    TPosition seqEnd = 0;  // End of the last anchor in seq.
+    for (TPosition pos = 0; pos + seedLength <= length(seq); ++pos)
+    {
+        if (pos >= seqEnd)
+        {
+            TEntryIter it = std::lower_bound(begin(table.entries, Standard()), end(table.entries, Standard()),
+                                             TEntry(hash, 0));
+            if (it != end(table.entries, Standard()) && it->i1 == hash)
+            {
+                TPosition refPos = it->i2;
+                TPosition len = 0;
+                while (pos + len < length(seq) && refPos + len < length(ref) && seq[pos + len] == ref[refPos + len])
+                    ++len;
+                if (len >= seedLength)  // Otherwise a hash collision.
+                {
+                    appendValue(anchors, TSeed(refPos, pos, len));
+                    seqEnd = pos + len;
+                }
+            }
+        }
+        if (pos + seedLength < length(seq))
+            hash = (hash - (ordValue(seq[pos]) + 1) * power) * 1099511628211ull + ordValue(seq[pos + seedLength]) + 1;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _joinTraceFromGaps()
+// ----------------------------------------------------------------------------
+
+// Converts the alignment of the reference (horizontal) and seq (vertical) into journal entries.  Runs of matches are
+// taken from the reference, all other characters of seq are stored in the insertion buffer.
+
+template <typename TJournalString, typename THost, typename TSequence, typename TGapsH, typename TGapsV>
+inline void
+_joinTraceFromGaps(JournalTraceBuffer<TJournalString> & trace,
+                   THost const & ref,
+                   TSequence const & seq,
+                   TGapsH & gapsRef,
+                   TGapsV & gapsSeq)
+{
+    typedef typename Position<TJournalString>::Type       TPos;
+    typedef typename Iterator<TGapsH, Standard>::Type     TGapsIterH;
+    typedef typename Iterator<TGapsV, Standard>::Type     TGapsIterV;
+
+    TPos refPos = 0, seqPos = 0;
+    TPos runRefBegin = 0, runSeqBegin = 0;
+    bool runOpen = false;
+    TraceDirection runType = DIAGONAL;
+
+    TGapsIterH itRef = begin(gapsRef, Standard());
+    TGapsIterV itSeq = begin(gapsSeq, Standard());
+    while (!atEnd(itRef) || !atEnd(itSeq))
+    {
+        bool refGap = atEnd(itRef) || isGap(itRef);
+        bool seqGap = atEnd(itSeq) || isGap(itSeq);
+
+        // Columns with a character of seq either continue a match run or a patch run.  Deletions only interrupt
+        // match runs, since these have to be contiguous in the reference.
+        if (seqGap)
+        {
+            if (runOpen && runType == DIAGONAL)
+            {
+                _alignTracePrint(trace, ref, seq, 0, runRefBegin, 0, runSeqBegin, seqPos - runSeqBegin, runType);
+                runOpen = false;
+            }
+        }
+        else
+        {
+            TraceDirection colType = (!refGap && ref[refPos] == seq[seqPos]) ? DIAGONAL : VERTICAL;
+            if (runOpen && runType != colType)
+            {
+                _alignTracePrint(trace, ref, seq, 0, runRefBegin, 0, runSeqBegin, seqPos - runSeqBegin, runType);
+                runOpen = false;
+            }
+            if (!runOpen)
+            {
+                runOpen = true;
+                runType = colType;
+                runRefBegin = refPos;
+                runSeqBegin = seqPos;
+            }
+        }
+
+        if (!refGap)
+            ++refPos;
+        if (!seqGap)
+            ++seqPos;
+        if (!atEnd(itRef))
+            ++itRef;
+        if (!atEnd(itSeq))
+            ++itSeq;
+    }
+    if (runOpen)
+        _alignTracePrint(trace, ref, seq, 0, runRefBegin, 0, runSeqBegin, seqPos - runSeqBegin, runType);
+}
+
+// ----------------------------------------------------------------------------
+// Function _joinTraceFromChain()
+// ----------------------------------------------------------------------------
+
+// Takes the anchors from the reference and stores the sequence between the anchors in the insertion buffer.
+
+template <typename TJournalString, typename THost, typename TSequence, typename TSeedChain>
+inline void
+_joinTraceFromChain(JournalTraceBuffer<TJournalString> & trace,
+                    THost const & ref,
+                    TSequence const & seq,
+                    TSeedChain const & chain)
+{
+    typedef typename Position<TJournalString>::Type               TPos;
+    typedef typename Iterator<TSeedChain const, Standard>::Type   TChainIter;
+
+    TPos seqPos = 0;
+    for (TChainIter it = begin(chain, Standard()); it != end(chain, Standard()); ++it)
+    {
+        TPos seqBegin = beginPositionV(*it);
+        TPos refBegin = beginPositionH(*it);
+        // Overlaps with the previous anchor are cut away.
+        if (seqBegin < seqPos)
+        {
+            refBegin += seqPos - seqBegin;
+            seqBegin = seqPos;
+        }
+        if (seqBegin >= static_cast<TPos>(endPositionV(*it)))
+            continue;
+
+        _alignTracePrint(trace, ref, seq, 0, refBegin, 0, seqPos, seqBegin - seqPos, VERTICAL);
+        _alignTracePrint(trace, ref, seq, 0, refBegin, 0, seqBegin, (TPos)endPositionV(*it) - seqBegin, DIAGONAL);
+        seqPos = endPositionV(*it);
+    }
+    _alignTracePrint(trace, ref, seq, 0, (TPos)length(ref), 0, seqPos, (TPos)length(seq) - seqPos, VERTICAL);
+}
+
+// ----------------------------------------------------------------------------
+// Function _joinGlobalChain()
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename THostSpec, typename TJournalSpec, typename TBuffSpec, typename TJournalString2,
+          typename TSpec>
+inline void
+_joinGlobalChain(String<TValue, Journaled<THostSpec, TJournalSpec, TBuffSpec> > & journal,
+                 StringSet<TJournalString2, Owner<JournaledSet> > const & journalSet,
+                 JoinSeedTable_<String<TValue, THostSpec> > const & table,
+                 JoinConfig<GlobalChain<TSpec> > const & joinConfig)
+{
+    typedef String<TValue, Journaled<THostSpec, TJournalSpec, TBuffSpec> > TJournalString;
+    typedef String<TValue, THostSpec>                                       THost;
+    typedef Seed<Simple>                                                    TSeed;
+
+    THost const & ref = host(journalSet);
+    THost seq = journal;
+
+    String<TSeed> anchors;
+    _joinFindAnchors(anchors, seq, ref, table);
+
+    // Without anchors there is nothing shared with the reference worth to journal.
+    if (empty(anchors))
+    {
+        _joinInternal(journal, journalSet, JoinConfig<GlobalAlign<JournaledManhatten> >());
+        return;
+    }
+
+    SeedSet<TSeed, Unordered> seedSet;
+    for (unsigned i = 0; i < length(anchors); ++i)
+        addSeed(seedSet, anchors[i], Single());
+    String<TSeed> chain;
+    chainSeedsGlobally(chain, seedSet, SparseChaining());
+
+    JournalTraceBuffer<TJournalString> trace;
+    if (IsSameType<TSpec, JournaledCompact>::VALUE)
+    {
+        // Banded DP around and between the anchors only.  The reference is not modified by the alignment.
+        Gaps<THost, ArrayGaps> gapsRef(const_cast<THost &>(ref));
+        Gaps<THost, ArrayGaps> gapsSeq(seq);
+        bandedChainAlignment(gapsRef, gapsSeq, chain, scoringScheme(joinConfig),
+                             AlignConfig<false, false, false, false>(), bandExtension(joinConfig));
+        _joinTraceFromGaps(trace, ref, seq, gapsRef, gapsSeq);
+    }
+    else
+    {
+        _joinTraceFromChain(trace, ref, seq, chain);
+    }
+    _applyTraceOperations(journal, ref, trace);
+}
+
+// ----------------------------------------------------------------------------
+// Function _joinInternal()                                       [GlobalChain]
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename THostSpec, typename TJournalSpec, typename TBuffSpec, typename TJournalString2,
+          typename TSpec>
+inline void
+_joinInternal(String<TValue, Journaled<THostSpec, TJournalSpec, TBuffSpec> > & journal,
+              StringSet<TJournalString2, Owner<JournaledSet> > const & journalSet,
+              JoinConfig<GlobalChain<TSpec> > const & joinConfig)
+{
+    JoinSeedTable_<String<TValue, THostSpec> > table;
+    _joinBuildSeedTable(table, host(journalSet), seedLength(joinConfig), Serial());
+    _joinGlobalChain(journal, journalSet, table, joinConfig);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef INCLUDE_SEQAN_JOURNALED_SET_JOURNALED_SET_JOIN_GLOBAL_CHAIN_H_
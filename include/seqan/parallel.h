@@ -98,5 +98,7 @@
 #include <seqan/parallel/parallel_queue_suspendable.h>
 #include <seqan/parallel/parallel_resource_pool.h>
 #include <seqan/parallel/parallel_serializer.h>
+#include <seqan/parallel/parallel_work_stealing.h>
+#include <seqan/parallel/parallel_thread_caching_allocator.h>
 
 #endif  // SEQAN_PARALLEL_H_
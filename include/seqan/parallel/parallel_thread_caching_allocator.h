@@ -0,0 +1,742 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Thread-safe pool allocator with per-thread caches.
+// ==========================================================================
+// Small blocks are rounded up to size classes.  Every thread keeps a cache
+// of free blocks per size class and exchanges whole batches of blocks with
+// a global free list that has one spin lock per size class, so allocating
+// and freeing usually needs no synchronization at all.  New blocks are
+// carved from aligned arenas that store the owning cache in their header.
+
+#ifndef SEQAN_PARALLEL_PARALLEL_THREAD_CACHING_ALLOCATOR_H_
+#define SEQAN_PARALLEL_PARALLEL_THREAD_CACHING_ALLOCATOR_H_
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+// The thread caches require C++11 thread-local storage.  Without it, every
+// operation borrows a cache from the global pool.
+#if defined(SEQAN_CXX11_STANDARD) && (!defined(_MSC_VER) || _MSC_VER >= 1900)
+#define SEQAN_THREAD_CACHING_ALLOC_TLS 1
+#else
+#define SEQAN_THREAD_CACHING_ALLOC_TLS 0
+#endif
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+template <typename TSpec>
+struct ThreadCachingAllocCache_;
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Tag HugePages
+// ----------------------------------------------------------------------------
+
+/*!
+ * @tag HugePages
+ * @headerfile <seqan/parallel.h>
+ * @brief Backs the arenas of the @link ThreadCachingAllocator @endlink by huge pages.
+ *
+ * @signature typedef Tag<HugePages_> HugePages;
+ *
+ * On Linux, the arenas are mapped with <tt>MAP_HUGETLB</tt>.  If no huge pages are reserved, transparent huge pages
+ * are requested with <tt>madvise</tt> instead.  On other platforms, the tag has no effect.
+ */
+
+struct HugePages_;
+typedef Tag<HugePages_> HugePages;
+
+// ----------------------------------------------------------------------------
+// Class ThreadCachingAllocator
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class ThreadCachingAllocator
+ * @extends Allocator
+ * @headerfile <seqan/parallel.h>
+ * @brief Thread-safe allocator that pools memory blocks in per-thread caches.
+ *
+ * @signature template <[typename TSpec]>
+ *            class Allocator<ThreadCachingAlloc<TSpec> >;
+ *
+ * @tparam TSpec Use @link HugePages @endlink to back the arenas by huge pages.  Default is <tt>Default</tt>.
+ *
+ * All allocator objects with the same <tt>TSpec</tt> share one process-wide pool, thus a block can be deallocated by
+ * any thread.  Blocks of up to <tt>BLOCKING_LIMIT</tt> bytes are rounded up to one of <tt>CLASS_COUNT</tt> size
+ * classes and carved from arenas of <tt>ARENA_SIZE</tt> bytes.  A freed block is put into the cache of the freeing
+ * thread.  Caches hand surplus blocks in batches to a global free list, guarded by one spin lock per size class, and
+ * refill from it.  Arenas are not returned to the operating system.  Larger blocks are allocated and deallocated with
+ * <tt>operator new</tt> and <tt>operator delete</tt>.
+ *
+ * An Alloc String uses this allocator if it is specialized with <tt>Alloc&lt;ThreadCachingAlloc&lt;TSpec&gt; &gt;</tt>.
+ *
+ * @section Examples
+ *
+ * @code{.cpp}
+ * typedef String<Dna, Alloc<ThreadCachingAlloc<> > > TReadSeq;
+ *
+ * SEQAN_OMP_PRAGMA(parallel for)
+ * for (int i = 0; i < 1000; ++i)
+ * {
+ *     TReadSeq read = "ACGTACGT";
+ *     appendValue(read, 'A');
+ * }
+ * ThreadCachingAllocStatistics stats = allocatorStatistics(ThreadCachingAllocator());
+ * @endcode
+ */
+
+template <typename TSpec = Default>
+struct ThreadCachingAlloc;
+
+typedef Allocator<ThreadCachingAlloc<> > ThreadCachingAllocator;
+
+template <typename TSpec>
+struct Allocator<ThreadCachingAlloc<TSpec> >
+{
+    enum
+    {
+        BLOCKING_LIMIT = 0x10000,
+        CLASS_COUNT = 48,
+        ARENA_SIZE = 0x200000,
+        ARENA_HEADER_SIZE = 64,
+        BATCH_SIZE = 32,
+        BATCH_BYTES = 0x10000
+    };
+};
+
+// ----------------------------------------------------------------------------
+// Class ThreadCachingAllocStatistics
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class ThreadCachingAllocStatistics
+ * @headerfile <seqan/parallel.h>
+ * @brief Memory statistics of a @link ThreadCachingAllocator @endlink.
+ *
+ * @signature struct ThreadCachingAllocStatistics;
+ *
+ * The counters are maintained by each thread on its own and summed up when the statistics are requested.
+ *
+ * @var __int64 ThreadCachingAllocStatistics::bytesInUse;
+ * @brief Number of requested bytes that are currently allocated.
+ *
+ * @var __int64 ThreadCachingAllocStatistics::bytesReserved;
+ * @brief Total size of the arenas.
+ *
+ * @var __int64 ThreadCachingAllocStatistics::crossThreadFrees;
+ * @brief Number of pooled blocks deallocated by another thread than the one that carved them from its arena.
+ */
+
+struct ThreadCachingAllocStatistics
+{
+    __int64 bytesInUse;
+    __int64 bytesReserved;
+    __int64 crossThreadFrees;
+
+    ThreadCachingAllocStatistics() :
+        bytesInUse(0), bytesReserved(0), crossThreadFrees(0)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class ThreadCachingAllocCache_
+// ----------------------------------------------------------------------------
+
+// The free blocks and counters of one thread.  Caches are never destroyed; the cache of a finished thread is taken
+// over by the next thread that needs one.
+template <typename TSpec>
+struct ThreadCachingAllocCache_
+{
+    typedef Allocator<ThreadCachingAlloc<TSpec> > TAllocator;
+
+    char *              freeBlocks[TAllocator::CLASS_COUNT];
+    unsigned            freeCount[TAllocator::CLASS_COUNT];
+    char *              arenaFree;
+    char *              arenaEnd;
+    __int64 volatile    bytesAllocated;
+    __int64 volatile    bytesFreed;
+    __int64 volatile    crossThreadFrees;
+    unsigned volatile   inUse;
+    ThreadCachingAllocCache_ * nextCache;
+
+    ThreadCachingAllocCache_() :
+        arenaFree(NULL), arenaEnd(NULL), bytesAllocated(0), bytesFreed(0), crossThreadFrees(0), inUse(1u),
+        nextCache(NULL)
+    {
+        std::memset(freeBlocks, 0, sizeof(freeBlocks));
+        std::memset(freeCount, 0, sizeof(freeCount));
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Class ThreadCachingAllocPool_
+// ----------------------------------------------------------------------------
+
+// The global state shared by all threads.  Each entry of batches is a stack of batches of free blocks that is guarded
+// by the spin lock of its size class.  The first pointer of a block links the blocks of a batch, the second pointer of
+// the first block links the batches.
+template <typename TSpec>
+struct ThreadCachingAllocPool_
+{
+    typedef Allocator<ThreadCachingAlloc<TSpec> > TAllocator;
+    typedef ThreadCachingAllocCache_<TSpec> TCache;
+
+    char *              batches[TAllocator::CLASS_COUNT];
+    ReadWriteLock       batchLocks[TAllocator::CLASS_COUNT];
+    TCache * volatile   caches;
+    __int64 volatile    bytesReserved;
+
+    ThreadCachingAllocPool_() :
+        caches(NULL), bytesReserved(0)
+    {
+        for (unsigned i = 0; i < TAllocator::CLASS_COUNT; ++i)
+            batches[i] = NULL;
+    }
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Helper Function _threadCachingAllocSizeClass()
+// ----------------------------------------------------------------------------
+
+// Sizes up to 256 bytes are rounded up to multiples of 16, larger sizes to a quarter of their power of two.
+inline unsigned
+_threadCachingAllocSizeClass(size_t bytes)
+{
+    if (bytes <= 256u)
+        return (bytes == 0u) ? 0u : static_cast<unsigned>((bytes - 1) >> 4);
+
+    unsigned exponent = 8;
+    while (((bytes - 1) >> (exponent + 1)) != 0u)
+        ++exponent;
+    return 16u + ((exponent - 8) << 2) + static_cast<unsigned>(((bytes - 1) >> (exponent - 2)) & 3u);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _threadCachingAllocClassSize()
+// ----------------------------------------------------------------------------
+
+inline size_t
+_threadCachingAllocClassSize(unsigned sizeClass)
+{
+    if (sizeClass < 16u)
+        return (sizeClass + 1) << 4;
+
+    unsigned exponent = 8 + ((sizeClass - 16) >> 2);
+    return (static_cast<size_t>(1) << exponent) + (static_cast<size_t>((sizeClass & 3u) + 1) << (exponent - 2));
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _threadCachingAllocBatchSize()
+// ----------------------------------------------------------------------------
+
+// Number of blocks that are moved between a thread cache and the global pool at once.
+template <typename TSpec>
+inline unsigned
+_threadCachingAllocBatchSize(Allocator<ThreadCachingAlloc<TSpec> > const &, unsigned sizeClass)
+{
+    typedef Allocator<ThreadCachingAlloc<TSpec> > TAllocator;
+
+    size_t count = TAllocator::BATCH_BYTES / _threadCachingAllocClassSize(sizeClass);
+    return static_cast<unsigned>(_max(static_cast<size_t>(1), _min(count, static_cast<size_t>(TAllocator::BATCH_SIZE))));
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _threadCachingAllocPool()
+// ----------------------------------------------------------------------------
+
+// The pool is intentionally never destroyed, so that strings in static objects can still be deallocated at exit.
+template <typename TSpec>
+inline ThreadCachingAllocPool_<TSpec> &
+_threadCachingAllocPool(Allocator<ThreadCachingAlloc<TSpec> > const &)
+{
+    static ThreadCachingAllocPool_<TSpec> * pool = new ThreadCachingAllocPool_<TSpec>();
+    return *pool;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _allocateThreadCachingAllocArena()
+// ----------------------------------------------------------------------------
+
+#if defined(__linux__)
+
+// Maps an arena aligned to its size by trimming a mapping of twice the size.
+inline char *
+_mapAlignedArena(size_t arenaSize)
+{
+    void * ptr = mmap(NULL, 2 * arenaSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+        SEQAN_THROW(BadAlloc());
+
+    char * raw = static_cast<char *>(ptr);
+    char * arena = raw + (arenaSize - reinterpret_cast<size_t>(raw) % arenaSize) % arenaSize;
+    if (arena != raw)
+        munmap(raw, arena - raw);
+    munmap(arena + arenaSize, raw + arenaSize - arena);
+    return arena;
+}
+
+#endif  // #if defined(__linux__)
+
+template <typename TSpec>
+inline char *
+_allocateThreadCachingAllocArena(Allocator<ThreadCachingAlloc<TSpec> > const &)
+{
+    typedef Allocator<ThreadCachingAlloc<TSpec> > TAllocator;
+
+#if defined(__linux__)
+    return _mapAlignedArena(TAllocator::ARENA_SIZE);
+#else
+    char * raw = static_cast<char *>(operator new(2 * TAllocator::ARENA_SIZE));
+    return raw + (TAllocator::ARENA_SIZE - reinterpret_cast<size_t>(raw) % TAllocator::ARENA_SIZE) %
+                 TAllocator::ARENA_SIZE;
+#endif
+}
+
+inline char *
+_allocateThreadCachingAllocArena(Allocator<ThreadCachingAlloc<HugePages> > const & me)
+{
+    typedef Allocator<ThreadCachingAlloc<HugePages> > TAllocator;
+
+#if defined(__linux__)
+#if defined(MAP_HUGETLB)
+    // Huge pages are aligned to their size, which is at least the arena size.
+    void * ptr = mmap(NULL, TAllocator::ARENA_SIZE, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED && reinterpret_cast<size_t>(ptr) % TAllocator::ARENA_SIZE == 0u)
+        return static_cast<char *>(ptr);
+    if (ptr != MAP_FAILED)
+        munmap(ptr, TAllocator::ARENA_SIZE);
+#endif  // #if defined(MAP_HUGETLB)
+    char * arena = _mapAlignedArena(TAllocator::ARENA_SIZE);
+#if defined(MADV_HUGEPAGE)
+    madvise(arena, TAllocator::ARENA_SIZE, MADV_HUGEPAGE);
+#endif  // #if defined(MADV_HUGEPAGE)
+    ignoreUnusedVariableWarning(me);
+    return arena;
+#else
+    return _allocateThreadCachingAllocArena<Default>(Allocator<ThreadCachingAlloc<Default> >());
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _threadCachingAllocArenaOwner()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec>
+inline ThreadCachingAllocCache_<TSpec> *
+_threadCachingAllocArenaOwner(Allocator<ThreadCachingAlloc<TSpec> > const &, char const * block)
+{
+    typedef Allocator<ThreadCachingAlloc<TSpec> > TAllocator;
+
+    size_t arena = reinterpret_cast<size_t>(block) & ~static_cast<size_t>(TAllocator::ARENA_SIZE - 1);
+    return *reinterpret_cast<ThreadCachingAllocCache_<TSpec> **>(arena);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _pushThreadCachingAllocBatch()
+// ----------------------------------------------------------------------------
+
+// Pushes a batch onto the global stack of the size class.
+template <typename TSpec>
+inline void
+_pushThreadCachingAllocBatch(ThreadCachingAllocPool_<TSpec> & pool, unsigned sizeClass, char * batch)
+{
+    ScopedWriteLock<> lock(pool.batchLocks[sizeClass]);
+    reinterpret_cast<char **>(batch)[1] = pool.batches[sizeClass];
+    pool.batches[sizeClass] = batch;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _popThreadCachingAllocBatch()
+// ----------------------------------------------------------------------------
+
+// Pops a single batch under the lock of the size class.  The stack is never detached as a whole, so a thread only
+// sees it empty if there is no free batch at all.
+template <typename TSpec>
+inline char *
+_popThreadCachingAllocBatch(ThreadCachingAllocPool_<TSpec> & pool, unsigned sizeClass)
+{
+    ScopedWriteLock<> lock(pool.batchLocks[sizeClass]);
+    char * head = pool.batches[sizeClass];
+    if (head != NULL)
+        pool.batches[sizeClass] = reinterpret_cast<char **>(head)[1];
+    return head;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _releaseThreadCachingAllocBatch()
+// ----------------------------------------------------------------------------
+
+// Moves up to one batch of free blocks from the cache to the global pool.
+template <typename TSpec>
+inline void
+_releaseThreadCachingAllocBatch(ThreadCachingAllocPool_<TSpec> & pool,
+                                ThreadCachingAllocCache_<TSpec> & cache,
+                                unsigned sizeClass)
+{
+    unsigned count = _threadCachingAllocBatchSize(Allocator<ThreadCachingAlloc<TSpec> >(), sizeClass);
+    char * first = cache.freeBlocks[sizeClass];
+    char * last = first;
+    unsigned taken = 1;
+    for (; taken < count && *reinterpret_cast<char **>(last) != NULL; ++taken)
+        last = *reinterpret_cast<char **>(last);
+
+    cache.freeBlocks[sizeClass] = *reinterpret_cast<char **>(last);
+    cache.freeCount[sizeClass] -= taken;
+    *reinterpret_cast<char **>(last) = NULL;
+    _pushThreadCachingAllocBatch(pool, sizeClass, first);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _refillThreadCachingAllocCache()
+// ----------------------------------------------------------------------------
+
+// Gets a batch of free blocks from the global pool or carves new blocks from the arena of the cache.  A new arena is
+// only mapped if the global pool has no free batch of the size class.
+template <typename TSpec>
+inline void
+_refillThreadCachingAllocCache(ThreadCachingAllocPool_<TSpec> & pool,
+                               ThreadCachingAllocCache_<TSpec> & cache,
+                               unsigned sizeClass)
+{
+    typedef Allocator<ThreadCachingAlloc<TSpec> > TAllocator;
+
+    char * batch = _popThreadCachingAllocBatch(pool, sizeClass);
+    if (batch != NULL)
+    {
+        unsigned count = 0;
+        for (char * block = batch; block != NULL; block = *reinterpret_cast<char **>(block))
+            ++count;
+        cache.freeBlocks[sizeClass] = batch;
+        cache.freeCount[sizeClass] = count;
+        return;
+    }
+
+    size_t blockSize = _threadCachingAllocClassSize(sizeClass);
+    if (cache.arenaFree == NULL || static_cast<size_t>(cache.arenaEnd - cache.arenaFree) < blockSize)
+    {
+        char * arena = _allocateThreadCachingAllocArena(TAllocator());
+        *reinterpret_cast<ThreadCachingAllocCache_<TSpec> **>(arena) = &cache;
+        cache.arenaFree = arena + TAllocator::ARENA_HEADER_SIZE;
+        cache.arenaEnd = arena + TAllocator::ARENA_SIZE;
+        atomicAdd(pool.bytesReserved, static_cast<__int64>(TAllocator::ARENA_SIZE));
+    }
+
+    size_t count = _min(static_cast<size_t>(_threadCachingAllocBatchSize(TAllocator(), sizeClass)),
+                        static_cast<size_t>(cache.arenaEnd - cache.arenaFree) / blockSize);
+    char * block = cache.arenaFree;
+    for (size_t i = 1; i < count; ++i, block += blockSize)
+        *reinterpret_cast<char **>(block) = block + blockSize;
+    *reinterpret_cast<char **>(block) = NULL;
+
+    cache.freeBlocks[sizeClass] = cache.arenaFree;
+    cache.freeCount[sizeClass] = static_cast<unsigned>(count);
+    cache.arenaFree += count * blockSize;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _acquireThreadCachingAllocCache()
+// ----------------------------------------------------------------------------
+
+// Takes over an unused cache or registers a new one.
+template <typename TSpec>
+inline ThreadCachingAllocCache_<TSpec> *
+_acquireThreadCachingAllocCache(ThreadCachingAllocPool_<TSpec> & pool)
+{
+    typedef ThreadCachingAllocCache_<TSpec> TCache;
+
+    for (TCache * cache = pool.caches; cache != NULL; cache = cache->nextCache)
+        if (cache->inUse == 0u && atomicCasBool(cache->inUse, 0u, 1u))
+            return cache;
+
+    TCache * cache = new TCache();
+    TCache * head;
+    do
+    {
+        head = pool.caches;
+        cache->nextCache = head;
+    }
+    while (!atomicCasBool(pool.caches, head, cache));
+    return cache;
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _releaseThreadCachingAllocCache()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec>
+inline void
+_releaseThreadCachingAllocCache(ThreadCachingAllocCache_<TSpec> & cache)
+{
+    atomicCas(cache.inUse, 1u, 0u);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _flushThreadCachingAllocCache()
+// ----------------------------------------------------------------------------
+
+// Returns all free blocks of the cache to the global pool.
+template <typename TSpec>
+inline void
+_flushThreadCachingAllocCache(ThreadCachingAllocPool_<TSpec> & pool, ThreadCachingAllocCache_<TSpec> & cache)
+{
+    typedef Allocator<ThreadCachingAlloc<TSpec> > TAllocator;
+
+    for (unsigned sizeClass = 0; sizeClass < TAllocator::CLASS_COUNT; ++sizeClass)
+        while (cache.freeBlocks[sizeClass] != NULL)
+            _releaseThreadCachingAllocBatch(pool, cache, sizeClass);
+}
+
+// ----------------------------------------------------------------------------
+// Helper Function _threadCachingAllocLocalCache()
+// ----------------------------------------------------------------------------
+
+#if SEQAN_THREAD_CACHING_ALLOC_TLS
+
+// The cache of the current thread.  The destructor of the guard hands the cache back when the thread exits.
+template <typename TSpec>
+struct ThreadCachingAllocLocal_
+{
+    static thread_local ThreadCachingAllocCache_<TSpec> * cache;
+    static thread_local bool finished;
+
+    ~ThreadCachingAllocLocal_()
+    {
+        if (cache == NULL)
+            return;
+        _flushThreadCachingAllocCache(_threadCachingAllocPool(Allocator<ThreadCachingAlloc<TSpec> >()), *cache);
+        _releaseThreadCachingAllocCache(*cache);
+        cache = NULL;
+        finished = true;
+    }
+};
+
+template <typename TSpec>
+thread_local ThreadCachingAllocCache_<TSpec> * ThreadCachingAllocLocal_<TSpec>::cache = NULL;
+
+template <typename TSpec>
+thread_local bool ThreadCachingAllocLocal_<TSpec>::finished = false;
+
+#endif  // #if SEQAN_THREAD_CACHING_ALLOC_TLS
+
+// Returns the cache of the current thread or NULL if there is none, e.g. while the thread exits.
+template <typename TSpec>
+inline ThreadCachingAllocCache_<TSpec> *
+_threadCachingAllocLocalCache(ThreadCachingAllocPool_<TSpec> & pool)
+{
+#if SEQAN_THREAD_CACHING_ALLOC_TLS
+    typedef ThreadCachingAllocLocal_<TSpec> TLocal;
+
+    if (TLocal::cache != NULL || TLocal::finished)
+        return TLocal::cache;
+
+    static thread_local TLocal guard;
+    ignoreUnusedVariableWarning(guard);
+    TLocal::cache = _acquireThreadCachingAllocCache(pool);
+    return TLocal::cache;
+#else
+    ignoreUnusedVariableWarning(pool);
+    return NULL;
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+// The memory is shared by all allocator objects, so there is nothing to clear.
+template <typename TSpec>
+inline void
+clear(Allocator<ThreadCachingAlloc<TSpec> > &)
+{}
+
+// ----------------------------------------------------------------------------
+// Function allocate()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TValue, typename TSize, typename TUsage>
+inline void
+allocate(Allocator<ThreadCachingAlloc<TSpec> > & me,
+         TValue * & data,
+         TSize count,
+         Tag<TUsage> const &)
+{
+    typedef Allocator<ThreadCachingAlloc<TSpec> > TAllocator;
+    typedef ThreadCachingAllocCache_<TSpec> TCache;
+
+    size_t bytes = count * sizeof(TValue);
+    ThreadCachingAllocPool_<TSpec> & pool = _threadCachingAllocPool(me);
+    TCache * localCache = _threadCachingAllocLocalCache(pool);
+    TCache * cache = (localCache != NULL) ? localCache : _acquireThreadCachingAllocCache(pool);
+
+    char * ptr;
+    if (bytes > static_cast<size_t>(TAllocator::BLOCKING_LIMIT))
+    {
+        ptr = static_cast<char *>(operator new(bytes));
+    }
+    else
+    {
+        unsigned sizeClass = _threadCachingAllocSizeClass(bytes);
+        if (cache->freeBlocks[sizeClass] == NULL)
+            _refillThreadCachingAllocCache(pool, *cache, sizeClass);
+        ptr = cache->freeBlocks[sizeClass];
+        cache->freeBlocks[sizeClass] = *reinterpret_cast<char **>(ptr);
+        --cache->freeCount[sizeClass];
+    }
+    cache->bytesAllocated += bytes;
+
+    if (localCache == NULL)
+        _releaseThreadCachingAllocCache(*cache);
+    data = reinterpret_cast<TValue *>(ptr);
+}
+
+// ----------------------------------------------------------------------------
+// Function deallocate()
+// ----------------------------------------------------------------------------
+
+template <typename TSpec, typename TValue, typename TSize, typename TUsage>
+inline void
+deallocate(Allocator<ThreadCachingAlloc<TSpec> > & me,
+           TValue * data,
+           TSize count,
+           Tag<TUsage> const &)
+{
+    typedef Allocator<ThreadCachingAlloc<TSpec> > TAllocator;
+    typedef ThreadCachingAllocCache_<TSpec> TCache;
+
+    if (data == NULL)
+        return;
+
+    size_t bytes = count * sizeof(TValue);
+    char * ptr = reinterpret_cast<char *>(data);
+    ThreadCachingAllocPool_<TSpec> & pool = _threadCachingAllocPool(me);
+    TCache * localCache = _threadCachingAllocLocalCache(pool);
+    TCache * cache = (localCache != NULL) ? localCache : _acquireThreadCachingAllocCache(pool);
+
+    if (bytes > static_cast<size_t>(TAllocator::BLOCKING_LIMIT))
+    {
+        operator delete(ptr);
+    }
+    else
+    {
+        unsigned sizeClass = _threadCachingAllocSizeClass(bytes);
+        if (_threadCachingAllocArenaOwner(me, ptr) != cache)
+            ++cache->crossThreadFrees;
+        *reinterpret_cast<char **>(ptr) = cache->freeBlocks[sizeClass];
+        cache->freeBlocks[sizeClass] = ptr;
+        if (++cache->freeCount[sizeClass] >= 2 * _threadCachingAllocBatchSize(me, sizeClass))
+            _releaseThreadCachingAllocBatch(pool, *cache, sizeClass);
+    }
+    cache->bytesFreed += bytes;
+
+    if (localCache == NULL)
+        _releaseThreadCachingAllocCache(*cache);
+}
+
+// ----------------------------------------------------------------------------
+// Function allocatorStatistics()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn ThreadCachingAllocator#allocatorStatistics
+ * @brief Returns the memory statistics of the pool shared by all allocators of this type.
+ *
+ * @signature ThreadCachingAllocStatistics allocatorStatistics(allocator);
+ *
+ * @param[in] allocator The @link ThreadCachingAllocator @endlink to query.
+ *
+ * @return ThreadCachingAllocStatistics The statistics summed up over all threads.  While other threads allocate
+ *                                      memory, the result is only approximate.
+ */
+
+template <typename TSpec>
+inline ThreadCachingAllocStatistics
+allocatorStatistics(Allocator<ThreadCachingAlloc<TSpec> > const & me)
+{
+    typedef ThreadCachingAllocCache_<TSpec> TCache;
+
+    ThreadCachingAllocPool_<TSpec> & pool = _threadCachingAllocPool(me);
+    ThreadCachingAllocStatistics stats;
+    for (TCache * cache = pool.caches; cache != NULL; cache = cache->nextCache)
+    {
+        stats.bytesInUse += cache->bytesAllocated - cache->bytesFreed;
+        stats.crossThreadFrees += cache->crossThreadFrees;
+    }
+    stats.bytesReserved = pool.bytesReserved;
+    return stats;
+}
+
+// ----------------------------------------------------------------------------
+// Function allocate()                          [String<.., ThreadCachingAlloc>]
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TValue2, typename TSize, typename TUsage>
+inline void
+allocate(String<TValue, Alloc<ThreadCachingAlloc<TSpec> > > &,
+         TValue2 * & data,
+         TSize count,
+         Tag<TUsage> const & tag)
+{
+    Allocator<ThreadCachingAlloc<TSpec> > alloc;
+    allocate(alloc, data, count, tag);
+}
+
+// ----------------------------------------------------------------------------
+// Function deallocate()                        [String<.., ThreadCachingAlloc>]
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec, typename TValue2, typename TSize, typename TUsage>
+inline void
+deallocate(String<TValue, Alloc<ThreadCachingAlloc<TSpec> > > &,
+           TValue2 * data,
+           TSize count,
+           Tag<TUsage> const & tag)
+{
+    Allocator<ThreadCachingAlloc<TSpec> > alloc;
+    deallocate(alloc, data, count, tag);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_PARALLEL_PARALLEL_THREAD_CACHING_ALLOCATOR_H_
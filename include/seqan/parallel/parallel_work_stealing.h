@@ -0,0 +1,654 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2014, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Lock-free work-stealing deque (Chase-Lev) and a task pool built on it.
+// ==========================================================================
+// Each thread owns one deque.  The owner appends and removes tasks at the
+// back without locking, other threads steal the oldest task at the front
+// with a single compare-and-swap.  See Chase and Lev, "Dynamic circular
+// work-stealing deque", SPAA 2005.
+
+#ifndef SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
+#define SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
+
+namespace seqan {
+
+// ============================================================================
+// Classes
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class WorkStealingDeque
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class WorkStealingDeque
+ * @headerfile <seqan/parallel.h>
+ * @brief Lock-free deque for one owner thread and multiple stealing threads.
+ *
+ * @signature template <typename TValue[, typename TSpec]>
+ *            class WorkStealingDeque;
+ *
+ * @tparam TValue Element type of the deque.
+ * @tparam TSpec  Tag for further specializing the deque. Default is <tt>void</tt>.
+ *
+ * Only the owner thread may call @link WorkStealingDeque#appendValue @endlink and @link
+ * WorkStealingDeque#tryPopBack @endlink, i.e. it uses the deque as a stack.  Any thread may call @link
+ * WorkStealingDeque#tryPopFront @endlink to steal the oldest element.
+ *
+ * The elements are kept in nodes referenced by a growing ring buffer of pointers.  Buffers that were replaced by a
+ * larger one are only freed in the destructor, as stealing threads may still read from them.  Nodes of removed
+ * elements are returned to a free list of the deque and reused by the owner, s.t. nodes are only allocated while the
+ * deque grows.
+ */
+
+template <typename TValue>
+struct WorkStealingNode_
+{
+    TValue                          value;
+    WorkStealingNode_ *             next;   // next node in a free list
+
+    template <typename TValue2>
+    explicit
+    WorkStealingNode_(TValue2 SEQAN_FORWARD_CARG val) :
+        value(SEQAN_FORWARD(TValue2, val)),
+        next(NULL)
+    {}
+};
+
+template <typename TValue, typename TSpec = void>
+class WorkStealingDeque
+{
+public:
+    typedef WorkStealingNode_<TValue>   TNode;
+    typedef String<TNode *>             TRing;
+
+    __int64 volatile    topPos;         char pad1[SEQAN_CACHE_LINE_SIZE - sizeof(__int64)];
+    __int64 volatile    bottomPos;      char pad2[SEQAN_CACHE_LINE_SIZE - sizeof(__int64)];
+    TNode * volatile    freeNodes;      char pad3[SEQAN_CACHE_LINE_SIZE - sizeof(TNode *)];
+                                        // nodes of removed elements, pushed by any thread, taken by the owner
+    TRing * volatile    ring;
+    String<TRing *>     oldRings;       // replaced ring buffers, only accessed by the owner
+    TNode *             ownerNodes;     // free nodes taken from freeNodes, only accessed by the owner
+
+    WorkStealingDeque() :
+        topPos(0),
+        bottomPos(0),
+        freeNodes(NULL),
+        ring(new TRing),
+        ownerNodes(NULL)
+    {
+        resize(*ring, 64, (TNode *)NULL, Exact());
+    }
+
+    ~WorkStealingDeque()
+    {
+        __int64 mask = length(*ring) - 1;
+        for (__int64 i = topPos; i < bottomPos; ++i)
+            delete (*ring)[i & mask];
+        delete ring;
+        for (unsigned i = 0; i < length(oldRings); ++i)
+            delete oldRings[i];
+        _deleteWorkStealingNodes(freeNodes);
+        _deleteWorkStealingNodes(ownerNodes);
+    }
+
+private:
+    WorkStealingDeque(WorkStealingDeque const &);
+    void operator=(WorkStealingDeque const &);
+};
+
+// ----------------------------------------------------------------------------
+// Class WorkStealingPool
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class WorkStealingPool
+ * @headerfile <seqan/parallel.h>
+ * @brief Pool of tasks with one @link WorkStealingDeque @endlink per thread.
+ *
+ * @signature template <typename TValue[, typename TSpec]>
+ *            class WorkStealingPool;
+ *
+ * @tparam TValue Task type.
+ * @tparam TSpec  Tag for further specializing the pool. Default is <tt>void</tt>.
+ *
+ * Threads are identified by numbers in <tt>[0, threadCount)</tt>, e.g. <tt>omp_get_thread_num()</tt>.  Tasks are
+ * added to the deque of the calling thread with @link WorkStealingPool#pushTask @endlink.  @link
+ * WorkStealingPool#popTask @endlink returns the newest task of the own deque or steals the oldest task of another
+ * thread.  Threads that found no task are counted as idle until they obtain a task again, see @link
+ * WorkStealingPool#idleThreads @endlink.
+ *
+ * @section Examples
+ *
+ * @code{.cpp}
+ * WorkStealingPool<unsigned> pool(omp_get_max_threads());
+ * SEQAN_OMP_PRAGMA(parallel)
+ * {
+ *     unsigned task;
+ *     pushTask(pool, omp_get_thread_num(), omp_get_thread_num());
+ *     while (popTask(task, pool, omp_get_thread_num()))
+ *         process(task);
+ * }
+ * @endcode
+ */
+
+template <typename TValue, typename TSpec = void>
+class WorkStealingPool
+{
+public:
+    typedef WorkStealingDeque<TValue, TSpec>    TDeque;
+
+    String<TDeque *>    deques;
+    String<unsigned>    seeds;          // for choosing the first victim
+    String<bool>        idle;           // whether the thread found no task in its last popTask() call
+    unsigned volatile   idleCount;
+
+    explicit
+    WorkStealingPool(unsigned threadCount) :
+        idleCount(0)
+    {
+        resize(deques, threadCount, Exact());
+        resize(seeds, threadCount, Exact());
+        resize(idle, threadCount, false, Exact());
+        for (unsigned i = 0; i < threadCount; ++i)
+        {
+            deques[i] = new TDeque;
+            seeds[i] = 73 * i + 1;
+        }
+    }
+
+    ~WorkStealingPool()
+    {
+        for (unsigned i = 0; i < length(deques); ++i)
+            delete deques[i];
+    }
+
+private:
+    WorkStealingPool(WorkStealingPool const &);
+    void operator=(WorkStealingPool const &);
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Metafunction Value
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+struct Value<WorkStealingDeque<TValue, TSpec> >
+{
+    typedef TValue Type;
+};
+
+template <typename TValue, typename TSpec>
+struct Value<WorkStealingPool<TValue, TSpec> >
+{
+    typedef TValue Type;
+};
+
+// ----------------------------------------------------------------------------
+// Metafunction Size
+// ----------------------------------------------------------------------------
+
+template <typename TValue, typename TSpec>
+struct Size<WorkStealingDeque<TValue, TSpec> >
+{
+    typedef __int64 Type;
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _workStealingFence()
+// ----------------------------------------------------------------------------
+
+// Full memory barrier, orders the accesses to top and bottom position.
+inline void
+_workStealingFence()
+{
+#if defined(PLATFORM_WINDOWS) && !defined(PLATFORM_WINDOWS_MINGW)
+    MemoryBarrier();
+#else
+    __sync_synchronize();
+#endif
+}
+
+// ----------------------------------------------------------------------------
+// Function _deleteWorkStealingNodes()
+// ----------------------------------------------------------------------------
+
+template <typename TValue>
+inline void
+_deleteWorkStealingNodes(WorkStealingNode_<TValue> * node)
+{
+    while (node != NULL)
+    {
+        WorkStealingNode_<TValue> * next = node->next;
+        delete node;
+        node = next;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _releaseWorkStealingNode()
+// ----------------------------------------------------------------------------
+
+// Returns the node of a removed element to the free list of the deque, can be called by any thread.
+template <typename TValue, typename TSpec>
+inline void
+_releaseWorkStealingNode(WorkStealingDeque<TValue, TSpec> & me, WorkStealingNode_<TValue> * node)
+{
+    typedef WorkStealingNode_<TValue> TNode;
+
+    TNode * head;
+    do
+    {
+        head = me.freeNodes;
+        node->next = head;
+    }
+    while (!atomicCasBool(me.freeNodes, head, node));
+}
+
+// ----------------------------------------------------------------------------
+// Function _createWorkStealingNode()
+// ----------------------------------------------------------------------------
+
+// Returns a node holding val, reuses a free node if possible.  Must only be called by the owner of the deque, the only
+// thread removing nodes from the free list, which makes taking the whole list ABA-safe.
+template <typename TValue, typename TSpec, typename TValue2>
+inline WorkStealingNode_<TValue> *
+_createWorkStealingNode(WorkStealingDeque<TValue, TSpec> & me, TValue2 SEQAN_FORWARD_CARG val)
+{
+    typedef WorkStealingNode_<TValue> TNode;
+
+    if (me.ownerNodes == NULL && me.freeNodes != NULL)
+    {
+        TNode * head;
+        do
+        {
+            head = me.freeNodes;
+        }
+        while (!atomicCasBool(me.freeNodes, head, (TNode *)NULL));
+        me.ownerNodes = head;
+    }
+
+    TNode * node = me.ownerNodes;
+    if (node == NULL)
+        return new TNode(SEQAN_FORWARD(TValue2, val));
+
+    me.ownerNodes = node->next;
+    node->value = SEQAN_FORWARD(TValue2, val);
+    node->next = NULL;
+    return node;
+}
+
+// ----------------------------------------------------------------------------
+// Function length()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingDeque#length
+ * @brief Returns the number of elements in a deque.
+ *
+ * @signature TSize length(deque);
+ *
+ * @param[in] deque The deque to query.
+ *
+ * @return TSize The number of elements, only a snapshot if other threads access the deque concurrently.
+ */
+
+template <typename TValue, typename TSpec>
+inline __int64
+length(WorkStealingDeque<TValue, TSpec> const & me)
+{
+    __int64 top = me.topPos;
+    __int64 bottom = me.bottomPos;
+    return (bottom > top) ? bottom - top : 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function empty()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingDeque#empty
+ * @brief Returns whether a deque is empty.
+ *
+ * @signature bool empty(deque);
+ *
+ * @param[in] deque The deque to query.
+ *
+ * @return bool Whether the deque is empty, only a snapshot if other threads access the deque concurrently.
+ */
+
+template <typename TValue, typename TSpec>
+inline bool
+empty(WorkStealingDeque<TValue, TSpec> const & me)
+{
+    return length(me) == 0;
+}
+
+// ----------------------------------------------------------------------------
+// Function appendValue()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingDeque#appendValue
+ * @brief Appends an element at the back of a deque.
+ *
+ * @signature void appendValue(deque, val);
+ *
+ * @param[in,out] deque The deque to append the element to.
+ * @param[in]     val   The element to append.
+ *
+ * Must only be called by the owner of the deque.  The ring buffer is doubled if it is full.
+ */
+
+template <typename TValue, typename TSpec, typename TValue2>
+inline void
+appendValue(WorkStealingDeque<TValue, TSpec> & me, TValue2 SEQAN_FORWARD_CARG val)
+{
+    typedef typename WorkStealingDeque<TValue, TSpec>::TRing TRing;
+
+    // the node is filled before it is published by the fence below
+    typename WorkStealingDeque<TValue, TSpec>::TNode * node = _createWorkStealingNode(me, SEQAN_FORWARD(TValue2, val));
+
+    __int64 bottom = me.bottomPos;
+    __int64 top = me.topPos;
+    TRing * ring = me.ring;
+    __int64 ringSize = length(*ring);
+
+    if (bottom - top >= ringSize - 1)
+    {
+        // double the ring buffer, stealing threads may still read the old one
+        TRing * newRing = new TRing;
+        resize(*newRing, 2 * ringSize, (typename WorkStealingDeque<TValue, TSpec>::TNode *)NULL, Exact());
+        for (__int64 i = top; i < bottom; ++i)
+            (*newRing)[i & (2 * ringSize - 1)] = (*ring)[i & (ringSize - 1)];
+        appendValue(me.oldRings, ring);
+        _workStealingFence();
+        me.ring = ring = newRing;
+        ringSize *= 2;
+    }
+
+    (*ring)[bottom & (ringSize - 1)] = node;
+    _workStealingFence();
+    me.bottomPos = bottom + 1;
+}
+
+// ----------------------------------------------------------------------------
+// Function tryPopBack()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingDeque#tryPopBack
+ * @brief Removes the newest element of a deque.
+ *
+ * @signature bool tryPopBack(result, deque);
+ *
+ * @param[out]    result The removed element.
+ * @param[in,out] deque  The deque to remove the element from.
+ *
+ * @return bool <tt>true</tt> if an element was removed, <tt>false</tt> if the deque was empty or its last element was
+ *              stolen concurrently.
+ *
+ * Must only be called by the owner of the deque.
+ */
+
+template <typename TValue, typename TSpec>
+inline bool
+tryPopBack(TValue & result, WorkStealingDeque<TValue, TSpec> & me)
+{
+    typedef typename WorkStealingDeque<TValue, TSpec>::TRing TRing;
+
+    __int64 bottom = me.bottomPos - 1;
+    TRing * ring = me.ring;
+    me.bottomPos = bottom;
+    _workStealingFence();
+    __int64 top = me.topPos;
+
+    if (top > bottom)
+    {
+        // deque was empty
+        me.bottomPos = top;
+        return false;
+    }
+
+    typename WorkStealingDeque<TValue, TSpec>::TNode * node = (*ring)[bottom & (length(*ring) - 1)];
+    if (top == bottom)
+    {
+        // last element, race against stealing threads
+        bool success = atomicCasBool(me.topPos, top, top + 1);
+        me.bottomPos = top + 1;
+        if (!success)
+            return false;
+    }
+
+    result = SEQAN_MOVE(node->value);
+    node->next = me.ownerNodes;
+    me.ownerNodes = node;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function tryPopFront()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingDeque#tryPopFront
+ * @brief Steals the oldest element of a deque.
+ *
+ * @signature bool tryPopFront(result, deque);
+ *
+ * @param[out]    result The removed element.
+ * @param[in,out] deque  The deque to remove the element from.
+ *
+ * @return bool <tt>true</tt> if an element was removed, <tt>false</tt> if the deque was empty or another thread
+ *              removed the element concurrently.
+ *
+ * Can be called by any thread.
+ */
+
+template <typename TValue, typename TSpec>
+inline bool
+tryPopFront(TValue & result, WorkStealingDeque<TValue, TSpec> & me)
+{
+    typedef typename WorkStealingDeque<TValue, TSpec>::TRing TRing;
+
+    __int64 top = me.topPos;
+    _workStealingFence();
+    __int64 bottom = me.bottomPos;
+
+    if (top >= bottom)
+        return false;
+
+    TRing * ring = me.ring;
+    typename WorkStealingDeque<TValue, TSpec>::TNode * node = (*ring)[top & (length(*ring) - 1)];
+    if (!atomicCasBool(me.topPos, top, top + 1))
+        return false;
+
+    result = SEQAN_MOVE(node->value);
+    _releaseWorkStealingNode(me, node);
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function pushTask()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingPool#pushTask
+ * @brief Adds a task to the deque of a thread.
+ *
+ * @signature void pushTask(pool, threadId, task);
+ *
+ * @param[in,out] pool     The pool to add the task to.
+ * @param[in]     threadId The number of the calling thread.
+ * @param[in]     task     The task to add.
+ */
+
+template <typename TValue, typename TSpec, typename TValue2>
+inline void
+pushTask(WorkStealingPool<TValue, TSpec> & pool, unsigned threadId, TValue2 SEQAN_FORWARD_CARG task)
+{
+    appendValue(*pool.deques[threadId], SEQAN_FORWARD(TValue2, task));
+}
+
+// ----------------------------------------------------------------------------
+// Function popTask()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingPool#popTask
+ * @brief Removes a task from the own deque or steals one from another thread.
+ *
+ * @signature bool popTask(task, pool, threadId);
+ *
+ * @param[out]    task     The removed task.
+ * @param[in,out] pool     The pool to remove the task from.
+ * @param[in]     threadId The number of the calling thread.
+ *
+ * @return bool <tt>true</tt> if a task was removed.  <tt>false</tt> if no task was found, the thread is then counted
+ *              as idle until it obtains a task.
+ *
+ * The newest task of the own deque is preferred.  Otherwise, all other deques are tried once in cyclic order,
+ * starting at a random thread.
+ */
+
+template <typename TValue, typename TSpec>
+inline bool
+popTask(TValue & task, WorkStealingPool<TValue, TSpec> & pool, unsigned threadId)
+{
+    unsigned threadCount = length(pool.deques);
+    bool found = tryPopBack(task, *pool.deques[threadId]);
+
+    if (!found && threadCount > 1)
+    {
+        unsigned & seed = pool.seeds[threadId];
+        seed = 1664525 * seed + 1013904223;     // LCG
+        unsigned victim = (seed >> 8) % threadCount;
+        for (unsigned i = 0; i < threadCount && !found; ++i, victim = (victim + 1 == threadCount) ? 0 : victim + 1)
+            if (victim != threadId)
+                found = tryPopFront(task, *pool.deques[victim]);
+    }
+
+    if (found == pool.idle[threadId])
+    {
+        pool.idle[threadId] = !found;
+        if (found)
+            atomicDec(pool.idleCount);
+        else
+            atomicInc(pool.idleCount);
+    }
+    return found;
+}
+
+// ----------------------------------------------------------------------------
+// Function idleThreads()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingPool#idleThreads
+ * @brief Returns the number of threads that found no task in their last call of @link WorkStealingPool#popTask
+ *        @endlink.
+ *
+ * @signature unsigned idleThreads(pool);
+ *
+ * @param[in] pool The pool to query.
+ *
+ * @return unsigned The number of idle threads.  Tasks can be split if this number is greater than 0.
+ */
+
+template <typename TValue, typename TSpec>
+inline unsigned
+idleThreads(WorkStealingPool<TValue, TSpec> const & pool)
+{
+    return pool.idleCount;
+}
+
+// ----------------------------------------------------------------------------
+// Function length()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingPool#length
+ * @brief Returns the number of tasks in a pool.
+ *
+ * @signature __int64 length(pool);
+ *
+ * @param[in] pool The pool to query.
+ *
+ * @return __int64 The number of tasks in all deques, only a snapshot if other threads access the pool concurrently.
+ */
+
+template <typename TValue, typename TSpec>
+inline __int64
+length(WorkStealingPool<TValue, TSpec> const & pool)
+{
+    __int64 result = 0;
+    for (unsigned i = 0; i < length(pool.deques); ++i)
+        result += length(*pool.deques[i]);
+    return result;
+}
+
+// ----------------------------------------------------------------------------
+// Function empty()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn WorkStealingPool#empty
+ * @brief Returns whether a pool contains no tasks.
+ *
+ * @signature bool empty(pool);
+ *
+ * @param[in] pool The pool to query.
+ *
+ * @return bool Whether all deques are empty, only a snapshot if other threads access the pool concurrently.
+ */
+
+template <typename TValue, typename TSpec>
+inline bool
+empty(WorkStealingPool<TValue, TSpec> const & pool)
+{
+    for (unsigned i = 0; i < length(pool.deques); ++i)
+        if (!empty(*pool.deques[i]))
+            return false;
+    return true;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_PARALLEL_PARALLEL_WORK_STEALING_H_
@@ -76,12 +76,14 @@
 #include <seqan/seeds/basic_iter_indirect.h>
 #include <seqan/seeds/seeds_seed_set_base.h>
 #include <seqan/seeds/seeds_seed_set_unordered.h>
+#include <seqan/seeds/seeds_seed_set_diagonal_sorted.h>
 
 // Banded chain alignment.
 #include <seqan/seeds/banded_chain_alignment_profile.h>
 #include <seqan/seeds/banded_chain_alignment_scout.h>
 #include <seqan/seeds/banded_chain_alignment_traceback.h>
 #include <seqan/seeds/banded_chain_alignment_impl.h>
+#include <seqan/seeds/banded_chain_alignment_anti_diagonal.h>
 #include <seqan/seeds/banded_chain_alignment.h>
 
 // Global chaining algorithms
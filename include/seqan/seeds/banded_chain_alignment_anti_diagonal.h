@@ -0,0 +1,238 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Anti-diagonal computation of the unbanded grids (the gaps between the
+// anchors) of the banded chain alignment for linear gap costs.  The cells
+// of one anti-diagonal do not depend on each other, so the recurrence is
+// written as a branch-free loop over the anti-diagonal that the compiler
+// vectorizes.  The trace matrix and the tracking of the scout are the same
+// as for the column-wise computation.
+// ==========================================================================
+
+#ifndef INCLUDE_SEQAN_SEEDS_BANDED_CHAIN_ALIGNMENT_ANTI_DIAGONAL_H_
+#define INCLUDE_SEQAN_SEEDS_BANDED_CHAIN_ALIGNMENT_ANTI_DIAGONAL_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function _replayBandedChainTracking()
+// ----------------------------------------------------------------------------
+
+// Applies the tracking of the scout to one column whose scores were computed beforehand.
+template <typename TDPScout, typename TTraceMatrixNavigator, typename TScoreValue, typename TColumnDescriptor,
+          typename TDPProfile>
+inline void
+_replayBandedChainTracking(TDPScout & scout,
+                           TTraceMatrixNavigator & traceMatrixNavigator,
+                           TScoreValue const * columnScores,
+                           unsigned column,
+                           unsigned columnSize,
+                           TColumnDescriptor const &,
+                           TDPProfile const &)
+{
+    typedef DPCell_<TScoreValue, LinearGaps> TDPCell;
+
+    TDPCell activeCell;
+    unsigned hostPosition = column * columnSize;
+
+    _setToPosition(traceMatrixNavigator, hostPosition);
+    activeCell._score = columnScores[0];
+    _applyBandedChainTracking(scout, traceMatrixNavigator, activeCell, TColumnDescriptor(), FirstCell(), TDPProfile());
+
+    for (unsigned row = 1; row + 1 < columnSize; ++row)
+    {
+        _setToPosition(traceMatrixNavigator, hostPosition + row);
+        activeCell._score = columnScores[row];
+        _applyBandedChainTracking(scout, traceMatrixNavigator, activeCell, TColumnDescriptor(), InnerCell(),
+                                  TDPProfile());
+    }
+
+    _setToPosition(traceMatrixNavigator, hostPosition + columnSize - 1);
+    activeCell._score = columnScores[columnSize - 1];
+    _applyBandedChainTracking(scout, traceMatrixNavigator, activeCell, TColumnDescriptor(), LastCell(), TDPProfile());
+}
+
+// ----------------------------------------------------------------------------
+// Function _computeUnbandedAlignment()           [BandedChainAlignment, Linear]
+// ----------------------------------------------------------------------------
+
+// Computes the unbanded grids of the banded chain alignment along the anti-diagonals.  The first column and the first
+// row are taken from the scout state, all other cells use the full recursion.  The trace values are identical to the
+// column-wise computation.  The scores of the columns that are tracked by the scout are kept and the tracking is
+// applied in column-major order afterwards, so that the initialization of the next grid and the maximal host
+// positions do not change either.  Only complete traces are supported, single traces keep the column-wise computation.
+template <typename TScoreValue, typename TDPScoreMatrixNavigator, typename TDPTraceMatrixNavigator,
+          typename TSequenceH, typename TSequenceV, typename TFreeEndGaps, typename TDPMatrixLocation,
+          typename TGapsPlacement>
+inline void
+_computeUnbandedAlignment(DPScout_<DPCell_<TScoreValue, LinearGaps>, BandedChainAlignmentScout> & scout,
+                          TDPScoreMatrixNavigator & /*dpScoreMatrixNavigator*/,
+                          TDPTraceMatrixNavigator & dpTraceMatrixNavigator,
+                          TSequenceH const & seqH,
+                          TSequenceV const & seqV,
+                          Score<TScoreValue, Simple> const & scoringScheme,
+                          DPProfile_<BandedChainAlignment_<TFreeEndGaps, TDPMatrixLocation>, LinearGaps,
+                                     TracebackOn<TracebackConfig_<CompleteTrace, TGapsPlacement> > > const &)
+{
+    typedef DPProfile_<BandedChainAlignment_<TFreeEndGaps, TDPMatrixLocation>, LinearGaps,
+                       TracebackOn<TracebackConfig_<CompleteTrace, TGapsPlacement> > > TDPProfile;
+    typedef DPScoutState_<BandedChainAlignmentScoutState<DPCell_<TScoreValue, LinearGaps> > > TScoutState;
+    typedef typename TraceBitMap_::TTraceValue TTraceValue;
+    typedef typename Value<TSequenceH const>::Type TSeqHValue;
+    typedef typename Value<TSequenceV const>::Type TSeqVValue;
+
+    SEQAN_ASSERT_GT(length(seqH), 0u);
+    SEQAN_ASSERT_GT(length(seqV), 0u);
+
+    TScoutState const & scoutState = *scout._dpScoutStatePtr;
+    int const lengthH = length(seqH);
+    int const lengthV = length(seqV);
+    unsigned const columnSize = lengthV + 1;
+    int const trackingBegin = _min(static_cast<int>(scoutState._horizontalNextGridOrigin), lengthH + 1);
+
+    TScoreValue const gapV = scoreGapExtendVertical(scoringScheme, value(seqH, 0), value(seqV, 0));
+    TScoreValue const gapH = scoreGapExtendHorizontal(scoringScheme, value(seqH, 0), value(seqV, 0));
+    TTraceValue const traceD = TraceBitMap_::DIAGONAL;
+    TTraceValue const traceV = TraceBitMap_::VERTICAL | TraceBitMap_::MAX_FROM_VERTICAL_MATRIX;
+    TTraceValue const traceH = TraceBitMap_::HORIZONTAL | TraceBitMap_::MAX_FROM_HORIZONTAL_MATRIX;
+
+    // The horizontal sequence is stored reversed and the vertical one shifted by one, so that the characters of the
+    // cells on one anti-diagonal are accessed contiguously.
+    String<TSeqHValue> reversedH;
+    resize(reversedH, lengthH, Exact());
+    for (int i = 0; i < lengthH; ++i)
+        reversedH[i] = value(seqH, lengthH - 1 - i);
+    String<TSeqVValue> shiftedV;
+    resize(shiftedV, columnSize, Exact());
+    shiftedV[0] = value(seqV, 0);
+    for (int i = 0; i < lengthV; ++i)
+        shiftedV[i + 1] = value(seqV, i);
+
+    // The last three anti-diagonals indexed by the row of the cell.
+    String<TScoreValue> diagonals;
+    resize(diagonals, 3 * columnSize, Exact());
+    TScoreValue * prevPrev = begin(diagonals, Standard());
+    TScoreValue * prev = prevPrev + columnSize;
+    TScoreValue * curr = prev + columnSize;
+    String<TTraceValue> traces;
+    resize(traces, columnSize, Exact());
+    TTraceValue * currTrace = begin(traces, Standard());
+
+    // The scores of the tracked columns in column-major order.
+    String<TScoreValue> trackedScores;
+    resize(trackedScores, (lengthH + 1 - trackingBegin) * columnSize, Exact());
+    TScoreValue * tracked = begin(trackedScores, Standard());
+
+    TTraceValue * trace = begin(container(dpTraceMatrixNavigator), Standard());
+    TSeqHValue const * hChars = begin(reversedH, Standard());
+    TSeqVValue const * vChars = begin(shiftedV, Standard());
+
+    // The initial column and the first row of the remaining columns are given by the scout state.
+    for (unsigned row = 0; row < columnSize; ++row)
+        trace[row] = TraceBitMap_::NONE;
+    for (int col = 1; col <= lengthH; ++col)
+        trace[col * columnSize] = TraceBitMap_::NONE;
+    if (trackingBegin == 0)
+        for (unsigned row = 0; row < columnSize; ++row)
+            tracked[row] = _scoreOfCell(scoutState._verticalInitCurrentMatrix[row]);
+    for (int col = _max(trackingBegin, 1); col <= lengthH; ++col)
+        tracked[(col - trackingBegin) * columnSize] = _scoreOfCell(scoutState._horizontalInitCurrentMatrix[col]);
+
+    prevPrev[0] = _scoreOfCell(scoutState._verticalInitCurrentMatrix[0]);
+    prev[0] = _scoreOfCell(scoutState._horizontalInitCurrentMatrix[1]);
+    prev[1] = _scoreOfCell(scoutState._verticalInitCurrentMatrix[1]);
+
+    for (int diag = 2; diag <= lengthH + lengthV; ++diag)
+    {
+        int const rowBegin = _max(1, diag - lengthH);
+        int const rowEnd = _min(lengthV, diag - 1) + 1;
+
+        // Border cells of this anti-diagonal that are read by the following ones.
+        if (diag <= lengthH)
+            curr[0] = _scoreOfCell(scoutState._horizontalInitCurrentMatrix[diag]);
+        if (diag <= lengthV)
+            curr[diag] = _scoreOfCell(scoutState._verticalInitCurrentMatrix[diag]);
+
+        int const hOffset = lengthH - diag;
+        for (int row = rowBegin; row < rowEnd; ++row)
+        {
+            TScoreValue best = prevPrev[row - 1] + score(scoringScheme, hChars[row + hOffset], vChars[row]);
+            TScoreValue tmp = prev[row - 1] + gapV;
+            TTraceValue tv = (best < tmp) ? traceV : ((best == tmp) ? (traceD | traceV) : traceD);
+            best = (best < tmp) ? tmp : best;
+            tmp = prev[row] + gapH;
+            tv = (best < tmp) ? traceH : ((best == tmp) ? (tv | traceH) : tv);
+            best = (best < tmp) ? tmp : best;
+            curr[row] = best;
+            currTrace[row] = tv;
+        }
+
+        // Scatter the anti-diagonal into the column-major trace matrix and the tracked scores.
+        for (int row = rowBegin; row < rowEnd; ++row)
+            trace[(diag - row) * columnSize + row] = currTrace[row];
+        for (int row = rowBegin; row < _min(rowEnd, diag - trackingBegin + 1); ++row)
+            tracked[(diag - row - trackingBegin) * columnSize + row] = curr[row];
+
+        std::swap(prevPrev, prev);
+        std::swap(prev, curr);
+    }
+
+    // Track the scores in the same order as the column-wise computation does.
+    if (trackingBegin == 0)
+        _replayBandedChainTracking(scout, dpTraceMatrixNavigator, tracked, 0u, columnSize,
+                                   MetaColumnDescriptor<DPInitialColumn, FullColumn>(), TDPProfile());
+    for (int col = _max(trackingBegin, 1); col < lengthH; ++col)
+        _replayBandedChainTracking(scout, dpTraceMatrixNavigator, tracked + (col - trackingBegin) * columnSize, col,
+                                   columnSize, MetaColumnDescriptor<DPInnerColumn, FullColumn>(), TDPProfile());
+    if (trackingBegin <= lengthH)
+        _replayBandedChainTracking(scout, dpTraceMatrixNavigator, tracked + (lengthH - trackingBegin) * columnSize,
+                                   lengthH, columnSize, MetaColumnDescriptor<DPFinalColumn, FullColumn>(), TDPProfile());
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef INCLUDE_SEQAN_SEEDS_BANDED_CHAIN_ALIGNMENT_ANTI_DIAGONAL_H_
@@ -35,7 +35,8 @@
 #ifndef SEQAN_SEEDS_SEEDS_GLOBAL_CHAINING_H_
 #define SEQAN_SEEDS_SEEDS_GLOBAL_CHAINING_H_
 
-#include <map>
+#include <algorithm>
+#include <set>
 
 namespace seqan {
 
@@ -49,11 +50,23 @@ namespace seqan {
  *
  * @tag GlobalChainingTags#SparseChaining
  * @brief Tag for global sparse chaining.
+ *
+ * @tag GlobalChainingTags#RangeMaxChaining
+ * @brief Tag for global sparse chaining with a range maximum query structure over the end positions.
+ *
+ * @tag GlobalChainingTags#GapCostChaining
+ * @brief Tag for global chaining with linear gap costs and a bounded number of predecessor candidates.
  */
 
 struct SparseChaining_;
 typedef Tag<SparseChaining_> SparseChaining;
 
+struct RangeMaxChaining_;
+typedef Tag<RangeMaxChaining_> RangeMaxChaining;
+
+struct GapCostChaining_;
+typedef Tag<GapCostChaining_> GapCostChaining;
+
 // ===========================================================================
 // Metafunctions
 // ===========================================================================
@@ -68,13 +81,28 @@ typedef Tag<SparseChaining_> SparseChaining;
  * @brief Global chaining of seeds.
  *
  * @signature void chainSeedsGlobally(target, seedSet, tag);
+ * @signature void chainSeedsGlobally(target, seedSet, gapCost, maxLookback, GapCostChaining());
  *
- * @param[out] target  A @link ContainerConcept container @endlink to append the seeds to.
- * @param[in]  seedSet The @link SeedSet @endlink object to get the seeds from.
- * @param[in]  tag     The tag to select the algorithm with (currently only @link GlobalChainingTags#SparseChaining
- *                     SparseChaining @endlink is supported).
+ * @param[out] target      A @link ContainerConcept container @endlink to append the seeds to.
+ * @param[in]  seedSet     The @link SeedSet @endlink object to get the seeds from.
+ * @param[in]  tag         The tag to select the algorithm with, @link GlobalChainingTags#SparseChaining
+ *                         SparseChaining @endlink or @link GlobalChainingTags#RangeMaxChaining RangeMaxChaining
+ *                         @endlink.
+ * @param[in]  gapCost     The cost per diagonal between the end of a seed and the begin of its successor.  Chain
+ *                         scores are computed in the signed counterpart of its type.
+ * @param[in]  maxLookback The number of preceding seeds, in order of their begin positions, that are considered as
+ *                         predecessors of a seed.
  *
  * Chaining of seeds between two sequences can be performed using sparse chaining as defined in (Gusfield, 1997).
+ * Both SparseChaining and RangeMaxChaining compute a chain of non-overlapping seeds with maximal sum of seed sizes
+ * in time O(n log n).  RangeMaxChaining sweeps over the seeds and keeps the best chain ending at each end position in
+ * the second sequence in a Fenwick tree.  It is considerably faster on large seed sets but may choose a different chain
+ * of the same quality.
+ *
+ * GapCostChaining scores a chain by the sum of the seed sizes minus <tt>gapCost</tt> times the diagonal distance of
+ * consecutive seeds, similar to the chaining of anchors for long reads.  Only the <tt>maxLookback</tt> seeds
+ * preceding a seed are considered as its predecessor, which gives running time O(n * maxLookback).  The result can
+ * directly be passed to @link bandedChainAlignment @endlink.
  *
  * @section Example
  *
@@ -96,6 +124,78 @@ typedef Tag<SparseChaining_> SparseChaining;
  * </ul>
  */
 
+// ---------------------------------------------------------------------------
+// Helper Function _copySeedsForChaining()
+// ---------------------------------------------------------------------------
+
+// We copy over the seeds from the seed set into an array of seeds.  We can then directly reference seed by their index
+// in this array which is simpler than handling iterators into the seed set.
+
+template <typename TSeed, typename TSeedSetSpec>
+inline void
+_copySeedsForChaining(String<TSeed> & seeds, SeedSet<TSeed, TSeedSetSpec> const & seedSet)
+{
+    typedef typename Iterator<SeedSet<TSeed, TSeedSetSpec> const, Standard>::Type TSeedSetIter;
+
+    clear(seeds);
+    reserve(seeds, length(seedSet), Exact());
+    for (TSeedSetIter it = begin(seedSet, Standard()); it != end(seedSet, Standard()); ++it)
+        appendValue(seeds, *it);
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _writeChain()
+// ---------------------------------------------------------------------------
+
+// Writes the chain ending in seed last to target, following the predecessors.
+
+template <typename TTargetContainer, typename TSeeds, typename TPredecessors>
+inline void
+_writeChain(TTargetContainer & target, TSeeds const & seeds, TPredecessors const & predecessor, unsigned last)
+{
+    clear(target);
+    for (unsigned next = last; next != maxValue<unsigned>(); next = predecessor[next])
+        appendValue(target, seeds[next]);
+    reverse(target);
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _assertChainNonOverlapping()
+// ---------------------------------------------------------------------------
+
+// Assert that the resulting chain is non-overlapping.
+
+template <typename TTargetContainer>
+inline void
+_assertChainNonOverlapping(TTargetContainer const & target)
+{
+    #if SEQAN_ENABLE_DEBUG
+    if (length(target) > 0u) {
+        typedef typename Iterator<TTargetContainer const, Standard>::Type TIterator;
+        // std::cerr << ".-- Chain (" << __FILE__ << ":" << __LINE__ << "):" << std::endl;
+        // for (TIterator it = begin(target, Standard()); it != end(target, Standard()); ++it)
+        //     std::cerr << "| " << *it << std::endl;
+        // std::cerr << "`--" << std::endl;
+        TIterator itPrevious = begin(target, Standard());
+        TIterator it = itPrevious;
+        TIterator itEnd = end(target, Standard());
+        // std::cout << *it << std::endl;
+        ++it;
+        for (; it != itEnd; ++it) {
+            // std::cout << *it << std::endl;
+            SEQAN_ASSERT_LEQ(endPositionH(*itPrevious), beginPositionH(*it));
+            SEQAN_ASSERT_LEQ(endPositionV(*itPrevious), beginPositionV(*it));
+            itPrevious = it;
+        }
+    }
+    #endif  // #if SEQAN_ENABLE_DEBUG
+    ignoreUnusedVariableWarning(target);
+}
+
+// ---------------------------------------------------------------------------
+// Function chainSeedsGlobally()
+// ---------------------------------------------------------------------------
+
 // TODO(holtgrew): Implement scored!
 template <typename TTargetContainer, typename TSeed, typename TSeedSetSpec>
 void
@@ -111,11 +211,8 @@ chainSeedsGlobally(
     // Preparation
     // -----------------------------------------------------------------------
 
-    // We copy over the seeds from the seed set into an array of seeds.  We can then directly reference seed by their
-    // index in this array which is simpler than handling iterators into the std::set<> of the seed set.
     String<TSeed> seeds;
-    resize(seeds, length(seedSet));
-    std::copy(seedSet._seeds.begin(), seedSet._seeds.end(), begin(seeds, Standard()));
+    _copySeedsForChaining(seeds, seedSet);
 
     // -----------------------------------------------------------------------
     // Step 1: Generate the sorted list of interval points.
@@ -128,10 +225,13 @@ chainSeedsGlobally(
     typedef typename Iterator<TIntervalPoints, Standard>::Type TIntervalPointsIterator;
 
     TIntervalPoints intervalPoints;
+    reserve(intervalPoints, 2 * length(seeds), Exact());
     // std::cout << ",--- high quality seeds" << std::endl;
-    // TODO(holtgrew): Using something dense here for qualities and predecessors should be faster but requires seeds to be available by consecutive ids.
-    std::map<unsigned, TSize> qualityOfChainEndingIn;
-    std::map<unsigned, unsigned> predecessor;
+    // The seeds are available by consecutive ids, so qualities and predecessors are stored densely.
+    String<TSize> qualityOfChainEndingIn;
+    resize(qualityOfChainEndingIn, length(seeds), Exact());
+    String<unsigned> predecessor;
+    resize(predecessor, length(seeds), Exact());
     for (unsigned i = 0; i < length(seeds); ++i)
     {
         // Since we use gap space, we have to use "false" for end points so the lexical ordering gives us what the
@@ -254,36 +354,221 @@ chainSeedsGlobally(
     // Step 3: Write out the resulting chain.
     // -----------------------------------------------------------------------
     // TODO(holtgrew): We could use two different algorithms for target containers that are strings and those that are lists.
+    _writeChain(target, seeds, predecessor, intermediateSolutions.rbegin()->i3);
+
+    _assertChainNonOverlapping(target);
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _prefixMaxChainEnd()
+// ---------------------------------------------------------------------------
+
+// Returns the best (quality, seed id) pair stored for the ranks [1, rank] of the 1-based Fenwick tree.  Position 0 of
+// the tree holds the empty chain.
+
+template <typename TChainEnds, typename TSize>
+inline typename Value<TChainEnds>::Type
+_prefixMaxChainEnd(TChainEnds const & tree, TSize rank)
+{
+    typename Value<TChainEnds>::Type best = tree[0];
+    for (; rank > 0u; rank -= rank & (~rank + 1))
+        if (best.i1 < tree[rank].i1)
+            best = tree[rank];
+    return best;
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _updateChainEnd()
+// ---------------------------------------------------------------------------
+
+template <typename TChainEnds, typename TSize, typename TChainEnd>
+inline void
+_updateChainEnd(TChainEnds & tree, TSize rank, TChainEnd const & chainEnd)
+{
+    for (; rank < length(tree); rank += rank & (~rank + 1))
+        if (tree[rank].i1 < chainEnd.i1)
+            tree[rank] = chainEnd;
+}
+
+template <typename TTargetContainer, typename TSeed, typename TSeedSetSpec>
+void
+chainSeedsGlobally(
+        TTargetContainer & target,
+        SeedSet<TSeed, TSeedSetSpec> const & seedSet,
+        RangeMaxChaining const &)
+{
+    typedef typename Position<TSeed>::Type TPosition;
+    typedef typename Size<TSeed>::Type TSize;
+    typedef typename Iterator<String<TPosition>, Standard>::Type TPositionIter;
+
+    String<TSeed> seeds;
+    _copySeedsForChaining(seeds, seedSet);
     clear(target);
-    unsigned next = intermediateSolutions.rbegin()->i3;
-    while (next != maxValue<unsigned>())
+    if (empty(seeds))
+        return;
+
+    // -----------------------------------------------------------------------
+    // Step 1: Generate the sorted list of interval points and the ranks of the end positions in dimension 1.
+    // -----------------------------------------------------------------------
+
+    // As for SparseChaining, end points ("false") come before begin points at the same position so that seeds may
+    // abut each other.
+    typedef Triple<TPosition, bool, unsigned> TIntervalPoint;
+    typedef String<TIntervalPoint> TIntervalPoints;
+    typedef typename Iterator<TIntervalPoints, Standard>::Type TIntervalPointsIterator;
+
+    TIntervalPoints intervalPoints;
+    reserve(intervalPoints, 2 * length(seeds), Exact());
+    String<TPosition> endPositions;
+    reserve(endPositions, length(seeds), Exact());
+    String<TSize> qualityOfChainEndingIn;
+    resize(qualityOfChainEndingIn, length(seeds), Exact());
+    String<unsigned> predecessor;
+    resize(predecessor, length(seeds), maxValue<unsigned>(), Exact());
+    for (unsigned i = 0; i < length(seeds); ++i)
     {
-        appendValue(target, seeds[next]);
-        next = predecessor[next];
+        qualityOfChainEndingIn[i] = seedSize(seeds[i]);
+        appendValue(intervalPoints, TIntervalPoint(beginPositionH(seeds[i]), true, i));
+        appendValue(intervalPoints, TIntervalPoint(endPositionH(seeds[i]), false, i));
+        appendValue(endPositions, endPositionV(seeds[i]));
     }
-    reverse(target);
+    std::sort(begin(intervalPoints, Standard()), end(intervalPoints, Standard()));
+    std::sort(begin(endPositions, Standard()), end(endPositions, Standard()));
+    resize(endPositions, std::unique(begin(endPositions, Standard()), end(endPositions, Standard())) -
+                         begin(endPositions, Standard()));
 
-    // Assert that the resulting chain is non-overlapping.
-    #if SEQAN_ENABLE_DEBUG
-    if (length(target) > 0u) {
-        typedef typename Iterator<TTargetContainer, Standard>::Type TIterator;
-        // std::cerr << ".-- Chain (" << __FILE__ << ":" << __LINE__ << "):" << std::endl;
-        // for (TIterator it = begin(target, Standard()); it != end(target, Standard()); ++it)
-        //     std::cerr << "| " << *it << std::endl;
-        // std::cerr << "`--" << std::endl;
-        TIterator itPrevious = begin(target, Standard());
-        TIterator it = itPrevious;
-        TIterator itEnd = end(target, Standard());
-        // std::cout << *it << std::endl;
-        ++it;
-        for (; it != itEnd; ++it) {
-            // std::cout << *it << std::endl;
-            SEQAN_ASSERT_LEQ(endPositionH(*itPrevious), beginPositionH(*it));
-            SEQAN_ASSERT_LEQ(endPositionV(*itPrevious), beginPositionV(*it));
-            itPrevious = it;
+    // -----------------------------------------------------------------------
+    // Step 2: Sweep over the interval points.
+    // -----------------------------------------------------------------------
+
+    // The Fenwick tree stores the best chain ending at or before each end position in dimension 1 for the seeds whose
+    // end point has already been passed in dimension 0.
+    typedef Pair<TSize, unsigned> TChainEnd;
+    String<TChainEnd> chainEnds;
+    resize(chainEnds, length(endPositions) + 1, TChainEnd(0, maxValue<unsigned>()), Exact());
+
+    TPositionIter itPosBegin = begin(endPositions, Standard());
+    TPositionIter itPosEnd = end(endPositions, Standard());
+    for (TIntervalPointsIterator it = begin(intervalPoints, Standard()), itEnd = end(intervalPoints, Standard());
+         it != itEnd; ++it)
+    {
+        TSeed const & seedK = seeds[it->i3];
+        if (it->i2)  // Is begin point, extend the best chain ending before seed k.
+        {
+            TSize rank = std::upper_bound(itPosBegin, itPosEnd, beginPositionV(seedK)) - itPosBegin;
+            TChainEnd best = _prefixMaxChainEnd(chainEnds, rank);
+            qualityOfChainEndingIn[it->i3] += best.i1;
+            predecessor[it->i3] = best.i2;
+        }
+        else  // Is end point, make the chain ending in seed k available.
+        {
+            TSize rank = std::lower_bound(itPosBegin, itPosEnd, endPositionV(seedK)) - itPosBegin + 1;
+            _updateChainEnd(chainEnds, rank, TChainEnd(qualityOfChainEndingIn[it->i3], it->i3));
         }
     }
-    #endif  // #if SEQAN_ENABLE_DEBUG
+
+    // -----------------------------------------------------------------------
+    // Step 3: Write out the resulting chain.
+    // -----------------------------------------------------------------------
+    _writeChain(target, seeds, predecessor, _prefixMaxChainEnd(chainEnds, length(endPositions)).i2);
+    _assertChainNonOverlapping(target);
+}
+
+template <typename TTargetContainer, typename TSeed, typename TSeedSetSpec, typename TGapCost, typename TSize>
+void
+chainSeedsGlobally(
+        TTargetContainer & target,
+        SeedSet<TSeed, TSeedSetSpec> const & seedSet,
+        TGapCost const & gapCost,
+        TSize const & maxLookback,
+        GapCostChaining const &)
+{
+    typedef typename Position<TSeed>::Type TPosition;
+    typedef typename Diagonal<TSeed>::Type TDiagonal;
+    // Chain scores become negative when gap costs exceed seed sizes, so they are computed in a signed type.
+    typedef typename MakeSigned<TGapCost>::Type TScore;
+
+    String<TSeed> seeds;
+    _copySeedsForChaining(seeds, seedSet);
+    clear(target);
+    if (empty(seeds))
+        return;
+
+    // -----------------------------------------------------------------------
+    // Step 1: Sort the seeds by their begin positions.
+    // -----------------------------------------------------------------------
+    typedef Triple<TPosition, TPosition, unsigned> TBeginPoint;
+    String<TBeginPoint> order;
+    reserve(order, length(seeds), Exact());
+    for (unsigned i = 0; i < length(seeds); ++i)
+        appendValue(order, TBeginPoint(beginPositionH(seeds[i]), beginPositionV(seeds[i]), i));
+    std::sort(begin(order, Standard()), end(order, Standard()));
+
+    // -----------------------------------------------------------------------
+    // Step 2: Compute the best chain ending in each seed.
+    // -----------------------------------------------------------------------
+
+    // The values of the predecessor candidates are kept in separate arrays, indexed by the rank of the seed in the
+    // order, so that the candidates of a seed are scored in one pass over contiguous memory that the compiler can
+    // vectorize.  The best candidate is picked in a second pass.
+    String<TPosition> endsH, endsV;
+    String<TDiagonal> endDiagonals;
+    String<TScore> scores, candidateScores;
+    String<unsigned> predecessor;
+    resize(endsH, length(seeds), Exact());
+    resize(endsV, length(seeds), Exact());
+    resize(endDiagonals, length(seeds), Exact());
+    resize(scores, length(seeds), Exact());
+    resize(predecessor, length(seeds), maxValue<unsigned>(), Exact());
+
+    unsigned bestEnd = 0;
+    for (unsigned i = 0; i < length(order); ++i)
+    {
+        TSeed const & seed = seeds[order[i].i3];
+        TPosition beginH = beginPositionH(seed);
+        TPosition beginV = beginPositionV(seed);
+        TDiagonal diagonal = beginDiagonal(seed);
+        TScore size = static_cast<TScore>(seedSize(seed));
+
+        unsigned first = (i > static_cast<unsigned>(maxLookback)) ? i - static_cast<unsigned>(maxLookback) : 0u;
+        resize(candidateScores, i - first);
+        TPosition const * itEndH = begin(endsH, Standard()) + first;
+        TPosition const * itEndV = begin(endsV, Standard()) + first;
+        TDiagonal const * itDiag = begin(endDiagonals, Standard()) + first;
+        TScore const * itScore = begin(scores, Standard()) + first;
+        TScore * itCandidate = begin(candidateScores, Standard());
+        for (unsigned k = 0; k < i - first; ++k)
+        {
+            TDiagonal distance = itDiag[k] - diagonal;
+            distance = (distance < 0) ? -distance : distance;
+            TScore candidate = itScore[k] - static_cast<TScore>(gapCost) * static_cast<TScore>(distance);
+            itCandidate[k] = (itEndH[k] <= beginH && itEndV[k] <= beginV) ? candidate : static_cast<TScore>(0);
+        }
+
+        // Starting a new chain at the seed scores 0, only better predecessors are used.
+        TScore best = 0;
+        for (unsigned k = 0; k < i - first; ++k)
+            if (itCandidate[k] > best)
+            {
+                best = itCandidate[k];
+                predecessor[i] = first + k;
+            }
+
+        endsH[i] = endPositionH(seed);
+        endsV[i] = endPositionV(seed);
+        endDiagonals[i] = endDiagonal(seed);
+        scores[i] = size + best;
+        if (scores[i] > scores[bestEnd])
+            bestEnd = i;
+    }
+
+    // -----------------------------------------------------------------------
+    // Step 3: Write out the resulting chain.
+    // -----------------------------------------------------------------------
+    for (unsigned next = bestEnd; next != maxValue<unsigned>(); next = predecessor[next])
+        appendValue(target, seeds[order[next].i3]);
+    reverse(target);
+    _assertChainNonOverlapping(target);
 }
 
 }  // namespace seqan
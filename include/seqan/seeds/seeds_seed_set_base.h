@@ -44,11 +44,12 @@ namespace seqan {
 // Forwards
 // ===========================================================================
 
-// TODO(holtgrew): Add DiagonalSorted as default specialization.
-
 struct Unordered_;
 typedef Tag<Unordered_> Unordered;
 
+struct DiagonalSorted_;
+typedef Tag<DiagonalSorted_> DiagonalSorted;
+
 // ===========================================================================
 // Enums, Tags, Classes, Specializations
 // ===========================================================================
@@ -62,7 +63,7 @@ typedef Tag<Unordered_> Unordered;
  * @headerfile <seqan/seeds.h>
  * @implements ContainerConcept
  * @brief Handles a set of seeds with local chaining on adding seeds.
- * @note At the moment only <tt>Unordered SeedSets</tt> are supported.
+ * @note At the moment <tt>Unordered</tt> and <tt>DiagonalSorted</tt> SeedSets are supported.
  *
  * @signature template <typename TSeed[, typename TSpec]>
  *            class SeedSet;
@@ -0,0 +1,726 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// The DiagonalSorted specialization of the class SeedSet.  Seeds are
+// stored in a flat string sorted by their begin diagonal.
+// ==========================================================================
+
+#ifndef SEQAN_SEEDS_SEEDS_SEED_SET_DIAGONAL_SORTED_H_
+#define SEQAN_SEEDS_SEEDS_SEED_SET_DIAGONAL_SORTED_H_
+
+namespace seqan {
+
+// ===========================================================================
+// Enums, Tags, Classes, Specializations
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+// Class DiagonalSorted SeedSet
+// ---------------------------------------------------------------------------
+
+/*!
+ * @class DiagonalSortedSeedSet
+ * @extends SeedSet
+ * @headerfile <seqan/seeds.h>
+ * @brief SeedSet that keeps its seeds in a flat string sorted by begin diagonal.
+ *
+ * @signature template <typename TSeed>
+ *            class SeedSet<TSeed, DiagonalSorted>;
+ *
+ * @tparam TSeed Type of the @link Seed @endlink objects stored in the seed set.
+ *
+ * The seeds are iterated and combined in the same order as in the <tt>Unordered</tt> SeedSet, i.e. sorted by begin
+ * diagonal and in insertion order for equal begin diagonals.  Instead of scanning all seeds, only the seeds on the
+ * diagonals within the combination distance are considered when adding a seed.  Many seeds are best added at once
+ * using @link DiagonalSortedSeedSet#addSeeds @endlink.
+ */
+
+template <typename TSeed>
+class SeedSet<TSeed, DiagonalSorted>
+{
+public:
+    typedef typename SeedScore<TSeed>::Type TScoreValue_;
+    typedef typename Size<TSeed>::Type TSize_;
+    typedef typename Diagonal<TSeed>::Type TDiagonal_;
+    typedef String<TSeed> TSeeds_;
+
+    TSeeds_ _seeds;
+
+    // Upper bound for the difference of begin and end diagonal of the contained seeds.
+    TDiagonal_ _maxDiagonalSpread;
+
+    TScoreValue_ _minScore;
+    TSize_ _minSeedSize;
+
+    SeedSet() : _maxDiagonalSpread(0), _minScore(0), _minSeedSize(0)
+    {}
+};
+
+// ===========================================================================
+// Metafunctions
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+// Metafunction Position
+// ---------------------------------------------------------------------------
+
+template <typename TSeed>
+struct Position<SeedSet<TSeed, DiagonalSorted> >
+{
+    typedef typename Position<String<TSeed> >::Type Type;
+};
+
+template <typename TSeed>
+struct Position<SeedSet<TSeed, DiagonalSorted> const> : Position<SeedSet<TSeed, DiagonalSorted> >
+{};
+
+// ---------------------------------------------------------------------------
+// Metafunction Size
+// ---------------------------------------------------------------------------
+
+template <typename TSeed>
+struct Size<SeedSet<TSeed, DiagonalSorted> >
+{
+    typedef typename Size<String<TSeed> >::Type Type;
+};
+
+template <typename TSeed>
+struct Size<SeedSet<TSeed, DiagonalSorted> const> : Size<SeedSet<TSeed, DiagonalSorted> >
+{};
+
+// ---------------------------------------------------------------------------
+// Metafunction Value
+// ---------------------------------------------------------------------------
+
+template <typename TSeed>
+struct Value<SeedSet<TSeed, DiagonalSorted> >
+{
+    typedef TSeed Type;
+};
+
+template <typename TSeed>
+struct Value<SeedSet<TSeed, DiagonalSorted> const>
+{
+    typedef TSeed const Type;
+};
+
+// ---------------------------------------------------------------------------
+// Metafunction Reference
+// ---------------------------------------------------------------------------
+
+// Seeds can't be modified in place since this could break the order.
+
+template <typename TSeed>
+struct Reference<SeedSet<TSeed, DiagonalSorted> >
+{
+    typedef TSeed const & Type;
+};
+
+template <typename TSeed>
+struct Reference<SeedSet<TSeed, DiagonalSorted> const> : Reference<SeedSet<TSeed, DiagonalSorted> >
+{};
+
+// ---------------------------------------------------------------------------
+// Metafunction Iterator
+// ---------------------------------------------------------------------------
+
+template <typename TSeed>
+struct Iterator<SeedSet<TSeed, DiagonalSorted>, Standard>
+{
+    typedef typename Iterator<String<TSeed> const, Standard>::Type Type;
+};
+
+template <typename TSeed>
+struct Iterator<SeedSet<TSeed, DiagonalSorted> const, Standard> : Iterator<SeedSet<TSeed, DiagonalSorted>, Standard>
+{};
+
+// ===========================================================================
+// Functions
+// ===========================================================================
+
+// ---------------------------------------------------------------------------
+// Function length()
+// ---------------------------------------------------------------------------
+
+// Standard Container Functions
+
+template <typename TSeed>
+inline typename Size<SeedSet<TSeed, DiagonalSorted> >::Type
+length(SeedSet<TSeed, DiagonalSorted> const & seedSet)
+{
+    return length(seedSet._seeds);
+}
+
+// ---------------------------------------------------------------------------
+// Function begin()
+// ---------------------------------------------------------------------------
+
+template <typename TSeed>
+inline typename Iterator<SeedSet<TSeed, DiagonalSorted>, Standard>::Type
+begin(SeedSet<TSeed, DiagonalSorted> & seedSet, Standard const &)
+{
+    return begin(static_cast<String<TSeed> const &>(seedSet._seeds), Standard());
+}
+
+template <typename TSeed>
+inline typename Iterator<SeedSet<TSeed, DiagonalSorted> const, Standard>::Type
+begin(SeedSet<TSeed, DiagonalSorted> const & seedSet, Standard const &)
+{
+    return begin(seedSet._seeds, Standard());
+}
+
+// ---------------------------------------------------------------------------
+// Function end()
+// ---------------------------------------------------------------------------
+
+template <typename TSeed>
+inline typename Iterator<SeedSet<TSeed, DiagonalSorted>, Standard>::Type
+end(SeedSet<TSeed, DiagonalSorted> & seedSet, Standard const &)
+{
+    return end(static_cast<String<TSeed> const &>(seedSet._seeds), Standard());
+}
+
+template <typename TSeed>
+inline typename Iterator<SeedSet<TSeed, DiagonalSorted> const, Standard>::Type
+end(SeedSet<TSeed, DiagonalSorted> const & seedSet, Standard const &)
+{
+    return end(seedSet._seeds, Standard());
+}
+
+// ---------------------------------------------------------------------------
+// Function front()
+// ---------------------------------------------------------------------------
+
+template <typename TSeed>
+inline TSeed const &
+front(SeedSet<TSeed, DiagonalSorted> & seedSet)
+{
+    return front(static_cast<String<TSeed> const &>(seedSet._seeds));
+}
+
+template <typename TSeed>
+inline TSeed const &
+front(SeedSet<TSeed, DiagonalSorted> const & seedSet)
+{
+    return front(seedSet._seeds);
+}
+
+// ---------------------------------------------------------------------------
+// Function back()
+// ---------------------------------------------------------------------------
+
+template <typename TSeed>
+inline TSeed const &
+back(SeedSet<TSeed, DiagonalSorted> & seedSet)
+{
+    return back(static_cast<String<TSeed> const &>(seedSet._seeds));
+}
+
+template <typename TSeed>
+inline TSeed const &
+back(SeedSet<TSeed, DiagonalSorted> const & seedSet)
+{
+    return back(seedSet._seeds);
+}
+
+// ---------------------------------------------------------------------------
+// Function clear()
+// ---------------------------------------------------------------------------
+
+template <typename TSeed>
+inline void clear(SeedSet<TSeed, DiagonalSorted> & seedSet)
+{
+    clear(seedSet._seeds);
+    seedSet._maxDiagonalSpread = 0;
+    seedSet._minScore = 0;
+    seedSet._minSeedSize = 0;
+}
+
+// SeedSet Functions
+
+// ---------------------------------------------------------------------------
+// Helper Function _upperBoundBeginDiagonal()
+// ---------------------------------------------------------------------------
+
+// Returns the position of the first seed in the sorted string seeds whose begin diagonal is greater than diagonal.
+
+template <typename TSeed, typename TSpec, typename TDiagonal>
+inline typename Size<String<TSeed, TSpec> >::Type
+_upperBoundBeginDiagonal(String<TSeed, TSpec> const & seeds, TDiagonal diagonal)
+{
+    typedef typename Size<String<TSeed, TSpec> >::Type TSize;
+
+    TSize lo = 0;
+    TSize hi = length(seeds);
+    while (lo < hi)
+    {
+        TSize mid = lo + (hi - lo) / 2;
+        if (diagonal < beginDiagonal(seeds[mid]))
+            hi = mid;
+        else
+            lo = mid + 1;
+    }
+    return lo;
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _updateDiagonalSpread()
+// ---------------------------------------------------------------------------
+
+template <typename TSeed>
+inline void
+_updateDiagonalSpread(SeedSet<TSeed, DiagonalSorted> & seedSet, TSeed const & seed)
+{
+    typename Diagonal<TSeed>::Type spread = _abs(endDiagonal(seed) - beginDiagonal(seed));
+    if (spread > seedSet._maxDiagonalSpread)
+        seedSet._maxDiagonalSpread = spread;
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _combinationWindow()
+// ---------------------------------------------------------------------------
+
+// Computes the range of begin diagonals of the seeds that can be combined with seed.  All combination methods require
+// the end diagonal of the left seed to be within maxDistance of the begin diagonal of the right seed, and the begin
+// and end diagonal of a seed in the set differ by at most the spread.
+
+template <typename TSeed, typename TDistanceThreshold>
+inline void
+_combinationWindow(typename Diagonal<TSeed>::Type & lo,
+                   typename Diagonal<TSeed>::Type & hi,
+                   SeedSet<TSeed, DiagonalSorted> const & seedSet,
+                   TSeed const & seed,
+                   TDistanceThreshold const & maxDistance)
+{
+    typedef typename Diagonal<TSeed>::Type TDiagonal;
+
+    // Merge() compares against the unsigned threshold, a negative one allows all distances.
+    if (static_cast<__int64>(maxDistance) < 0)
+    {
+        lo = MinValue<TDiagonal>::VALUE;
+        hi = MaxValue<TDiagonal>::VALUE;
+        return;
+    }
+    TDiagonal margin = static_cast<TDiagonal>(maxDistance) + seedSet._maxDiagonalSpread;
+    lo = _min(beginDiagonal(seed), endDiagonal(seed)) - margin;
+    hi = _max(beginDiagonal(seed), endDiagonal(seed)) + margin;
+}
+
+// ---------------------------------------------------------------------------
+// Function _findSeedForCombination()
+// ---------------------------------------------------------------------------
+
+template <typename TPosition, typename TSeed, typename TDistanceThreshold, typename TBandwidth, typename TCombination>
+bool
+_findSeedForCombination(
+        TPosition & mergePartner,
+        bool & seedIsOnTheLeft,
+        SeedSet<TSeed, DiagonalSorted> const & seedSet,
+        TSeed const & seed,
+        TDistanceThreshold const & maxDistance,
+        TBandwidth const & bandwidth,
+        TCombination const & tag)
+{
+    typedef typename Diagonal<TSeed>::Type TDiagonal;
+    typedef typename Size<String<TSeed> >::Type TSize;
+
+    // Search the seeds in the window for the first one that is combineable in the order of the seed set, exactly
+    // like the scan over all seeds of the Unordered SeedSet does.
+    TDiagonal lo, hi;
+    _combinationWindow(lo, hi, seedSet, seed, maxDistance);
+    TSize endPos = length(seedSet._seeds);
+    if (lo != MinValue<TDiagonal>::VALUE)
+        endPos = _upperBoundBeginDiagonal(seedSet._seeds, hi);
+    TSize pos = 0;
+    if (lo != MinValue<TDiagonal>::VALUE)
+        pos = _upperBoundBeginDiagonal(seedSet._seeds, lo - 1);
+
+    for (; pos < endPos; ++pos)
+    {
+        TSeed const & other = seedSet._seeds[pos];
+        if (_seedsCombineable(other, seed, maxDistance, bandwidth, tag))
+        {
+            // seed is to be merged into other.
+            mergePartner = pos;
+            seedIsOnTheLeft = false;
+            return true;
+        }
+        else if (_seedsCombineable(seed, other, maxDistance, bandwidth, tag))
+        {
+            // other is to be merged into seed.
+            mergePartner = pos;
+            seedIsOnTheLeft = true;
+            return true;
+        }
+    }
+
+    // Found no seed to combine with.
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _insertSeed()
+// ---------------------------------------------------------------------------
+
+// Inserts seed behind all seeds with the same or a smaller begin diagonal.
+
+template <typename TSeed>
+inline void
+_insertSeed(SeedSet<TSeed, DiagonalSorted> & seedSet, TSeed const & seed)
+{
+    _updateDiagonalSpread(seedSet, seed);
+    insertValue(seedSet._seeds, _upperBoundBeginDiagonal(seedSet._seeds, beginDiagonal(seed)), seed);
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _combineSeedInSet()
+// ---------------------------------------------------------------------------
+
+// Combines seed with a seed in the set, returns false if there is none to combine with.
+
+template <typename TSeed, typename TDistanceThreshold, typename TBandwidth, typename TScoreValue, typename TSequence0, typename TSequence1, typename TCombination>
+inline bool
+_combineSeedInSet(SeedSet<TSeed, DiagonalSorted> & seedSet,
+                  TSeed const & seed,
+                  TDistanceThreshold const & maxDiagDist,
+                  TBandwidth const & bandwidth,
+                  Score<TScoreValue, Simple> const & scoringScheme,
+                  TSequence0 const & sequence0,
+                  TSequence1 const & sequence1,
+                  TCombination const & tag)
+{
+    typedef typename Position<SeedSet<TSeed, DiagonalSorted> >::Type TPosition;
+
+    // Try to find a seed for recombination.
+    TPosition pos = 0;
+    bool seedIsOnTheLeft = false;
+    if (!_findSeedForCombination(pos, seedIsOnTheLeft, seedSet, seed, maxDiagDist, bandwidth, tag))
+        return false;
+
+    // Combine them and move the result to its new place.
+    TSeed left;
+    if (!seedIsOnTheLeft)
+    {
+        left = seedSet._seeds[pos];
+        _combineSeeds(left, seed, scoringScheme, sequence0, sequence1, tag);
+    }
+    else
+    {
+        left = seed;
+        _combineSeeds(left, seedSet._seeds[pos], scoringScheme, sequence0, sequence1, tag);
+    }
+
+    erase(seedSet._seeds, pos);
+    _insertSeed(seedSet, left);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Function addSeed()
+// ---------------------------------------------------------------------------
+
+template <typename TSeed, typename TDistanceThreshold, typename TBandwidth, typename TScoreValue, typename TSequence0, typename TSequence1, typename TCombination>
+inline bool
+addSeed(SeedSet<TSeed, DiagonalSorted> & seedSet,
+        TSeed const & seed,
+        TDistanceThreshold const & maxDiagDist,
+        TBandwidth const & bandwidth,
+        Score<TScoreValue, Simple> const & scoringScheme,
+        TSequence0 const & sequence0,
+        TSequence1 const & sequence1,
+        TCombination const & tag)
+{
+    return _combineSeedInSet(seedSet, seed, maxDiagDist, bandwidth, scoringScheme, sequence0, sequence1, tag);
+}
+
+template <typename TSeed, typename TDistanceThreshold>
+inline bool
+addSeed(SeedSet<TSeed, DiagonalSorted> & seedSet,
+        TSeed const & seed,
+        TDistanceThreshold const & maxDiagDist,
+        Merge const &)
+{
+    return addSeed(seedSet, seed, maxDiagDist, 0, Score<int, Simple>(), Nothing(), Nothing(), Merge());
+}
+
+template <typename TSeed, typename TDistanceThreshold, typename TScoreValue>
+inline bool
+addSeed(SeedSet<TSeed, DiagonalSorted> & seedSet,
+        TSeed const & seed,
+        TDistanceThreshold const & maxDiagDist,
+        Score<TScoreValue, Simple> const & scoringScheme,
+        SimpleChain const &)
+{
+    return addSeed(seedSet, seed, maxDiagDist, 0, scoringScheme, Nothing(), Nothing(), SimpleChain());
+}
+
+template <typename TSeed>
+inline bool
+addSeed(SeedSet<TSeed, DiagonalSorted> & seedSet,
+        TSeed const & seed,
+        Single const &)
+{
+    _insertSeed(seedSet, seed);
+    return true;    // Always returns true.
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _radixSortPermutation()
+// ---------------------------------------------------------------------------
+
+// Stable LSD radix sort of the positions in perm by their keys, one byte per pass.
+
+template <typename TPermutation, typename TKeys>
+inline void
+_radixSortPermutation(TPermutation & perm, TKeys const & keys)
+{
+    typedef typename Value<TPermutation>::Type TPos;
+    typedef typename Size<TPermutation>::Type TSize;
+
+    __uint64 maxKey = 0;
+    for (TSize i = 0; i < length(keys); ++i)
+        maxKey = _max(maxKey, static_cast<__uint64>(keys[i]));
+
+    TPermutation buffer;
+    resize(buffer, length(perm), Exact());
+    String<TSize> counts;
+    for (unsigned shift = 0; shift < 64u && (maxKey >> shift) != 0u; shift += 8)
+    {
+        clear(counts);
+        resize(counts, 256, 0);
+        for (TSize i = 0; i < length(perm); ++i)
+            ++counts[(keys[perm[i]] >> shift) & 255u];
+
+        TSize sum = 0;
+        for (unsigned c = 0; c < 256u; ++c)
+        {
+            TSize t = counts[c];
+            counts[c] = sum;
+            sum += t;
+        }
+
+        for (TSize i = 0; i < length(perm); ++i)
+        {
+            TPos p = perm[i];
+            buffer[counts[(keys[p] >> shift) & 255u]++] = p;
+        }
+        swap(perm, buffer);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _sortSeedsByDiagonal()
+// ---------------------------------------------------------------------------
+
+// Computes the order of seeds by (begin diagonal, begin position in the first sequence).
+
+template <typename TPermutation, typename TSeeds>
+inline void
+_sortSeedsByDiagonal(TPermutation & perm, TSeeds const & seeds)
+{
+    typedef typename Value<TSeeds>::Type TSeed;
+    typedef typename Diagonal<TSeed>::Type TDiagonal;
+    typedef typename Size<TSeeds>::Type TSize;
+
+    resize(perm, length(seeds), Exact());
+    if (empty(seeds))
+        return;
+
+    TDiagonal minDiagonal = beginDiagonal(seeds[0]);
+    for (TSize i = 0; i < length(seeds); ++i)
+    {
+        perm[i] = i;
+        minDiagonal = _min(minDiagonal, beginDiagonal(seeds[i]));
+    }
+
+    String<__uint64> keys;
+    resize(keys, length(seeds), Exact());
+    for (TSize i = 0; i < length(seeds); ++i)
+        keys[i] = beginPositionH(seeds[i]);
+    _radixSortPermutation(perm, keys);
+    for (TSize i = 0; i < length(seeds); ++i)
+        keys[i] = static_cast<__uint64>(beginDiagonal(seeds[i]) - minDiagonal);
+    _radixSortPermutation(perm, keys);
+}
+
+// ---------------------------------------------------------------------------
+// Helper Function _moveSeedsUpTo()
+// ---------------------------------------------------------------------------
+
+// Appends the seeds from pending[pos..] with a begin diagonal not greater than diagonal to the seed set.
+
+template <typename TSeed, typename TSize, typename TDiagonal>
+inline void
+_moveSeedsUpTo(SeedSet<TSeed, DiagonalSorted> & seedSet, String<TSeed> const & pending, TSize & pos,
+               TDiagonal diagonal)
+{
+    TSize first = pos;
+    while (pos < length(pending) && !(diagonal < beginDiagonal(pending[pos])))
+        ++pos;
+    append(seedSet._seeds, infix(pending, first, pos));
+}
+
+// ---------------------------------------------------------------------------
+// Function addSeeds()
+// ---------------------------------------------------------------------------
+
+/*!
+ * @fn DiagonalSortedSeedSet#addSeeds
+ * @headerfile <seqan/seeds.h>
+ * @brief Adds a batch of seeds, combining them with the seeds in the set where possible.
+ *
+ * @signature void addSeeds(seedSet, seeds, distance, bandwidth, score, seqH, seqV, tag);
+ * @signature void addSeeds(seedSet, seeds, distance, score, SimpleChain);
+ * @signature void addSeeds(seedSet, seeds, distance, Merge);
+ * @signature void addSeeds(seedSet, seeds, Single);
+ *
+ * @param[in,out] seedSet The SeedSet to add the seeds to.
+ * @param[in]     seeds   The seeds to add, a @link ContainerConcept @endlink of @link Seed @endlink objects.
+ *
+ * The remaining parameters are the same as for @link SeedSet#addSeed @endlink.
+ *
+ * The seeds are sorted by begin diagonal and begin position in the first sequence with a radix sort and then added
+ * in this order.  Each seed is combined with a seed of the set as @link SeedSet#addSeed @endlink does.  Seeds that
+ * can't be combined are added as with <tt>Single</tt>.  The result is the same as adding the sorted seeds one by one
+ * but the set is rebuilt only once.
+ */
+
+template <typename TSeed, typename TSeeds, typename TDistanceThreshold, typename TBandwidth, typename TScoreValue, typename TSequence0, typename TSequence1, typename TCombination>
+inline void
+addSeeds(SeedSet<TSeed, DiagonalSorted> & seedSet,
+         TSeeds const & seeds,
+         TDistanceThreshold const & maxDiagDist,
+         TBandwidth const & bandwidth,
+         Score<TScoreValue, Simple> const & scoringScheme,
+         TSequence0 const & sequence0,
+         TSequence1 const & sequence1,
+         TCombination const & tag)
+{
+    typedef typename Size<TSeeds>::Type TSize;
+    typedef typename Diagonal<TSeed>::Type TDiagonal;
+    typedef typename Position<SeedSet<TSeed, DiagonalSorted> >::Type TPosition;
+
+    String<TSize> order;
+    _sortSeedsByDiagonal(order, seeds);
+
+    // The seeds of the set are moved over while sweeping along the diagonals of the new seeds, so that insertions and
+    // removals only shift the seeds on the diagonals that are currently combined.
+    String<TSeed> pending;
+    swap(pending, seedSet._seeds);
+    reserve(seedSet._seeds, length(pending) + length(seeds), Exact());
+    TSize pendingPos = 0;
+
+    for (TSize i = 0; i < length(order); ++i)
+    {
+        TSeed const & seed = seeds[order[i]];
+
+        TDiagonal lo, hi;
+        _updateDiagonalSpread(seedSet, seed);
+        _combinationWindow(lo, hi, seedSet, seed, maxDiagDist);
+        _moveSeedsUpTo(seedSet, pending, pendingPos, hi);
+
+        TPosition pos = 0;
+        bool seedIsOnTheLeft = false;
+        if (!_findSeedForCombination(pos, seedIsOnTheLeft, seedSet, seed, maxDiagDist, bandwidth, tag))
+        {
+            _moveSeedsUpTo(seedSet, pending, pendingPos, beginDiagonal(seed));
+            _insertSeed(seedSet, seed);
+            continue;
+        }
+
+        TSeed left;
+        if (!seedIsOnTheLeft)
+        {
+            left = seedSet._seeds[pos];
+            _combineSeeds(left, seed, scoringScheme, sequence0, sequence1, tag);
+        }
+        else
+        {
+            left = seed;
+            _combineSeeds(left, seedSet._seeds[pos], scoringScheme, sequence0, sequence1, tag);
+        }
+        erase(seedSet._seeds, pos);
+        _moveSeedsUpTo(seedSet, pending, pendingPos, beginDiagonal(left));
+        _insertSeed(seedSet, left);
+    }
+    append(seedSet._seeds, suffix(pending, pendingPos));
+}
+
+template <typename TSeed, typename TSeeds, typename TDistanceThreshold>
+inline void
+addSeeds(SeedSet<TSeed, DiagonalSorted> & seedSet,
+         TSeeds const & seeds,
+         TDistanceThreshold const & maxDiagDist,
+         Merge const &)
+{
+    addSeeds(seedSet, seeds, maxDiagDist, 0, Score<int, Simple>(), Nothing(), Nothing(), Merge());
+}
+
+template <typename TSeed, typename TSeeds, typename TDistanceThreshold, typename TScoreValue>
+inline void
+addSeeds(SeedSet<TSeed, DiagonalSorted> & seedSet,
+         TSeeds const & seeds,
+         TDistanceThreshold const & maxDiagDist,
+         Score<TScoreValue, Simple> const & scoringScheme,
+         SimpleChain const &)
+{
+    addSeeds(seedSet, seeds, maxDiagDist, 0, scoringScheme, Nothing(), Nothing(), SimpleChain());
+}
+
+template <typename TSeed, typename TSeeds>
+inline void
+addSeeds(SeedSet<TSeed, DiagonalSorted> & seedSet,
+         TSeeds const & seeds,
+         Single const &)
+{
+    typedef typename Size<TSeeds>::Type TSize;
+
+    String<TSize> order;
+    _sortSeedsByDiagonal(order, seeds);
+
+    // Merge the sorted seeds with the ones of the set, new seeds go behind the old ones on the same diagonal.
+    String<TSeed> pending;
+    swap(pending, seedSet._seeds);
+    reserve(seedSet._seeds, length(pending) + length(seeds), Exact());
+    TSize pendingPos = 0;
+    for (TSize i = 0; i < length(order); ++i)
+    {
+        TSeed const & seed = seeds[order[i]];
+        _moveSeedsUpTo(seedSet, pending, pendingPos, beginDiagonal(seed));
+        _updateDiagonalSpread(seedSet, seed);
+        appendValue(seedSet._seeds, seed);
+    }
+    append(seedSet._seeds, suffix(pending, pendingPos));
+}
+
+}  // namespace seqan
+
+#endif  // SEQAN_SEEDS_SEEDS_SEED_SET_DIAGONAL_SORTED_H_
@@ -90,6 +90,62 @@ clear(FaiIndexEntry_ &entry)
     entry.overallLineLength = 0;
 }
 
+// ----------------------------------------------------------------------------
+// Class FaiBgzfCache_
+// ----------------------------------------------------------------------------
+
+// LRU cache of decompressed blocks of a BGZF compressed FASTA file.
+
+struct FaiBgzfCacheEntry_
+{
+    // Number of the cached block in the GZI index.
+    __uint64 blockId;
+    // Value of the use counter at the last access.
+    __uint64 lastUse;
+    // The decompressed block.
+    CharString data;
+
+    FaiBgzfCacheEntry_() :
+        blockId(0), lastUse(0)
+    {}
+};
+
+class FaiBgzfCache_
+{
+public:
+    // Maximal number of cached blocks.
+    unsigned capacity;
+    // Incremented on each access.
+    __uint64 useCount;
+    String<FaiBgzfCacheEntry_> entries;
+    // Guards the cache, as it is modified by the const readRegion() functions.
+    ReadWriteLock lock;
+
+    FaiBgzfCache_() :
+        capacity(64), useCount(0)
+    {}
+
+    // The cache contents and the lock are not copied.
+    FaiBgzfCache_(FaiBgzfCache_ const & other) :
+        capacity(other.capacity), useCount(0)
+    {}
+
+    FaiBgzfCache_ & operator=(FaiBgzfCache_ const & other)
+    {
+        capacity = other.capacity;
+        useCount = 0;
+        clear(entries);
+        return *this;
+    }
+};
+
+inline void
+clear(FaiBgzfCache_ & cache)
+{
+    cache.useCount = 0;
+    clear(cache.entries);
+}
+
 // ----------------------------------------------------------------------------
 // Class FaiIndex
 // ----------------------------------------------------------------------------
@@ -104,6 +160,11 @@ clear(FaiIndexEntry_ &entry)
  * FAI indices allow the rast random access to sequences or parts of sequences in a FASTA file.  Originally, they were
  * introduced in the <a href="http://samtools.sourceforge.net/samtools.shtml">samtools</a> program.
  *
+ * The FASTA file can also be compressed with <tt>bgzip</tt>.  The positions of the compressed blocks are then taken
+ * from the GZI file <tt>"${fastaFileName}.gzi"</tt> or, if it does not exist, by scanning the block headers.
+ * Decompressed blocks are kept in an LRU cache of <tt>faiIndex.blockCache.capacity</tt> blocks (default: 64), such
+ * that reading many small nearby regions decompresses each block only once.
+ *
  * Also see the <a href="http://seqan.readthedocs.org/en/develop/Tutorial/IndexedFastaIO.html">Indexed FASTA I/O
  * Tutorial</a>.
  *
@@ -141,6 +202,11 @@ public:
     // We use this memory mapped string (opened read-only) to read from the file.
     String<char, MMap<> > mmapString;
 
+    // For BGZF compressed FASTA files the (compressed, uncompressed) begin offsets of all blocks, empty otherwise.
+    String<Pair<__uint64, __uint64> > gziIndex;
+    // Recently decompressed blocks of compressed FASTA files.
+    mutable FaiBgzfCache_ blockCache;
+
     FaiIndex() :
         seqNameStoreCache(seqNameStore)
     {}
@@ -174,6 +240,8 @@ inline void clear(FaiIndex & index)
     clear(index.indexEntryStore);
     clear(index.seqNameStore);
     clear(index.seqNameStoreCache);
+    clear(index.gziIndex);
+    clear(index.blockCache);
 }
 
 // ----------------------------------------------------------------------------
@@ -274,6 +342,163 @@ inline __uint64 numSeqs(FaiIndex const & index)
 // Function readRegion()
 // ----------------------------------------------------------------------------
 
+// Copy the bytes [ofs, ofs + len) of the uncompressed FASTA file to target.
+
+template <typename TTargetIter>
+inline TTargetIter
+_faiCopyBytes(TTargetIter target, FaiIndex const & index, __uint64 ofs, __uint64 len)
+{
+    typedef Iterator<String<char, MMap<> > const, Standard>::Type TSourceIter;
+
+    if (ofs + len > length(index.mmapString))
+        SEQAN_THROW(UnexpectedEnd());
+
+    TSourceIter source = begin(index.mmapString, Standard()) + ofs;
+    return std::copy(source, source + len, target);
+}
+
+#if SEQAN_HAS_ZLIB
+
+// Return the number of the block that contains the uncompressed offset ofs.
+
+inline __uint64
+_faiFindBlock(FaiIndex const & index, __uint64 ofs)
+{
+    __uint64 lo = 0, hi = length(index.gziIndex);
+    while (hi - lo > 1)
+    {
+        __uint64 mid = lo + (hi - lo) / 2;
+        if (index.gziIndex[mid].i2 <= ofs)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+// Return the decompressed block from the cache, decompress it on a cache miss.  The cache must be locked.
+
+inline CharString const &
+_faiGetBlock(FaiIndex const & index, __uint64 blockId)
+{
+    FaiBgzfCache_ & cache = index.blockCache;
+    ++cache.useCount;
+
+    // Cache hit?
+    unsigned victim = 0;
+    for (unsigned i = 0; i < length(cache.entries); ++i)
+    {
+        if (cache.entries[i].blockId == blockId)
+        {
+            cache.entries[i].lastUse = cache.useCount;
+            return cache.entries[i].data;
+        }
+        if (cache.entries[i].lastUse < cache.entries[victim].lastUse)
+            victim = i;
+    }
+
+    // Otherwise, replace the least recently used block.
+    if (length(cache.entries) < std::max(cache.capacity, 1u))
+    {
+        victim = length(cache.entries);
+        resize(cache.entries, victim + 1);
+    }
+    // Invalidate the entry until the block has been decompressed successfully.
+    FaiBgzfCacheEntry_ & entry = cache.entries[victim];
+    entry.blockId = MaxValue<__uint64>::VALUE;
+    entry.lastUse = 0;
+
+    __uint64 compressedOfs = index.gziIndex[blockId].i1;
+    if (compressedOfs + DefaultPageSize<BgzfFile>::BLOCK_HEADER_LENGTH > length(index.mmapString))
+        SEQAN_THROW(UnexpectedEnd());
+    char const * block = &index.mmapString[0] + compressedOfs;
+    unsigned compressedLen = _bgzfUnpack16(block + 16) + 1u;
+    if (compressedOfs + compressedLen > length(index.mmapString))
+        SEQAN_THROW(UnexpectedEnd());
+
+    CompressionContext<BgzfFile> ctx;
+    resize(entry.data, DefaultPageSize<BgzfFile>::MAX_BLOCK_SIZE, Exact());
+    resize(entry.data, _decompressBlock(&entry.data[0], DefaultPageSize<BgzfFile>::MAX_BLOCK_SIZE, block, compressedLen, ctx));
+    entry.blockId = blockId;
+    entry.lastUse = cache.useCount;
+    return entry.data;
+}
+
+template <typename TTargetIter>
+inline TTargetIter
+_faiCopyBgzfBytes(TTargetIter target, FaiIndex const & index, __uint64 ofs, __uint64 len)
+{
+    __uint64 blockId = _faiFindBlock(index, ofs);
+    while (len != 0)
+    {
+        if (blockId >= length(index.gziIndex))
+            SEQAN_THROW(UnexpectedEnd());
+
+        CharString const & block = _faiGetBlock(index, blockId);
+        __uint64 blockOfs = ofs - index.gziIndex[blockId].i2;
+        if (blockOfs < length(block))
+        {
+            __uint64 n = std::min(len, (__uint64)length(block) - blockOfs);
+            target = std::copy(begin(block, Standard()) + blockOfs, begin(block, Standard()) + (blockOfs + n), target);
+            ofs += n;
+            len -= n;
+        }
+        ++blockId;
+    }
+    return target;
+}
+
+#endif  // #if SEQAN_HAS_ZLIB
+
+// Copy len sequence characters beginning at position beginPos of the sequence described by entry to target.
+//
+// The characters are stored in lines of entry.lineLength characters, each followed by a line break.  Instead of
+// testing each character for being a line break, whole lines are copied at once.
+
+template <typename TTargetIter, typename TCompression>
+inline TTargetIter
+_faiReadLines(TTargetIter target, FaiIndex const & index, FaiIndexEntry_ const & entry, __uint64 beginPos,
+              __uint64 len, TCompression const &)
+{
+    unsigned column = beginPos % entry.lineLength;
+    __uint64 ofs = entry.offset + (beginPos / entry.lineLength) * entry.overallLineLength + column;
+
+    while (len != 0)
+    {
+        __uint64 n = std::min(len, (__uint64)(entry.lineLength - column));
+#if SEQAN_HAS_ZLIB
+        if (IsSameType<TCompression, BgzfFile>::VALUE)
+            target = _faiCopyBgzfBytes(target, index, ofs, n);
+        else
+#endif
+            target = _faiCopyBytes(target, index, ofs, n);
+        len -= n;
+        ofs += n + (entry.overallLineLength - entry.lineLength);
+        column = 0;
+    }
+    return target;
+}
+
+template <typename TTargetIter>
+inline void
+_faiReadRegion(TTargetIter target, FaiIndex const & index, FaiIndexEntry_ const & entry, __uint64 beginPos,
+               __uint64 len)
+{
+    if (len == 0)
+        return;
+
+#if SEQAN_HAS_ZLIB
+    // Only the block cache of BGZF compressed files is modified, uncompressed files are read without locking.
+    if (!empty(index.gziIndex))
+    {
+        ScopedWriteLock<ReadWriteLock> lock(index.blockCache.lock);
+        _faiReadLines(target, index, entry, beginPos, len, BgzfFile());
+        return;
+    }
+#endif
+    _faiReadLines(target, index, entry, beginPos, len, Nothing());
+}
+
 /*!
  * @fn FaiIndex#readRegion
  * @brief Read a region through an FaiIndex.
@@ -296,66 +521,16 @@ inline void readRegion(String<TValue, TSpec> & str,
                        TBeginPos beginPos,
                        TEndPos endPos)
 {
-    typedef String<char, MMap<> > const TFastaFile;
-
     FaiIndexEntry_ const & entry = index.indexEntryStore[rID];
 
     // Limit region to the infix, make sure that beginPos < endPos, compute character to read.
-    TEndPos seqLen = entry.sequenceLength;;
+    TEndPos seqLen = entry.sequenceLength;
     beginPos = std::min((TEndPos)beginPos, seqLen);
     endPos = std::min(std::max((TEndPos)beginPos, endPos), seqLen);
     TEndPos toRead = endPos - beginPos;
 
-    // seek to start position
-    DirectionIterator<TFastaFile, Input>::Type reader = directionIterator(index.mmapString, Input());
-    setPosition(
-        reader,
-        index.indexEntryStore[rID].offset +
-        (beginPos / entry.lineLength) * entry.overallLineLength);
-
-    // set up countdowns
-    CountDownFunctor<NotFunctor<IsWhitespace> > countDownIgnore(beginPos % entry.lineLength);
-    CountDownFunctor<NotFunctor<IsWhitespace> > countDownData(toRead);
-    IsWhitespace ignWhiteSpace;
-
-    // read characters
-    clear(str);
-    skipUntil(reader, countDownIgnore);
-    readUntil(str, reader, countDownData, ignWhiteSpace);
-    if (!countDownData)
-        SEQAN_THROW(UnexpectedEnd());
-//
-//
-//    typedef typename Iterator<String<char, MMap<> > const, Standard>::Type TSourceIter;
-//    typedef typename Iterator<String<TValue, TSpec>, Standard>::Type TTargetIter;
-//    TSourceIter itSource = begin(index.mmapString, Standard());
-//    __uint64 offset = index.indexEntryStore[rID].offset;
-//    // First, compute offset of the completely filled lines.
-//    unsigned numLines = beginPos / index.indexEntryStore[rID].lineLength;
-//    unsigned numBytes = numLines * index.indexEntryStore[rID].overallLineLength;
-//    // Then, compute overall offset by adding remaining bytes, too.
-//    numBytes += beginPos % index.indexEntryStore[rID].lineLength;
-//    offset += numBytes;
-//    // Advance iterator in MMap file.
-//    itSource += offset;
-//
-//    // Copy out the characters from FASTA file and convert via iterator assignment to target string's type.
-//    resize(str, toRead, TValue());
-//    TTargetIter itTarget = begin(str, Standard());
-//    for (TEndPos i = 0; i < toRead; )
-//    {
-//        if (isspace(*itSource))
-//        {
-//            ++itSource;
-//            continue;  // Skip spaces.
-//        }
-//        *itTarget = *itSource;
-//        ++itTarget;
-//        ++itSource;
-//        ++i;
-//    }
-//
-//    return true;
+    resize(str, toRead, Exact());
+    _faiReadRegion(begin(str, Standard()), index, entry, beginPos, toRead);
 }
 
 template <typename TValue, typename TSpec>
@@ -451,6 +626,109 @@ readRecord(FaiIndexEntry_ & entry, TFwdIterator & reader, CharString & buffer)
     skipLine(reader);           // Skip over line ending.
 }
 
+// ---------------------------------------------------------------------------
+// Function _faiOpenGziIndex()
+// ---------------------------------------------------------------------------
+
+#if SEQAN_HAS_ZLIB
+
+// Read the GZI file of a BGZF compressed FASTA file.  It consists of the number of blocks (except the first) followed
+// by their (compressed, uncompressed) begin offsets, all as little-endian 64 bit integers.
+
+inline bool _faiReadGziIndex(String<Pair<__uint64, __uint64> > & gziIndex, char const * gziFilename)
+{
+    std::ifstream file(gziFilename, std::ios_base::in | std::ios_base::binary);
+    if (!file.good())
+        return false;
+
+    __uint64 numEntries = 0;
+    if (!file.read(reinterpret_cast<char *>(&numEntries), 8))
+        return false;
+
+    resize(gziIndex, numEntries + 1, Exact());
+    gziIndex[0] = Pair<__uint64, __uint64>(0, 0);
+    for (__uint64 i = 1; i <= numEntries; ++i)
+    {
+        if (!file.read(reinterpret_cast<char *>(&gziIndex[i].i1), 8) ||
+            !file.read(reinterpret_cast<char *>(&gziIndex[i].i2), 8))
+            return false;
+    }
+    return true;
+}
+
+// Compute the GZI index by scanning the headers of all BGZF blocks.
+
+inline bool _faiScanGziIndex(String<Pair<__uint64, __uint64> > & gziIndex, String<char, MMap<> > const & file)
+{
+    clear(gziIndex);
+
+    __uint64 compressedOfs = 0;
+    __uint64 uncompressedOfs = 0;
+    while (compressedOfs < length(file))
+    {
+        char const * block = &file[0] + compressedOfs;
+        if (length(file) - compressedOfs < DefaultPageSize<BgzfFile>::BLOCK_HEADER_LENGTH ||
+            !_bgzfCheckHeader(block))
+            return false;
+
+        __uint64 compressedLen = _bgzfUnpack16(block + 16) + 1u;
+        if (compressedLen > length(file) - compressedOfs)
+            return false;
+
+        appendValue(gziIndex, Pair<__uint64, __uint64>(compressedOfs, uncompressedOfs));
+        compressedOfs += compressedLen;
+        uncompressedOfs += _bgzfUnpack32(block + compressedLen - 4);
+    }
+    return true;
+}
+
+#endif  // #if SEQAN_HAS_ZLIB
+
+// Set up the GZI index if the memory mapped FASTA file is compressed.  Fails for compressed files that are not BGZF.
+
+inline bool _faiOpenGziIndex(FaiIndex & index, bool readGziFile)
+{
+    clear(index.gziIndex);
+    clear(index.blockCache);
+
+    if (length(index.mmapString) < 2 ||
+        index.mmapString[0] != MagicHeader<GZFile>::VALUE[0] ||
+        index.mmapString[1] != MagicHeader<GZFile>::VALUE[1])
+        return true;  // Not compressed.
+
+#if SEQAN_HAS_ZLIB
+    if (length(index.mmapString) < DefaultPageSize<BgzfFile>::BLOCK_HEADER_LENGTH ||
+        !_bgzfCheckHeader(&index.mmapString[0]))
+        return false;  // Plain gzip does not allow random access.
+
+    std::string gziFilename = toCString(index.fastaFilename);
+    gziFilename += ".gzi";
+    if (readGziFile && _faiReadGziIndex(index.gziIndex, gziFilename.c_str()))
+        return true;
+    return _faiScanGziIndex(index.gziIndex, index.mmapString);
+#else
+    ignoreUnusedVariableWarning(readGziFile);
+    return false;
+#endif
+}
+
+// Translate a position reported by a BGZF stream (virtual offset) into the uncompressed file offset.
+
+inline __uint64 _faiUncompressedOffset(String<Pair<__uint64, __uint64> > const & gziIndex, __uint64 virtualOfs)
+{
+    __uint64 compressedOfs = virtualOfs >> 16;
+    __uint64 lo = 0, hi = length(gziIndex);
+    while (hi - lo > 1)
+    {
+        __uint64 mid = lo + (hi - lo) / 2;
+        if (gziIndex[mid].i1 <= compressedOfs)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return gziIndex[lo].i2 + (virtualOfs & 0xffff);
+}
+
 // ---------------------------------------------------------------------------
 // Function open()
 // ---------------------------------------------------------------------------
@@ -478,6 +756,8 @@ inline bool open(FaiIndex & index, char const * fastaFilename, char const * faiF
 
     if (!open(index.mmapString, toCString(fastaFilename), OPEN_RDONLY))
         return false;  // Could not open file.
+    if (!_faiOpenGziIndex(index, true))
+        return false;  // Compressed, but not with BGZF.
 
     // Open file.
     std::ifstream faiStream(toCString(index.faiFilename));
@@ -523,9 +803,27 @@ inline bool open(FaiIndex & index, char const * fastaFilename)
  *                        file name from the previous call to @link FaiIndex#build @endlink is used.  Type: <tt>char
  *                        const *</tt>.
  *
+ * For BGZF compressed FASTA files, the GZI file <tt>"${fastaFileName}.gzi"</tt> is written as well.
+ *
  * @return bool <tt>true</tt> on success, <tt>false</tt> otherwise.
  */
 
+inline bool _faiSaveGziIndex(String<Pair<__uint64, __uint64> > const & gziIndex, char const * gziFilename)
+{
+    std::ofstream file(gziFilename, std::ios_base::out | std::ios_base::binary);
+    if (!file.good())
+        return false;
+
+    __uint64 numEntries = length(gziIndex) - 1;  // The first block is implicit.
+    file.write(reinterpret_cast<char const *>(&numEntries), 8);
+    for (__uint64 i = 1; i < length(gziIndex); ++i)
+    {
+        file.write(reinterpret_cast<char const *>(&gziIndex[i].i1), 8);
+        file.write(reinterpret_cast<char const *>(&gziIndex[i].i2), 8);
+    }
+    return file.good();
+}
+
 inline bool save(FaiIndex const & index, char const * faiFilename)
 {
     // Open index files.
@@ -540,6 +838,13 @@ inline bool save(FaiIndex const & index, char const * faiFilename)
         file << entry.name << '\t' << entry.sequenceLength << '\t' << entry.offset << '\t'
              << entry.lineLength << '\t' << entry.overallLineLength << '\n';
     }
+
+    if (!empty(index.gziIndex))
+    {
+        std::string gziFilename = toCString(index.fastaFilename);
+        gziFilename += ".gzi";
+        return _faiSaveGziIndex(index.gziIndex, gziFilename.c_str());
+    }
     return true;
 }
 
@@ -554,20 +859,45 @@ inline bool save(FaiIndex const & index)
 // Function getRecordInfo(Fastq);
 // ----------------------------------------------------------------------------
 
-template <typename TFwdIterator>
-inline void getRecordInfo(FaiIndexEntry_ & entry, TFwdIterator & iter, Fasta)
+// Returns the uncompressed file position of a stream iterator.  For BGZF streams, the virtual offset is translated
+// using the GZI index.
+
+struct FaiFilePosition_
+{
+    String<Pair<__uint64, __uint64> > const * gziIndex;
+
+    FaiFilePosition_() :
+        gziIndex()
+    {}
+
+    explicit
+    FaiFilePosition_(String<Pair<__uint64, __uint64> > const & gziIndex) :
+        gziIndex(&gziIndex)
+    {}
+
+    template <typename TFwdIterator>
+    __uint64 operator()(TFwdIterator & iter) const
+    {
+        if (gziIndex == 0 || empty(*gziIndex))
+            return position(iter);
+        return _faiUncompressedOffset(*gziIndex, position(iter));
+    }
+};
+
+template <typename TFwdIterator, typename TPosition>
+inline void _getRecordInfo(FaiIndexEntry_ & entry, TFwdIterator & iter, Fasta, TPosition const & filePosition)
 {
     typedef EqualsChar<'>'> TFastaBegin;
 
     clear(entry);
 
     skipUntil(iter, TFastaBegin());     // forward to the next '>'
-    entry.offset = position(iter);      // store file position
+    entry.offset = filePosition(iter);  // store file position
     skipOne(iter);                      // skip '>'
 
     readUntil(entry.name, iter, IsWhitespace());    // read Fasta id (up to first whitespace)
     skipLine(iter);
-    entry.offset = position(iter);      // store offset
+    entry.offset = filePosition(iter);  // store offset
 
     FaiIndexEntry_ temp;
     FaiIndexEntry_ *entryPtr = &entry;
@@ -583,7 +913,7 @@ inline void getRecordInfo(FaiIndexEntry_ & entry, TFwdIterator & iter, Fasta)
             SEQAN_THROW(ParseError("FastaIndex: Record has inconsistent line lengths or line endings"));
         }
 
-        __uint64 start = position(iter);
+        __uint64 start = filePosition(iter);
 
         // skip to the end of line and count non-whitespace characters
         clear(countCharsPerLine.func2);
@@ -597,16 +927,38 @@ inline void getRecordInfo(FaiIndexEntry_ & entry, TFwdIterator & iter, Fasta)
         skipLine(iter);
 
         // determine line length in bytes
-        entryPtr->overallLineLength = (__uint64)position(iter) - start;
+        entryPtr->overallLineLength = filePosition(iter) - start;
         cmpPtr = entryPtr;
         entryPtr = &temp;
     }
 }
 
+template <typename TFwdIterator>
+inline void getRecordInfo(FaiIndexEntry_ & entry, TFwdIterator & iter, Fasta)
+{
+    _getRecordInfo(entry, iter, Fasta(), FaiFilePosition_());
+}
+
 // ---------------------------------------------------------------------------
 // Function build()
 // ---------------------------------------------------------------------------
 
+template <typename TFwdIterator>
+inline bool _faiAppendEntries(FaiIndex & index, TFwdIterator & iter, FaiFilePosition_ const & filePosition)
+{
+    if (!atEnd(iter) && value(iter) != '>')
+        return false;  // Invalid format, not FASTA.
+
+    FaiIndexEntry_ entry;
+    while (!atEnd(iter))
+    {
+        _getRecordInfo(entry, iter, Fasta(), filePosition);
+        appendValue(index.seqNameStore, entry.name);
+        appendValue(index.indexEntryStore, entry);
+    }
+    return true;
+}
+
 /*!
  * @fn FaiIndex#build
  * @brief Create a FaiIndex from FASTA file.
@@ -626,24 +978,35 @@ inline bool build(FaiIndex & index, char const * seqFilename, char const * faiFi
     index.fastaFilename = seqFilename;
     index.faiFilename = faiFilename;
 
-    SeqFileIn seqFile(seqFilename);
-    DirectionIterator<SeqFileIn, Input>::Type iter = directionIterator(seqFile, Input());
-    
-    if (!isEqual(format(seqFile), seqan::Fasta()))
-        return false;  // Invalid format, not FASTA.
-
     // Clear everything.
     clear(index.seqNameStore);
     clear(index.seqNameStoreCache);
     clear(index.indexEntryStore);
 
+    // Map the file for readRegion() and locate the blocks of compressed files.
+    if (!open(index.mmapString, seqFilename, OPEN_RDONLY))
+        return false;
+    if (!_faiOpenGziIndex(index, false))
+        return false;  // Compressed, but not with BGZF.
+
     // Create FastaIndex
-    FaiIndexEntry_ entry;
-    while (!atEnd(iter))
+#if SEQAN_HAS_ZLIB
+    if (!empty(index.gziIndex))
     {
-        getRecordInfo(entry, iter, Fasta());
-        appendValue(index.seqNameStore, entry.name);
-        appendValue(index.indexEntryStore, entry);
+        // Read through a BGZF stream whose positions can be translated into uncompressed file offsets.
+        std::ifstream file(seqFilename, std::ios_base::in | std::ios_base::binary);
+        bgzf_istream bgzfStream(file);
+        DirectionIterator<bgzf_istream, Input>::Type bgzfIter = directionIterator(bgzfStream, Input());
+        if (!_faiAppendEntries(index, bgzfIter, FaiFilePosition_(index.gziIndex)))
+            return false;
+    }
+    else
+#endif
+    {
+        // Uncompressed files are read from the mapping, file positions are the iterator positions.
+        Iterator<String<char, MMap<> >, Rooted>::Type iter = begin(index.mmapString, Rooted());
+        if (!_faiAppendEntries(index, iter, FaiFilePosition_()))
+            return false;
     }
 
     // Recreate name store cache.
@@ -240,11 +240,13 @@ inline void readRecords(TIdStringSet & meta,
 // Function readRecords(); Without max records
 // ----------------------------------------------------------------------------
 
+// an integral last argument is the number of records, not the alphabet
 template <typename TIdStringSet, typename TSeqStringSet, typename TSpec, typename TFastqAlphabet>
-inline void readRecords(TIdStringSet & meta,
-                        TSeqStringSet & seq,
-                        SmartFile<Fastq, Input, TSpec> & file,
-                        TFastqAlphabet = Iupac())
+inline SEQAN_FUNC_DISABLE_IF(Is<IntegerConcept<TFastqAlphabet> >, void)
+readRecords(TIdStringSet & meta,
+            TSeqStringSet & seq,
+            SmartFile<Fastq, Input, TSpec> & file,
+            TFastqAlphabet = Iupac())
 {
     readRecords(meta, seq, file, MaxValue<__uint64>::VALUE, TFastqAlphabet());
 }
@@ -302,12 +304,14 @@ inline void readRecords(TIdStringSet & meta,
 // Function readRecords(); With separate qualities; Without max records
 // ----------------------------------------------------------------------------
 
+// an integral last argument is the number of records, not the alphabet
 template <typename TIdStringSet, typename TSeqStringSet, typename TQualStringSet, typename TSpec, typename TFastqAlphabet>
-inline void readRecords(TIdStringSet & meta,
-                        TSeqStringSet & seq,
-                        TQualStringSet & qual,
-                        SmartFile<Fastq, Input, TSpec> & file,
-                        TFastqAlphabet = Iupac())
+inline SEQAN_FUNC_DISABLE_IF(Is<IntegerConcept<TFastqAlphabet> >, void)
+readRecords(TIdStringSet & meta,
+            TSeqStringSet & seq,
+            TQualStringSet & qual,
+            SmartFile<Fastq, Input, TSpec> & file,
+            TFastqAlphabet = Iupac())
 {
     readRecords(meta, seq, qual, file, MaxValue<__uint64>::VALUE, TFastqAlphabet());
 }
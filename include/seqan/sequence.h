@@ -141,6 +141,7 @@
 #include <seqan/sequence/string_set_device.h>
 #endif
 #include <seqan/sequence/string_set_concat_direct.h>
+#include <seqan/sequence/string_set_arena.h>
 #include <seqan/sequence/string_set_dependent_tight.h>
 #include <seqan/sequence/string_set_dependent_generous.h>
 #include <seqan/sequence/string_set_owner.h>
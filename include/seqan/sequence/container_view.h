@@ -604,6 +604,23 @@ inline void assign(ContainerView<TContainer, Resizable<TSpec> > & view, TOtherCo
     view._capacity = capacity(cont, Standard());
 }
 
+// Views are shallow, thus assigning a const view must not make its values const.
+template <typename TContainer, typename TSpec>
+inline void assign(ContainerView<TContainer, TSpec> & view, ContainerView<TContainer, TSpec> const & other)
+{
+    view._begin = other._begin;
+    view._end = other._end;
+}
+
+template <typename TContainer, typename TSpec>
+inline void assign(ContainerView<TContainer, Resizable<TSpec> > & view,
+                   ContainerView<TContainer, Resizable<TSpec> > const & other)
+{
+    view._begin = other._begin;
+    view._end = other._end;
+    view._capacity = other._capacity;
+}
+
 // ----------------------------------------------------------------------------
 // Function capacity()
 // ----------------------------------------------------------------------------
@@ -648,6 +665,54 @@ clear(ContainerView<TContainer, Resizable<TSpec> > & view)
     resize(view, 0, Exact());
 }
 
+// ----------------------------------------------------------------------------
+// Comparison operators
+// ----------------------------------------------------------------------------
+
+template <typename TContainer, typename TSpec, typename TRight>
+inline bool
+operator==(ContainerView<TContainer, TSpec> const & left, TRight const & right)
+{
+    typename Comparator<ContainerView<TContainer, TSpec> >::Type _lex(left, right);
+    return isEqual(_lex);
+}
+
+template <typename TContainer, typename TSpec, typename TRight>
+inline bool
+operator!=(ContainerView<TContainer, TSpec> const & left, TRight const & right)
+{
+    typename Comparator<ContainerView<TContainer, TSpec> >::Type _lex(left, right);
+    return isNotEqual(_lex);
+}
+
+template <typename TContainer, typename TSpec, typename TRight>
+inline bool
+operator<(ContainerView<TContainer, TSpec> const & left, TRight const & right)
+{
+    return isLess(left, right, typename DefaultPrefixOrder<ContainerView<TContainer, TSpec> >::Type());
+}
+
+template <typename TContainer, typename TSpec, typename TRight>
+inline bool
+operator<=(ContainerView<TContainer, TSpec> const & left, TRight const & right)
+{
+    return isLessOrEqual(left, right, typename DefaultPrefixOrder<ContainerView<TContainer, TSpec> >::Type());
+}
+
+template <typename TContainer, typename TSpec, typename TRight>
+inline bool
+operator>(ContainerView<TContainer, TSpec> const & left, TRight const & right)
+{
+    return isGreater(left, right, typename DefaultPrefixOrder<ContainerView<TContainer, TSpec> >::Type());
+}
+
+template <typename TContainer, typename TSpec, typename TRight>
+inline bool
+operator>=(ContainerView<TContainer, TSpec> const & left, TRight const & right)
+{
+    return isGreaterOrEqual(left, right, typename DefaultPrefixOrder<ContainerView<TContainer, TSpec> >::Type());
+}
+
 // ----------------------------------------------------------------------------
 // Operator<<
 // ----------------------------------------------------------------------------
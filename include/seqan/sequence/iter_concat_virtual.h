@@ -147,7 +147,7 @@ public:
 
     inline operator void * ()
     {
-        return _cur;
+        return (void *)_cur;   // the objects may be const, e.g. read-only views
     }
 
     // ----------------------------------------------------------------------
@@ -0,0 +1,557 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Implementation of the Arena string set, a string set storing its strings
+// in large chunks that are reused after clearing the string set.
+// ==========================================================================
+
+#ifndef SEQAN_SEQUENCE_STRING_SET_ARENA_H_
+#define SEQAN_SEQUENCE_STRING_SET_ARENA_H_
+
+namespace seqan {
+
+// ============================================================================
+// Forwards
+// ============================================================================
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+template <typename TSpec = void>
+struct Arena;                           // contains chunks that are filled with the strings one after another
+
+/*!
+ * @class ArenaStringSet Arena StringSet
+ * @extends OwnerStringSet
+ * @headerfile <seqan/sequence.h>
+ * @brief Owner StringSet implementation that bump-allocates its strings from large chunks.
+ *
+ * @signature template <typename TString>
+ *            class StringSet<TString, Owner<Arena<> > >;
+ *
+ * @tparam TString The type of the string to store in the string set.  Must be an @link AllocString @endlink.
+ *
+ * Appended strings are copied to the end of the current chunk of <tt>CHUNK_LENGTH</tt> values.  A string that does
+ * not fit starts a new chunk.  The stored strings are never moved, thus appending strings keeps iterators and views
+ * of the previous strings valid.  @link StringSet#clear @endlink keeps all chunks and the string set limits for
+ * the next strings.  This makes it suitable for read batches that are loaded one after another, as a batch of at
+ * most the size of the previous ones is stored without allocating memory.
+ *
+ * The string set limits are always up-to-date, thus the string set can be passed to index construction.  The
+ * values of the string set are @link ContainerView @endlink objects of the stored strings, which are read-only.
+ * Changing the length of a stored string is not possible, but @link StringSet#assignValue @endlink replaces it.
+ */
+
+template <typename TString, typename TSpec>
+class StringSet<TString, Owner<Arena<TSpec> > >
+{
+public:
+    typedef String<TString>                             TChunks;
+    typedef typename Size<TChunks>::Type                TChunkCount;
+    typedef typename View<TString>::Type                TView;
+    typedef String<TView>                               TViews;
+    typedef typename StringSetLimits<StringSet>::Type   TLimits;
+    typedef typename Concatenator<StringSet>::Type      TConcatenator;
+
+    enum { CHUNK_LENGTH = 0x100000 };
+
+    TChunks         chunks;
+    TChunkCount     usedChunks;         // chunks[usedChunks - 1] is the chunk that is currently filled
+    TViews          views;
+    TLimits         limits;
+    TConcatenator   concat;
+
+    StringSet() :
+        usedChunks(0)
+    {
+        _initStringSetLimits(*this);
+    }
+
+    // The views point into the chunks, thus a copy must append the strings to its own chunks.
+    StringSet(StringSet const & other) :
+        usedChunks(0)
+    {
+        _initStringSetLimits(*this);
+        assign(*this, other);
+    }
+
+    template <typename TOtherString, typename TOtherSpec>
+    StringSet(StringSet<TOtherString, TOtherSpec> const & other) :
+        usedChunks(0)
+    {
+        _initStringSetLimits(*this);
+        assign(*this, other);
+    }
+
+    template <typename TOtherSpec>
+    StringSet(String<TString, TOtherSpec> const & other) :
+        usedChunks(0)
+    {
+        _initStringSetLimits(*this);
+        assign(*this, other);
+    }
+
+    // ----------------------------------------------------------------------
+    // Subscription operators; have to be defined in class def.
+    // ----------------------------------------------------------------------
+
+    template <typename TPos>
+    inline typename Reference<StringSet>::Type
+    operator[](TPos pos)
+    {
+        return value(*this, pos);
+    }
+
+    template <typename TPos>
+    inline typename Reference<StringSet const>::Type
+    operator[](TPos pos) const
+    {
+        return value(*this, pos);
+    }
+
+    StringSet & operator= (StringSet const & other)
+    {
+        if (this != &other)
+            assign(*this, other);
+        return *this;
+    }
+
+    template <typename TStringSet>
+    StringSet & operator= (TStringSet const & other)
+    {
+        assign(*this, other);
+        return *this;
+    }
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// --------------------------------------------------------------------------
+// Metafunction Value
+// --------------------------------------------------------------------------
+
+// The views are read-only, also in a non-const string set.
+template <typename TString, typename TSpec>
+struct Value<StringSet<TString, Owner<Arena<TSpec> > > >
+{
+    typedef typename View<TString>::Type const Type;
+};
+
+template <typename TString, typename TSpec>
+struct Value<StringSet<TString, Owner<Arena<TSpec> > > const>
+{
+    typedef typename View<TString>::Type const Type;
+};
+
+// --------------------------------------------------------------------------
+// Metafunction GetValue
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec>
+struct GetValue<StringSet<TString, Owner<Arena<TSpec> > > >
+{
+    typedef typename View<TString>::Type const & Type;
+};
+
+template <typename TString, typename TSpec>
+struct GetValue<StringSet<TString, Owner<Arena<TSpec> > > const>
+{
+    typedef typename View<TString>::Type const & Type;
+};
+
+// --------------------------------------------------------------------------
+// Metafunction Reference
+// --------------------------------------------------------------------------
+
+// Replacing a view would leave the limits stale, this must be done with assignValue().
+template <typename TString, typename TSpec>
+struct Reference<StringSet<TString, Owner<Arena<TSpec> > > >
+{
+    typedef typename View<TString>::Type const & Type;
+};
+
+template <typename TString, typename TSpec>
+struct Reference<StringSet<TString, Owner<Arena<TSpec> > > const>
+{
+    typedef typename View<TString>::Type const & Type;
+};
+
+// --------------------------------------------------------------------------
+// Metafunction Prefix
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec>
+struct Prefix<StringSet<TString, Owner<Arena<TSpec> > > >
+    : View<TString> {};
+
+template <typename TString, typename TSpec>
+struct Prefix<StringSet<TString, Owner<Arena<TSpec> > > const>
+    : View<TString> {};
+
+// --------------------------------------------------------------------------
+// Metafunction Suffix
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec>
+struct Suffix<StringSet<TString, Owner<Arena<TSpec> > > >
+    : View<TString> {};
+
+template <typename TString, typename TSpec>
+struct Suffix<StringSet<TString, Owner<Arena<TSpec> > > const>
+    : View<TString> {};
+
+// --------------------------------------------------------------------------
+// Metafunction Infix
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec>
+struct Infix<StringSet<TString, Owner<Arena<TSpec> > > >
+    : View<TString> {};
+
+template <typename TString, typename TSpec>
+struct Infix<StringSet<TString, Owner<Arena<TSpec> > > const>
+    : View<TString> {};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// --------------------------------------------------------------------------
+// Function _validStringSetLimits
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec>
+inline bool _validStringSetLimits(StringSet<TString, Owner<Arena<TSpec> > > const &)
+{
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Function _refreshStringSetLimits()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec>
+inline void _refreshStringSetLimits(StringSet<TString, Owner<Arena<TSpec> > > &) {}
+
+// --------------------------------------------------------------------------
+// Function _allocateArenaString()
+// --------------------------------------------------------------------------
+
+// Copies seq to the end of the current chunk or to the next chunk and returns a view of the copy.
+template <typename TString, typename TSpec, typename TSequence>
+inline typename View<TString>::Type
+_allocateArenaString(StringSet<TString, Owner<Arena<TSpec> > > & me, TSequence const & seq)
+{
+    typedef StringSet<TString, Owner<Arena<TSpec> > > TStringSet;
+    typedef typename Size<TString>::Type TSize;
+
+    TSize seqLength = length(seq);
+    if (me.usedChunks == 0u ||
+        capacity(me.chunks[me.usedChunks - 1]) - length(me.chunks[me.usedChunks - 1]) < seqLength)
+    {
+        // start the next chunk, which is reused from a previous batch if possible
+        if (me.usedChunks == length(me.chunks))
+            appendValue(me.chunks, TString());
+        TString & chunk = me.chunks[me.usedChunks++];
+        TSize chunkLength = _max(seqLength, static_cast<TSize>(TStringSet::CHUNK_LENGTH));
+        if (capacity(chunk) < chunkLength)
+            reserve(chunk, chunkLength, Exact());
+    }
+
+    TString & chunk = me.chunks[me.usedChunks - 1];
+    TSize offset = length(chunk);
+    append(chunk, seq, Insist());
+    return typename View<TString>::Type(begin(chunk, Standard()) + offset, end(chunk, Standard()));
+}
+
+// --------------------------------------------------------------------------
+// Function appendValue()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TString2, typename TSpec, typename TExpand>
+inline void appendValue(
+    StringSet<TString, Owner<Arena<TSpec> > > & me,
+    TString2 const & obj,
+    Tag<TExpand> tag)
+{
+    appendValue(me.views, _allocateArenaString(me, obj), tag);
+    appendValue(me.limits, back(me.limits) + length(obj), tag);
+}
+
+// --------------------------------------------------------------------------
+// Function assignValue()
+// --------------------------------------------------------------------------
+
+// The old string is left unused in its chunk until the string set is cleared.
+template <typename TString, typename TSpec, typename TPos, typename TSequence>
+inline void assignValue(
+    StringSet<TString, Owner<Arena<TSpec> > > & me,
+    TPos pos,
+    TSequence const & seq)
+{
+    typedef StringSet<TString, Owner<Arena<TSpec> > > TStringSet;
+    typedef typename Size<TStringSet>::Type TSize;
+    typedef typename StringSetLimits<TStringSet>::Type TLimits;
+    typedef typename Value<TLimits>::Type TLimitValue;
+    typedef typename MakeSigned<TLimitValue>::Type TSignedLimitValue;
+
+    TSignedLimitValue delta = (TSignedLimitValue)length(seq) - (TSignedLimitValue)length(me[pos]);
+    me.views[pos] = _allocateArenaString(me, seq);
+    TSize size = length(me);
+    while ((TSize)pos < size)
+        me.limits[++pos] += delta;
+}
+
+// --------------------------------------------------------------------------
+// Function insertValue()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec, typename TPos, typename TSequence, typename TExpand>
+inline void insertValue(
+    StringSet<TString, Owner<Arena<TSpec> > > & me,
+    TPos pos,
+    TSequence const & seq,
+    Tag<TExpand> tag)
+{
+    typedef StringSet<TString, Owner<Arena<TSpec> > > TStringSet;
+    typedef typename Size<TStringSet>::Type TSize;
+    typedef typename StringSetLimits<TStringSet>::Type TLimits;
+    typedef typename Value<TLimits>::Type TLimitValue;
+
+    insertValue(me.views, pos, _allocateArenaString(me, seq), tag);
+    insertValue(me.limits, pos, me.limits[pos], tag);
+    TLimitValue delta = (TLimitValue)length(seq);
+    TSize size = length(me);
+    while ((TSize)pos < size)
+        me.limits[++pos] += delta;
+}
+
+// --------------------------------------------------------------------------
+// Function erase()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec, typename TPos, typename TPosEnd>
+inline typename Size<StringSet<TString, Owner<Arena<TSpec> > > >::Type
+erase(StringSet<TString, Owner<Arena<TSpec> > > & me, TPos pos, TPosEnd posEnd)
+{
+    typedef StringSet<TString, Owner<Arena<TSpec> > > TStringSet;
+    typedef typename Size<TStringSet>::Type TSize;
+    typedef typename StringSetLimits<TStringSet>::Type TLimits;
+    typedef typename Value<TLimits>::Type TLimitValue;
+
+    TLimitValue delta = me.limits[posEnd] - me.limits[pos];
+    erase(me.views, pos, posEnd);
+    erase(me.limits, pos + 1, posEnd + 1);
+
+    TSize size = length(me);
+    for (TSize i = pos; i < size; )
+        me.limits[++i] -= delta;
+    return size;
+}
+
+template <typename TString, typename TSpec, typename TPos>
+inline typename Size<StringSet<TString, Owner<Arena<TSpec> > > >::Type
+erase(StringSet<TString, Owner<Arena<TSpec> > > & me, TPos pos)
+{
+    return erase(me, pos, pos + 1);
+}
+
+// --------------------------------------------------------------------------
+// Function clear()
+// --------------------------------------------------------------------------
+
+// Only resets the lengths, the memory is kept for the next strings.
+template <typename TString, typename TSpec>
+inline void clear(StringSet<TString, Owner<Arena<TSpec> > > & me)
+{
+    for (typename Size<String<TString> >::Type i = 0; i < me.usedChunks; ++i)
+        clear(me.chunks[i]);
+    me.usedChunks = 0;
+    clear(me.views);
+    resize(me.limits, 1, Exact());
+}
+
+// --------------------------------------------------------------------------
+// Function length()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec>
+inline typename Size<StringSet<TString, Owner<Arena<TSpec> > > >::Type
+length(StringSet<TString, Owner<Arena<TSpec> > > const & me)
+{
+    return length(me.limits) - 1;
+}
+
+// --------------------------------------------------------------------------
+// Function resize()
+// --------------------------------------------------------------------------
+
+// New strings are empty.
+template <typename TString, typename TSpec, typename TSize, typename TExpand>
+inline typename Size<StringSet<TString, Owner<Arena<TSpec> > > >::Type
+resize(StringSet<TString, Owner<Arena<TSpec> > > & me, TSize new_size, Tag<TExpand> tag)
+{
+    typedef typename View<TString>::Type TView;
+
+    resize(me.views, new_size, TView(), tag);
+    return resize(me.limits, new_size + 1, back(me.limits), tag) - 1;
+}
+
+// --------------------------------------------------------------------------
+// Function reserve()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec, typename TSize, typename TExpand>
+inline typename Size<StringSet<TString, Owner<Arena<TSpec> > > >::Type
+reserve(StringSet<TString, Owner<Arena<TSpec> > > & me,
+        TSize const & new_capacity,
+        Tag<TExpand> tag)
+{
+    reserve(me.views, new_capacity, tag);
+    return reserve(me.limits, new_capacity + 1, tag) - 1;
+}
+
+// --------------------------------------------------------------------------
+// Function value()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec, typename TPos>
+inline typename Reference<StringSet<TString, Owner<Arena<TSpec> > > >::Type
+value(StringSet<TString, Owner<Arena<TSpec> > > & me, TPos pos)
+{
+    return me.views[pos];
+}
+
+template <typename TString, typename TSpec, typename TPos>
+inline typename Reference<StringSet<TString, Owner<Arena<TSpec> > > const>::Type
+value(StringSet<TString, Owner<Arena<TSpec> > > const & me, TPos pos)
+{
+    return me.views[pos];
+}
+
+// --------------------------------------------------------------------------
+// Function prefix()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec, typename TPosition>
+inline typename Prefix<StringSet<TString, Owner<Arena<TSpec> > > >::Type
+prefix(StringSet<TString, Owner<Arena<TSpec> > > & me, TPosition const & pos)
+{
+    return prefix(me[getSeqNo(pos, stringSetLimits(me))], getSeqOffset(pos, stringSetLimits(me)));
+}
+
+template <typename TString, typename TSpec, typename TPosition>
+inline typename Prefix<StringSet<TString, Owner<Arena<TSpec> > > const>::Type
+prefix(StringSet<TString, Owner<Arena<TSpec> > > const & me, TPosition const & pos)
+{
+    return prefix(me[getSeqNo(pos, stringSetLimits(me))], getSeqOffset(pos, stringSetLimits(me)));
+}
+
+// --------------------------------------------------------------------------
+// Function suffix()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec, typename TPosition>
+inline typename Suffix<StringSet<TString, Owner<Arena<TSpec> > > >::Type
+suffix(StringSet<TString, Owner<Arena<TSpec> > > & me, TPosition const & pos)
+{
+    return suffix(me[getSeqNo(pos, stringSetLimits(me))], getSeqOffset(pos, stringSetLimits(me)));
+}
+
+template <typename TString, typename TSpec, typename TPosition>
+inline typename Suffix<StringSet<TString, Owner<Arena<TSpec> > > const>::Type
+suffix(StringSet<TString, Owner<Arena<TSpec> > > const & me, TPosition const & pos)
+{
+    return suffix(me[getSeqNo(pos, stringSetLimits(me))], getSeqOffset(pos, stringSetLimits(me)));
+}
+
+// --------------------------------------------------------------------------
+// Function infix()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec, typename TPosBegin, typename TPosEnd>
+inline typename Infix<StringSet<TString, Owner<Arena<TSpec> > > >::Type
+infix(StringSet<TString, Owner<Arena<TSpec> > > & me, TPosBegin const & posBegin, TPosEnd const & posEnd)
+{
+    return infix(me[getSeqNo(posBegin, stringSetLimits(me))],
+                 getSeqOffset(posBegin, stringSetLimits(me)),
+                 getSeqOffset(posEnd, stringSetLimits(me)));
+}
+
+template <typename TString, typename TSpec, typename TPosBegin, typename TPosEnd>
+inline typename Infix<StringSet<TString, Owner<Arena<TSpec> > > const>::Type
+infix(StringSet<TString, Owner<Arena<TSpec> > > const & me, TPosBegin const & posBegin, TPosEnd const & posEnd)
+{
+    return infix(me[getSeqNo(posBegin, stringSetLimits(me))],
+                 getSeqOffset(posBegin, stringSetLimits(me)),
+                 getSeqOffset(posEnd, stringSetLimits(me)));
+}
+
+// --------------------------------------------------------------------------
+// Function infixWithLength()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec, typename TPosition, typename TSize>
+inline typename Infix<StringSet<TString, Owner<Arena<TSpec> > > >::Type
+infixWithLength(StringSet<TString, Owner<Arena<TSpec> > > & me, TPosition const & pos, TSize length)
+{
+    return infixWithLength(me[getSeqNo(pos, stringSetLimits(me))], getSeqOffset(pos, stringSetLimits(me)), length);
+}
+
+template <typename TString, typename TSpec, typename TPosition, typename TSize>
+inline typename Infix<StringSet<TString, Owner<Arena<TSpec> > > const>::Type
+infixWithLength(StringSet<TString, Owner<Arena<TSpec> > > const & me, TPosition const & pos, TSize length)
+{
+    return infixWithLength(me[getSeqNo(pos, stringSetLimits(me))], getSeqOffset(pos, stringSetLimits(me)), length);
+}
+
+// --------------------------------------------------------------------------
+// Function swap()
+// --------------------------------------------------------------------------
+
+template <typename TString, typename TSpec>
+void swap(StringSet<TString, Owner<Arena<TSpec> > > & lhs,
+          StringSet<TString, Owner<Arena<TSpec> > > & rhs)
+{
+    using std::swap;
+
+    swap(lhs.chunks, rhs.chunks);
+    swap(lhs.usedChunks, rhs.usedChunks);
+    swap(lhs.views, rhs.views);
+    swap(lhs.limits, rhs.limits);
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_SEQUENCE_STRING_SET_ARENA_H_
@@ -80,14 +80,18 @@ public:
     struct BufferWriter
     {
         ostream_reference ostream;
+        String<__uint64>  blockOffsets;     // compressed begin offsets of all written blocks and the end offset
 
         BufferWriter(ostream_reference ostream) :
             ostream(ostream)
-        {}
+        {
+            resize(blockOffsets, 1, 0u);
+        }
 
         bool operator() (OutputBuffer const & outputBuffer)
         {
             ostream.write(outputBuffer.buffer, outputBuffer.size);
+            appendValue(blockOffsets, back(blockOffsets) + outputBuffer.size);
             return ostream.good();
         }
     };
@@ -119,6 +123,7 @@ public:
 
     size_t                  currentJobId;
     bool                    currentJobAvail;
+    __uint64                blockCount;     // number of submitted blocks
 
 
     struct CompressionThread
@@ -167,6 +172,7 @@ public:
     {
         resize(jobs, numJobs, Exact());
         currentJobId = 0;
+        blockCount = 0;
 
         lockWriting(jobQueue);
         lockReading(idleQueue);
@@ -216,6 +222,7 @@ public:
         {
             jobs[currentJobId].size = size;
             appendValue(jobQueue, currentJobId);
+            ++blockCount;
         }
 
         // recycle existing idle job
@@ -287,6 +294,22 @@ public:
 
 	/// returns a reference to the output stream
 	ostream_reference get_ostream() const	{ return serializer.worker.ostream; };
+
+    /// returns the current write position as (number of the current block << 16) | (offset in the block)
+    ///
+    /// The compressed offsets of the blocks are not known before they are written by the compression threads.
+    /// After a flush(), block positions can be converted into BGZF virtual offsets with virtualOffset().
+    __uint64 blockPosition() const
+    {
+        return (blockCount << 16) | static_cast<__uint64>(this->pptr() - this->pbase());
+    }
+
+    /// converts a block position of an already flushed block into a BGZF virtual offset
+    __uint64 virtualOffset(__uint64 blockPos) const
+    {
+        SEQAN_ASSERT_LT(blockPos >> 16, length(serializer.worker.blockOffsets));
+        return (serializer.worker.blockOffsets[blockPos >> 16] << 16) | (blockPos & 0xffff);
+    }
 };
 
 template<
@@ -664,7 +687,10 @@ public:
                     // find our seek target
 
                     if (currentJobId >= 0)
+                    {
                         appendValue(todoQueue, currentJobId);
+                        currentJobId = -1;
+                    }
 
                     // empty is thread-safe in serializer.lock
                     while (!empty(runningQueue))
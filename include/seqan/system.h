@@ -87,6 +87,9 @@
 
 #include <seqan/system/file_sync.h>
 #include <seqan/system/file_async.h>
+#ifndef PLATFORM_WINDOWS
+#include <seqan/system/file_async_uring.h>
+#endif  // #ifndef PLATFORM_WINDOWS
 #include <seqan/system/file_directory.h>
 
 #endif //#ifndef SEQAN_HEADER_...
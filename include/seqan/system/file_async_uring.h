@@ -0,0 +1,725 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Asynchronous file access using the Linux io_uring interface.
+// ==========================================================================
+
+//SEQAN_NO_GENERATED_FORWARDS: no forwards are generated for this file
+
+#ifndef SEQAN_HEADER_FILE_ASYNC_URING_H
+#define SEQAN_HEADER_FILE_ASYNC_URING_H
+
+// io_uring is used via raw system calls, so only the kernel headers are required.
+#ifndef SEQAN_HAS_IOURING
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <sys/syscall.h>
+#ifdef __NR_io_uring_setup
+#define SEQAN_HAS_IOURING 1
+#endif
+#endif
+#endif
+#endif
+
+#ifndef SEQAN_HAS_IOURING
+#define SEQAN_HAS_IOURING 0
+#endif
+
+#if SEQAN_HAS_IOURING
+
+#include <vector>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+// <linux/fs.h> defines BLOCK_SIZE, which clashes with identifiers in SeqAn.
+// Only remove it if it was not defined before, e.g. by the application.
+#ifndef BLOCK_SIZE
+#define SEQAN_IOURING_UNDEF_BLOCK_SIZE
+#endif
+#include <linux/io_uring.h>
+#ifdef SEQAN_IOURING_UNDEF_BLOCK_SIZE
+#undef BLOCK_SIZE
+#undef BLOCK_SIZE_BITS
+#undef SEQAN_IOURING_UNDEF_BLOCK_SIZE
+#endif
+
+// Number of submission queue entries of a ring.
+#ifndef SEQAN_IOURING_QUEUE_DEPTH
+#define SEQAN_IOURING_QUEUE_DEPTH 128
+#endif
+
+namespace SEQAN_NAMESPACE_MAIN
+{
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+/*!
+ * @class IOUringFile
+ * @extends AsyncFile
+ * @headerfile <seqan/file.h>
+ * @brief Asynchronous file access using the Linux io_uring interface.
+ *
+ * @signature template <>
+ *            class File<Async<IOUring> >;
+ *
+ * Instead of the POSIX <tt>aio_*</tt> functions, which glibc emulates with threads, requests are passed to the kernel
+ * through a submission ring and collected from a completion ring.  This allows deep queues of large reads and writes,
+ * e.g. for external strings and pools:
+ *
+ * @code{.cpp}
+ * String<unsigned, External<ExternalConfigLarge<File<Async<IOUring> > > > > str;
+ * @endcode
+ *
+ * The public members <tt>queueDepth</tt>, <tt>submitBatchSize</tt> and <tt>directIO</tt> can be changed before the
+ * file is opened.  <tt>queueDepth</tt> is the number of submission queue entries (default:
+ * <tt>SEQAN_IOURING_QUEUE_DEPTH</tt>, 128).  With <tt>submitBatchSize</tt> &gt; 1, requests are collected and passed
+ * to the kernel with a single system call once the batch is full or a request is waited for (default: 1).  With
+ * <tt>directIO</tt> set, the file is additionally opened with <tt>O_DIRECT</tt> and used for all requests whose
+ * buffer, offset and size are aligned to 4KB (default: <tt>false</tt>).
+ *
+ * Buffers that are used for many transfers can be registered with @link IOUringFile#registerBuffer @endlink to save
+ * the kernel mapping them for each request.
+ *
+ * If the kernel does not support io_uring, all requests are executed synchronously.
+ *
+ * This specialization is only available on Linux, <tt>SEQAN_HAS_IOURING</tt> is set to 1 in this case.
+ */
+
+struct IOUring_;
+typedef Tag<IOUring_> IOUring;
+
+// ----------------------------------------------------------------------------
+// Class IOUringContext_
+// ----------------------------------------------------------------------------
+
+// The memory mapped submission and completion rings of an io_uring instance.
+
+struct IOUringContext_
+{
+    int ringFd;
+
+    void *          sqRing;
+    size_t          sqRingSize;
+    void *          cqRing;
+    size_t          cqRingSize;
+    io_uring_sqe *  sqes;
+    size_t          sqesSize;
+
+    unsigned *      sqHead;
+    unsigned *      sqTail;
+    unsigned *      sqMask;
+    unsigned *      sqArray;
+    unsigned        sqEntries;
+
+    unsigned *      cqHead;
+    unsigned *      cqTail;
+    unsigned *      cqMask;
+    io_uring_cqe *  cqes;
+    unsigned        cqEntries;
+
+    unsigned        features;
+    unsigned        toSubmit;       // prepared but not yet submitted entries
+    unsigned        inFlight;       // submitted but not yet completed entries
+
+    std::vector<iovec> fixedBuffers;    // buffers registered with the kernel
+
+    IOUringContext_() :
+        ringFd(-1), sqRing(MAP_FAILED), sqRingSize(0), cqRing(MAP_FAILED), cqRingSize(0),
+        sqes((io_uring_sqe *)MAP_FAILED), sqesSize(0), sqHead(NULL), sqTail(NULL), sqMask(NULL), sqArray(NULL),
+        sqEntries(0), cqHead(NULL), cqTail(NULL), cqMask(NULL), cqes(NULL), cqEntries(0), features(0), toSubmit(0),
+        inFlight(0)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class IOUringRequest
+// ----------------------------------------------------------------------------
+
+// Like an aiocb, a request must not be moved or destroyed while it is in progress.
+
+struct IOUringRequest
+{
+    enum State { IDLE, IN_PROGRESS, COMPLETED };
+
+    IOUringContext_ *   ring;
+    size_t              nbytes;     // number of bytes to transfer
+    __int64             result;     // number of bytes transferred or -errno
+    State               state;
+
+    IOUringRequest() :
+        ring(NULL), nbytes(0), result(0), state(IDLE)
+    {}
+
+    IOUringRequest(IOUringRequest & other, Move) :
+        ring(other.ring), nbytes(other.nbytes), result(other.result), state(other.state)
+    {}
+
+#ifdef SEQAN_CXX11_STANDARD
+    IOUringRequest(IOUringRequest && other) :
+        ring(other.ring), nbytes(other.nbytes), result(other.result), state(other.state)
+    {}
+#endif
+
+private:
+    IOUringRequest(IOUringRequest const &)
+    {}
+};
+
+template <>
+struct HasMoveConstructor<IOUringRequest> : True {};
+
+// ----------------------------------------------------------------------------
+// Ring Helpers
+// ----------------------------------------------------------------------------
+
+inline int _ioUringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags, void * arg, size_t argSize)
+{
+    return (int)::syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, arg, argSize);
+}
+
+inline void _ioUringDestroy(IOUringContext_ * ring)
+{
+    if (ring->sqes != MAP_FAILED)
+        ::munmap(ring->sqes, ring->sqesSize);
+    if (ring->cqRing != MAP_FAILED && ring->cqRing != ring->sqRing)
+        ::munmap(ring->cqRing, ring->cqRingSize);
+    if (ring->sqRing != MAP_FAILED)
+        ::munmap(ring->sqRing, ring->sqRingSize);
+    if (ring->ringFd != -1)
+        ::close(ring->ringFd);
+    delete ring;
+}
+
+// Returns NULL if the kernel does not support io_uring or the required operations.
+
+inline IOUringContext_ * _ioUringSetup(unsigned entries)
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    IOUringContext_ * ring = new IOUringContext_;
+    ring->ringFd = (int)::syscall(__NR_io_uring_setup, entries, &params);
+
+    // IORING_OP_READ/WRITE are available since Linux 5.6, we test for a feature of the same release.
+    if (ring->ringFd == -1 || !(params.features & IORING_FEAT_NODROP) || !(params.features & IORING_FEAT_RW_CUR_POS))
+    {
+        _ioUringDestroy(ring);
+        return NULL;
+    }
+    ring->features = params.features;
+
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        ring->sqRingSize = ring->cqRingSize = std::max(ring->sqRingSize, ring->cqRingSize);
+
+    ring->sqRing = ::mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ringFd,
+                          IORING_OFF_SQ_RING);
+    if (ring->sqRing == MAP_FAILED)
+    {
+        _ioUringDestroy(ring);
+        return NULL;
+    }
+
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        ring->cqRing = ring->sqRing;
+    else
+        ring->cqRing = ::mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                              ring->ringFd, IORING_OFF_CQ_RING);
+
+    ring->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    ring->sqes = (io_uring_sqe *)::mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                        ring->ringFd, IORING_OFF_SQES);
+    if (ring->cqRing == MAP_FAILED || ring->sqes == MAP_FAILED)
+    {
+        _ioUringDestroy(ring);
+        return NULL;
+    }
+
+    char * sq = (char *)ring->sqRing;
+    ring->sqHead = (unsigned *)(sq + params.sq_off.head);
+    ring->sqTail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sqMask = (unsigned *)(sq + params.sq_off.ring_mask);
+    ring->sqArray = (unsigned *)(sq + params.sq_off.array);
+    ring->sqEntries = params.sq_entries;
+
+    char * cq = (char *)ring->cqRing;
+    ring->cqHead = (unsigned *)(cq + params.cq_off.head);
+    ring->cqTail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cqMask = (unsigned *)(cq + params.cq_off.ring_mask);
+    ring->cqes = (io_uring_cqe *)(cq + params.cq_off.cqes);
+    ring->cqEntries = params.cq_entries;
+    return ring;
+}
+
+// Pass all prepared entries to the kernel and optionally wait for minComplete completions.
+
+inline bool _ioUringSubmit(IOUringContext_ * ring, unsigned minComplete)
+{
+    unsigned flags = (minComplete != 0) ? IORING_ENTER_GETEVENTS : 0;
+    while (ring->toSubmit != 0 || minComplete != 0)
+    {
+        int result = _ioUringEnter(ring->ringFd, ring->toSubmit, minComplete, flags, NULL, 0);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        ring->toSubmit -= result;
+        ring->inFlight += result;
+        if (ring->toSubmit == 0)
+            break;
+    }
+    return true;
+}
+
+// Move all available completions into their requests.  Returns the number of completions.
+
+inline unsigned _ioUringReap(IOUringContext_ * ring)
+{
+    unsigned head = *ring->cqHead;
+    unsigned tail = __atomic_load_n(ring->cqTail, __ATOMIC_ACQUIRE);
+    unsigned count = tail - head;
+
+    for (; head != tail; ++head)
+    {
+        io_uring_cqe const & cqe = ring->cqes[head & *ring->cqMask];
+        IOUringRequest * request = reinterpret_cast<IOUringRequest *>(cqe.user_data);
+        if (request != NULL)    // cancel requests have no IOUringRequest
+        {
+            request->result = cqe.res;
+            request->state = IOUringRequest::COMPLETED;
+        }
+    }
+    __atomic_store_n(ring->cqHead, tail, __ATOMIC_RELEASE);
+    ring->inFlight -= count;
+    return count;
+}
+
+// Wait until at least one request has completed.
+
+inline bool _ioUringWaitAny(IOUringContext_ * ring)
+{
+    if (_ioUringReap(ring) != 0)
+        return true;
+    if (!_ioUringSubmit(ring, 1))
+        return false;
+    _ioUringReap(ring);
+    return true;
+}
+
+// Wait until all submitted requests have completed.
+
+inline bool _ioUringWaitAll(IOUringContext_ * ring)
+{
+    if (!_ioUringSubmit(ring, 0))
+        return false;
+    while (ring->inFlight != 0)
+        if (!_ioUringWaitAny(ring))
+            return false;
+    return true;
+}
+
+// Return a free submission queue entry, which is passed to the kernel with the next _ioUringSubmit().
+
+inline io_uring_sqe * _ioUringGetSqe(IOUringContext_ * ring)
+{
+    // Keep the number of outstanding requests below the completion queue size.
+    while (ring->inFlight + ring->toSubmit >= ring->cqEntries)
+        if (!_ioUringWaitAny(ring))
+            return NULL;
+
+    unsigned tail = *ring->sqTail;
+    while (tail - __atomic_load_n(ring->sqHead, __ATOMIC_ACQUIRE) >= ring->sqEntries)
+        if (!_ioUringSubmit(ring, 0) || (ring->toSubmit != 0 && !_ioUringWaitAny(ring)))
+            return NULL;
+
+    unsigned index = tail & *ring->sqMask;
+    io_uring_sqe * sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(io_uring_sqe));
+    ring->sqArray[index] = index;
+    __atomic_store_n(ring->sqTail, tail + 1, __ATOMIC_RELEASE);
+    ++ring->toSubmit;
+    return sqe;
+}
+
+// Returns the index of the registered buffer containing [ptr, ptr + size) or -1.
+
+inline int _ioUringFixedBuffer(IOUringContext_ const * ring, void const * ptr, size_t size)
+{
+    char const * begin = (char const *)ptr;
+    for (unsigned i = 0; i < ring->fixedBuffers.size(); ++i)
+    {
+        char const * bufBegin = (char const *)ring->fixedBuffers[i].iov_base;
+        if (bufBegin <= begin && begin + size <= bufBegin + ring->fixedBuffers[i].iov_len)
+            return i;
+    }
+    return -1;
+}
+
+// ----------------------------------------------------------------------------
+// Class File<Async<IOUring> >
+// ----------------------------------------------------------------------------
+
+template <>
+class File<Async<IOUring> > : public File<Async<> >
+{
+public:
+    typedef File<Async<> >  Base;
+
+    IOUringContext_ *   ring;
+    unsigned            queueDepth;         // number of submission queue entries
+    unsigned            submitBatchSize;    // number of requests collected before they are submitted
+    bool                directIO;           // use O_DIRECT for aligned requests
+
+    File(void * = NULL) :   // to be compatible with the FILE*(NULL) constructor
+        ring(NULL), queueDepth(SEQAN_IOURING_QUEUE_DEPTH), submitBatchSize(1), directIO(false)
+    {}
+
+    virtual ~File() {}
+
+    virtual bool open(char const * fileName, int openMode = DefaultOpenMode<File>::VALUE)
+    {
+        if (!Base::open(fileName, openMode))
+            return false;
+
+        if (directIO && handleAsync == handle)
+        {
+            Handle directHandle = ::open(fileName, (_getOFlag(openMode) & ~(O_CREAT | O_TRUNC)) | O_DIRECT);
+            if (directHandle != -1)
+                handleAsync = directHandle;
+#if SEQAN_ENABLE_DEBUG || SEQAN_ENABLE_TESTING
+            else if (!(openMode & OPEN_QUIET))
+                std::cerr << "Warning: Direct access openening failed. \"" << ::strerror(errno) << '"' << std::endl;
+#endif
+        }
+
+        ring = _ioUringSetup(queueDepth);
+#if SEQAN_ENABLE_DEBUG || SEQAN_ENABLE_TESTING
+        if (ring == NULL && !(openMode & OPEN_QUIET))
+            std::cerr << "Warning: io_uring is not supported, falling back to synchronous I/O." << std::endl;
+#endif
+        return true;
+    }
+
+    virtual bool close()
+    {
+        bool result = true;
+        if (ring != NULL)
+        {
+            result &= _ioUringWaitAll(ring);
+            _ioUringDestroy(ring);
+            ring = NULL;
+        }
+        result &= Base::close();
+        return result;
+    }
+};
+
+template <>
+struct AsyncRequest<File<Async<IOUring> > >
+{
+    typedef IOUringRequest Type;
+};
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function asyncReadAt() / asyncWriteAt()
+// ----------------------------------------------------------------------------
+
+inline bool _asyncTransferAt(File<Async<IOUring> > & me, void * memPtr, size_t nbytes, __int64 fileOfs,
+                             IOUringRequest & request, bool isWrite)
+{
+    SEQAN_PROADD(SEQAN_PROIO, (nbytes + SEQAN_PROPAGESIZE - 1) / SEQAN_PROPAGESIZE);
+
+    request.ring = me.ring;
+    request.nbytes = nbytes;
+    request.result = 0;
+    request.state = IOUringRequest::COMPLETED;
+    if (nbytes == 0)
+        return true;
+
+    io_uring_sqe * sqe = (me.ring != NULL) ? _ioUringGetSqe(me.ring) : NULL;
+    if (sqe == NULL)
+    {
+        // Transfer synchronously instead.
+        request.result = isWrite ? ::pwrite(me.handle, memPtr, nbytes, fileOfs) : ::pread(me.handle, memPtr, nbytes, fileOfs);
+        if (request.result < 0)
+            request.result = -errno;
+        return request.result == (__int64)nbytes;
+    }
+
+    // O_DIRECT requires aligned buffers, offsets and sizes.
+    const size_t DIRECT_ALIGNMENT = 4096;
+    bool aligned = (((size_t)memPtr | (size_t)fileOfs | nbytes) & (DIRECT_ALIGNMENT - 1)) == 0;
+
+    int fixedBuffer = _ioUringFixedBuffer(me.ring, memPtr, nbytes);
+    if (fixedBuffer != -1)
+    {
+        sqe->opcode = isWrite ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe->buf_index = fixedBuffer;
+    }
+    else
+    {
+        sqe->opcode = isWrite ? IORING_OP_WRITE : IORING_OP_READ;
+    }
+    sqe->fd = aligned ? me.handleAsync : me.handle;
+    sqe->addr = (__u64)(size_t)memPtr;
+    sqe->len = nbytes;
+    sqe->off = fileOfs;
+    sqe->user_data = (__u64)(size_t)&request;
+    request.state = IOUringRequest::IN_PROGRESS;
+
+    if (me.ring->toSubmit >= me.submitBatchSize)
+        return _ioUringSubmit(me.ring, 0);
+    return true;
+}
+
+template <typename TValue, typename TSize, typename TPos>
+inline bool
+asyncReadAt(File<Async<IOUring> > & me, TValue * memPtr, TSize const count, TPos const fileOfs,
+            IOUringRequest & request)
+{
+    return _asyncTransferAt(me, memPtr, count * sizeof(TValue), (__int64)fileOfs * sizeof(TValue), request, false);
+}
+
+template <typename TValue, typename TSize, typename TPos>
+inline bool
+asyncWriteAt(File<Async<IOUring> > & me, TValue const * memPtr, TSize const count, TPos const fileOfs,
+             IOUringRequest & request)
+{
+    return _asyncTransferAt(me, const_cast<TValue *>(memPtr), count * sizeof(TValue),
+                            (__int64)fileOfs * sizeof(TValue), request, true);
+}
+
+// ----------------------------------------------------------------------------
+// Function waitFor()
+// ----------------------------------------------------------------------------
+
+inline bool waitFor(IOUringRequest & request)
+{
+    SEQAN_PROTIMESTART(tw);
+    if (request.state == IOUringRequest::IN_PROGRESS && !_ioUringSubmit(request.ring, 0))
+        return false;
+    while (request.state == IOUringRequest::IN_PROGRESS)
+        if (!_ioUringWaitAny(request.ring))
+            return false;
+    SEQAN_PROADD(SEQAN_PROCWAIT, SEQAN_PROTIMEDIFF(tw));
+
+    if (request.result != (__int64)request.nbytes)
+    {
+        errno = (request.result < 0) ? (int)-request.result : EIO;
+        std::cerr << "Asynchronous I/O operation failed (waitFor): \"" << ::strerror(errno) << '"' << std::endl;
+        return false;
+    }
+    return true;
+}
+
+inline bool waitFor(IOUringRequest & request, long timeoutMilliSec, bool & inProgress)
+{
+    if (request.state == IOUringRequest::IN_PROGRESS)
+    {
+        IOUringContext_ * ring = request.ring;
+        if (!_ioUringSubmit(ring, 0))
+            return false;
+        _ioUringReap(ring);
+
+        if (request.state == IOUringRequest::IN_PROGRESS && timeoutMilliSec != 0)
+        {
+            SEQAN_PROTIMESTART(tw);
+#ifdef IORING_ENTER_EXT_ARG
+            if (ring->features & IORING_FEAT_EXT_ARG)
+            {
+                __kernel_timespec ts;
+                ts.tv_sec = timeoutMilliSec / 1000;
+                ts.tv_nsec = (timeoutMilliSec % 1000) * 1000000;
+                io_uring_getevents_arg arg;
+                memset(&arg, 0, sizeof(arg));
+                arg.ts = (__u64)(size_t)&ts;
+                // Fails with ETIME if no request completes in time.
+                _ioUringEnter(ring->ringFd, 0, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+                _ioUringReap(ring);
+            }
+            else
+#endif
+            // Without timeouts, wait for any completion.  File transfers never block indefinitely.
+            if (!_ioUringWaitAny(ring))
+                return false;
+            SEQAN_PROADD(SEQAN_PROCWAIT, SEQAN_PROTIMEDIFF(tw));
+        }
+    }
+
+    inProgress = (request.state == IOUringRequest::IN_PROGRESS);
+    if (inProgress)
+        return true;
+    return waitFor(request);
+}
+
+// ----------------------------------------------------------------------------
+// Function cancel()
+// ----------------------------------------------------------------------------
+
+inline bool cancel(File<Async<IOUring> > & me, IOUringRequest & request)
+{
+    if (request.state != IOUringRequest::IN_PROGRESS)
+        return true;
+
+    // The request can only be cancelled after it has been submitted.
+    IOUringContext_ * ring = me.ring;
+    if (!_ioUringSubmit(ring, 0))
+        return false;
+    _ioUringReap(ring);
+    if (request.state != IOUringRequest::IN_PROGRESS)
+        return true;
+
+    io_uring_sqe * sqe = _ioUringGetSqe(ring);
+    if (sqe != NULL)
+    {
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->addr = (__u64)(size_t)&request;
+        sqe->user_data = 0;
+        if (!_ioUringSubmit(ring, 0))
+            return false;
+    }
+
+    // Wait for the cancelled (or completed) request, it must not be referenced by the ring afterwards.
+    while (request.state == IOUringRequest::IN_PROGRESS)
+        if (!_ioUringWaitAny(ring))
+            return false;
+    return true;
+}
+
+// ----------------------------------------------------------------------------
+// Function release()
+// ----------------------------------------------------------------------------
+
+inline void release(File<Async<IOUring> > & /*me*/, IOUringRequest const & /*request*/)
+{}
+
+// ----------------------------------------------------------------------------
+// Function error()
+// ----------------------------------------------------------------------------
+
+inline int error(IOUringRequest const & request)
+{
+    if (request.state == IOUringRequest::IN_PROGRESS)
+        return EINPROGRESS;
+    return (request.result < 0) ? (int)-request.result : 0;
+}
+
+inline int _returnValue(IOUringRequest & request)
+{
+    return (int)request.result;
+}
+
+// ----------------------------------------------------------------------------
+// Function registerBuffer()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn IOUringFile#registerBuffer
+ * @brief Register a buffer with the kernel for faster transfers.
+ *
+ * @signature bool registerBuffer(file, memPtr, count);
+ *
+ * @param[in,out] file   The open @link IOUringFile @endlink.
+ * @param[in]     memPtr Pointer to the beginning of the buffer.
+ * @param[in]     count  Number of values in the buffer.
+ *
+ * @return bool <tt>true</tt> on success, <tt>false</tt> if the buffer could not be registered.  Unregistered buffers
+ *              can still be used for transfers.
+ *
+ * Waits for all outstanding requests of the file.  The buffer must stay valid until
+ * @link IOUringFile#unregisterBuffers @endlink is called or the file is closed.
+ */
+
+/*!
+ * @fn IOUringFile#unregisterBuffers
+ * @brief Unregister all buffers registered with @link IOUringFile#registerBuffer @endlink.
+ *
+ * @signature bool unregisterBuffers(file);
+ *
+ * @param[in,out] file The open @link IOUringFile @endlink.
+ *
+ * @return bool <tt>true</tt> on success, <tt>false</tt> otherwise.
+ */
+
+inline bool unregisterBuffers(File<Async<IOUring> > & me)
+{
+    IOUringContext_ * ring = me.ring;
+    if (ring == NULL || ring->fixedBuffers.empty())
+        return true;
+    if (!_ioUringWaitAll(ring))
+        return false;
+    ring->fixedBuffers.clear();
+    return ::syscall(__NR_io_uring_register, ring->ringFd, IORING_UNREGISTER_BUFFERS, NULL, 0) == 0;
+}
+
+template <typename TValue, typename TSize>
+inline bool registerBuffer(File<Async<IOUring> > & me, TValue * memPtr, TSize count)
+{
+    IOUringContext_ * ring = me.ring;
+    if (ring == NULL)
+        return false;
+
+    // The kernel only allows to replace the whole table.
+    std::vector<iovec> buffers = ring->fixedBuffers;
+    if (!unregisterBuffers(me))
+        return false;
+
+    iovec buffer;
+    buffer.iov_base = (void *)memPtr;
+    buffer.iov_len = count * sizeof(TValue);
+    buffers.push_back(buffer);
+    if (::syscall(__NR_io_uring_register, ring->ringFd, IORING_REGISTER_BUFFERS, &buffers[0], buffers.size()) != 0)
+    {
+        buffers.pop_back();
+        if (!buffers.empty() &&
+            ::syscall(__NR_io_uring_register, ring->ringFd, IORING_REGISTER_BUFFERS, &buffers[0], buffers.size()) == 0)
+            ring->fixedBuffers.swap(buffers);
+        return false;
+    }
+    ring->fixedBuffers.swap(buffers);
+    return true;
+}
+
+}  // namespace SEQAN_NAMESPACE_MAIN
+
+#endif  // #if SEQAN_HAS_IOURING
+
+#endif  // #ifndef SEQAN_HEADER_FILE_ASYNC_URING_H
@@ -57,6 +57,7 @@
 
 #include <seqan/vcf_io/vcf_io_context.h>
 #include <seqan/vcf_io/read_vcf.h>
+#include <seqan/vcf_io/vcf_record_batch.h>
 #include <seqan/vcf_io/write_vcf.h>
 
 #include <seqan/vcf_io/vcf_file.h>
@@ -174,6 +174,34 @@ readRecord(VcfRecord & record, SmartFile<Vcf, Input, TSpec> & file)
     readRecord(record, context(file), file.iter, file.format);
 }
 
+// ----------------------------------------------------------------------------
+// Function readBatch(); VcfRecordBatch
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfFileIn#readBatch
+ * @brief Read up to <tt>maxRecords</tt> records into a @link VcfRecordBatch @endlink.
+ *
+ * @signature TSize readBatch(batch, vcfFileIn, maxRecords);
+ *
+ * @param[out]    batch      The @link VcfRecordBatch @endlink to read into.
+ * @param[in,out] vcfFileIn  The VcfFileIn to read from.  The header must have been read before.
+ * @param[in]     maxRecords The maximal number of records to read.
+ *
+ * @return TSize The number of records read, 0 at the end of the file.
+ *
+ * The lines are read sequentially, the records are parsed in parallel if OpenMP is enabled.
+ *
+ * @throw ParseError if a record could not be parsed.
+ */
+
+template <typename TSpec, typename TSize>
+inline TSize
+readBatch(VcfRecordBatch & batch, SmartFile<Vcf, Input, TSpec> & file, TSize maxRecords)
+{
+    return readBatch(batch, context(file), file.iter, maxRecords, file.format);
+}
+
 // ----------------------------------------------------------------------------
 // Function writeRecord(); VcfRecord
 // ----------------------------------------------------------------------------
@@ -0,0 +1,503 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Batches of VCF records that are parsed in parallel and keep their fields
+// as ranges of one shared text buffer.
+// ==========================================================================
+
+#ifndef SEQAN_INCLUDE_SEQAN_VCF_IO_VCF_RECORD_BATCH_H_
+#define SEQAN_INCLUDE_SEQAN_VCF_IO_VCF_RECORD_BATCH_H_
+
+namespace seqan {
+
+// ============================================================================
+// Tags, Classes, Enums
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Class LazyVcfRecord
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class LazyVcfRecord
+ * @headerfile <seqan/vcf_io.h>
+ * @brief One record of a @link VcfRecordBatch @endlink.
+ *
+ * @signature class LazyVcfRecord;
+ *
+ * The numeric fields <tt>rID</tt>, <tt>beginPos</tt> and <tt>qual</tt> are parsed like in @link VcfRecord @endlink.
+ * All text fields are stored as (begin, end) positions in the text buffer of the batch and can be accessed with
+ * @link VcfRecordBatch#getId @endlink, @link VcfRecordBatch#getRef @endlink, etc.  The genotype columns are not
+ * split until they are accessed with @link VcfRecordBatch#getGenotypeInfo @endlink.
+ */
+
+class LazyVcfRecord
+{
+public:
+    typedef Pair<size_t> TRange;
+
+    // Numeric id of the reference sequence.
+    __int32 rID;
+    // Position on the reference.
+    __int32 beginPos;
+    // Quality
+    float qual;
+
+    // Ranges of the text fields in the batch buffer.
+    TRange chrom;
+    TRange id;
+    TRange ref;
+    TRange alt;
+    TRange filter;
+    TRange info;
+    TRange format;
+    // All genotype columns, separated by tabs.
+    TRange genotypeInfos;
+
+    LazyVcfRecord() :
+        rID(VcfRecord::INVALID_REFID), beginPos(VcfRecord::INVALID_POS), qual(VcfRecord::MISSING_QUAL()),
+        chrom(0, 0), id(0, 0), ref(0, 0), alt(0, 0), filter(0, 0), info(0, 0), format(0, 0), genotypeInfos(0, 0)
+    {}
+};
+
+// ----------------------------------------------------------------------------
+// Class VcfRecordBatch
+// ----------------------------------------------------------------------------
+
+/*!
+ * @class VcfRecordBatch
+ * @headerfile <seqan/vcf_io.h>
+ * @brief A batch of VCF records read with @link VcfFileIn#readBatch @endlink.
+ *
+ * @signature class VcfRecordBatch;
+ *
+ * The lines of all records are kept in one text buffer.  The records are parsed in parallel and only store the
+ * positions of their fields in this buffer (see @link LazyVcfRecord @endlink).  This avoids to allocate strings for
+ * each field and genotype, which dominates reading VCF files with many samples if only some fields or some samples
+ * are required.
+ *
+ * @section Examples
+ *
+ * @code{.cpp}
+ * VcfFileIn vcfFile("example.vcf");
+ * VcfHeader header;
+ * readRecord(header, vcfFile);
+ *
+ * VcfRecordBatch batch;
+ * while (readBatch(batch, vcfFile, 10000) != 0)
+ *     for (unsigned i = 0; i < length(batch); ++i)
+ *         std::cout << batch[i].beginPos << '\t' << getRef(batch, i) << '\t' << getGenotypeInfo(batch, i, 5) << '\n';
+ * @endcode
+ */
+
+class VcfRecordBatch
+{
+public:
+    // The text of all records, each line terminated by '\n'.
+    CharString text;
+    // The parsed records.
+    String<LazyVcfRecord> records;
+    // The number of samples given in the VCF header.
+    unsigned numSamples;
+
+    VcfRecordBatch() : numSamples(0)
+    {}
+
+    LazyVcfRecord & operator[](size_t pos)
+    {
+        return records[pos];
+    }
+
+    LazyVcfRecord const & operator[](size_t pos) const
+    {
+        return records[pos];
+    }
+};
+
+// ============================================================================
+// Metafunctions
+// ============================================================================
+
+// ============================================================================
+// Functions
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// Function clear()
+// ----------------------------------------------------------------------------
+
+inline void clear(VcfRecordBatch & batch)
+{
+    clear(batch.text);
+    clear(batch.records);
+}
+
+// ----------------------------------------------------------------------------
+// Function length()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfRecordBatch#length
+ * @brief Return the number of records in a VcfRecordBatch.
+ *
+ * @signature size_t length(batch);
+ *
+ * @param[in] batch The VcfRecordBatch to query.
+ *
+ * @return size_t The number of records.
+ */
+
+inline size_t length(VcfRecordBatch const & batch)
+{
+    return length(batch.records);
+}
+
+// ----------------------------------------------------------------------------
+// Function getId(), getRef(), getAlt(), getFilter(), getInfo(), getFormat()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfRecordBatch#getId
+ * @brief Return the text fields of a record in a VcfRecordBatch.
+ *
+ * @signature TInfix getId(batch, i);
+ * @signature TInfix getRef(batch, i);
+ * @signature TInfix getAlt(batch, i);
+ * @signature TInfix getFilter(batch, i);
+ * @signature TInfix getInfo(batch, i);
+ * @signature TInfix getFormat(batch, i);
+ *
+ * @param[in] batch The VcfRecordBatch to query.
+ * @param[in] i     The number of the record in the batch.
+ *
+ * @return TInfix An infix of the batch text (Type: <tt>Infix&lt;CharString const&gt;::Type</tt>).  The FORMAT field
+ *                is empty if the record has no genotype columns.
+ */
+
+inline Infix<CharString const>::Type
+_getField(VcfRecordBatch const & batch, LazyVcfRecord::TRange const & range)
+{
+    return infix(batch.text, range.i1, range.i2);
+}
+
+inline Infix<CharString const>::Type
+getId(VcfRecordBatch const & batch, size_t i)
+{
+    return _getField(batch, batch.records[i].id);
+}
+
+inline Infix<CharString const>::Type
+getRef(VcfRecordBatch const & batch, size_t i)
+{
+    return _getField(batch, batch.records[i].ref);
+}
+
+inline Infix<CharString const>::Type
+getAlt(VcfRecordBatch const & batch, size_t i)
+{
+    return _getField(batch, batch.records[i].alt);
+}
+
+inline Infix<CharString const>::Type
+getFilter(VcfRecordBatch const & batch, size_t i)
+{
+    return _getField(batch, batch.records[i].filter);
+}
+
+inline Infix<CharString const>::Type
+getInfo(VcfRecordBatch const & batch, size_t i)
+{
+    return _getField(batch, batch.records[i].info);
+}
+
+inline Infix<CharString const>::Type
+getFormat(VcfRecordBatch const & batch, size_t i)
+{
+    return _getField(batch, batch.records[i].format);
+}
+
+// ----------------------------------------------------------------------------
+// Function getGenotypeInfo()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfRecordBatch#getGenotypeInfo
+ * @brief Return the genotype column of one sample.
+ *
+ * @signature TInfix getGenotypeInfo(batch, i, sampleId);
+ *
+ * @param[in] batch    The VcfRecordBatch to query.
+ * @param[in] i        The number of the record in the batch.
+ * @param[in] sampleId The number of the sample, as in <tt>sampleNames(context(vcfFile))</tt>.
+ *
+ * @return TInfix An infix of the batch text (Type: <tt>Infix&lt;CharString const&gt;::Type</tt>).
+ *
+ * @throw EmptyFieldError if the column is missing or empty.
+ */
+
+inline Infix<CharString const>::Type
+getGenotypeInfo(VcfRecordBatch const & batch, size_t i, unsigned sampleId)
+{
+    LazyVcfRecord::TRange const & range = batch.records[i].genotypeInfos;
+    char const * textBegin = &batch.text[0];
+    char const * it = textBegin + range.i1;
+    char const * itEnd = textBegin + range.i2;
+
+    // Skip the columns of the previous samples.
+    for (unsigned s = 0; s < sampleId && it != itEnd; ++s)
+    {
+        it = std::find(it, itEnd, '\t');
+        if (it != itEnd)
+            ++it;
+    }
+    char const * fieldEnd = std::find(it, itEnd, '\t');
+
+    if (it == fieldEnd)
+    {
+        char buffer[30];    // == 9 (GENOTYPE_) + 20 (#digits in MIN_INT64) + 1 (trailing zero)
+        sprintf(buffer, "GENOTYPE_%u", sampleId + 1);
+        SEQAN_THROW(EmptyFieldError(buffer));
+    }
+    return infix(batch.text, it - textBegin, fieldEnd - textBegin);
+}
+
+// ----------------------------------------------------------------------------
+// Function assignRecord()
+// ----------------------------------------------------------------------------
+
+/*!
+ * @fn VcfRecordBatch#assignRecord
+ * @brief Copy a record of a VcfRecordBatch into a @link VcfRecord @endlink.
+ *
+ * @signature void assignRecord(record, batch, i);
+ *
+ * @param[out] record The @link VcfRecord @endlink to assign to.
+ * @param[in]  batch  The VcfRecordBatch to read from.
+ * @param[in]  i      The number of the record in the batch.
+ *
+ * @throw EmptyFieldError if a genotype column is missing or empty.
+ */
+
+inline void
+assignRecord(VcfRecord & record, VcfRecordBatch const & batch, size_t i)
+{
+    LazyVcfRecord const & lazyRecord = batch.records[i];
+
+    clear(record);
+    record.rID = lazyRecord.rID;
+    record.beginPos = lazyRecord.beginPos;
+    record.qual = lazyRecord.qual;
+    record.id = getId(batch, i);
+    record.ref = getRef(batch, i);
+    record.alt = getAlt(batch, i);
+    record.filter = getFilter(batch, i);
+    record.info = getInfo(batch, i);
+    record.format = getFormat(batch, i);
+
+    if (empty(record.format))
+        return;
+
+    // Split the genotype columns in one pass instead of rescanning them for each sample.
+    char const * textBegin = &batch.text[0];
+    char const * it = textBegin + lazyRecord.genotypeInfos.i1;
+    char const * itEnd = textBegin + lazyRecord.genotypeInfos.i2;
+    reserve(record.genotypeInfos, batch.numSamples, Exact());
+    for (unsigned s = 0; s < batch.numSamples; ++s)
+    {
+        char const * fieldEnd = std::find(it, itEnd, '\t');
+        if (it == fieldEnd)
+        {
+            char buffer[30];    // == 9 (GENOTYPE_) + 20 (#digits in MIN_INT64) + 1 (trailing zero)
+            sprintf(buffer, "GENOTYPE_%u", s + 1);
+            SEQAN_THROW(EmptyFieldError(buffer));
+        }
+        appendValue(record.genotypeInfos, infix(batch.text, it - textBegin, fieldEnd - textBegin));
+        it = (fieldEnd != itEnd) ? fieldEnd + 1 : fieldEnd;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Function _parseLazyVcfRecord()
+// ----------------------------------------------------------------------------
+
+// Store the range of the next field in range, move it behind the following tab.  Returns false at the end of line.
+
+inline bool
+_vcfNextField(LazyVcfRecord::TRange & range, char const * & it, char const * lineEnd, char const * textBegin)
+{
+    char const * fieldEnd = std::find(it, lineEnd, '\t');
+    range.i1 = it - textBegin;
+    range.i2 = fieldEnd - textBegin;
+    it = fieldEnd;
+    if (it == lineEnd)
+        return false;
+    ++it;
+    return true;
+}
+
+inline void
+_vcfNextMandatoryField(LazyVcfRecord::TRange & range, char const * & it, char const * lineEnd,
+                       char const * textBegin, char const * fieldName)
+{
+    if (!_vcfNextField(range, it, lineEnd, textBegin))
+        SEQAN_THROW(ParseError(std::string("Unexpected end of line before ") + fieldName + " field."));
+    if (range.i1 == range.i2)
+        SEQAN_THROW(EmptyFieldError(fieldName));
+}
+
+// Parse the line [lineBegin, lineEnd) of the batch text, except the CHROM name lookup.
+
+inline void
+_parseLazyVcfRecord(LazyVcfRecord & record, VcfRecordBatch const & batch, size_t lineBegin, size_t lineEnd)
+{
+    char const * textBegin = &batch.text[0];
+    char const * it = textBegin + lineBegin;
+    char const * itEnd = textBegin + lineEnd;
+
+    _vcfNextMandatoryField(record.chrom, it, itEnd, textBegin, "CHROM");
+
+    LazyVcfRecord::TRange pos;
+    _vcfNextMandatoryField(pos, it, itEnd, textBegin, "POS");
+    record.beginPos = lexicalCast<__int32>(infix(batch.text, pos.i1, pos.i2)) - 1;  // Translate from 1-based to 0-based.
+
+    _vcfNextMandatoryField(record.id, it, itEnd, textBegin, "ID");
+    _vcfNextMandatoryField(record.ref, it, itEnd, textBegin, "REF");
+    _vcfNextMandatoryField(record.alt, it, itEnd, textBegin, "ALT");
+
+    LazyVcfRecord::TRange qual;
+    _vcfNextMandatoryField(qual, it, itEnd, textBegin, "QUAL");
+    if (qual.i2 - qual.i1 == 1 && textBegin[qual.i1] == '.')
+    {
+        record.qual = VcfRecord::MISSING_QUAL();
+    }
+    else
+    {
+        // The field is followed by a tab, so strtod() stops at its end.
+        char * qualEnd;
+        record.qual = (float)strtod(textBegin + qual.i1, &qualEnd);
+        if (qualEnd != textBegin + qual.i2)
+            SEQAN_THROW(BadLexicalCast(record.qual, infix(batch.text, qual.i1, qual.i2)));
+    }
+
+    _vcfNextMandatoryField(record.filter, it, itEnd, textBegin, "FILTER");
+
+    // INFO, the following columns are optional
+    bool hasFormat = _vcfNextField(record.info, it, itEnd, textBegin);
+    if (record.info.i1 == record.info.i2)
+        SEQAN_THROW(EmptyFieldError("INFO"));
+    if (!hasFormat)
+    {
+        record.format.i1 = record.format.i2 = record.genotypeInfos.i1 = record.genotypeInfos.i2 = lineEnd;
+        return;
+    }
+
+    // FORMAT
+    _vcfNextField(record.format, it, itEnd, textBegin);
+    if (record.format.i1 == record.format.i2)
+        SEQAN_THROW(EmptyFieldError("FORMAT"));
+
+    // The genotype columns are split on access.
+    record.genotypeInfos.i1 = it - textBegin;
+    record.genotypeInfos.i2 = lineEnd;
+}
+
+// ----------------------------------------------------------------------------
+// Function readBatch()
+// ----------------------------------------------------------------------------
+
+template <typename TForwardIter, typename TNameStore, typename TNameStoreCache, typename TStorageSpec, typename TSize>
+inline TSize
+readBatch(VcfRecordBatch & batch,
+          VcfIOContext<TNameStore, TNameStoreCache, TStorageSpec> & context,
+          TForwardIter & iter,
+          TSize maxRecords,
+          Vcf const & /*tag*/)
+{
+    clear(batch);
+    batch.numSamples = length(sampleNames(context));
+
+    // Copy whole lines into the batch text, this is the only sequential part.
+    String<size_t> lineEnds;
+    while ((TSize)length(lineEnds) < maxRecords && !atEnd(iter))
+    {
+        size_t lineBegin = length(batch.text);
+        readUntil(batch.text, iter, IsNewline());
+        skipLine(iter);
+        if (length(batch.text) != lineBegin && back(batch.text) == '\r')
+            eraseBack(batch.text);
+        if (length(batch.text) == lineBegin)
+            continue;   // skip empty lines
+        appendValue(lineEnds, length(batch.text));
+        appendValue(batch.text, '\n');
+    }
+
+    TSize numRecords = length(lineEnds);
+    resize(batch.records, numRecords, Exact());
+
+    // Parse the records in parallel and remember the first failure.
+    TSize firstError = numRecords;
+    SEQAN_OMP_PRAGMA(parallel for schedule(dynamic, 64))
+    for (int i = 0; i < (int)numRecords; ++i)
+    {
+        try
+        {
+            _parseLazyVcfRecord(batch.records[i], batch, (i == 0) ? 0 : lineEnds[i - 1] + 1, lineEnds[i]);
+        }
+        catch (...)
+        {
+            SEQAN_OMP_PRAGMA(critical (vcfBatchError))
+            firstError = std::min(firstError, (TSize)i);
+        }
+    }
+
+    // Exceptions must not leave the parallel region, parse the record again to throw it here.
+    if (firstError != numRecords)
+        _parseLazyVcfRecord(batch.records[firstError], batch,
+                            (firstError == 0) ? 0 : lineEnds[firstError - 1] + 1, lineEnds[firstError]);
+
+    // The name store cache is not thread-safe, look up contig names sequentially.  Subsequent records usually share
+    // the same contig, which makes most lookups a single comparison.
+    for (TSize i = 0; i < numRecords; ++i)
+    {
+        LazyVcfRecord & record = batch.records[i];
+        Infix<CharString const>::Type chrom = _getField(batch, record.chrom);
+        if (i != 0 && chrom == _getField(batch, batch.records[i - 1].chrom))
+            record.rID = batch.records[i - 1].rID;
+        else
+            record.rID = nameToId(contigNamesCache(context), chrom);
+    }
+
+    return numRecords;
+}
+
+}  // namespace seqan
+
+#endif  // #ifndef SEQAN_INCLUDE_SEQAN_VCF_IO_VCF_RECORD_BATCH_H_
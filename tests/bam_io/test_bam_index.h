@@ -39,6 +39,7 @@
 #include <seqan/sequence.h>
 
 #include <seqan/bam_io.h>
+#include <seqan/seq_io.h>
 
 SEQAN_DEFINE_TEST(test_bam_io_bam_index_bai)
 {
@@ -80,4 +81,185 @@ SEQAN_DEFINE_TEST(test_bam_io_bam_index_bai)
     SEQAN_ASSERT_NOT(found);
 }
 
+// Collects (regionId, beginPos) pairs passed by queryRegions().
+
+struct BamIndexQueryCollector_
+{
+    seqan::String<seqan::Pair<unsigned, __int32> > hits;
+
+    void operator()(seqan::BamAlignmentRecord const & record, unsigned regionId)
+    {
+        appendValue(hits, seqan::Pair<unsigned, __int32>(regionId, record.beginPos));
+    }
+};
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_index_bai_query_regions)
+{
+    using namespace seqan;
+
+    CharString baiFilename;
+    append(baiFilename, SEQAN_PATH_TO_ROOT());
+    append(baiFilename, "/tests/bam_io/small.bam.bai");
+
+    BamIndex<Bai> baiIndex;
+    SEQAN_ASSERT(open(baiIndex, toCString(baiFilename)));
+
+    CharString bamFilename;
+    append(bamFilename, SEQAN_PATH_TO_ROOT());
+    append(bamFilename, "/tests/bam_io/small.bam");
+
+    BamFileIn bamFile(toCString(bamFilename));
+
+    BamHeader header;
+    readRecord(header, bamFile);
+
+    // The alignments cover [0, 9), [1, 10), and [2, 11).
+    String<GenomicRegion> regions;
+    resize(regions, 5);
+    regions[0].rID = 0; regions[0].beginPos = 5;   regions[0].endPos = 6;
+    regions[1].rID = 0; regions[1].beginPos = 0;   regions[1].endPos = 1;
+    regions[2].rID = 0; regions[2].beginPos = 10;  regions[2].endPos = 20;
+    regions[3].rID = 0; regions[3].beginPos = 100; regions[3].endPos = 200;
+    regions[4].rID = 0;  // whole reference
+
+    BamIndexQueryCollector_ collector;
+    SEQAN_ASSERT(queryRegions(bamFile, baiIndex, regions, collector));
+
+    std::sort(begin(collector.hits, Standard()), end(collector.hits, Standard()));
+    SEQAN_ASSERT_EQ(length(collector.hits), 8u);
+    SEQAN_ASSERT_EQ(collector.hits[0], (Pair<unsigned, __int32>(0, 0)));
+    SEQAN_ASSERT_EQ(collector.hits[1], (Pair<unsigned, __int32>(0, 1)));
+    SEQAN_ASSERT_EQ(collector.hits[2], (Pair<unsigned, __int32>(0, 2)));
+    SEQAN_ASSERT_EQ(collector.hits[3], (Pair<unsigned, __int32>(1, 0)));
+    SEQAN_ASSERT_EQ(collector.hits[4], (Pair<unsigned, __int32>(2, 2)));
+    SEQAN_ASSERT_EQ(collector.hits[5], (Pair<unsigned, __int32>(4, 0)));
+    SEQAN_ASSERT_EQ(collector.hits[6], (Pair<unsigned, __int32>(4, 1)));
+    SEQAN_ASSERT_EQ(collector.hits[7], (Pair<unsigned, __int32>(4, 2)));
+
+    // Querying an invalid reference fails.
+    regions[3].rID = 1;
+    SEQAN_ASSERT_NOT(queryRegions(bamFile, baiIndex, regions, collector));
+}
+
+inline void
+_testBamIndexBaiEqual(seqan::BamIndex<seqan::Bai> const & lhs, seqan::BamIndex<seqan::Bai> const & rhs)
+{
+    using namespace seqan;
+
+    SEQAN_ASSERT_EQ(getUnalignedCount(lhs), getUnalignedCount(rhs));
+    SEQAN_ASSERT_EQ(length(lhs._binIndices), length(rhs._binIndices));
+    SEQAN_ASSERT_EQ(length(lhs._linearIndices), length(rhs._linearIndices));
+    for (unsigned i = 0; i < length(lhs._binIndices); ++i)
+    {
+        SEQAN_ASSERT(lhs._linearIndices[i] == rhs._linearIndices[i]);
+        SEQAN_ASSERT_EQ(lhs._binIndices[i].size(), rhs._binIndices[i].size());
+
+        typedef BamIndex<Bai>::TBinIndex_::const_iterator TIter;
+        for (TIter it = lhs._binIndices[i].begin(); it != lhs._binIndices[i].end(); ++it)
+        {
+            TIter it2 = rhs._binIndices[i].find(it->first);
+            SEQAN_ASSERT(it2 != rhs._binIndices[i].end());
+            SEQAN_ASSERT(it->second.chunkBegEnds == it2->second.chunkBegEnds);
+        }
+    }
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_index_bai_build)
+{
+    using namespace seqan;
+
+    CharString baiFilename;
+    append(baiFilename, SEQAN_PATH_TO_ROOT());
+    append(baiFilename, "/tests/bam_io/small.bam.bai");
+
+    BamIndex<Bai> baiIndex;
+    SEQAN_ASSERT(open(baiIndex, toCString(baiFilename)));
+
+    CharString bamFilename;
+    append(bamFilename, SEQAN_PATH_TO_ROOT());
+    append(bamFilename, "/tests/bam_io/small.bam");
+
+    BamFileIn bamFile(toCString(bamFilename));
+
+    BamHeader header;
+    readRecord(header, bamFile);
+
+    // The index built from the BAM file is the same as the one written by samtools.  Only the chunk ends differ as
+    // samtools reports the end of a BGZF block as the begin of the next block.
+    BamIndex<Bai> builtIndex;
+    SEQAN_ASSERT(buildIndex(builtIndex, bamFile));
+
+    SEQAN_ASSERT_EQ(getUnalignedCount(builtIndex), 0u);
+    SEQAN_ASSERT_EQ(length(builtIndex._binIndices), 1u);
+    SEQAN_ASSERT_EQ(builtIndex._binIndices[0].size(), 2u);
+    SEQAN_ASSERT(builtIndex._linearIndices[0] == baiIndex._linearIndices[0]);
+
+    String<Pair<__uint64> > const & chunks = builtIndex._binIndices[0][4681].chunkBegEnds;
+    SEQAN_ASSERT_EQ(length(chunks), 1u);
+    SEQAN_ASSERT_EQ(chunks[0].i1, baiIndex._binIndices[0][4681].chunkBegEnds[0].i1);
+    SEQAN_ASSERT_EQ(chunks[0].i2, 0x0120u);
+
+    String<Pair<__uint64> > const & meta = builtIndex._binIndices[0][37450].chunkBegEnds;
+    SEQAN_ASSERT_EQ(length(meta), 2u);
+    SEQAN_ASSERT_EQ(meta[0].i1, baiIndex._binIndices[0][37450].chunkBegEnds[0].i1);
+    SEQAN_ASSERT_EQ(meta[1], baiIndex._binIndices[0][37450].chunkBegEnds[1]);
+}
+
+SEQAN_DEFINE_TEST(test_bam_io_bam_index_bai_write)
+{
+    using namespace seqan;
+
+    CharString inFilename;
+    append(inFilename, SEQAN_PATH_TO_ROOT());
+    append(inFilename, "/tests/bam_io/ex1.bam");
+    CharString outFilename = SEQAN_TEMP_FILENAME();
+    append(outFilename, ".bam");
+    CharString baiFilename = outFilename;
+    append(baiFilename, ".bai");
+
+    // Copy the sorted BAM file and build the index on the fly.
+    BamIndex<Bai> writtenIndex;
+    {
+        BamFileIn bamFileIn(toCString(inFilename));
+        BamFileOut bamFileOut(bamFileIn, toCString(outFilename));
+
+        BamHeader header;
+        readRecord(header, bamFileIn);
+        writeRecord(bamFileOut, header);
+
+        BamAlignmentRecord record;
+        while (!atEnd(bamFileIn))
+        {
+            readRecord(record, bamFileIn);
+            writeRecord(bamFileOut, record, writtenIndex);
+        }
+        SEQAN_ASSERT(finalizeIndex(writtenIndex, bamFileOut));
+        SEQAN_ASSERT(save(writtenIndex, toCString(baiFilename)));
+    }
+
+    // The saved index equals the one built from the written file.
+    BamIndex<Bai> loadedIndex;
+    SEQAN_ASSERT(open(loadedIndex, toCString(baiFilename)));
+    _testBamIndexBaiEqual(loadedIndex, writtenIndex);
+
+    BamFileIn bamFile(toCString(outFilename));
+    BamHeader header;
+    readRecord(header, bamFile);
+
+    BamIndex<Bai> builtIndex;
+    SEQAN_ASSERT(buildIndex(builtIndex, bamFile));
+    _testBamIndexBaiEqual(builtIndex, writtenIndex);
+    SEQAN_ASSERT_EQ(length(builtIndex._binIndices), 2u);
+
+    // Regions can be queried with the written index.
+    String<GenomicRegion> regions;
+    resize(regions, 2);
+    regions[0].rID = 0; regions[0].beginPos = 100; regions[0].endPos = 200;
+    regions[1].rID = 1; regions[1].beginPos = 1000; regions[1].endPos = 1010;
+
+    BamIndexQueryCollector_ collector;
+    SEQAN_ASSERT(queryRegions(bamFile, writtenIndex, regions, collector));
+    SEQAN_ASSERT_GT(length(collector.hits), 0u);
+}
+
 #endif  // TESTS_BAM_IO_TEST_BAM_INDEX_H_
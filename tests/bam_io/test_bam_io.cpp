@@ -178,6 +178,9 @@ SEQAN_BEGIN_TESTSUITE(test_bam_io)
 
     // Test BAM indices.
     SEQAN_CALL_TEST(test_bam_io_bam_index_bai);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_bai_query_regions);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_bai_build);
+    SEQAN_CALL_TEST(test_bam_io_bam_index_bai_write);
 #endif
 }
 SEQAN_END_TESTSUITE
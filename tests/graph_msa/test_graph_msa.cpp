@@ -60,6 +60,7 @@ SEQAN_BEGIN_TESTSUITE(test_graph_msa)
     SEQAN_CALL_TEST(test_graph_msa_guide_tree_upgma_avg);
     SEQAN_CALL_TEST(test_graph_msa_guide_tree_upgma_min);
     SEQAN_CALL_TEST(test_graph_msa_guide_tree_upgma_max);
+    SEQAN_CALL_TEST(test_graph_msa_guide_tree_mbed);
 
     SEQAN_CALL_TEST(test_distances);
 	SEQAN_CALL_TEST(test_libraries);
@@ -67,6 +68,7 @@ SEQAN_BEGIN_TESTSUITE(test_graph_msa)
 	SEQAN_CALL_TEST(test_triplet_extension);
 	SEQAN_CALL_TEST(test_sop);
 	SEQAN_CALL_TEST(test_progressive);
+	SEQAN_CALL_TEST(test_progressive_threads);
 	SEQAN_CALL_TEST(test_reversable_fragments);	
 }
 SEQAN_END_TESTSUITE
@@ -174,6 +174,92 @@ Test_UpgmaGuideTree(int seed) {
 	}
 }
 
+template<typename TTree>
+void
+Test_CheckBinaryGuideTree(TTree & guideTree, unsigned nseq)
+{
+    using namespace seqan;
+
+    typedef typename Iterator<TTree, BfsIterator>::Type TBfsIterator;
+    typedef typename Iterator<TTree, AdjacencyIterator>::Type TAdjacencyIterator;
+
+    SEQAN_ASSERT_EQ(numVertices(guideTree), 2 * nseq - 1);
+    unsigned visited = 0;
+    for (TBfsIterator itBfs(guideTree, getRoot(guideTree)); !atEnd(itBfs); goNext(itBfs), ++visited)
+    {
+        unsigned children = 0;
+        for (TAdjacencyIterator adjIt(guideTree, *itBfs); !atEnd(adjIt); goNext(adjIt))
+            ++children;
+        // The sequences are the leaves, all inner nodes have two children.
+        SEQAN_ASSERT_EQ(children, (*itBfs < nseq) ? 0u : 2u);
+    }
+    SEQAN_ASSERT_EQ(visited, 2 * nseq - 1);
+}
+
+void Test_GuideTree_Mbed()
+{
+    using namespace seqan;
+
+    typedef String<AminoAcid> TSequence;
+    typedef Graph<Tree<double> > TTree;
+    typedef Iterator<TTree, EdgeIterator>::Type TEdgeIterator;
+
+    // Random sequences, derived from a few ancestors.
+    Rng<MersenneTwister> rng(42);
+    Pdf<Uniform<unsigned> > pdfChar(0, ValueSize<AminoAcid>::VALUE - 2);
+    Pdf<Uniform<unsigned> > pdfAncestor(0, 3);
+    StringSet<TSequence> ancestors;
+    resize(ancestors, 4);
+    for (unsigned i = 0; i < 4; ++i)
+        for (unsigned j = 0; j < 60; ++j)
+            appendValue(ancestors[i], AminoAcid(pickRandomNumber(rng, pdfChar)));
+    StringSet<TSequence> seqSet;
+    for (unsigned i = 0; i < 150; ++i)
+    {
+        TSequence seq = ancestors[pickRandomNumber(rng, pdfAncestor)];
+        for (unsigned j = 0; j < 10; ++j)
+        {
+            Pdf<Uniform<unsigned> > pdfPos(0, length(seq) - 1);
+            seq[pickRandomNumber(rng, pdfPos)] = AminoAcid(pickRandomNumber(rng, pdfChar));
+        }
+        appendValue(seqSet, seq);
+    }
+
+    // A single cluster gives the UPGMA tree of the k-mer distances.
+    StringSet<TSequence> smallSet;
+    for (unsigned i = 0; i < 20; ++i)
+        appendValue(smallSet, seqSet[i]);
+    TTree mbed;
+    mbedTree(smallSet, mbed, 3u, 20u);
+    Test_CheckBinaryGuideTree(mbed, 20);
+
+    String<double> distanceMatrix;
+    getKmerSimilarityMatrix(smallSet, distanceMatrix, 3u, AminoAcid());
+    for (unsigned i = 0; i < length(distanceMatrix); ++i)
+        distanceMatrix[i] = SEQAN_DISTANCE_UNITY - distanceMatrix[i];
+    TTree upgma;
+    upgmaTree(distanceMatrix, upgma, UpgmaAvg());
+    SEQAN_ASSERT_EQ(getRoot(mbed), getRoot(upgma));
+    for (TEdgeIterator itE(upgma); !atEnd(itE); goNext(itE))
+        SEQAN_ASSERT(findEdge(mbed, sourceVertex(itE), targetVertex(itE)) != 0);
+
+    // Small clusters.
+    for (unsigned clusterSize = 1; clusterSize <= 64; clusterSize *= 4)
+    {
+        clear(mbed);
+        mbedTree(seqSet, mbed, 3u, clusterSize);
+        Test_CheckBinaryGuideTree(mbed, length(seqSet));
+    }
+
+    // Trivial cases.
+    resize(smallSet, 2);
+    mbedTree(smallSet, mbed);
+    Test_CheckBinaryGuideTree(mbed, 2);
+    resize(smallSet, 1);
+    mbedTree(smallSet, mbed);
+    Test_CheckBinaryGuideTree(mbed, 1);
+}
+
 SEQAN_DEFINE_TEST(test_graph_msa_guide_tree_neighbour_joining)
 {
     Test_GuideTree_NeighbourJoining();
@@ -203,4 +289,9 @@ SEQAN_DEFINE_TEST(test_graph_msa_guide_tree_upgma_max)
         Test_UpgmaGuideTree<seqan::UpgmaMax>(i);
 }
 
+SEQAN_DEFINE_TEST(test_graph_msa_guide_tree_mbed)
+{
+    Test_GuideTree_Mbed();
+}
+
 #endif  // #ifndef TESTS_TEST_GRAPH_MSA_GUIDE_TREE_H_
@@ -439,6 +439,58 @@ void Test_Progressive() {
 }
 
 
+void Test_ProgressiveThreads() {
+	typedef String<Dna> TSequence;
+	typedef StringSet<TSequence, Owner<> > TSequenceSet;
+	typedef StringSet<TSequence, Dependent<> > TDependentSequenceSet;
+	typedef Graph<Alignment<TDependentSequenceSet, unsigned int> > TGraph;
+
+	// Mutated copies of a random sequence, enough for independent subtrees in the guide tree
+	Rng<MersenneTwister> rng(42);
+	TSequence base;
+	for(unsigned i = 0; i < 60; ++i) appendValue(base, Dna(pickRandomNumber(rng) % 4));
+	TSequenceSet seqSet;
+	for(unsigned k = 0; k < 16; ++k) {
+		TSequence seq;
+		for(unsigned i = 0; i < length(base); ++i) {
+			unsigned r = pickRandomNumber(rng) % 20;
+			if (r == 0) continue;
+			if (r == 1) appendValue(seq, Dna(pickRandomNumber(rng) % 4));
+			else if (r == 2) appendValue(seq, Dna((ordValue(base[i]) + 1) % 4));
+			appendValue(seq, base[i]);
+		}
+		appendValue(seqSet, seq);
+	}
+
+	TGraph g(seqSet);
+	Score<int> score_type = Score<int>(5,-4,-1,-11);
+	String<double> distanceMatrix;
+	String<Fragment<> > matches;
+	String<int> scores;
+	String<unsigned int> pList;
+	selectPairs(seqSet, pList);
+	appendSegmentMatches(stringSet(g), pList, score_type, matches, scores, distanceMatrix, GlobalPairwiseLibrary() );
+	buildAlignmentGraph(matches, scores, g, FractionalScore() );
+	tripletLibraryExtension(g);
+	Graph<Tree<double> > guideTree;
+	njTree(distanceMatrix, guideTree);
+
+	// The alignment must not depend on the number of threads
+	int maxThreads = omp_get_max_threads();
+	String<char> alignMat1;
+	for(int threads = 1; threads <= 8; threads *= 2) {
+		omp_set_num_threads(threads);
+		TGraph gOut(seqSet);
+		progressiveAlignment(g, guideTree, gOut);
+		String<char> alignMat;
+		convertAlignment(gOut, alignMat);
+		if (threads == 1) alignMat1 = alignMat;
+		else SEQAN_ASSERT(alignMat == alignMat1);
+	}
+	omp_set_num_threads(maxThreads);
+}
+
+
 void Test_ReversableFragments() {
 	typedef unsigned int TSize;
 	typedef String<Dna> TSequence;
@@ -491,6 +543,10 @@ SEQAN_DEFINE_TEST(test_progressive)
 {
 	Test_Progressive();
 }
+SEQAN_DEFINE_TEST(test_progressive_threads)
+{
+	Test_ProgressiveThreads();
+}
 SEQAN_DEFINE_TEST(test_reversable_fragments)
 {
 	Test_ReversableFragments();
@@ -321,6 +321,59 @@ SEQAN_DEFINE_TEST(testUngappedQGramIndexMulti)
 }
 
 
+template <typename TIndex, typename TParallelTag>
+void _testQGramIndexParallel(TIndex &refIndex, Tag<TParallelTag> parallelTag)
+{
+    typedef typename Fibre<TIndex, QGramSA>::Type   TSA;
+    typedef typename Value<TSA>::Type               TSAValue;
+
+    TIndex testIndex(indexText(refIndex));
+    resize(indexSA(testIndex), length(indexSA(refIndex)));
+    resize(indexDir(testIndex), length(indexDir(refIndex)));
+    createQGramIndex(testIndex, parallelTag);
+
+    for (unsigned i = 0; i < length(indexDir(refIndex)); ++i)
+        SEQAN_ASSERT_EQ_MSG(dirAt(i, refIndex), dirAt(i, testIndex), "i is %d", i);
+
+    // the order of occurrences within a bucket depends on the thread schedule
+    for (unsigned i = 1; i < length(indexDir(refIndex)); ++i)
+    {
+        String<TSAValue> refBucket = infix(indexSA(refIndex), dirAt(i - 1, refIndex), dirAt(i, refIndex));
+        String<TSAValue> testBucket = infix(indexSA(testIndex), dirAt(i - 1, testIndex), dirAt(i, testIndex));
+        std::sort(begin(refBucket, Standard()), end(refBucket, Standard()));
+        std::sort(begin(testBucket, Standard()), end(testBucket, Standard()));
+        SEQAN_ASSERT_EQ_MSG(refBucket, testBucket, "bucket is %d", i - 1);
+    }
+}
+
+SEQAN_DEFINE_TEST(testUngappedQGramIndexParallel)
+{
+    typedef Shape<Dna, UngappedShape<3> >                   TShape;
+    typedef Index<StringSet<DnaString>, IndexQGram<TShape> > TSetIndex;
+    typedef Index<DnaString, IndexQGram<TShape> >           TIndex;
+
+    StringSet<DnaString> strings;
+    appendValue(strings, "CTGAACCCTAAACCCT");
+    appendValue(strings, "GAAGGAGTGTGTGT");
+    appendValue(strings, "AAAACCCCAAACCCC");
+
+    // with disabled buckets (see _qgramDisableBuckets above)
+    TSetIndex refSetIndex(strings);
+    indexRequire(refSetIndex, QGramSADir());
+    _testQGramIndexParallel(refSetIndex, Serial());
+    _testQGramIndexParallel(refSetIndex, Parallel());
+
+    DnaString text;
+    for (unsigned i = 0; i < 1000; ++i)
+        appendValue(text, Dna((i * 7 + i / 13) % 4));
+
+    TIndex refIndex(text);
+    indexRequire(refIndex, QGramSADir());
+    _testQGramIndexParallel(refIndex, Serial());
+    _testQGramIndexParallel(refIndex, Parallel());
+}
+
+
 //////////////////////////////////////////////////////////////////////////////
 
 SEQAN_DEFINE_TEST(testQGramFind)
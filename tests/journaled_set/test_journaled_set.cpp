@@ -51,5 +51,12 @@ SEQAN_BEGIN_TESTSUITE(test_journaled_set)
     SEQAN_CALL_TEST(test_journaled_set_resize);
     SEQAN_CALL_TEST(test_journaled_set_empty);
     SEQAN_CALL_TEST(test_journaled_set_iterator);
+
+    // Journaled Set join.
+    SEQAN_CALL_TEST(test_journaled_set_join_global_chain_compact);
+    SEQAN_CALL_TEST(test_journaled_set_join_global_chain_manhatten);
+
+    // Journaled Set search.
+    SEQAN_CALL_TEST(test_journaled_set_find);
 }
 SEQAN_END_TESTSUITE
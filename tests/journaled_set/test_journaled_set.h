@@ -40,6 +40,7 @@
 #include <seqan/basic.h>
 #include <seqan/sequence.h>
 #include <seqan/journaled_set.h>
+#include <seqan/random.h>
 
 using namespace seqan;
 
@@ -407,4 +408,169 @@ SEQAN_DEFINE_TEST(test_journaled_set_iterator)
     SEQAN_ASSERT_EQ(&host(*it), &ref);
 }
 
+template <typename TJString, typename TPattern, typename TParallelTag>
+void testJournaledSetFind(StringSet<TJString, Owner<JournaledSet> > const & jSet,
+                          TPattern & pattern,
+                          TParallelTag parallelTag)
+{
+    typedef typename Position<TJString>::Type TPos;
+    typedef Pair<unsigned, TPos> THit;
+
+    String<THit> hits;
+    find(hits, jSet, pattern, parallelTag);
+
+    // Compare with searching each string separately.
+    String<THit> expected;
+    for (unsigned seqNo = 0; seqNo < length(jSet); ++seqNo)
+    {
+        CharString seq = jSet[seqNo];
+        Finder<CharString> finder(seq);
+        while (find(finder, pattern))
+            appendValue(expected, THit(seqNo, endPosition(finder)));
+    }
+
+    SEQAN_ASSERT_GT(length(expected), 0u);
+    SEQAN_ASSERT_EQ(length(hits), length(expected));
+    for (unsigned i = 0; i < length(expected); ++i)
+        SEQAN_ASSERT_EQ(hits[i], expected[i]);
+}
+
+SEQAN_DEFINE_TEST(test_journaled_set_find)
+{
+    typedef String<char, Journaled<Alloc<>, SortedArray > > TJString;
+
+    Rng<MersenneTwister> rng(42);
+    char const * alphabet = "ACGT";
+
+    CharString ref;
+    for (unsigned i = 0; i < 3000; ++i)
+        appendValue(ref, alphabet[pickRandomNumber(rng) % 4]);
+
+    StringSet<TJString, Owner<JournaledSet> > jSet;
+    setHost(jSet, ref);
+    resize(jSet, 8, Exact());
+
+    // Journal random substitutions, insertions and deletions, including edits at both ends of the strings.
+    for (unsigned seqNo = 0; seqNo < 7; ++seqNo)
+    {
+        TJString tmp(ref);
+        for (unsigned i = 0; i < 10 * seqNo; ++i)
+        {
+            unsigned pos = pickRandomNumber(rng) % length(tmp);
+            switch (pickRandomNumber(rng) % 3)
+            {
+                case 0:
+                    assignValue(tmp, pos, alphabet[pickRandomNumber(rng) % 4]);
+                    break;
+                case 1:
+                    insert(tmp, pos, "ACGTT");
+                    break;
+                default:
+                    erase(tmp, pos, std::min(pos + 7, (unsigned)length(tmp)));
+            }
+        }
+        if (seqNo == 6)
+        {
+            erase(tmp, 0, 3);
+            insert(tmp, length(tmp), "GTAC");
+        }
+        assignValue(jSet, seqNo, tmp);
+    }
+
+    // A string that is not journaled against the global reference.
+    CharString other = infix(ref, 500, 1500);
+    assignValue(jSet, 7, other);
+
+    CharString ndl = "ACGTA";
+
+    Pattern<CharString, Horspool> horspool(ndl);
+    testJournaledSetFind(jSet, horspool, Serial());
+    testJournaledSetFind(jSet, horspool, Parallel());
+
+    Pattern<CharString, ShiftAnd> shiftAnd(ndl);
+    testJournaledSetFind(jSet, shiftAnd, Serial());
+    testJournaledSetFind(jSet, shiftAnd, Parallel());
+
+    Pattern<CharString, Myers<> > myers(ndl, -1);
+    testJournaledSetFind(jSet, myers, Serial());
+    testJournaledSetFind(jSet, myers, Parallel());
+
+    CharString longNdl = "ACGTACGTAC";
+    Pattern<CharString, Myers<> > myers2(longNdl, -3);
+    testJournaledSetFind(jSet, myers2, Serial());
+    testJournaledSetFind(jSet, myers2, Parallel());
+}
+
+template <typename TStrategy>
+void testJournaledSetJoinGlobalChain(TStrategy const &)
+{
+    typedef String<Dna, Journaled<Alloc<>, SortedArray > > TJString;
+
+    Rng<MersenneTwister> rng(7);
+
+    DnaString ref;
+    for (unsigned i = 0; i < 5000; ++i)
+        appendValue(ref, Dna(pickRandomNumber(rng) % 4));
+
+    // Sequences with random substitutions, insertions and deletions.
+    String<DnaString> seqs;
+    for (unsigned seqNo = 0; seqNo < 6; ++seqNo)
+    {
+        DnaString seq = ref;
+        for (unsigned i = 0; i < 5 * seqNo; ++i)
+        {
+            unsigned pos = pickRandomNumber(rng) % length(seq);
+            switch (pickRandomNumber(rng) % 3)
+            {
+                case 0:
+                    seq[pos] = Dna((ordValue(seq[pos]) + 1) % 4);
+                    break;
+                case 1:
+                    insert(seq, pos, "ACGTTGCA");
+                    break;
+                default:
+                    erase(seq, pos, std::min(pos + 6, (unsigned)length(seq)));
+            }
+        }
+        appendValue(seqs, seq);
+    }
+    // A sequence not sharing anything with the reference.
+    appendValue(seqs, "ACGTACGTTT");
+
+    JoinConfig<GlobalChain<TStrategy> > joinConfig;
+    setSeedLength(joinConfig, 12);
+
+    StringSet<TJString, Owner<JournaledSet> > jSet;
+    setHost(jSet, ref);
+    for (unsigned seqNo = 0; seqNo < length(seqs); ++seqNo)
+        appendValue(jSet, TJString(seqs[seqNo]));
+    StringSet<TJString, Owner<JournaledSet> > jSetParallel = jSet;
+    setHost(jSetParallel, ref);
+
+    for (unsigned seqNo = 0; seqNo < length(seqs); ++seqNo)
+        join(jSet, seqNo, joinConfig);
+    join(jSetParallel, joinConfig, Parallel());
+
+    for (unsigned seqNo = 0; seqNo < length(seqs); ++seqNo)
+    {
+        SEQAN_ASSERT_EQ(jSet[seqNo], seqs[seqNo]);
+        SEQAN_ASSERT_EQ(&host(jSet[seqNo]), &ref);
+        SEQAN_ASSERT_EQ(jSetParallel[seqNo], seqs[seqNo]);
+        SEQAN_ASSERT_EQ(&host(jSetParallel[seqNo]), &ref);
+        // Each edit contributes at most two entries.
+        if (seqNo + 1 < length(seqs))
+            SEQAN_ASSERT_LEQ(length(jSet[seqNo]._journalEntries), 2 * 5 * seqNo + 1);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_journaled_set_join_global_chain_compact)
+{
+    testJournaledSetJoinGlobalChain(JournaledCompact());
+}
+
+SEQAN_DEFINE_TEST(test_journaled_set_join_global_chain_manhatten)
+{
+    testJournaledSetJoinGlobalChain(JournaledManhatten());
+}
+
 #endif  // TESTS_JOURNALED_SET_TEST_JOURNALED_SET_H_
@@ -47,6 +47,8 @@
 #include "test_parallel_splitting.h"
 #include "test_parallel_algorithms.h"
 #include "test_parallel_queue.h"
+#include "test_parallel_work_stealing.h"
+#include "test_parallel_thread_caching_allocator.h"
 
 SEQAN_BEGIN_TESTSUITE(test_parallel) {
 #if defined(_OPENMP)
@@ -85,6 +87,17 @@ SEQAN_BEGIN_TESTSUITE(test_parallel) {
     SEQAN_CALL_TEST(test_parallel_queue_resize);
     SEQAN_CALL_TEST(test_parallel_queue_non_pod);
 
+    // Tests for work-stealing deque and pool.
+    SEQAN_CALL_TEST(test_parallel_work_stealing_deque_simple);
+    SEQAN_CALL_TEST(test_parallel_work_stealing_deque_non_pod);
+    SEQAN_CALL_TEST(test_parallel_work_stealing_pool);
+
+    // Tests for the thread-caching allocator.
+    SEQAN_CALL_TEST(test_parallel_thread_caching_allocator_size_classes);
+    SEQAN_CALL_TEST(test_parallel_thread_caching_allocator_simple);
+    SEQAN_CALL_TEST(test_parallel_thread_caching_allocator_string);
+    SEQAN_CALL_TEST(test_parallel_thread_caching_allocator_reuse);
+
 #if defined(_OPENMP) || defined(SEQAN_CXX11_STANDARD)
 #ifdef SEQAN_CXX11_STL
     if (std::thread::hardware_concurrency() >= 2u)
@@ -100,6 +113,7 @@ SEQAN_BEGIN_TESTSUITE(test_parallel) {
         SEQAN_CALL_TEST(test_parallel_queue_mpsc_dynamicsize);
         SEQAN_CALL_TEST(test_parallel_queue_mpmc_fixedsize);
         SEQAN_CALL_TEST(test_parallel_queue_mpmc_dynamicsize);
+        SEQAN_CALL_TEST(test_parallel_thread_caching_allocator_threads);
     }
 #endif
 }
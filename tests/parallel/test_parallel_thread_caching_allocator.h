@@ -0,0 +1,215 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2014, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// ==========================================================================
+// Tests for the thread-caching allocator.
+// ==========================================================================
+
+#ifndef TEST_PARALLEL_TEST_PARALLEL_THREAD_CACHING_ALLOCATOR_H_
+#define TEST_PARALLEL_TEST_PARALLEL_THREAD_CACHING_ALLOCATOR_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/parallel.h>
+
+SEQAN_DEFINE_TEST(test_parallel_thread_caching_allocator_size_classes)
+{
+    using namespace seqan;
+
+    SEQAN_ASSERT_EQ(_threadCachingAllocSizeClass(0u), 0u);
+    SEQAN_ASSERT_EQ(_threadCachingAllocSizeClass(16u), 0u);
+    SEQAN_ASSERT_EQ(_threadCachingAllocSizeClass(17u), 1u);
+    SEQAN_ASSERT_EQ(_threadCachingAllocSizeClass(256u), 15u);
+    SEQAN_ASSERT_EQ(_threadCachingAllocSizeClass(257u), 16u);
+    SEQAN_ASSERT_EQ(_threadCachingAllocClassSize(16u), 320u);
+
+    // every size fits into its class and the classes are contiguous
+    for (size_t bytes = 1; bytes <= ThreadCachingAllocator::BLOCKING_LIMIT; ++bytes)
+    {
+        unsigned sizeClass = _threadCachingAllocSizeClass(bytes);
+        SEQAN_ASSERT_LT(sizeClass, (unsigned)ThreadCachingAllocator::CLASS_COUNT);
+        SEQAN_ASSERT_GEQ(_threadCachingAllocClassSize(sizeClass), bytes);
+        if (sizeClass > 0u)
+            SEQAN_ASSERT_LT(_threadCachingAllocClassSize(sizeClass - 1), bytes);
+    }
+}
+
+SEQAN_DEFINE_TEST(test_parallel_thread_caching_allocator_simple)
+{
+    using namespace seqan;
+
+    ThreadCachingAllocator alloc;
+    ThreadCachingAllocStatistics before = allocatorStatistics(alloc);
+
+    // blocks of the same class are recycled by the thread cache
+    int * a = NULL;
+    allocate(alloc, a, 100, TagAllocateUnspecified());
+    for (int i = 0; i < 100; ++i)
+        a[i] = i;
+    SEQAN_ASSERT_EQ(allocatorStatistics(alloc).bytesInUse, before.bytesInUse + 400);
+    deallocate(alloc, a, 100, TagAllocateUnspecified());
+    int * b = NULL;
+    allocate(alloc, b, 100, TagAllocateUnspecified());
+    SEQAN_ASSERT_EQ(a, b);
+    deallocate(alloc, b, 100, TagAllocateUnspecified());
+
+    // large blocks bypass the pool
+    char * c = NULL;
+    allocate(alloc, c, 1000000, TagAllocateUnspecified());
+    c[999999] = 'x';
+    SEQAN_ASSERT_EQ(allocatorStatistics(alloc).bytesInUse, before.bytesInUse + 1000000);
+    deallocate(alloc, c, 1000000, TagAllocateUnspecified());
+
+    // many blocks spill batches to the global pool and come back again
+    String<char *> blocks;
+    for (unsigned i = 0; i < 10000; ++i)
+    {
+        char * block = NULL;
+        allocate(alloc, block, 48, TagAllocateUnspecified());
+        std::memset(block, i & 0xff, 48);
+        appendValue(blocks, block);
+    }
+    for (unsigned i = 0; i < 10000; ++i)
+    {
+        SEQAN_ASSERT_EQ(blocks[i][47], (char)(i & 0xff));
+        deallocate(alloc, blocks[i], 48, TagAllocateUnspecified());
+    }
+
+    ThreadCachingAllocStatistics after = allocatorStatistics(alloc);
+    SEQAN_ASSERT_EQ(after.bytesInUse, before.bytesInUse);
+    SEQAN_ASSERT_GEQ(after.bytesReserved, (__int64)ThreadCachingAllocator::ARENA_SIZE);
+}
+
+SEQAN_DEFINE_TEST(test_parallel_thread_caching_allocator_string)
+{
+    using namespace seqan;
+
+    typedef String<Dna, Alloc<ThreadCachingAlloc<> > > TString;
+    typedef String<Dna5, Alloc<ThreadCachingAlloc<HugePages> > > THugeString;
+
+    __int64 inUse = allocatorStatistics(ThreadCachingAllocator()).bytesInUse;
+    {
+        TString str;
+        for (unsigned i = 0; i < 100000; ++i)
+            appendValue(str, Dna(i % 4));
+        SEQAN_ASSERT_EQ(length(str), 100000u);
+        for (unsigned i = 0; i < 100000; ++i)
+            SEQAN_ASSERT_EQ(str[i], Dna(i % 4));
+
+        TString copy = str;
+        SEQAN_ASSERT(copy == str);
+        SEQAN_ASSERT_GT(allocatorStatistics(ThreadCachingAllocator()).bytesInUse, inUse);
+    }
+    SEQAN_ASSERT_EQ(allocatorStatistics(ThreadCachingAllocator()).bytesInUse, inUse);
+
+    THugeString huge = "ACGTN";
+    append(huge, "NTGCA");
+    SEQAN_ASSERT_EQ(huge, "ACGTNNTGCA");
+    SEQAN_ASSERT_GT(allocatorStatistics(Allocator<ThreadCachingAlloc<HugePages> >()).bytesInUse, 0);
+}
+
+SEQAN_DEFINE_TEST(test_parallel_thread_caching_allocator_threads)
+{
+    using namespace seqan;
+
+    typedef String<char, Alloc<ThreadCachingAlloc<> > > TString;
+
+    ThreadCachingAllocator alloc;
+    ThreadCachingAllocStatistics before = allocatorStatistics(alloc);
+
+    // every thread frees the blocks of its successor
+    int threadCount = omp_get_max_threads();
+    String<String<TString> > strings;
+    resize(strings, threadCount);
+
+    SEQAN_OMP_PRAGMA(parallel num_threads(threadCount))
+    {
+        int threadId = omp_get_thread_num();
+        resize(strings[threadId], 1000);
+        for (unsigned i = 0; i < 1000; ++i)
+            for (unsigned j = 0; j <= i % 200; ++j)
+                appendValue(strings[threadId][i], 'a' + threadId % 26);
+
+        SEQAN_OMP_PRAGMA(barrier)
+
+        String<TString> & other = strings[(threadId + 1) % threadCount];
+        for (unsigned i = 0; i < 1000; ++i)
+        {
+            SEQAN_ASSERT_EQ(length(other[i]), i % 200 + 1);
+            clear(other[i]);
+            shrinkToFit(other[i]);
+        }
+    }
+
+    ThreadCachingAllocStatistics after = allocatorStatistics(alloc);
+    SEQAN_ASSERT_EQ(after.bytesInUse, before.bytesInUse);
+    SEQAN_ASSERT_GT(after.crossThreadFrees, before.crossThreadFrees);
+}
+
+SEQAN_DEFINE_TEST(test_parallel_thread_caching_allocator_reuse)
+{
+    using namespace seqan;
+
+    typedef Allocator<ThreadCachingAlloc<> > TAllocator;
+
+    TAllocator alloc;
+
+    // in every round each thread frees the blocks of its successor, the freed blocks must be reused
+    int const threadCount = 8;
+    String<String<char *> > blocks;
+    resize(blocks, threadCount);
+    __int64 reserved = 0;
+    for (unsigned round = 0; round < 20; ++round)
+    {
+        SEQAN_OMP_PRAGMA(parallel num_threads(threadCount))
+        {
+            int threadId = omp_get_thread_num();
+            resize(blocks[threadId], 4000);
+            for (unsigned i = 0; i < 4000; ++i)
+                allocate(alloc, blocks[threadId][i], 48, TagAllocateUnspecified());
+
+            SEQAN_OMP_PRAGMA(barrier)
+
+            String<char *> & other = blocks[(threadId + 1) % threadCount];
+            for (unsigned i = 0; i < 4000; ++i)
+                deallocate(alloc, other[i], 48, TagAllocateUnspecified());
+        }
+
+        // the caches may keep some blocks, but no thread needs more than one further arena
+        if (round == 1)
+            reserved = allocatorStatistics(alloc).bytesReserved;
+        else if (round > 1)
+            SEQAN_ASSERT_LEQ(allocatorStatistics(alloc).bytesReserved,
+                             reserved + threadCount * (__int64)TAllocator::ARENA_SIZE);
+    }
+}
+
+#endif  // TEST_PARALLEL_TEST_PARALLEL_THREAD_CACHING_ALLOCATOR_H_
@@ -0,0 +1,168 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2014, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// ==========================================================================
+// Tests for the work-stealing deque and pool.
+// ==========================================================================
+
+#ifndef TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
+#define TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
+
+#include <seqan/basic.h>
+#include <seqan/sequence.h>
+#include <seqan/parallel.h>
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_deque_simple)
+{
+    seqan::WorkStealingDeque<int> deque;
+    int x = -1;
+    SEQAN_ASSERT(empty(deque));
+    SEQAN_ASSERT_NOT(tryPopBack(x, deque));
+    SEQAN_ASSERT_NOT(tryPopFront(x, deque));
+
+    // the owner uses the deque as a stack, other threads steal the oldest element
+    appendValue(deque, 3);
+    appendValue(deque, 6);
+    appendValue(deque, 9);
+    SEQAN_ASSERT_EQ(length(deque), 3);
+    SEQAN_ASSERT(tryPopBack(x, deque));
+    SEQAN_ASSERT_EQ(x, 9);
+    SEQAN_ASSERT(tryPopFront(x, deque));
+    SEQAN_ASSERT_EQ(x, 3);
+    SEQAN_ASSERT(tryPopBack(x, deque));
+    SEQAN_ASSERT_EQ(x, 6);
+    SEQAN_ASSERT_NOT(tryPopBack(x, deque));
+    SEQAN_ASSERT_NOT(tryPopFront(x, deque));
+    SEQAN_ASSERT(empty(deque));
+
+    // enforce several capacity upgrades with a wrapped-around ring buffer
+    for (int i = 0; i < 50; ++i)
+        appendValue(deque, i);
+    for (int i = 0; i < 40; ++i)
+    {
+        SEQAN_ASSERT(tryPopFront(x, deque));
+        SEQAN_ASSERT_EQ(x, i);
+    }
+    for (int i = 50; i < 1000; ++i)
+        appendValue(deque, i);
+    SEQAN_ASSERT_EQ(length(deque), 960);
+    for (int i = 40; i < 500; ++i)
+    {
+        SEQAN_ASSERT(tryPopFront(x, deque));
+        SEQAN_ASSERT_EQ(x, i);
+    }
+    for (int i = 999; i >= 500; --i)
+    {
+        SEQAN_ASSERT(tryPopBack(x, deque));
+        SEQAN_ASSERT_EQ(x, i);
+    }
+    SEQAN_ASSERT(empty(deque));
+}
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_deque_non_pod)
+{
+    typedef seqan::CharString TValue;
+
+    seqan::WorkStealingDeque<TValue> deque;
+    for (int i = 0; i < 100; ++i)
+    {
+        TValue y = "al_";
+        y[2] = '0' + i % 10;
+        appendValue(deque, y);
+    }
+
+    TValue x;
+    SEQAN_ASSERT(tryPopFront(x, deque));
+    SEQAN_ASSERT_EQ(x, "al0");
+    SEQAN_ASSERT(tryPopBack(x, deque));
+    SEQAN_ASSERT_EQ(x, "al9");
+
+    // the nodes of removed elements are reused
+    SEQAN_ASSERT(deque.freeNodes != NULL);
+    SEQAN_ASSERT(deque.ownerNodes != NULL);
+    appendValue(deque, TValue("be"));
+    appendValue(deque, TValue("ta"));
+    SEQAN_ASSERT(deque.freeNodes == NULL);
+    SEQAN_ASSERT(deque.ownerNodes == NULL);
+    SEQAN_ASSERT(tryPopBack(x, deque));
+    SEQAN_ASSERT_EQ(x, "ta");
+    SEQAN_ASSERT(tryPopBack(x, deque));
+    SEQAN_ASSERT_EQ(x, "be");
+    SEQAN_ASSERT(tryPopFront(x, deque));
+    SEQAN_ASSERT_EQ(x, "al1");
+    // the remaining elements and free nodes are freed by the destructor
+}
+
+SEQAN_DEFINE_TEST(test_parallel_work_stealing_pool)
+{
+    typedef seqan::Pair<unsigned> TTask;
+
+    unsigned threadCount = omp_get_max_threads();
+    seqan::WorkStealingPool<TTask> pool(threadCount);
+    SEQAN_ASSERT(empty(pool));
+
+    // sum up [0, 100000) with tasks that are split in halves until they have at most 16 elements
+    unsigned volatile pendingTasks = 1;
+    __uint64 volatile sum = 0;
+    unsigned volatile tasksProcessed = 0;
+    pushTask(pool, 0u, TTask(0, 100000));
+
+    SEQAN_OMP_PRAGMA(parallel num_threads(threadCount))
+    {
+        unsigned threadId = omp_get_thread_num();
+        TTask task;
+        while (pendingTasks != 0)
+        {
+            if (!popTask(task, pool, threadId))
+                continue;
+            while (task.i2 - task.i1 > 16)
+            {
+                unsigned mid = task.i1 + (task.i2 - task.i1) / 2;
+                seqan::atomicInc(pendingTasks);
+                pushTask(pool, threadId, TTask(mid, task.i2));
+                task.i2 = mid;
+            }
+            __uint64 localSum = 0;
+            for (unsigned i = task.i1; i < task.i2; ++i)
+                localSum += i;
+            seqan::atomicAdd(sum, localSum);
+            seqan::atomicInc(tasksProcessed);
+            seqan::atomicDec(pendingTasks);
+        }
+    }
+
+    SEQAN_ASSERT_EQ(sum, 100000ull * 99999ull / 2);
+    SEQAN_ASSERT_GEQ(tasksProcessed, 100000u / 16);
+    SEQAN_ASSERT(empty(pool));
+    SEQAN_ASSERT_EQ(length(pool), 0);
+}
+
+#endif  // TEST_PARALLEL_TEST_PARALLEL_WORK_STEALING_H_
@@ -277,9 +277,260 @@ void testSorter(unsigned maxSize = 16*1024*1024) {
 SEQAN_DEFINE_TEST(test_pipe_test_external_string) {
     testExternalString<MMap<> >(MAX_SIZE);
     testExternalString<External<> >(MAX_SIZE);
+#if SEQAN_HAS_IOURING
+    testExternalString<External<ExternalConfig<File<Async<IOUring> > > > >(MAX_SIZE);
+#endif
 }
 
 
+// ---------------------------------------------------------------------------
+// File<Async<IOUring> >, the tests are skipped if the kernel has no io_uring.
+// ---------------------------------------------------------------------------
+
+#if SEQAN_HAS_IOURING
+
+typedef File<Async<IOUring> >                   TIOUringFile;
+typedef AsyncRequest<TIOUringFile>::Type        TIOUringRequest;
+
+const unsigned IOURING_TEST_SIZE = 16 * 1024;   // values per buffer, a multiple of the page size
+
+inline bool openIOUringTestFile(TIOUringFile & file)
+{
+    SEQAN_ASSERT(open(file, SEQAN_TEMP_FILENAME(), OPEN_RDWR | OPEN_CREATE | OPEN_QUIET));
+    if (file.ring != NULL)
+        return true;
+    close(file);
+    return false;
+}
+
+inline void fillIOUringTestBuffer(unsigned * buf, unsigned seed)
+{
+    for (unsigned i = 0; i < IOURING_TEST_SIZE; ++i)
+        buf[i] = i * 7 + seed;
+}
+
+SEQAN_DEFINE_TEST(test_pipe_io_uring_register_buffer)
+{
+    TIOUringFile file;
+    if (!openIOUringTestFile(file))
+        SEQAN_SKIP_TEST;
+
+    unsigned *src, *dst;
+    allocate(file, src, IOURING_TEST_SIZE);
+    allocate(file, dst, IOURING_TEST_SIZE);
+    fillIOUringTestBuffer(src, 1);
+
+    // Transfers from and to registered buffers use the fixed opcodes.
+    SEQAN_ASSERT(registerBuffer(file, src, IOURING_TEST_SIZE));
+    SEQAN_ASSERT(registerBuffer(file, dst, IOURING_TEST_SIZE));
+    SEQAN_ASSERT_EQ(file.ring->fixedBuffers.size(), 2u);
+    SEQAN_ASSERT_EQ(_ioUringFixedBuffer(file.ring, src + 1, 100 * sizeof(unsigned)), 0);
+    SEQAN_ASSERT_EQ(_ioUringFixedBuffer(file.ring, dst, IOURING_TEST_SIZE * sizeof(unsigned)), 1);
+    SEQAN_ASSERT_EQ(_ioUringFixedBuffer(file.ring, dst, (IOURING_TEST_SIZE + 1) * sizeof(unsigned)), -1);
+
+    TIOUringRequest request;
+    SEQAN_ASSERT(asyncWriteAt(file, src, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT(waitFor(request));
+    SEQAN_ASSERT(asyncReadAt(file, dst, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT(waitFor(request));
+    for (unsigned i = 0; i < IOURING_TEST_SIZE; ++i)
+        SEQAN_ASSERT_EQ(dst[i], src[i]);
+
+    SEQAN_ASSERT(unregisterBuffers(file));
+    SEQAN_ASSERT(file.ring->fixedBuffers.empty());
+    SEQAN_ASSERT_EQ(_ioUringFixedBuffer(file.ring, dst, IOURING_TEST_SIZE * sizeof(unsigned)), -1);
+
+    // Unregistered buffers can still be used.
+    memset(dst, 0, IOURING_TEST_SIZE * sizeof(unsigned));
+    SEQAN_ASSERT(asyncReadAt(file, dst, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT(waitFor(request));
+    for (unsigned i = 0; i < IOURING_TEST_SIZE; ++i)
+        SEQAN_ASSERT_EQ(dst[i], src[i]);
+
+    deallocate(file, src, IOURING_TEST_SIZE);
+    deallocate(file, dst, IOURING_TEST_SIZE);
+    close(file);
+}
+
+SEQAN_DEFINE_TEST(test_pipe_io_uring_direct_io)
+{
+    TIOUringFile file;
+    file.directIO = true;
+    if (!openIOUringTestFile(file))
+        SEQAN_SKIP_TEST;
+    if (file.handleAsync == file.handle)    // the file system does not support O_DIRECT
+    {
+        close(file);
+        SEQAN_SKIP_TEST;
+    }
+
+    unsigned *src, *dst;
+    allocate(file, src, IOURING_TEST_SIZE);
+    allocate(file, dst, IOURING_TEST_SIZE);
+    fillIOUringTestBuffer(src, 2);
+
+    // Aligned requests go through the O_DIRECT handle.
+    TIOUringRequest request;
+    SEQAN_ASSERT(asyncWriteAt(file, src, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT(waitFor(request));
+    SEQAN_ASSERT(asyncReadAt(file, dst, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT(waitFor(request));
+    for (unsigned i = 0; i < IOURING_TEST_SIZE; ++i)
+        SEQAN_ASSERT_EQ(dst[i], src[i]);
+
+    // Unaligned requests fall back to the buffered handle and see the same data.
+    memset(dst, 0, IOURING_TEST_SIZE * sizeof(unsigned));
+    SEQAN_ASSERT(asyncReadAt(file, dst + 1, 1000, 3, request));
+    SEQAN_ASSERT(waitFor(request));
+    for (unsigned i = 0; i < 1000; ++i)
+        SEQAN_ASSERT_EQ(dst[i + 1], src[i + 3]);
+    SEQAN_ASSERT(asyncWriteAt(file, src + 5, 10, 1, request));
+    SEQAN_ASSERT(waitFor(request));
+    SEQAN_ASSERT(asyncReadAt(file, dst, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT(waitFor(request));
+    SEQAN_ASSERT_EQ(dst[0], src[0]);
+    for (unsigned i = 1; i < 11; ++i)
+        SEQAN_ASSERT_EQ(dst[i], src[i + 4]);
+    SEQAN_ASSERT_EQ(dst[11], src[11]);
+
+    deallocate(file, src, IOURING_TEST_SIZE);
+    deallocate(file, dst, IOURING_TEST_SIZE);
+    close(file);
+}
+
+SEQAN_DEFINE_TEST(test_pipe_io_uring_submit_batch)
+{
+    TIOUringFile file;
+    file.submitBatchSize = 4;
+    if (!openIOUringTestFile(file))
+        SEQAN_SKIP_TEST;
+
+    const unsigned CHUNK = IOURING_TEST_SIZE / 8;
+    unsigned *src, *dst;
+    allocate(file, src, IOURING_TEST_SIZE);
+    allocate(file, dst, IOURING_TEST_SIZE);
+    fillIOUringTestBuffer(src, 3);
+
+    // Requests are collected until the batch is full.
+    TIOUringRequest requests[5];
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        SEQAN_ASSERT(asyncWriteAt(file, src + i * CHUNK, CHUNK, i * CHUNK, requests[i]));
+        SEQAN_ASSERT_EQ(file.ring->toSubmit, i + 1);
+        SEQAN_ASSERT_EQ(error(requests[i]), EINPROGRESS);
+    }
+    SEQAN_ASSERT(asyncWriteAt(file, src + 3 * CHUNK, CHUNK, 3 * CHUNK, requests[3]));
+    SEQAN_ASSERT_EQ(file.ring->toSubmit, 0u);
+
+    // Waiting for a collected request submits the incomplete batch.
+    SEQAN_ASSERT(asyncWriteAt(file, src + 4 * CHUNK, 4 * CHUNK, 4 * CHUNK, requests[4]));
+    SEQAN_ASSERT_EQ(file.ring->toSubmit, 1u);
+    SEQAN_ASSERT(waitFor(requests[4]));
+    SEQAN_ASSERT_EQ(file.ring->toSubmit, 0u);
+    for (unsigned i = 0; i < 4; ++i)
+        SEQAN_ASSERT(waitFor(requests[i]));
+
+    SEQAN_ASSERT(asyncReadAt(file, dst, IOURING_TEST_SIZE, 0, requests[0]));
+    SEQAN_ASSERT(waitFor(requests[0]));
+    for (unsigned i = 0; i < IOURING_TEST_SIZE; ++i)
+        SEQAN_ASSERT_EQ(dst[i], src[i]);
+
+    deallocate(file, src, IOURING_TEST_SIZE);
+    deallocate(file, dst, IOURING_TEST_SIZE);
+    close(file);
+}
+
+SEQAN_DEFINE_TEST(test_pipe_io_uring_cancel)
+{
+    TIOUringFile file;
+    file.submitBatchSize = 8;
+    if (!openIOUringTestFile(file))
+        SEQAN_SKIP_TEST;
+
+    unsigned *src, *dst;
+    allocate(file, src, IOURING_TEST_SIZE);
+    allocate(file, dst, IOURING_TEST_SIZE);
+    fillIOUringTestBuffer(src, 4);
+
+    TIOUringRequest request;
+    SEQAN_ASSERT(asyncWriteAt(file, src, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT(waitFor(request));
+
+    // A request that has not been submitted yet is either cancelled or completed.
+    SEQAN_ASSERT(asyncReadAt(file, dst, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT_EQ(error(request), EINPROGRESS);
+    SEQAN_ASSERT(cancel(file, request));
+    SEQAN_ASSERT_NEQ(error(request), EINPROGRESS);
+    if (error(request) == 0)
+        for (unsigned i = 0; i < IOURING_TEST_SIZE; ++i)
+            SEQAN_ASSERT_EQ(dst[i], src[i]);
+    else
+        SEQAN_ASSERT_EQ(error(request), ECANCELED);
+    SEQAN_ASSERT_EQ(file.ring->toSubmit, 0u);
+    SEQAN_ASSERT_EQ(file.ring->inFlight, 0u);
+
+    // Cancelling a completed request has no effect.
+    SEQAN_ASSERT(asyncReadAt(file, dst, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT(waitFor(request));
+    SEQAN_ASSERT(cancel(file, request));
+    SEQAN_ASSERT_EQ(error(request), 0);
+
+    // The file is still usable afterwards.
+    memset(dst, 0, IOURING_TEST_SIZE * sizeof(unsigned));
+    SEQAN_ASSERT(asyncReadAt(file, dst, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT(waitFor(request));
+    for (unsigned i = 0; i < IOURING_TEST_SIZE; ++i)
+        SEQAN_ASSERT_EQ(dst[i], src[i]);
+
+    deallocate(file, src, IOURING_TEST_SIZE);
+    deallocate(file, dst, IOURING_TEST_SIZE);
+    close(file);
+}
+
+SEQAN_DEFINE_TEST(test_pipe_io_uring_wait_for_timeout)
+{
+    TIOUringFile file;
+    if (!openIOUringTestFile(file))
+        SEQAN_SKIP_TEST;
+
+    unsigned *src, *dst;
+    allocate(file, src, IOURING_TEST_SIZE);
+    allocate(file, dst, IOURING_TEST_SIZE);
+    fillIOUringTestBuffer(src, 5);
+
+    TIOUringRequest request;
+    bool inProgress = true;
+    SEQAN_ASSERT(asyncWriteAt(file, src, IOURING_TEST_SIZE, 0, request));
+    SEQAN_ASSERT(waitFor(request, 0, inProgress));    // only polls
+    while (inProgress)
+        SEQAN_ASSERT(waitFor(request, 1000, inProgress));
+    SEQAN_ASSERT_EQ(error(request), 0);
+
+    SEQAN_ASSERT(asyncReadAt(file, dst, IOURING_TEST_SIZE, 0, request));
+    for (inProgress = true; inProgress;)
+        SEQAN_ASSERT(waitFor(request, 10, inProgress));
+    for (unsigned i = 0; i < IOURING_TEST_SIZE; ++i)
+        SEQAN_ASSERT_EQ(dst[i], src[i]);
+
+    // A completed request is reported immediately.
+    SEQAN_ASSERT(waitFor(request, 1000, inProgress));
+    SEQAN_ASSERT_NOT(inProgress);
+
+    // A failed request is reported as soon as it completes.
+    SEQAN_ASSERT(asyncReadAt(file, dst, IOURING_TEST_SIZE, 4 * IOURING_TEST_SIZE, request));
+    bool result = true;
+    for (inProgress = true; result && inProgress;)
+        result = waitFor(request, 1000, inProgress);
+    SEQAN_ASSERT_NOT(result);
+
+    deallocate(file, src, IOURING_TEST_SIZE);
+    deallocate(file, dst, IOURING_TEST_SIZE);
+    close(file);
+}
+
+#endif  // #if SEQAN_HAS_IOURING
+
+
 SEQAN_DEFINE_TEST(test_pipe_test_simple_pool) {
     testPool(MAX_SIZE);
 }
@@ -667,6 +918,13 @@ SEQAN_DEFINE_TEST(test_pipe_tupler_multi)
 SEQAN_BEGIN_TESTSUITE(test_pipe) {
 	std::cerr << "";  // This line is an esoteric fix for an even more esoteric crash in MS VC++ 9/10.
     SEQAN_CALL_TEST(test_pipe_test_external_string);
+#if SEQAN_HAS_IOURING
+    SEQAN_CALL_TEST(test_pipe_io_uring_register_buffer);
+    SEQAN_CALL_TEST(test_pipe_io_uring_direct_io);
+    SEQAN_CALL_TEST(test_pipe_io_uring_submit_batch);
+    SEQAN_CALL_TEST(test_pipe_io_uring_cancel);
+    SEQAN_CALL_TEST(test_pipe_io_uring_wait_for_timeout);
+#endif
     SEQAN_CALL_TEST(test_pipe_test_simple_pool);
     SEQAN_CALL_TEST(test_pipe_test_mapper);
     SEQAN_CALL_TEST(test_pipe_test_mapper_partially_filled);
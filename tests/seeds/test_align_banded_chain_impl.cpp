@@ -990,6 +990,134 @@ void testBandedChainAlignmentBandExtension(TGapSpec)
 
     }
 }
+
+// Computes one unbanded grid of the banded chain alignment either along the anti-diagonals or column by column like
+// the generic DP algorithm and returns the trace matrix.
+template <typename TTraceValue, typename TScoutState, typename TSequenceH, typename TSequenceV, typename TDPProfile>
+void _computeBandedChainGrid(seqan::String<TTraceValue> & traces,
+                             seqan::String<unsigned> & maxHostPositions,
+                             int & bestScore,
+                             TScoutState & scoutState,
+                             TSequenceH const & seqH,
+                             TSequenceV const & seqV,
+                             seqan::Score<int, seqan::Simple> const & scoringScheme,
+                             TDPProfile const & dpProfile,
+                             bool antiDiagonal)
+{
+    using namespace seqan;
+
+    typedef DPContext<int, LinearGaps> TDPContext;
+    typedef typename GetDPScoreMatrix<TDPContext>::Type TDPScoreMatrixHost;
+    typedef typename Value<TDPScoreMatrixHost>::Type TDPScoreValue;
+    typedef DPMatrix_<TDPScoreValue, SparseDPMatrix> TDPScoreMatrix;
+    typedef DPMatrix_<TTraceValue, FullDPMatrix> TDPTraceMatrix;
+    typedef DPMatrixNavigator_<TDPScoreMatrix, DPScoreMatrix, NavigateColumnWise> TDPScoreMatrixNavigator;
+    typedef DPMatrixNavigator_<TDPTraceMatrix, DPTraceMatrix<TracebackOn<> >, NavigateColumnWise>
+        TDPTraceMatrixNavigator;
+    typedef typename Iterator<TSequenceH const, Rooted>::Type TSeqHIterator;
+    typedef typename Iterator<TSequenceV const, Rooted>::Type TSeqVIterator;
+
+    TDPContext dpContext;
+    TDPScoreMatrix dpScoreMatrix;
+    TDPTraceMatrix dpTraceMatrix;
+    setLength(dpScoreMatrix, +DPMatrixDimension_::HORIZONTAL, length(seqH) + 1);
+    setLength(dpTraceMatrix, +DPMatrixDimension_::HORIZONTAL, length(seqH) + 1);
+    setLength(dpScoreMatrix, +DPMatrixDimension_::VERTICAL, length(seqV) + 1);
+    setLength(dpTraceMatrix, +DPMatrixDimension_::VERTICAL, length(seqV) + 1);
+    setHost(dpScoreMatrix, getDpScoreMatrix(dpContext));
+    setHost(dpTraceMatrix, getDpTraceMatrix(dpContext));
+    resize(dpScoreMatrix);
+    resize(dpTraceMatrix);
+
+    TDPScoreMatrixNavigator dpScoreMatrixNavigator;
+    TDPTraceMatrixNavigator dpTraceMatrixNavigator;
+    _init(dpScoreMatrixNavigator, dpScoreMatrix, DPBandConfig<BandOff>());
+    _init(dpTraceMatrixNavigator, dpTraceMatrix, DPBandConfig<BandOff>());
+
+    DPScout_<DPCell_<int, LinearGaps>, BandedChainAlignmentScout> dpScout(scoutState);
+    if (antiDiagonal)
+    {
+        _computeUnbandedAlignment(dpScout, dpScoreMatrixNavigator, dpTraceMatrixNavigator, seqH, seqV, scoringScheme,
+                                  dpProfile);
+    }
+    else
+    {
+        TSeqVIterator seqVBegin = begin(seqV, Rooted());
+        TSeqVIterator seqVEnd = end(seqV, Rooted());
+        _computeTrack(dpScout, dpScoreMatrixNavigator, dpTraceMatrixNavigator, value(seqH, 0), value(seqV, 0),
+                      seqVBegin, seqVEnd, scoringScheme, MetaColumnDescriptor<DPInitialColumn, FullColumn>(),
+                      dpProfile);
+        TSeqHIterator seqHIter = begin(seqH, Rooted());
+        for (; seqHIter != end(seqH, Rooted()) - 1; ++seqHIter)
+            _computeTrack(dpScout, dpScoreMatrixNavigator, dpTraceMatrixNavigator, value(seqHIter), value(seqV, 0),
+                          seqVBegin, seqVEnd, scoringScheme, MetaColumnDescriptor<DPInnerColumn, FullColumn>(),
+                          dpProfile);
+        _computeTrack(dpScout, dpScoreMatrixNavigator, dpTraceMatrixNavigator, value(seqHIter), value(seqV, 0),
+                      seqVBegin, seqVEnd, scoringScheme, MetaColumnDescriptor<DPFinalColumn, FullColumn>(),
+                      dpProfile);
+    }
+
+    traces = host(dpTraceMatrix);
+    maxHostPositions = dpScout._maxHostPositions;
+    bestScore = maxScore(dpScout);
+}
+
+// The anti-diagonal computation of the gaps must yield the same trace matrix and the same scores as the column-wise
+// computation.  The scores are compared through the initialization values stored for the next grid, which cover a
+// full row and column of the score matrix for each origin of the next grid.
+void testBandedChainAlignmentAntiDiagonal()
+{
+    using namespace seqan;
+
+    typedef DPCell_<int, LinearGaps> TDPCell;
+    typedef DPScoutState_<BandedChainAlignmentScoutState<TDPCell> > TScoutState;
+    typedef DPProfile_<BandedChainAlignment_<FreeEndGaps_<>, BandedChainInnerDPMatrix>, LinearGaps,
+                       TracebackOn<TracebackConfig_<CompleteTrace, GapsLeft> > > TDPProfile;
+    typedef TraceBitMap_::TTraceValue TTraceValue;
+
+    CharString sequenceH = "NNACGTTGCAGGATTACANN";
+    CharString sequenceV = "NACGATTGCCAGATTAACNNN";
+    Infix<CharString const>::Type seqH = infix(sequenceH, 2, 18);
+    Infix<CharString const>::Type seqV = infix(sequenceV, 1, 18);
+    Score<int, Simple> scoringScheme(2, -1, -2);
+
+    unsigned lengthH = length(seqH);
+    unsigned lengthV = length(seqV);
+    unsigned originsH[] = {0u, 1u, 7u, lengthH};
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        for (unsigned originV = 0; originV <= lengthV; ++originV)
+        {
+            TScoutState scoutState[2];
+            String<TTraceValue> traces[2];
+            String<unsigned> maxHostPositions[2];
+            int maxScore[2];
+            for (unsigned k = 0; k < 2; ++k)
+            {
+                _reinitScoutState(scoutState[k], originsH[i], originV, lengthH + 1, lengthV + 1,
+                                  lengthH + 1 - originsH[i], lengthV + 1 - originV);
+                // Initialization values as left by a preceding anchor.
+                for (unsigned col = 0; col <= lengthH; ++col)
+                    scoutState[k]._horizontalInitCurrentMatrix[col]._score = 3 - 2 * static_cast<int>(col % 5);
+                for (unsigned row = 0; row <= lengthV; ++row)
+                    scoutState[k]._verticalInitCurrentMatrix[row]._score = 3 - 2 * static_cast<int>(row % 4);
+                _computeBandedChainGrid(traces[k], maxHostPositions[k], maxScore[k], scoutState[k], seqH, seqV,
+                                        scoringScheme, TDPProfile(), k == 0);
+            }
+
+            SEQAN_ASSERT(traces[0] == traces[1]);
+            SEQAN_ASSERT_EQ(maxScore[0], maxScore[1]);
+            SEQAN_ASSERT(maxHostPositions[0] == maxHostPositions[1]);
+            for (unsigned col = 0; col <= lengthH - originsH[i]; ++col)
+                SEQAN_ASSERT_EQ(_scoreOfCell(scoutState[0]._horizontalInitNextMatrix[col]),
+                                _scoreOfCell(scoutState[1]._horizontalInitNextMatrix[col]));
+            for (unsigned row = 0; row <= lengthV - originV; ++row)
+                SEQAN_ASSERT_EQ(_scoreOfCell(scoutState[0]._verticalInitNextMatrix[row]),
+                                _scoreOfCell(scoutState[1]._verticalInitNextMatrix[row]));
+        }
+    }
+}
+
 SEQAN_DEFINE_TEST(test_banded_chain_alignment_empty_set_linear)
 {
     testBandedChainAlignmentEmptyChain(seqan::LinearGaps());
@@ -1050,6 +1178,11 @@ SEQAN_DEFINE_TEST(test_banded_chain_alignment_band_extensions_affine)
     testBandedChainAlignmentBandExtension(seqan::AffineGaps());
 }
 
+SEQAN_DEFINE_TEST(test_banded_chain_alignment_anti_diagonal)
+{
+    testBandedChainAlignmentAntiDiagonal();
+}
+
 SEQAN_BEGIN_TESTSUITE(test_banded_chain_impl)
 {
     SEQAN_CALL_TEST(test_banded_chain_alignment_empty_set_linear);
@@ -1064,5 +1197,6 @@ SEQAN_BEGIN_TESTSUITE(test_banded_chain_impl)
     SEQAN_CALL_TEST(test_banded_chain_alignment_special_seeds_affine);
     SEQAN_CALL_TEST(test_banded_chain_alignment_band_extensions_linear);
     SEQAN_CALL_TEST(test_banded_chain_alignment_band_extensions_affine);
+    SEQAN_CALL_TEST(test_banded_chain_alignment_anti_diagonal);
 }
 SEQAN_END_TESTSUITE
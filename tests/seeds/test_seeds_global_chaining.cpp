@@ -37,6 +37,8 @@
 #include <seqan/basic.h>  // Includes testing infrastructure.
 #include <seqan/stream.h>   // Required to print strings in tests.
 
+#include <seqan/random.h>
+
 #include <seqan/seeds.h>  // Include module under test.
 
 
@@ -118,9 +120,222 @@ SEQAN_DEFINE_TEST(test_seeds_global_chaining_sparse_length)
     }
 }
 
+// Test global chaining of the seeds of a DiagonalSorted SeedSet.
+SEQAN_DEFINE_TEST(test_seeds_global_chaining_sparse_length_diagonal_sorted)
+{
+    using namespace seqan;
+
+    typedef SeedSet<Seed<Simple>, DiagonalSorted> TSeedSet;
+    typedef Value<TSeedSet>::Type TSeed;
+    typedef String<TSeed> TSeedChain;
+
+    TSeedSet seedSet;
+    String<TSeed> seeds;
+    appendValue(seeds, TSeed(0, 0, 2));
+    appendValue(seeds, TSeed(3, 5, 2));
+    appendValue(seeds, TSeed(4, 2, 3));
+    appendValue(seeds, TSeed(9, 9, 2));
+    addSeeds(seedSet, seeds, Single());
+
+    TSeedChain result;
+    chainSeedsGlobally(result, seedSet, SparseChaining());
+
+    SEQAN_ASSERT_EQ(3u, length(result));
+    SEQAN_ASSERT_EQ(TSeed(0, 0, 2), result[0]);
+    SEQAN_ASSERT_EQ(TSeed(4, 2, 3), result[1]);
+    SEQAN_ASSERT_EQ(TSeed(9, 9, 2), result[2]);
+}
+
+// Test global chaining with a range maximum structure on the examples of the sparse chaining.
+SEQAN_DEFINE_TEST(test_seeds_global_chaining_range_max_length)
+{
+    using namespace seqan;
+
+    typedef SeedSet<Seed<Simple>, Unordered> TSeedSet;
+    typedef Value<TSeedSet>::Type TSeed;
+    typedef String<TSeed> TSeedChain;
+
+    // Test without seeds.
+    {
+        TSeedSet seedSet;
+
+        TSeedChain result;
+        chainSeedsGlobally(result, seedSet, RangeMaxChaining());
+
+        SEQAN_ASSERT_EQ(0u, length(result));
+    }
+    // Test with two seeds, both are part of the chain.
+    {
+        TSeedSet seedSet;
+        addSeed(seedSet, TSeed(1, 2, 3), Single());
+        addSeed(seedSet, TSeed(4, 5, 6), Single());
+
+        TSeedChain result;
+        chainSeedsGlobally(result, seedSet, RangeMaxChaining());
+
+        SEQAN_ASSERT_EQ(2u, length(result));
+        SEQAN_ASSERT_EQ(TSeed(1, 2, 3), result[0]);
+        SEQAN_ASSERT_EQ(TSeed(4, 5, 6), result[1]);
+    }
+    // A bit larger example.
+    {
+        TSeedSet seedSet;
+        addSeed(seedSet, TSeed(0, 0, 2), Single());
+        addSeed(seedSet, TSeed(3, 5, 2), Single());
+        addSeed(seedSet, TSeed(4, 2, 3), Single());
+        addSeed(seedSet, TSeed(9, 9, 2), Single());
+
+        TSeedChain result;
+        chainSeedsGlobally(result, seedSet, RangeMaxChaining());
+
+        SEQAN_ASSERT_EQ(3u, length(result));
+        SEQAN_ASSERT_EQ(TSeed(0, 0, 2), result[0]);
+        SEQAN_ASSERT_EQ(TSeed(4, 2, 3), result[1]);
+        SEQAN_ASSERT_EQ(TSeed(9, 9, 2), result[2]);
+    }
+    // The seeds are all overlapping here.
+    {
+        TSeedSet seedSet;
+        addSeed(seedSet, TSeed(0, 93, 281, 342), Single());
+        addSeed(seedSet, TSeed(3, 237, 127, 364), Single());
+        addSeed(seedSet, TSeed(3, 284, 86, 368), Single());
+        addSeed(seedSet, TSeed(5, 146, 239, 374), Single());
+
+        TSeedChain result;
+        chainSeedsGlobally(result, seedSet, RangeMaxChaining());
+
+        SEQAN_ASSERT_EQ(1u, length(result));
+        SEQAN_ASSERT_EQ(TSeed(0, 93, 281, 342), result[0]);
+    }
+}
+
+struct LessBeginPositionH
+{
+    template <typename TSeed>
+    bool operator()(TSeed const & a, TSeed const & b) const
+    {
+        return beginPositionH(a) < beginPositionH(b);
+    }
+};
+
+// Compare the quality of the chains from range maximum chaining to the best chain on random seeds.
+SEQAN_DEFINE_TEST(test_seeds_global_chaining_range_max_random)
+{
+    using namespace seqan;
+
+    typedef SeedSet<Seed<Simple>, Unordered> TSeedSet;
+    typedef Value<TSeedSet>::Type TSeed;
+    typedef String<TSeed> TSeedChain;
+
+    Rng<MersenneTwister> rng(42);
+    for (unsigned round = 0; round < 50; ++round)
+    {
+        TSeedSet seedSet;
+        TSeedChain seeds;
+        for (unsigned i = 0; i < 100; ++i)
+        {
+            unsigned beginH = pickRandomNumber(rng) % 1000;
+            unsigned beginV = pickRandomNumber(rng) % 1000;
+            TSeed seed(beginH, beginV, 1 + pickRandomNumber(rng) % 20);
+            addSeed(seedSet, seed, Single());
+            appendValue(seeds, seed);
+        }
+
+        // Quadratic dynamic programming over the seeds sorted by begin position.
+        std::sort(begin(seeds, Standard()), end(seeds, Standard()), LessBeginPositionH());
+        String<unsigned> best;
+        unsigned expectedQuality = 0;
+        for (unsigned i = 0; i < length(seeds); ++i)
+        {
+            appendValue(best, seedSize(seeds[i]));
+            for (unsigned j = 0; j < i; ++j)
+                if (endPositionH(seeds[j]) <= beginPositionH(seeds[i]) &&
+                    endPositionV(seeds[j]) <= beginPositionV(seeds[i]))
+                    best[i] = std::max(best[i], static_cast<unsigned>(best[j] + seedSize(seeds[i])));
+            expectedQuality = std::max(expectedQuality, best[i]);
+        }
+
+        TSeedChain result;
+        chainSeedsGlobally(result, seedSet, RangeMaxChaining());
+
+        unsigned quality = 0;
+        for (unsigned i = 0; i < length(result); ++i)
+            quality += seedSize(result[i]);
+        SEQAN_ASSERT_EQ(expectedQuality, quality);
+
+        for (unsigned i = 1; i < length(result); ++i)
+        {
+            SEQAN_ASSERT_LEQ(endPositionH(result[i - 1]), beginPositionH(result[i]));
+            SEQAN_ASSERT_LEQ(endPositionV(result[i - 1]), beginPositionV(result[i]));
+        }
+    }
+}
+
+// Test global chaining with gap costs.
+SEQAN_DEFINE_TEST(test_seeds_global_chaining_gap_cost)
+{
+    using namespace seqan;
+
+    typedef SeedSet<Seed<Simple>, Unordered> TSeedSet;
+    typedef Value<TSeedSet>::Type TSeed;
+    typedef String<TSeed> TSeedChain;
+
+    TSeedSet seedSet;
+    addSeed(seedSet, TSeed(0, 0, 10), Single());
+    addSeed(seedSet, TSeed(12, 13, 10), Single());
+    addSeed(seedSet, TSeed(25, 40, 4), Single());
+    addSeed(seedSet, TSeed(35, 36, 10), Single());
+
+    // Without gap costs, the chain of maximal total seed size is found, the small seed (25, 40) overlaps (35, 36).
+    {
+        TSeedChain result;
+        chainSeedsGlobally(result, seedSet, 0, 10u, GapCostChaining());
+
+        SEQAN_ASSERT_EQ(3u, length(result));
+        SEQAN_ASSERT_EQ(TSeed(0, 0, 10), result[0]);
+        SEQAN_ASSERT_EQ(TSeed(12, 13, 10), result[1]);
+        SEQAN_ASSERT_EQ(TSeed(35, 36, 10), result[2]);
+    }
+    // The seed far off the diagonal is too expensive with gap costs.
+    {
+        addSeed(seedSet, TSeed(60, 100, 5), Single());
+
+        TSeedChain result;
+        chainSeedsGlobally(result, seedSet, 1, 10u, GapCostChaining());
+
+        SEQAN_ASSERT_EQ(3u, length(result));
+        SEQAN_ASSERT_EQ(TSeed(0, 0, 10), result[0]);
+        SEQAN_ASSERT_EQ(TSeed(12, 13, 10), result[1]);
+        SEQAN_ASSERT_EQ(TSeed(35, 36, 10), result[2]);
+    }
+    // Unsigned gap costs give the same result, the chain scores must not wrap around.
+    {
+        TSeedChain result;
+        chainSeedsGlobally(result, seedSet, 1u, 10u, GapCostChaining());
+
+        SEQAN_ASSERT_EQ(3u, length(result));
+        SEQAN_ASSERT_EQ(TSeed(0, 0, 10), result[0]);
+        SEQAN_ASSERT_EQ(TSeed(12, 13, 10), result[1]);
+        SEQAN_ASSERT_EQ(TSeed(35, 36, 10), result[2]);
+    }
+    // With a lookback of one, only the directly preceding seed can be the predecessor.
+    {
+        TSeedChain result;
+        chainSeedsGlobally(result, seedSet, 1, 1u, GapCostChaining());
+
+        SEQAN_ASSERT_EQ(2u, length(result));
+        SEQAN_ASSERT_EQ(TSeed(0, 0, 10), result[0]);
+        SEQAN_ASSERT_EQ(TSeed(12, 13, 10), result[1]);
+    }
+}
+
 SEQAN_BEGIN_TESTSUITE(test_seeds_global_chaining)
 {
     // Test global chaining of seeds.
     SEQAN_CALL_TEST(test_seeds_global_chaining_sparse_length);
+    SEQAN_CALL_TEST(test_seeds_global_chaining_sparse_length_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_global_chaining_range_max_length);
+    SEQAN_CALL_TEST(test_seeds_global_chaining_range_max_random);
+    SEQAN_CALL_TEST(test_seeds_global_chaining_gap_cost);
 }
 SEQAN_END_TESTSUITE
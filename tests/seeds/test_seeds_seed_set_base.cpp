@@ -1457,6 +1457,274 @@ SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible
     testSeedsSeedSetAddSeedChaosLeftChainingPossibleThresholdReachedScored(ChainedSeed(), Unordered());
 }
 
+// Test container functions for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_container_functions_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetContainerFunctions(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Single) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: No threshold.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_single_no_threshold_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSingleNoThreshold(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Single) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Size threshold, threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_single_threshold_reached_length_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSingleThresholdReachedLength(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Single) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Size threshold, threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_single_threshold_not_reached_length_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSingleThresholdNotReachedLength(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Single) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Size threshold, threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_single_threshold_reached_score_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSingleThresholdReachedScore(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Single) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Size threshold, threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_single_threshold_not_reached_score_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSingleThresholdNotReachedScore(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Merge) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Merging is possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_possible_no_threshold_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedMergeLeftMergingPossibleNoThreshold(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Merge) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is right of added;  Merging is possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_merge_right_merging_possible_no_threshold_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedMergeRightMergingPossibleNoThreshold(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Merge) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Merging is not possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_impossible_no_threshold_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedMergeLeftMergingImpossibleNoThreshold(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Merge) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Merging not possible;  Length quality threshold not reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_possible_threshold_not_reached_length_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedMergeLeftMergingPossibleThresholdNotReachedLength(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Merge) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Merging not possible;  Length quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_possible_threshold_reached_length_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedMergeLeftMergingPossibleThresholdReachedLength(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Merge) for specialization Simple Seed and
+// DiagonalSorted SeedSet.  Seeds have scores.
+//
+// Case: Seed in set is left of added;  Merging is possible;  Quality threshold not reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_possible_threshold_not_reached_scored_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedMergeLeftMergingPossibleThresholdNotReachedScored(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Merge) for specialization Simple Seed and
+// DiagonalSorted SeedSet.  Seeds have scores.
+//
+// Case: Seed in set is left of added;  Merging is possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_possible_threshold_reached_scored_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedMergeLeftMergingPossibleThresholdReachedScored(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., SimpleChain) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Chaining is possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_possible_no_threshold_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSimpleChainLeftChainingPossibleNoThreshold(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., SimpleChain) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is right of added;  Chaining is possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_simple_chain_right_chaining_possible_no_threshold_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSimpleChainRightChainingPossibleNoThreshold(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., SimpleChain) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Chaining is not possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_impossible_no_threshold_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSimpleChainLeftChainingImpossibleNoThreshold(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., SimpleChain) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Chaining not possible;  Length quality threshold not reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_possible_threshold_not_reached_length_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSimpleChainLeftChainingPossibleThresholdNotReachedLength(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., SimpleChain) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Chaining not possible;  Length quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_possible_threshold_reached_length_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSimpleChainLeftChainingPossibleThresholdReachedLength(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., SimpleChain) for specialization Simple Seed and
+// DiagonalSorted SeedSet.  Seeds have scores.
+//
+// Case: Seed in set is left of added;  Chaining is possible;  Quality threshold not reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_possible_threshold_not_reached_scored_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSimpleChainLeftChainingPossibleThresholdNotReachedScored(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., SimpleChain) for specialization Simple Seed and
+// DiagonalSorted SeedSet.  Seeds have scores.
+//
+// Case: Seed in set is left of added;  Chaining is possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_possible_threshold_reached_scored_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedSimpleChainLeftChainingPossibleThresholdReachedScored(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Chaos) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Chaining is possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_no_threshold_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedChaosLeftChainingPossibleNoThreshold(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Chaos) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is right of added;  Chaining is possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_chaos_right_chaining_possible_no_threshold_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedChaosRightChainingPossibleNoThreshold(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Chaos) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Chaining is not possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_impossible_no_threshold_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedChaosLeftChainingImpossibleNoThreshold(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Chaos) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Chaining not possible;  Length quality threshold not reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_not_reached_length_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedChaosLeftChainingPossibleThresholdNotReachedLength(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Chaos) for specialization Simple Seed and
+// DiagonalSorted SeedSet.
+//
+// Case: Seed in set is left of added;  Chaining not possible;  Length quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_reached_length_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedChaosLeftChainingPossibleThresholdReachedLength(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Chaos) for specialization Simple Seed and
+// DiagonalSorted SeedSet.  Seeds have scores.
+//
+// Case: Seed in set is left of added;  Chaining is possible;  Quality threshold not reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_not_reached_scored_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedChaosLeftChainingPossibleThresholdNotReachedScored(Simple(), DiagonalSorted());
+}
+
+// Test addSeed(..., Chaos) for specialization Simple Seed and
+// DiagonalSorted SeedSet.  Seeds have scores.
+//
+// Case: Seed in set is left of added;  Chaining is possible;  Quality threshold reached.
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_reached_scored_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetAddSeedChaosLeftChainingPossibleThresholdReachedScored(Simple(), DiagonalSorted());
+}
+
 template <typename TSeed, typename TSeedSet>
 void testSeedsSeedSetBaseClear()
 {
@@ -1483,6 +1751,12 @@ SEQAN_DEFINE_TEST(test_seeds_seed_set_base_clear_chained)
     testSeedsSeedSetBaseClear<Seed<ChainedSeed, DefaultSeedConfig>, SeedSet<Seed<ChainedSeed, DefaultSeedConfig> > >();
 }
 
+SEQAN_DEFINE_TEST(test_seeds_seed_set_base_clear_simple_diagonal_sorted)
+{
+    using namespace seqan;
+    testSeedsSeedSetBaseClear<Seed<Simple>, SeedSet<Seed<Simple>, DiagonalSorted> >();
+}
+
 SEQAN_BEGIN_TESTSUITE(test_seeds_seed_set_base)
 {
     // Tests for unordered seed sets and simple seeds.
@@ -1551,5 +1825,36 @@ SEQAN_BEGIN_TESTSUITE(test_seeds_seed_set_base)
     SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_reached_length_chained_unordered);
     SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_not_reached_scored_chained_unordered);
     SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_reached_scored_chained_unordered);
+
+    // Tests for diagonal sorted seed sets and simple seeds.
+
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_clear_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_container_functions_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_single_no_threshold_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_single_threshold_reached_length_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_single_threshold_not_reached_length_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_single_threshold_reached_score_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_single_threshold_not_reached_score_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_possible_no_threshold_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_merge_right_merging_possible_no_threshold_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_impossible_no_threshold_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_possible_threshold_not_reached_length_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_possible_threshold_reached_length_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_possible_threshold_not_reached_scored_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_merge_left_merging_possible_threshold_reached_scored_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_possible_no_threshold_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_simple_chain_right_chaining_possible_no_threshold_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_impossible_no_threshold_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_possible_threshold_not_reached_length_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_possible_threshold_reached_length_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_possible_threshold_not_reached_scored_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_simple_chain_left_chaining_possible_threshold_reached_scored_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_no_threshold_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_chaos_right_chaining_possible_no_threshold_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_impossible_no_threshold_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_not_reached_length_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_reached_length_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_not_reached_scored_simple_diagonal_sorted);
+    SEQAN_CALL_TEST(test_seeds_seed_set_base_add_seed_chaos_left_chaining_possible_threshold_reached_scored_simple_diagonal_sorted);
 }
 SEQAN_END_TESTSUITE
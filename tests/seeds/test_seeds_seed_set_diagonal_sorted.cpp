@@ -0,0 +1,181 @@
+// ==========================================================================
+//                 SeqAn - The Library for Sequence Analysis
+// ==========================================================================
+// Copyright (c) 2006-2013, Knut Reinert, FU Berlin
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//     * Redistributions of source code must retain the above copyright
+//       notice, this list of conditions and the following disclaimer.
+//     * Redistributions in binary form must reproduce the above copyright
+//       notice, this list of conditions and the following disclaimer in the
+//       documentation and/or other materials provided with the distribution.
+//     * Neither the name of Knut Reinert or the FU Berlin nor the names of
+//       its contributors may be used to endorse or promote products derived
+//       from this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL KNUT REINERT OR THE FU BERLIN BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+// LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+// OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH
+// DAMAGE.
+//
+// ==========================================================================
+// Author: Manuel Holtgrewe <manuel.holtgrewe@fu-berlin.de>
+// ==========================================================================
+// Test the specialization DiagonalSorted SeedSet.  The results are compared
+// to the ones of the Unordered SeedSet which combines seeds in the same
+// order.
+// ==========================================================================
+
+#include <algorithm>
+
+#include <seqan/basic.h>  // Includes testing infrastructure.
+#include <seqan/stream.h>   // Required to print strings in tests.
+#include <seqan/random.h>
+
+#include <seqan/seeds.h>  // Include module under test.
+
+using namespace seqan;
+
+typedef Seed<Simple> TTestSeed;
+
+struct LessDiagonalPositionH
+{
+    bool operator()(TTestSeed const & a, TTestSeed const & b) const
+    {
+        if (beginDiagonal(a) != beginDiagonal(b))
+            return beginDiagonal(a) < beginDiagonal(b);
+        return beginPositionH(a) < beginPositionH(b);
+    }
+};
+
+template <typename TRng>
+void fillRandomSeeds(String<TTestSeed> & seeds, TRng & rng, unsigned count, unsigned range)
+{
+    clear(seeds);
+    for (unsigned i = 0; i < count; ++i)
+    {
+        unsigned beginH = pickRandomNumber(rng) % range;
+        unsigned beginV = pickRandomNumber(rng) % range;
+        unsigned lengthH = 1 + pickRandomNumber(rng) % 8;
+        unsigned lengthV = lengthH + pickRandomNumber(rng) % 3 - 1;
+        TTestSeed seed(beginH, beginV, beginH + lengthH, beginV + lengthV);
+        setScore(seed, lengthH);
+        appendValue(seeds, seed);
+    }
+}
+
+template <typename TSeedSet, typename TTag>
+void addSeedOrSingle(TSeedSet & seedSet, TTestSeed const & seed, Dna5String const & seqH, Dna5String const & seqV,
+                     TTag const & tag)
+{
+    if (!addSeed(seedSet, seed, 3, 4, Score<int, Simple>(1, -1, -1), seqH, seqV, tag))
+        addSeed(seedSet, seed, Single());
+}
+
+template <typename TSeedSet>
+void assertEqualSeedSets(SeedSet<TTestSeed, Unordered> const & expected, TSeedSet const & actual)
+{
+    SEQAN_ASSERT_EQ(length(expected), length(actual));
+    typedef Iterator<SeedSet<TTestSeed, Unordered> const, Standard>::Type TExpectedIter;
+    typename Iterator<TSeedSet const, Standard>::Type itActual = begin(actual, Standard());
+    for (TExpectedIter it = begin(expected, Standard()); it != end(expected, Standard()); ++it, ++itActual)
+    {
+        SEQAN_ASSERT_EQ(*it, *itActual);
+        SEQAN_ASSERT_EQ(score(*it), score(*itActual));
+    }
+}
+
+// Adds two random batches of seeds with addSeed() and addSeeds() and compares the result to the Unordered SeedSet.
+template <typename TTag>
+void testSeedsSeedSetDiagonalSortedRandom(TTag const & tag)
+{
+    Rng<MersenneTwister> rng(42);
+
+    Dna5String seqH, seqV;
+    for (unsigned i = 0; i < 300; ++i)
+    {
+        appendValue(seqH, Dna5(pickRandomNumber(rng) % 4));
+        appendValue(seqV, Dna5(pickRandomNumber(rng) % 4));
+    }
+
+    for (unsigned round = 0; round < 20; ++round)
+    {
+        SeedSet<TTestSeed, Unordered> expected;
+        SeedSet<TTestSeed, DiagonalSorted> single;
+        SeedSet<TTestSeed, DiagonalSorted> bulk;
+
+        for (unsigned batch = 0; batch < 2; ++batch)
+        {
+            String<TTestSeed> seeds;
+            fillRandomSeeds(seeds, rng, 200, 100 + 50 * batch);
+
+            // addSeeds() adds the seeds in sorted order.
+            String<TTestSeed> sorted = seeds;
+            std::stable_sort(begin(sorted, Standard()), end(sorted, Standard()), LessDiagonalPositionH());
+            for (unsigned i = 0; i < length(sorted); ++i)
+            {
+                addSeedOrSingle(expected, sorted[i], seqH, seqV, tag);
+                addSeedOrSingle(single, sorted[i], seqH, seqV, tag);
+            }
+            addSeeds(bulk, seeds, 3, 4, Score<int, Simple>(1, -1, -1), seqH, seqV, tag);
+
+            assertEqualSeedSets(expected, single);
+            assertEqualSeedSets(expected, bulk);
+        }
+    }
+}
+
+SEQAN_DEFINE_TEST(test_seeds_seed_set_diagonal_sorted_merge_random)
+{
+    testSeedsSeedSetDiagonalSortedRandom(Merge());
+}
+
+SEQAN_DEFINE_TEST(test_seeds_seed_set_diagonal_sorted_simple_chain_random)
+{
+    testSeedsSeedSetDiagonalSortedRandom(SimpleChain());
+}
+
+SEQAN_DEFINE_TEST(test_seeds_seed_set_diagonal_sorted_chaos_random)
+{
+    testSeedsSeedSetDiagonalSortedRandom(Chaos());
+}
+
+SEQAN_DEFINE_TEST(test_seeds_seed_set_diagonal_sorted_add_seeds_single)
+{
+    SeedSet<TTestSeed, DiagonalSorted> seedSet;
+    addSeed(seedSet, TTestSeed(0, 2, 3), Single());
+    addSeed(seedSet, TTestSeed(5, 1, 3), Single());
+
+    String<TTestSeed> seeds;
+    appendValue(seeds, TTestSeed(7, 3, 2));
+    appendValue(seeds, TTestSeed(1, 3, 2));
+    appendValue(seeds, TTestSeed(2, 0, 2));
+    addSeeds(seedSet, seeds, Single());
+
+    // Sorted by begin diagonal, new seeds behind the old ones, equal diagonals by begin position.
+    SEQAN_ASSERT_EQ(length(seedSet), 5u);
+    SEQAN_ASSERT_EQ(seedSet._seeds[0], TTestSeed(0, 2, 3));
+    SEQAN_ASSERT_EQ(seedSet._seeds[1], TTestSeed(1, 3, 2));
+    SEQAN_ASSERT_EQ(seedSet._seeds[2], TTestSeed(2, 0, 2));
+    SEQAN_ASSERT_EQ(seedSet._seeds[3], TTestSeed(5, 1, 3));
+    SEQAN_ASSERT_EQ(seedSet._seeds[4], TTestSeed(7, 3, 2));
+}
+
+SEQAN_BEGIN_TESTSUITE(test_seeds_seed_set_diagonal_sorted)
+{
+    SEQAN_CALL_TEST(test_seeds_seed_set_diagonal_sorted_merge_random);
+    SEQAN_CALL_TEST(test_seeds_seed_set_diagonal_sorted_simple_chain_random);
+    SEQAN_CALL_TEST(test_seeds_seed_set_diagonal_sorted_chaos_random);
+    SEQAN_CALL_TEST(test_seeds_seed_set_diagonal_sorted_add_seeds_single);
+}
+SEQAN_END_TESTSUITE
@@ -50,6 +50,11 @@ SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_build)
     SEQAN_ASSERT_EQ(sequenceName(faiIndex, 0), "gi|9632547|ref|NC_002077.1|");
     SEQAN_ASSERT_EQ(sequenceLength(faiIndex, 1), 8u);
     SEQAN_ASSERT_EQ(sequenceName(faiIndex, 1), "sequence");
+
+    // FASTQ files can't be indexed.
+    filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/tests/seq_io/test_dna.fq");
+    SEQAN_ASSERT_EQ(build(faiIndex, toCString(filePath)), false);
 }
 
 SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_write)
@@ -139,4 +144,93 @@ SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_read_region)
     }
 }
 
+#if SEQAN_HAS_ZLIB
+
+// Write contents into a BGZF compressed file.
+
+inline void _testFaiWriteBgzf(seqan::CharString const & path, seqan::CharString const & contents)
+{
+    std::ofstream file(toCString(path), std::ios_base::out | std::ios_base::binary);
+    seqan::bgzf_ostream bgzfStream(file);
+    bgzfStream.write(toCString(contents), length(contents));
+}
+
+SEQAN_DEFINE_TEST(test_seq_io_genomic_fai_index_bgzf)
+{
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/tests/seq_io/adeno_genome.fa");
+
+    // Generate a FASTA file spanning several BGZF blocks and compress it.
+    seqan::CharString contents;
+    {
+        std::ifstream in(toCString(filePath), std::ios_base::in | std::ios_base::binary);
+        seqan::DirectionIterator<std::ifstream, seqan::Input>::Type reader = directionIterator(in, seqan::Input());
+        readUntil(contents, reader, seqan::False());
+    }
+    append(contents, ">long\n");
+    for (unsigned i = 0; i < 300000u; ++i)
+    {
+        appendValue(contents, "ACGTN"[(i * 7 + i / 13) % 5]);
+        if (i % 60 == 59)
+            appendValue(contents, '\n');
+    }
+    appendValue(contents, '\n');
+
+    seqan::CharString plainPath = SEQAN_TEMP_FILENAME();
+    append(plainPath, ".fa");
+    {
+        std::ofstream out(toCString(plainPath), std::ios_base::out | std::ios_base::binary);
+        out.write(toCString(contents), length(contents));
+    }
+    seqan::CharString bgzfPath = SEQAN_TEMP_FILENAME();
+    append(bgzfPath, ".fa.gz");
+    _testFaiWriteBgzf(bgzfPath, contents);
+
+    seqan::FaiIndex plainIndex;
+    SEQAN_ASSERT_EQ(build(plainIndex, toCString(plainPath)), true);
+    SEQAN_ASSERT(empty(plainIndex.gziIndex));
+
+    seqan::FaiIndex faiIndex;
+    SEQAN_ASSERT_EQ(build(faiIndex, toCString(bgzfPath)), true);
+    SEQAN_ASSERT_GT(length(faiIndex.gziIndex), 3u);
+    SEQAN_ASSERT_EQ(numSeqs(faiIndex), 3u);
+    for (unsigned i = 0; i < numSeqs(faiIndex); ++i)
+    {
+        SEQAN_ASSERT_EQ(sequenceName(faiIndex, i), sequenceName(plainIndex, i));
+        SEQAN_ASSERT_EQ(faiIndex.indexEntryStore[i].offset, plainIndex.indexEntryStore[i].offset);
+        SEQAN_ASSERT_EQ(faiIndex.indexEntryStore[i].sequenceLength, plainIndex.indexEntryStore[i].sequenceLength);
+        SEQAN_ASSERT_EQ(faiIndex.indexEntryStore[i].overallLineLength,
+                        plainIndex.indexEntryStore[i].overallLineLength);
+    }
+
+    // Regions within and across block boundaries, read after build and after save/open with the GZI file.
+    seqan::CharString faiPath = bgzfPath;
+    append(faiPath, ".fai");
+    SEQAN_ASSERT_EQ(save(faiIndex, toCString(faiPath)), true);
+
+    seqan::FaiIndex openedIndex;
+    SEQAN_ASSERT_EQ(open(openedIndex, toCString(bgzfPath)), true);
+    SEQAN_ASSERT(openedIndex.gziIndex == faiIndex.gziIndex);
+    openedIndex.blockCache.capacity = 2;
+
+    seqan::Dna5String expected, str, str2;
+    for (unsigned i = 0; i < 200; ++i)
+    {
+        unsigned rID = i % 3;
+        unsigned beginPos = (i * 7919u) % sequenceLength(plainIndex, rID);
+        unsigned endPos = beginPos + (i * 104729u) % 70000u;
+        readRegion(expected, plainIndex, rID, beginPos, endPos);
+        readRegion(str, faiIndex, rID, beginPos, endPos);
+        readRegion(str2, openedIndex, rID, beginPos, endPos);
+        SEQAN_ASSERT_EQ(str, expected);
+        SEQAN_ASSERT_EQ(str2, expected);
+    }
+    readSequence(str, openedIndex, 0);
+    SEQAN_ASSERT_EQ(prefix(str, 20), "TTGCCCACTCCCTCTCTGCG");
+    SEQAN_ASSERT_EQ(suffix(str, length(str) - 20), "CGCAGAGAGGGAGTGGGCAA");
+    SEQAN_ASSERT_LEQ(length(openedIndex.blockCache.entries), 2u);
+}
+
+#endif  // #if SEQAN_HAS_ZLIB
+
 #endif  // #ifndef TESTS_SEQ_IO_TEST_FAI_INDEX_H_
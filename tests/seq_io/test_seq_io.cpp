@@ -64,6 +64,7 @@ SEQAN_BEGIN_TESTSUITE(test_seq_io)
     // Test reading with different interfaces.
     SEQAN_CALL_TEST(test_seq_io_sequence_file_read_record_text_fasta);
     SEQAN_CALL_TEST(test_seq_io_sequence_file_read_all_text_fasta);
+    SEQAN_CALL_TEST(test_seq_io_sequence_file_read_batch_text_fasta);
 
     // Test writing with different interfaces.
     SEQAN_CALL_TEST(test_seq_io_sequence_file_write_record_text_fasta);
@@ -89,6 +90,9 @@ SEQAN_BEGIN_TESTSUITE(test_seq_io)
     SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_read);
     SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_read_sequence);
     SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_read_region);
+#if SEQAN_HAS_ZLIB
+    SEQAN_CALL_TEST(test_seq_io_genomic_fai_index_bgzf);
+#endif
 
     // -------------- File format specific code ------------------
 
@@ -160,6 +160,36 @@ SEQAN_DEFINE_TEST(test_seq_io_sequence_file_read_all_text_fasta)
     SEQAN_ASSERT(atEnd(seqIO));
 }
 
+SEQAN_DEFINE_TEST(test_seq_io_sequence_file_read_batch_text_fasta)
+{
+    // Build path to file.
+    seqan::CharString filePath = SEQAN_PATH_TO_ROOT();
+    append(filePath, "/tests/seq_io/test_dna.fa");
+
+    // Create SequenceStream object.
+    SeqFileIn seqIO(toCString(filePath));
+
+    // Read the records in batches, the integral count must not be taken for an alphabet.
+    seqan::StringSet<seqan::CharString> ids;
+    seqan::StringSet<seqan::Dna5QString> seqs;
+    unsigned records = 2;
+
+    readRecords(ids, seqs, seqIO, records);
+    SEQAN_ASSERT_EQ(length(seqs), 2u);
+    SEQAN_ASSERT_EQ(ids[0], "seq1");
+    SEQAN_ASSERT_EQ(seqs[0], "CGATCGATAAT");
+    SEQAN_ASSERT_EQ(ids[1], "seq2");
+    SEQAN_ASSERT_EQ(seqs[1], "CCTCTCTCTCCCT");
+    SEQAN_ASSERT_NOT(atEnd(seqIO));
+
+    readRecords(ids, seqs, seqIO, records);
+    SEQAN_ASSERT_EQ(length(seqs), 3u);
+    SEQAN_ASSERT_EQ(ids[2], "seq3");
+    SEQAN_ASSERT_EQ(seqs[2], "CCCCCCCC");
+
+    SEQAN_ASSERT(atEnd(seqIO));
+}
+
 // ---------------------------------------------------------------------------
 // Test writing with different interfaces.
 // ---------------------------------------------------------------------------
@@ -36,6 +36,8 @@
 #include <seqan/basic.h>
 #include <seqan/sequence.h>
 #include <seqan/stream.h>
+#include <seqan/random.h>
+#include <seqan/index.h>
 
 using namespace seqan;
 
@@ -90,6 +92,9 @@ SEQAN_BEGIN_TESTSUITE(Sequence tests)
     SEQAN_CALL_TEST(StringSet_Owner_Default);
     SEQAN_CALL_TEST(StringSet_Concat_Owner_Default);
     SEQAN_CALL_TEST(StringSet_Concat_Owner_ConcatDirect);
+    SEQAN_CALL_TEST(StringSet_Concat_Owner_Arena);
+    SEQAN_CALL_TEST(StringSet_Owner_Arena);
+    SEQAN_CALL_TEST(StringSet_Owner_Arena_Index);
     SEQAN_CALL_TEST(StringSet_Id_Dependent_Tight);
     SEQAN_CALL_TEST(StringSet_Id_Dependent_Generous);
     SEQAN_CALL_TEST(StringSetIdHolder_Char_Dependent_Tight);
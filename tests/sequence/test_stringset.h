@@ -272,6 +272,131 @@ SEQAN_DEFINE_TEST(StringSet_Concat_Owner_ConcatDirect) {
 	Test_StringSet_Concat< Owner<ConcatDirect<> > >();
 }
 
+SEQAN_DEFINE_TEST(StringSet_Concat_Owner_Arena) {
+    SEQAN_CHECKPOINT;
+	Test_StringSet_Concat< Owner<Arena<> > >();
+}
+
+SEQAN_DEFINE_TEST(StringSet_Owner_Arena)
+{
+    typedef StringSet<Dna5String, Owner<Arena<> > > TStringSet;
+    typedef Iterator<Dna5String const, Standard>::Type TIter;
+
+    TStringSet set;
+    appendValue(set, "ACGT");
+    appendValue(set, "NNA");
+    TIter firstBegin = begin(set[0], Standard());
+
+    // appending does not move the previous strings
+    Dna5String longRead;
+    resize(longRead, 3 * (int)TStringSet::CHUNK_LENGTH, Dna5('G'));
+    appendValue(set, longRead);
+    for (unsigned i = 0; i < 1000; ++i)
+        appendValue(set, "TTTTTTTTTT");
+    SEQAN_ASSERT(begin(set[0], Standard()) == firstBegin);
+    SEQAN_ASSERT_EQ(length(set), 1003u);
+    SEQAN_ASSERT_EQ(set[0], Dna5String("ACGT"));
+    SEQAN_ASSERT_EQ(set[1], Dna5String("NNA"));
+    SEQAN_ASSERT_EQ(length(set[2]), length(longRead));
+    SEQAN_ASSERT_EQ(set[1002], Dna5String("TTTTTTTTTT"));
+    SEQAN_ASSERT_EQ(stringSetLimits(set)[3], 7u + length(longRead));
+    SEQAN_ASSERT_EQ(lengthSum(set), 10007u + length(longRead));
+
+    // the next batch reuses the chunks
+    unsigned chunkCount = length(set.chunks);
+    clear(set);
+    SEQAN_ASSERT_EQ(length(set), 0u);
+    SEQAN_ASSERT_EQ(lengthSum(set), 0u);
+    appendValue(set, "CCC");
+    appendValue(set, longRead);
+    SEQAN_ASSERT(begin(set[0], Standard()) == firstBegin);
+    SEQAN_ASSERT_EQ(length(set.chunks), chunkCount);
+
+    // replace, insert and erase strings
+    assignValue(set, 0, "GATTACA");
+    insertValue(set, 1, "AC");
+    SEQAN_ASSERT_EQ(length(set), 3u);
+    SEQAN_ASSERT_EQ(set[0], Dna5String("GATTACA"));
+    SEQAN_ASSERT_EQ(set[1], Dna5String("AC"));
+    SEQAN_ASSERT_EQ(stringSetLimits(set)[2], 9u);
+    erase(set, 0);
+    SEQAN_ASSERT_EQ(length(set), 2u);
+    SEQAN_ASSERT_EQ(set[0], Dna5String("AC"));
+    SEQAN_ASSERT_EQ(stringSetLimits(set)[1], 2u);
+    SEQAN_ASSERT_EQ(stringSetLimits(set)[2], 2u + length(longRead));
+
+    // copies and infixes of the concatenation
+    TStringSet copy = set;
+    clear(set);
+    SEQAN_ASSERT_EQ(length(copy), 2u);
+    SEQAN_ASSERT_EQ(copy[0], Dna5String("AC"));
+    SEQAN_ASSERT_EQ(infix(copy, 2, 4), Dna5String("GG"));
+    SEQAN_ASSERT_EQ(suffix(copy, Pair<unsigned>(0, 1)), Dna5String("C"));
+    SEQAN_ASSERT_EQ(prefix(copy, Pair<unsigned>(1, 2)), Dna5String("GG"));
+
+    // views can only be replaced with assignValue(), which updates the limits
+    bool constReference = IsSameType<Reference<TStringSet>::Type, View<Dna5String>::Type const &>::VALUE;
+    SEQAN_ASSERT(constReference);
+}
+
+SEQAN_DEFINE_TEST(StringSet_Owner_Arena_Index)
+{
+    typedef StringSet<Dna5String, Owner<Arena<> > > TArenaSet;
+    typedef StringSet<Dna5String, Owner<Default> > TOwnerSet;
+
+    Rng<MersenneTwister> rng(42);
+    TArenaSet arenaSet;
+    TOwnerSet ownerSet;
+    for (unsigned i = 0; i < 100; ++i)
+    {
+        Dna5String read;
+        unsigned len = 20 + pickRandomNumber(rng) % 60;
+        for (unsigned j = 0; j < len; ++j)
+            appendValue(read, Dna5(pickRandomNumber(rng) % 5));
+        appendValue(arenaSet, read);
+        appendValue(ownerSet, read);
+    }
+    assignValue(arenaSet, 10, "ACGTACGTACGTACGTACGTAAAA");
+    assignValue(ownerSet, 10, "ACGTACGTACGTACGTACGTAAAA");
+
+    // q-gram index
+    {
+        typedef IndexQGram<UngappedShape<4> > TIndexSpec;
+        Index<TArenaSet, TIndexSpec> arenaIndex(arenaSet);
+        Index<TOwnerSet, TIndexSpec> ownerIndex(ownerSet);
+        indexRequire(arenaIndex, QGramSADir());
+        indexRequire(ownerIndex, QGramSADir());
+        SEQAN_ASSERT(indexSA(arenaIndex) == indexSA(ownerIndex));
+        SEQAN_ASSERT(indexDir(arenaIndex) == indexDir(ownerIndex));
+    }
+
+    // FM index
+    {
+        typedef Index<TArenaSet, FMIndex<> > TArenaIndex;
+        typedef Index<TOwnerSet, FMIndex<> > TOwnerIndex;
+        typedef SAValue<TArenaIndex>::Type TSAValue;
+        TArenaIndex arenaIndex(arenaSet);
+        TOwnerIndex ownerIndex(ownerSet);
+        Finder<TArenaIndex> arenaFinder(arenaIndex);
+        Finder<TOwnerIndex> ownerFinder(ownerIndex);
+
+        char const * patterns[] = { "ACGT", "AAAA", "GATTACA", "NN", "ACGTACGTACGTACGTACGTAAAA" };
+        for (unsigned i = 0; i < 5; ++i)
+        {
+            String<TSAValue> arenaOccs, ownerOccs;
+            clear(arenaFinder);
+            while (find(arenaFinder, patterns[i]))
+                appendValue(arenaOccs, position(arenaFinder));
+            clear(ownerFinder);
+            while (find(ownerFinder, patterns[i]))
+                appendValue(ownerOccs, position(ownerFinder));
+            std::sort(begin(arenaOccs, Standard()), end(arenaOccs, Standard()));
+            std::sort(begin(ownerOccs, Standard()), end(ownerOccs, Standard()));
+            SEQAN_ASSERT(arenaOccs == ownerOccs);
+        }
+    }
+}
+
 SEQAN_DEFINE_TEST(StringSet_Id_Dependent_Tight) {
     SEQAN_CHECKPOINT;
 	Test_StringSet_Id< Dependent<Tight> >();
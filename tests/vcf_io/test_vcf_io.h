@@ -269,6 +269,79 @@ SEQAN_DEFINE_TEST(test_vcf_io_vcf_file_read_record)
     SEQAN_ASSERT_EQ(length(records[2].genotypeInfos), 3u);
 }
 
+SEQAN_DEFINE_TEST(test_vcf_io_vcf_file_read_batch)
+{
+    seqan::CharString vcfPath = SEQAN_PATH_TO_ROOT();
+    append(vcfPath, "/tests/vcf_io/example.vcf");
+
+    // Read all records one by one for comparison.
+    seqan::String<seqan::VcfRecord> expected;
+    {
+        seqan::VcfFileIn vcfStream(toCString(vcfPath));
+        seqan::VcfHeader header;
+        readRecord(header, vcfStream);
+        seqan::VcfRecord record;
+        while (!atEnd(vcfStream))
+        {
+            readRecord(record, vcfStream);
+            appendValue(expected, record);
+        }
+    }
+
+    seqan::VcfFileIn vcfStream(toCString(vcfPath));
+    seqan::VcfHeader header;
+    readRecord(header, vcfStream);
+
+    // Read in batches of 2 records to test reading across batches.
+    seqan::VcfRecordBatch batch;
+    seqan::String<seqan::VcfRecord> records;
+    seqan::VcfRecord record;
+    while (readBatch(batch, vcfStream, 2u) != 0u)
+    {
+        SEQAN_ASSERT_LEQ(length(batch), 2u);
+        for (unsigned i = 0; i < length(batch); ++i)
+        {
+            assignRecord(record, batch, i);
+            appendValue(records, record);
+        }
+    }
+    SEQAN_ASSERT_EQ(length(batch), 0u);
+    SEQAN_ASSERT_EQ(length(records), length(expected));
+
+    for (unsigned i = 0; i < length(records); ++i)
+    {
+        SEQAN_ASSERT_EQ(records[i].rID, expected[i].rID);
+        SEQAN_ASSERT_EQ(records[i].beginPos, expected[i].beginPos);
+        SEQAN_ASSERT_EQ(records[i].id, expected[i].id);
+        SEQAN_ASSERT_EQ(records[i].ref, expected[i].ref);
+        SEQAN_ASSERT_EQ(records[i].alt, expected[i].alt);
+        SEQAN_ASSERT_EQ(records[i].qual, expected[i].qual);
+        SEQAN_ASSERT_EQ(records[i].filter, expected[i].filter);
+        SEQAN_ASSERT_EQ(records[i].info, expected[i].info);
+        SEQAN_ASSERT_EQ(records[i].format, expected[i].format);
+        SEQAN_ASSERT(records[i].genotypeInfos == expected[i].genotypeInfos);
+    }
+
+    // Lazy access to single fields and samples.
+    seqan::VcfFileIn vcfStream2(toCString(vcfPath));
+    readRecord(header, vcfStream2);
+    SEQAN_ASSERT_EQ(readBatch(batch, vcfStream2, 100u), 3u);
+    SEQAN_ASSERT_EQ(batch[2].beginPos, 1110695);
+    SEQAN_ASSERT_EQ(getAlt(batch, 2), "G,T");
+    SEQAN_ASSERT_EQ(getGenotypeInfo(batch, 1, 2), "0/0:41:3");
+    SEQAN_ASSERT_EQ(getGenotypeInfo(batch, 0, 0), "0|0:48:1:51,51");
+    bool thrown = false;
+    try
+    {
+        getGenotypeInfo(batch, 0, 3);
+    }
+    catch (seqan::EmptyFieldError const &)
+    {
+        thrown = true;
+    }
+    SEQAN_ASSERT(thrown);
+}
+
 SEQAN_DEFINE_TEST(test_vcf_io_write_vcf_header)
 {
     seqan::VcfIOContext<> vcfIOContext;